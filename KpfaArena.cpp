@@ -0,0 +1,120 @@
+/*
+ * KpfaArena.cpp
+ */
+
+#include "KpfaArena.h"
+
+KpfaArena::KpfaArena(size_t nChunkSize) {
+
+	m_nChunkSize = (nChunkSize > 0) ? nChunkSize : KPFA_ARENA_CHUNK_SIZE;
+
+	m_pCurrent = NULL;
+	m_pLimit = NULL;
+
+	m_nUsedSize = 0;
+}
+
+KpfaArena::~KpfaArena() {
+
+	Release();
+}
+
+/**
+ * This function will allocate a memory block from the arena.
+ * A block larger than the chunk size gets a dedicated chunk
+ * so that the active chunk can keep serving small blocks.
+ *
+ * @param nSize the size of the memory block
+ * @return the allocated memory block (NULL if failed)
+ */
+void *
+KpfaArena::Allocate(size_t nSize) {
+
+	// Round up to the alignment
+	nSize = (nSize + KPFA_ARENA_ALIGNMENT - 1) & ~((size_t)KPFA_ARENA_ALIGNMENT - 1);
+
+	if(nSize == 0) {
+		nSize = KPFA_ARENA_ALIGNMENT;
+	}
+
+	std::lock_guard<std::mutex> guard(m_rLock);
+
+	if(nSize > m_nChunkSize) {
+
+		char *chunk = (char *)malloc(nSize);
+
+		if(chunk == NULL) {
+			return NULL;
+		}
+
+		m_rChunkList.push_back(chunk);
+		m_nUsedSize += nSize;
+
+		return chunk;
+	}
+
+	if(m_pCurrent == NULL || (size_t)(m_pLimit - m_pCurrent) < nSize) {
+
+		char *chunk = (char *)malloc(m_nChunkSize);
+
+		if(chunk == NULL) {
+			return NULL;
+		}
+
+		m_rChunkList.push_back(chunk);
+
+		m_pCurrent = chunk;
+		m_pLimit = chunk + m_nChunkSize;
+	}
+
+	void *block = m_pCurrent;
+
+	m_pCurrent += nSize;
+	m_nUsedSize += nSize;
+
+	return block;
+}
+
+/**
+ * This function will release all the memory blocks of the arena at once.
+ */
+void
+KpfaArena::Release() {
+
+	std::lock_guard<std::mutex> guard(m_rLock);
+
+	std::vector<char *>::iterator iter;
+
+	for(iter = m_rChunkList.begin(); iter != m_rChunkList.end(); iter++) {
+		free(*iter);
+	}
+
+	m_rChunkList.clear();
+
+	m_pCurrent = NULL;
+	m_pLimit = NULL;
+
+	m_nUsedSize = 0;
+}
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaArena::Write(ostream &rOut) {
+
+	rOut << "KPFA ARENA: " << endl;
+
+	rOut << "\tCHUNK SIZE: " << m_nChunkSize << endl;
+
+	rOut << "\tCHUNK COUNT: " << m_rChunkList.size() << endl;
+
+	rOut << "\tUSED SIZE: " << m_nUsedSize << endl;
+}
+
+ostream &operator << (ostream &rOut, KpfaArena *pArena) {
+
+	pArena->Write(rOut);
+	return rOut;
+}
@@ -0,0 +1,87 @@
+/*
+ * KpfaArena.h
+ */
+
+#ifndef _KPFA_ARENA_H_
+#define _KPFA_ARENA_H_
+
+#include <mutex>
+
+#include "KpfaDebug.h"
+#include "KpfaConfig.h"
+
+// Default size of a memory chunk of the arena (4MB)
+#define KPFA_ARENA_CHUNK_SIZE		(4 * 1024 * 1024)
+
+// Alignment of the memory blocks returned by the arena
+#define KPFA_ARENA_ALIGNMENT		16
+
+/**
+ * The declaration of the class for a growable memory arena.
+ * Memory blocks are carved out of large chunks and cannot be freed
+ * individually. All the chunks are released at once by Release().
+ */
+class KpfaArena {
+
+private:
+
+	// Size of a regular chunk
+	size_t m_nChunkSize;
+
+	// A list of the allocated chunks
+	std::vector<char *> m_rChunkList;
+
+	// Current position and end of the active chunk
+	char *m_pCurrent;
+	char *m_pLimit;
+
+	// Total number of bytes handed out
+	size_t m_nUsedSize;
+
+	// Lock for concurrent allocations
+	std::mutex m_rLock;
+
+public:
+
+	KpfaArena(size_t nChunkSize = KPFA_ARENA_CHUNK_SIZE);
+
+	virtual ~KpfaArena();
+
+	void *Allocate(size_t nSize);
+
+	void Release();
+
+	/**
+	 * This function will return the number of bytes handed out by the arena.
+	 *
+	 * @return used size
+	 */
+	inline size_t GetUsedSize() {
+		return m_nUsedSize;
+	}
+
+	/**
+	 * This function will return the number of chunks owned by the arena.
+	 *
+	 * @return chunk count
+	 */
+	inline size_t GetChunkCount() {
+		return m_rChunkList.size();
+	}
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+
+	friend ostream &operator << (ostream &rOut, KpfaArena *pArena);
+
+private:
+
+	KpfaArena(const KpfaArena &);
+
+	KpfaArena &operator = (const KpfaArena &);
+};
+
+#endif /* _KPFA_ARENA_H_ */
@@ -0,0 +1,407 @@
+/*
+ * KpfaCheckpoint.cpp
+ */
+
+#include "KpfaCheckpoint.h"
+#include "KpfaResultData.h"
+#include "KpfaMappedFile.h"
+#include "KpfaUtility.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/**
+ * Cuts off the given file at the given size.
+ */
+static inline int
+TruncateFile(FILE *fp, long nSize) {
+
+	fflush(fp);
+
+#ifdef _WIN32
+	return _chsize(_fileno(fp), nSize);
+#else
+	return ftruncate(fileno(fp), (off_t)nSize);
+#endif
+}
+
+/**
+ * Gets the information to check the given input file (zero if no file is given).
+ */
+static KpfaError_t
+GetSourceInfo(const string &rFilePath, KpfaCheckpointSource_t &rSource) {
+
+	memset(&rSource, 0, sizeof(rSource));
+
+	if(rFilePath.empty() == true) {
+		return KPFA_SUCCESS;
+	}
+
+	KpfaMappedFile file;
+
+	KpfaError_t error = file.Open(rFilePath.c_str());
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	rSource.nSize = file.GetSize();
+	rSource.nTime = file.GetModifyTime();
+	rSource.nHash = KpfaHashData(file.GetData(), file.GetSize());
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * Checks whether the given input files are the same.
+ */
+static inline bool
+IsSameSource(const KpfaCheckpointSource_t &rLeft, const KpfaCheckpointSource_t &rRight) {
+	return rLeft.nSize == rRight.nSize && rLeft.nTime == rRight.nTime && rLeft.nHash == rRight.nHash;
+}
+
+KpfaCheckpoint::KpfaCheckpoint(const string &rFilePath, bool_t bResume, uint32_t nInterval) {
+
+	m_rFilePath = rFilePath;
+	m_pFile = NULL;
+	m_bResume = bResume;
+	m_nInterval = (nInterval > 0) ? nInterval : 1;
+	m_nPendingCount = 0;
+	m_nFinishedCount = 0;
+	m_nFailedCount = 0;
+}
+
+KpfaCheckpoint::~KpfaCheckpoint() {
+
+	if(m_pFile != NULL) {
+		fclose(m_pFile);
+	}
+}
+
+/**
+ * This function will open the checkpoint file. If the run is resumed and the
+ * file exists, its records are loaded and the new records are appended after
+ * the last complete one. Otherwise, a new file is created.
+ *
+ * @return error information
+ */
+KpfaError_t
+KpfaCheckpoint::Open() {
+
+	KPFA_CHECK(m_rFilePath.empty() == false, KPFA_ERROR_INVALID_ARGUMENT);
+
+	KpfaError_t error;
+
+	KpfaCheckpointHeader_t header;
+
+	error = SetHeader(header);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	long validSize = -1;
+
+	if(m_bResume == TRUE) {
+		error = Load(header, validSize);
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+	}
+
+	if(validSize > 0) {
+
+		m_pFile = fopen(m_rFilePath.c_str(), "r+b");
+
+		if(m_pFile == NULL) {
+			cerr << "File Not Open: " << m_rFilePath << endl;
+			return KPFA_ERROR_FILE_OPEN;
+		}
+
+		// Cut off the record torn at the end of the previous run
+		if(TruncateFile(m_pFile, validSize) != 0) {
+			return KPFA_ERROR_FILE_WRITE;
+		}
+
+		fseek(m_pFile, 0, SEEK_END);
+
+		KPFA_DEBUG("KpfaCheckpoint", "Resume: %u finished, %u failed",
+				   m_nFinishedCount, m_nFailedCount);
+
+		return KPFA_SUCCESS;
+	}
+
+	m_pFile = fopen(m_rFilePath.c_str(), "wb");
+
+	if(m_pFile == NULL) {
+		cerr << "File Not Open: " << m_rFilePath << endl;
+		return KPFA_ERROR_FILE_OPEN;
+	}
+
+	fwrite(&header, sizeof(header), 1, m_pFile);
+	fflush(m_pFile);
+
+	return (ferror(m_pFile) == 0) ? KPFA_SUCCESS : KPFA_ERROR_FILE_WRITE;
+}
+
+/**
+ * This function will record the given finished contingency.
+ *
+ * @param pResult the result of the contingency
+ * @return error information
+ */
+KpfaError_t
+KpfaCheckpoint::Push(KpfaCtgResult_t *pResult) {
+
+	KPFA_CHECK(pResult != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	// The result replayed from the previous run is recorded already
+	if(IsFinished(pResult->nIndex) == true) {
+		return KPFA_SUCCESS;
+	}
+
+	return Record(pResult->nIndex, KPFA_SUCCESS, pResult);
+}
+
+/**
+ * This function will append a record of the given contingency. The file is
+ * flushed every given number of records, and at once if the analysis failed.
+ *
+ * @param nIndex contingency index
+ * @param nError error of the analysis (KPFA_SUCCESS if finished)
+ * @param pResult the result of the contingency (NULL if not available)
+ * @return error information
+ */
+KpfaError_t
+KpfaCheckpoint::Record(uint32_t nIndex, KpfaError_t nError, KpfaCtgResult_t *pResult) {
+
+	KPFA_CHECK(m_pFile != NULL, KPFA_ERROR_FILE_OPEN);
+
+	bool failed = (nError != KPFA_SUCCESS);
+
+	KpfaCheckpointRecord_t record;
+
+	record.nTag = KPFA_CHECKPOINT_TAG_CTG;
+	record.nIndex = nIndex;
+	record.nError = (int32_t)nError;
+	record.nDataSize = (failed == false) ? (uint32_t)KpfaGetBinaryResultSize(pResult) : 0;
+
+	fwrite(&record, sizeof(record), 1, m_pFile);
+
+	if(record.nDataSize > 0) {
+		KpfaError_t error = KpfaWriteBinaryResult(m_pFile, pResult);
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+	}
+
+	SetState(nIndex, failed ? KPFA_CHECKPOINT_FAILED : KPFA_CHECKPOINT_FINISHED);
+
+	if(failed == true || ++m_nPendingCount >= m_nInterval) {
+		fflush(m_pFile);
+		m_nPendingCount = 0;
+	}
+
+	return (ferror(m_pFile) == 0) ? KPFA_SUCCESS : KPFA_ERROR_FILE_WRITE;
+}
+
+/**
+ * This function will flush and close the checkpoint file.
+ *
+ * @param pResultData the result data with the system-wide results (not used yet)
+ * @return error information
+ */
+KpfaError_t
+KpfaCheckpoint::Close(KpfaResultData_t *pResultData) {
+
+	(void)pResultData;
+
+	if(m_pFile == NULL) {
+		return KPFA_SUCCESS;
+	}
+
+	fflush(m_pFile);
+
+	KpfaError_t error = (ferror(m_pFile) == 0) ? KPFA_SUCCESS : KPFA_ERROR_FILE_WRITE;
+
+	fclose(m_pFile);
+	m_pFile = NULL;
+
+	return error;
+}
+
+/**
+ * This function will push the result of the given contingency finished in the
+ * previous run to the result data and the result sinks again, as if it was
+ * analyzed in this run.
+ *
+ * @param pCtgData contingency data finished in the previous run
+ * @return error information
+ */
+KpfaError_t
+KpfaCheckpoint::Replay(KpfaCtgData *pCtgData) {
+
+	KPFA_CHECK(pCtgData != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+	KPFA_CHECK(m_pFile != NULL, KPFA_ERROR_FILE_OPEN);
+
+	uint32_t index = pCtgData->GetIndex();
+
+	KPFA_CHECK(IsFinished(index) == true && index < m_rOffsetList.size(), KPFA_ERROR_RESULT_NOT_FOUND);
+
+	if(fseek(m_pFile, m_rOffsetList[index], SEEK_SET) != 0) {
+		return KPFA_ERROR_FILE_FORMAT;
+	}
+
+	KpfaError_t error = KpfaRestoreResultData(pCtgData, m_pFile);
+
+	// The new records are appended at the end
+	fseek(m_pFile, 0, SEEK_END);
+
+	return error;
+}
+
+/**
+ * This function will set the header of the checkpoint file of this run.
+ *
+ * @param rHeader output header
+ * @return error information
+ */
+KpfaError_t
+KpfaCheckpoint::SetHeader(KpfaCheckpointHeader_t &rHeader) {
+
+	KpfaError_t error;
+
+	memset(&rHeader, 0, sizeof(rHeader));
+
+	rHeader.nMagic = KPFA_CHECKPOINT_MAGIC;
+	rHeader.nVersion = KPFA_CHECKPOINT_VERSION;
+
+	error = GetSourceInfo(m_rRawFilePath, rHeader.hRawFile);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	error = GetSourceInfo(m_rCtgFilePath, rHeader.hCtgFile);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will load the records of the checkpoint file of a previous run.
+ * The records are read up to the last complete one, so that a record torn at
+ * the end of the file is ignored. The file is rejected if its input files are
+ * not the same as those of this run.
+ *
+ * @param rHeader header of the checkpoint file of this run
+ * @param nValidSize output size of the file up to the last complete record
+ * 					 (-1 if the file does not exist)
+ * @return error information
+ */
+KpfaError_t
+KpfaCheckpoint::Load(const KpfaCheckpointHeader_t &rHeader, long &nValidSize) {
+
+	nValidSize = -1;
+
+	FILE *fp = fopen(m_rFilePath.c_str(), "rb");
+
+	if(fp == NULL) {
+		return KPFA_SUCCESS;
+	}
+
+	fseek(fp, 0, SEEK_END);
+	long fileSize = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	KpfaCheckpointHeader_t header;
+
+	if(fread(&header, sizeof(header), 1, fp) != 1) {
+		// Torn before the header was written
+		fclose(fp);
+		return KPFA_SUCCESS;
+	}
+
+	if(header.nMagic != KPFA_CHECKPOINT_MAGIC || header.nVersion != KPFA_CHECKPOINT_VERSION) {
+		KPFA_ERROR("Invalid checkpoint file: %s", m_rFilePath.c_str());
+		fclose(fp);
+		return KPFA_ERROR_FILE_FORMAT;
+	}
+
+	// The results of the previous run are not valid for the other input files
+	if(IsSameSource(header.hRawFile, rHeader.hRawFile) == false ||
+	   IsSameSource(header.hCtgFile, rHeader.hCtgFile) == false) {
+		KPFA_ERROR("Checkpoint file for different input files: %s", m_rFilePath.c_str());
+		fclose(fp);
+		return KPFA_ERROR_FILE_FORMAT;
+	}
+
+	nValidSize = ftell(fp);
+
+	KpfaCheckpointRecord_t record;
+
+	while(fread(&record, sizeof(record), 1, fp) == 1) {
+
+		long next = nValidSize + (long)sizeof(record) + (long)record.nDataSize;
+
+		if(record.nTag != KPFA_CHECKPOINT_TAG_CTG || next > fileSize) {
+			break;
+		}
+
+		if(fseek(fp, next, SEEK_SET) != 0) {
+			break;
+		}
+
+		KpfaCheckpointState_t state = (record.nError == KPFA_SUCCESS) ?
+				KPFA_CHECKPOINT_FINISHED : KPFA_CHECKPOINT_FAILED;
+
+#ifdef KPFA_RESULT_SUPPORT
+		// Analyze again the contingency finished without its result, which cannot be replayed
+		if(state == KPFA_CHECKPOINT_FINISHED && record.nDataSize == 0) {
+			state = KPFA_CHECKPOINT_PENDING;
+		}
+#endif
+
+		if(record.nIndex >= m_rOffsetList.size()) {
+			m_rOffsetList.resize(record.nIndex + 1, 0);
+		}
+
+		m_rOffsetList[record.nIndex] = nValidSize + (long)sizeof(record);
+
+		SetState(record.nIndex, state);
+
+		nValidSize = next;
+	}
+
+	fclose(fp);
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will update the state of the given contingency.
+ *
+ * @param nIndex contingency index
+ * @param nState new state
+ */
+void
+KpfaCheckpoint::SetState(uint32_t nIndex, KpfaCheckpointState_t nState) {
+
+	if(nIndex >= m_rStateList.size()) {
+		m_rStateList.resize(nIndex + 1, KPFA_CHECKPOINT_PENDING);
+	}
+
+	uint8_t &state = m_rStateList[nIndex];
+
+	if(state == KPFA_CHECKPOINT_FINISHED)	m_nFinishedCount--;
+	else if(state == KPFA_CHECKPOINT_FAILED)	m_nFailedCount--;
+
+	if(nState == KPFA_CHECKPOINT_FINISHED)		m_nFinishedCount++;
+	else if(nState == KPFA_CHECKPOINT_FAILED)	m_nFailedCount++;
+
+	state = (uint8_t)nState;
+}
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaCheckpoint::Write(ostream &rOut) {
+
+	rOut << "KPFA CHECKPOINT: " << m_rFilePath << endl;
+	rOut << "\tRESUME: " << (uint32_t)m_bResume << endl;
+	rOut << "\tINTERVAL: " << m_nInterval << endl;
+	rOut << "\tFINISHED: " << m_nFinishedCount << endl;
+	rOut << "\tFAILED: " << m_nFailedCount << endl;
+}
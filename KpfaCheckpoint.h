@@ -0,0 +1,189 @@
+/*
+ * KpfaCheckpoint.h
+ */
+
+#ifndef _KPFA_CHECKPOINT_H_
+#define _KPFA_CHECKPOINT_H_
+
+#include "KpfaDebug.h"
+#include "KpfaConfig.h"
+#include "KpfaCtgData.h"
+#include "KpfaResultSink.h"
+
+// Magic number and version of the checkpoint file
+#define KPFA_CHECKPOINT_MAGIC			0x5043504B	// "KPCP"
+#define KPFA_CHECKPOINT_VERSION			2
+
+// Record tag of the checkpoint file
+#define KPFA_CHECKPOINT_TAG_CTG			0x00475443	// "CTG"
+
+// Default number of contingencies between the flushes of the checkpoint file
+#define KPFA_CHECKPOINT_INTERVAL		16
+
+/**
+ * State of a contingency in the checkpoint
+ */
+typedef enum {
+	KPFA_CHECKPOINT_PENDING = 0,
+	KPFA_CHECKPOINT_FINISHED,
+	KPFA_CHECKPOINT_FAILED,
+} KpfaCheckpointState_t;
+
+/**
+ * The information to check an input file of the run
+ */
+typedef struct {
+	// Size, modification time and hash of the file
+	uint64_t nSize;
+	int64_t nTime;
+	uint64_t nHash;
+} KpfaCheckpointSource_t;
+
+/**
+ * The header of the checkpoint file
+ */
+typedef struct {
+	uint32_t nMagic;
+	uint32_t nVersion;
+	// Raw data file and contingency data file of the run
+	KpfaCheckpointSource_t hRawFile;
+	KpfaCheckpointSource_t hCtgFile;
+} KpfaCheckpointHeader_t;
+
+/**
+ * The header of a contingency record in the checkpoint file.
+ * A finished contingency is followed by its result in the binary result
+ * format, and a failed one by nothing.
+ */
+typedef struct {
+	// Record tag
+	uint32_t nTag;
+	// Contingency index
+	uint32_t nIndex;
+	// Error of the analysis (KPFA_SUCCESS if finished)
+	int32_t nError;
+	// Size of the result following the header
+	uint32_t nDataSize;
+} KpfaCheckpointRecord_t;
+
+/**
+ * The declaration of the class for the checkpoint of a long contingency run.
+ * The checkpoint is a result sink appending a record for each analyzed
+ * contingency to a local file, which is flushed every given number of
+ * contingencies and at each failure. If the run is resumed, the records of
+ * the previous run are loaded first, a record torn by a crash at the end of
+ * the file is cut off, and the contingencies finished before can be skipped.
+ * Their results are replayed from the records instead. The failed
+ * contingencies are analyzed again. The run is not resumed if the raw data
+ * file or the contingency data file is not the same as the previous run.
+ */
+class KpfaCheckpoint: public KpfaResultSink {
+
+private:
+
+	// Checkpoint file path
+	string m_rFilePath;
+
+	// Checkpoint file
+	FILE *m_pFile;
+
+	// Input files of the run
+	string m_rRawFilePath;
+	string m_rCtgFilePath;
+
+	// Load the records of the previous run
+	bool_t m_bResume;
+
+	// Number of contingencies between the flushes
+	uint32_t m_nInterval;
+
+	// Number of contingencies recorded since the last flush
+	uint32_t m_nPendingCount;
+
+	// State of each contingency (indexed by the contingency index)
+	std::vector<uint8_t> m_rStateList;
+
+	// Offset of the result of each finished contingency in the file (indexed by the contingency index)
+	std::vector<long> m_rOffsetList;
+
+	// Number of finished and failed contingencies
+	uint32_t m_nFinishedCount;
+	uint32_t m_nFailedCount;
+
+public:
+
+	KpfaCheckpoint(const string &rFilePath, bool_t bResume = FALSE,
+				   uint32_t nInterval = KPFA_CHECKPOINT_INTERVAL);
+
+	virtual ~KpfaCheckpoint();
+
+	/**
+	 * This function will check whether the given contingency was finished.
+	 *
+	 * @param nIndex contingency index
+	 * @return true if finished
+	 */
+	inline bool IsFinished(uint32_t nIndex) {
+		return nIndex < m_rStateList.size() && m_rStateList[nIndex] == KPFA_CHECKPOINT_FINISHED;
+	}
+
+	/**
+	 * This function will return the number of finished contingencies.
+	 *
+	 * @return finished contingency number
+	 */
+	inline uint32_t GetFinishedCount() {
+		return m_nFinishedCount;
+	}
+
+	/**
+	 * This function will return the number of failed contingencies.
+	 *
+	 * @return failed contingency number
+	 */
+	inline uint32_t GetFailedCount() {
+		return m_nFailedCount;
+	}
+
+	/**
+	 * This function will set the input files of the run, which are checked
+	 * when the run is resumed.
+	 *
+	 * @param pRawFilePath raw data file path
+	 * @param pCtgFilePath contingency data file path
+	 */
+	inline void SetSourceFiles(const char *pRawFilePath, const char *pCtgFilePath) {
+		m_rRawFilePath = (pRawFilePath != NULL) ? pRawFilePath : "";
+		m_rCtgFilePath = (pCtgFilePath != NULL) ? pCtgFilePath : "";
+	}
+
+	KpfaError_t Open();
+
+	KpfaError_t Push(KpfaCtgResult_t *pResult);
+
+	KpfaError_t Record(uint32_t nIndex, KpfaError_t nError, KpfaCtgResult_t *pResult = NULL);
+
+	KpfaError_t Close(KpfaResultData_t *pResultData);
+
+	KpfaError_t Replay(KpfaCtgData *pCtgData);
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+
+private:
+
+	KpfaError_t Load(const KpfaCheckpointHeader_t &rHeader, long &nValidSize);
+
+	KpfaError_t SetHeader(KpfaCheckpointHeader_t &rHeader);
+
+	void SetState(uint32_t nIndex, KpfaCheckpointState_t nState);
+
+	KpfaCheckpoint(const KpfaCheckpoint &);
+
+	KpfaCheckpoint &operator = (const KpfaCheckpoint &);
+};
+
+#endif /* _KPFA_CHECKPOINT_H_ */
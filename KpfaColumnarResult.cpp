@@ -0,0 +1,597 @@
+/*
+ * KpfaColumnarResult.cpp
+ */
+
+#include "KpfaColumnarResult.h"
+
+////////////////////////////////////////////////////////
+// Column types
+////////////////////////////////////////////////////////
+
+static const KpfaResultColumnType_t s_rColumnTypeList[KPFA_COLUMN_MAX] = {
+	KPFA_COLUMN_TYPE_INT32,		// KPFA_COLUMN_BUS_ID
+	KPFA_COLUMN_TYPE_FLOAT32,	// KPFA_COLUMN_BUS_VOLTAGE
+	KPFA_COLUMN_TYPE_INT32,		// KPFA_COLUMN_BRANCH_START_ID
+	KPFA_COLUMN_TYPE_INT32,		// KPFA_COLUMN_BRANCH_END_ID
+	KPFA_COLUMN_TYPE_INT32,		// KPFA_COLUMN_BRANCH_CKT
+	KPFA_COLUMN_TYPE_FLOAT32,	// KPFA_COLUMN_BRANCH_P
+	KPFA_COLUMN_TYPE_FLOAT32,	// KPFA_COLUMN_BRANCH_Q1
+	KPFA_COLUMN_TYPE_FLOAT32,	// KPFA_COLUMN_BRANCH_Q2
+	KPFA_COLUMN_TYPE_INT32,		// KPFA_COLUMN_GEN_BUS_ID
+	KPFA_COLUMN_TYPE_FLOAT32,	// KPFA_COLUMN_GEN_QGEN
+	KPFA_COLUMN_TYPE_FLOAT32,	// KPFA_COLUMN_GV_GEN_PARAM
+	KPFA_COLUMN_TYPE_FLOAT32,	// KPFA_COLUMN_GV_VOLTAGE
+	KPFA_COLUMN_TYPE_INT32,		// KPFA_COLUMN_EQR_BUS_ID
+	KPFA_COLUMN_TYPE_FLOAT32,	// KPFA_COLUMN_EQR_VALUE_L
+	KPFA_COLUMN_TYPE_FLOAT32,	// KPFA_COLUMN_EQR_VALUE_C
+	KPFA_COLUMN_TYPE_INT32,		// KPFA_COLUMN_FACTS_BUS_ID
+	KPFA_COLUMN_TYPE_FLOAT32,	// KPFA_COLUMN_FACTS_VOLTAGE
+	KPFA_COLUMN_TYPE_FLOAT32,	// KPFA_COLUMN_FACTS_QGEN
+};
+
+/**
+ * Returns the value type of a column.
+ *
+ * @param nColumn column
+ * @return value type
+ */
+KpfaResultColumnType_t
+KpfaGetColumnType(uint32_t nColumn) {
+
+	KPFA_ASSERT(nColumn < KPFA_COLUMN_MAX, "Unknown result column");
+
+	return s_rColumnTypeList[nColumn];
+}
+
+/**
+ * Compares the contingency names of two index entries.
+ */
+static bool
+CompareColumnarIndex(const KpfaColumnarIndex_t &rLeft, const KpfaColumnarIndex_t &rRight) {
+
+	int result = strncmp(rLeft.rName, rRight.rName, KPFA_MAX_STR_LEN);
+
+	if(result != 0) {
+		return (result < 0);
+	}
+
+	return (rLeft.nIndex < rRight.nIndex);
+}
+
+///////////////////////////////////////////////////////////////////
+// Columnar Result Sink
+///////////////////////////////////////////////////////////////////
+
+/**
+ * Returns the number of valid items of a result list.
+ */
+#define _COUNT(LIST, SIZE)	(uint32_t)(((LIST) != NULL && (SIZE) > 0) ? (SIZE) : 0)
+
+/**
+ * Appends a column filled with a field of the given result items.
+ */
+#define _APPEND_COLUMN(COLUMN, STAGE, LIST, SIZE, TYPE, FIELD)						\
+do {																				\
+	uint32_t count = _COUNT(LIST, SIZE);											\
+	TYPE *column = (TYPE *)AppendColumn(COLUMN, STAGE, count);						\
+	for(uint32_t i = 0; i < count; i++) {											\
+		column[i] = (TYPE)(LIST)[i].FIELD;											\
+	}																				\
+} while(0)
+
+KpfaColumnarResultSink::KpfaColumnarResultSink(const string &rFilePath) {
+
+	m_rFilePath = rFilePath;
+	m_pFile = NULL;
+	m_nOffset = 0;
+	m_nColumnCount = KPFA_COLUMN_MAX;
+}
+
+KpfaColumnarResultSink::~KpfaColumnarResultSink() {
+
+	if(m_pFile != NULL) {
+		fclose(m_pFile);
+	}
+}
+
+/**
+ * This function will open the output file and reserve the file header.
+ *
+ * @return error information
+ */
+KpfaError_t
+KpfaColumnarResultSink::Open() {
+
+	KPFA_CHECK(m_rFilePath.empty() == false, KPFA_ERROR_INVALID_ARGUMENT);
+
+	m_pFile = fopen(m_rFilePath.c_str(), "wb");
+
+	if(m_pFile == NULL) {
+		cerr << "File Not Open: " << m_rFilePath << endl;
+		return KPFA_ERROR_FILE_OPEN;
+	}
+
+	m_rIndexList.clear();
+	m_nOffset = 0;
+
+	return WriteHeader(NULL);
+}
+
+/**
+ * This function will reserve a column of the block being built and
+ * register it in the column directory of the block.
+ *
+ * @param nColumn column
+ * @param nStage stage of the result
+ * @param nCount number of values
+ * @return start address of the column values
+ */
+void *
+KpfaColumnarResultSink::AppendColumn(uint32_t nColumn, uint32_t nStage, uint32_t nCount) {
+
+	size_t offset = KPFA_COLUMNAR_ALIGN(m_rBuffer.size());
+
+	m_rBuffer.resize(offset + (size_t)nCount * KPFA_COLUMNAR_WIDTH, 0);
+
+	KpfaColumnarColumn_t *columnList = (KpfaColumnarColumn_t *)(&m_rBuffer[0] + sizeof(KpfaColumnarBlock_t));
+
+	columnList[nColumn * KPFA_RESULT_STAGE_MAX + nStage].nOffset = (uint32_t)offset;
+	columnList[nColumn * KPFA_RESULT_STAGE_MAX + nStage].nCount = nCount;
+
+	return &m_rBuffer[0] + offset;
+}
+
+/**
+ * This function will write the result of a contingency as a block and
+ * record the block in the index.
+ *
+ * @param pResult the result of the contingency
+ * @return error information
+ */
+KpfaError_t
+KpfaColumnarResultSink::Push(KpfaCtgResult_t *pResult) {
+
+	KPFA_CHECK(m_pFile != NULL, KPFA_ERROR_FILE_OPEN);
+
+	size_t nheader = sizeof(KpfaColumnarBlock_t) + m_nColumnCount * KPFA_RESULT_STAGE_MAX * sizeof(KpfaColumnarColumn_t);
+
+	m_rBuffer.assign(nheader, 0);
+
+	// Scalar values
+	KpfaColumnarBlock_t *block = (KpfaColumnarBlock_t *)&m_rBuffer[0];
+
+	block->nIndex = pResult->nIndex;
+	block->nFactsStatus = pResult->pFacts->nStatus;
+	strncpy(block->rName, pResult->pName, KPFA_MAX_STR_LEN - 1);
+	block->nGvMargin = pResult->pGv->nMargin;
+
+	for(int k = 0; k < KPFA_RESULT_STAGE_MAX; k++) {
+		block->rCqrValueL[k] = pResult->pEqr[k]->nCqrValueL;
+		block->rCqrValueC[k] = pResult->pEqr[k]->nCqrValueC;
+		block->rEqrMarginL[k] = pResult->pEqr[k]->nEqrMarginL;
+		block->rEqrMarginC[k] = pResult->pEqr[k]->nEqrMarginC;
+	}
+
+	// Index entry
+	KpfaColumnarIndex_t entry;
+
+	memset(&entry, 0, sizeof(entry));
+	memcpy(entry.rName, block->rName, KPFA_MAX_STR_LEN);
+	entry.nIndex = pResult->nIndex;
+	entry.nOffset = m_nOffset;
+
+	// Columns
+	for(int k = 0; k < KPFA_RESULT_STAGE_MAX; k++) {
+
+		KpfaBusCtg_t *bus = pResult->pBus[k];
+		KpfaBranchCtg_t *branch = pResult->pBranch[k];
+		KpfaGeneratorCtg_t *gen = pResult->pGenerator[k];
+		KpfaEqrCtg_t *eqr = pResult->pEqr[k];
+
+		KpfaFacts_t *facts = (k == KPFA_RESULT_STAGE_PREV) ? pResult->pFacts->pPrevList : pResult->pFacts->pNextList;
+
+		_APPEND_COLUMN(KPFA_COLUMN_BUS_ID, k, bus->pList, bus->nSize, int32_t, nBusId);
+		_APPEND_COLUMN(KPFA_COLUMN_BUS_VOLTAGE, k, bus->pList, bus->nSize, float, nVoltage);
+
+		_APPEND_COLUMN(KPFA_COLUMN_BRANCH_START_ID, k, branch->pList, branch->nSize, int32_t, nStartId);
+		_APPEND_COLUMN(KPFA_COLUMN_BRANCH_END_ID, k, branch->pList, branch->nSize, int32_t, nEndId);
+		_APPEND_COLUMN(KPFA_COLUMN_BRANCH_CKT, k, branch->pList, branch->nSize, int32_t, nCkt);
+		_APPEND_COLUMN(KPFA_COLUMN_BRANCH_P, k, branch->pList, branch->nSize, float, nFlowValueP);
+		_APPEND_COLUMN(KPFA_COLUMN_BRANCH_Q1, k, branch->pList, branch->nSize, float, nFlowValueQ1);
+		_APPEND_COLUMN(KPFA_COLUMN_BRANCH_Q2, k, branch->pList, branch->nSize, float, nFlowValueQ2);
+
+		_APPEND_COLUMN(KPFA_COLUMN_GEN_BUS_ID, k, gen->pList, gen->nSize, int32_t, nBusId);
+		_APPEND_COLUMN(KPFA_COLUMN_GEN_QGEN, k, gen->pList, gen->nSize, float, nQGen);
+
+		_APPEND_COLUMN(KPFA_COLUMN_EQR_BUS_ID, k, eqr->pList, eqr->nSize, int32_t, nBusId);
+		_APPEND_COLUMN(KPFA_COLUMN_EQR_VALUE_L, k, eqr->pList, eqr->nSize, float, nEqrValueL);
+		_APPEND_COLUMN(KPFA_COLUMN_EQR_VALUE_C, k, eqr->pList, eqr->nSize, float, nEqrValueC);
+
+		_APPEND_COLUMN(KPFA_COLUMN_FACTS_BUS_ID, k, facts, pResult->pFacts->nSize, int32_t, nBusId);
+		_APPEND_COLUMN(KPFA_COLUMN_FACTS_VOLTAGE, k, facts, pResult->pFacts->nSize, float, nVoltage);
+		_APPEND_COLUMN(KPFA_COLUMN_FACTS_QGEN, k, facts, pResult->pFacts->nSize, float, nQGen);
+	}
+
+	KpfaGvCtg_t *gv = pResult->pGv;
+
+	_APPEND_COLUMN(KPFA_COLUMN_GV_GEN_PARAM, KPFA_RESULT_STAGE_PREV, gv->pList, gv->nSize, float, nGenParam);
+	_APPEND_COLUMN(KPFA_COLUMN_GV_VOLTAGE, KPFA_RESULT_STAGE_PREV, gv->pList, gv->nSize, float, nVoltage);
+
+	// Pad the block to keep the next block aligned
+	m_rBuffer.resize(KPFA_COLUMNAR_ALIGN(m_rBuffer.size()), 0);
+
+	block = (KpfaColumnarBlock_t *)&m_rBuffer[0];
+	block->nBlockSize = (uint32_t)m_rBuffer.size();
+
+	if(fwrite(&m_rBuffer[0], 1, m_rBuffer.size(), m_pFile) != m_rBuffer.size()) {
+		return KPFA_ERROR_FILE_WRITE;
+	}
+
+	m_nOffset += m_rBuffer.size();
+	m_rIndexList.push_back(entry);
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will write the index sorted by the contingency name,
+ * update the file header, and close the output file.
+ *
+ * @param pResultData the result data with the system-wide results
+ * @return error information
+ */
+KpfaError_t
+KpfaColumnarResultSink::Close(KpfaResultData_t *pResultData) {
+
+	if(m_pFile == NULL) {
+		return KPFA_SUCCESS;
+	}
+
+	std::stable_sort(m_rIndexList.begin(), m_rIndexList.end(), CompareColumnarIndex);
+
+	KpfaError_t error = KPFA_SUCCESS;
+
+	size_t nsize = m_rIndexList.size();
+
+	if(nsize > 0 && fwrite(&m_rIndexList[0], sizeof(KpfaColumnarIndex_t), nsize, m_pFile) != nsize) {
+		error = KPFA_ERROR_FILE_WRITE;
+	}
+
+	if(error == KPFA_SUCCESS) {
+		error = WriteHeader(pResultData);
+	}
+
+	if(fclose(m_pFile) != 0 && error == KPFA_SUCCESS) {
+		error = KPFA_ERROR_FILE_WRITE;
+	}
+
+	m_pFile = NULL;
+
+	return error;
+}
+
+/**
+ * This function will write the file header at the start of the file.
+ * The header written by Open() is a placeholder without the index.
+ *
+ * @param pResultData the result data with the system-wide results (NULL if not available)
+ * @return error information
+ */
+KpfaError_t
+KpfaColumnarResultSink::WriteHeader(KpfaResultData_t *pResultData) {
+
+	KpfaColumnarHeader_t header;
+
+	memset(&header, 0, sizeof(header));
+
+	header.nMagic = KPFA_COLUMNAR_RESULT_MAGIC;
+	header.nVersion = KPFA_COLUMNAR_RESULT_VERSION;
+	header.nHeaderSize = sizeof(KpfaColumnarHeader_t);
+	header.nColumnCount = m_nColumnCount;
+
+	if(pResultData != NULL) {
+		header.nCtgCount = (uint32_t)m_rIndexList.size();
+		header.nIndexOffset = m_nOffset;
+		header.nLossBefore = pResultData->hOpf.nLossBefore;
+		header.nLossAfter = pResultData->hOpf.nLossAfter;
+	}
+
+	if(m_nOffset == 0) {
+		// Reserve the header
+		m_nOffset = sizeof(KpfaColumnarHeader_t);
+	}
+	else if(fseek(m_pFile, 0, SEEK_SET) != 0) {
+		return KPFA_ERROR_FILE_WRITE;
+	}
+
+	if(fwrite(&header, sizeof(header), 1, m_pFile) != 1) {
+		return KPFA_ERROR_FILE_WRITE;
+	}
+
+	return KPFA_SUCCESS;
+}
+
+#undef _APPEND_COLUMN
+#undef _COUNT
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaColumnarResultSink::Write(ostream &rOut) {
+
+	rOut << "KPFA COLUMNAR RESULT SINK: " << endl;
+
+	rOut << "\tPATH: " << m_rFilePath << endl;
+
+	rOut << "\tCTG COUNT: " << m_rIndexList.size() << endl;
+}
+
+///////////////////////////////////////////////////////////////////
+// Columnar Contingency View
+///////////////////////////////////////////////////////////////////
+
+KpfaColumnarCtgView::KpfaColumnarCtgView() {
+
+	m_pBlock = NULL;
+	m_pColumnList = NULL;
+	m_nColumnCount = 0;
+}
+
+/**
+ * This function will make the view point to a block in the mapped file.
+ *
+ * @param pBlock start address of the block
+ * @param nColumnCount column count of the file
+ */
+void
+KpfaColumnarCtgView::Assign(const char *pBlock, uint32_t nColumnCount) {
+
+	m_pBlock = (const KpfaColumnarBlock_t *)pBlock;
+	m_pColumnList = (const KpfaColumnarColumn_t *)(pBlock + sizeof(KpfaColumnarBlock_t));
+	m_nColumnCount = nColumnCount;
+}
+
+/**
+ * This function will return the values of a column without any copy.
+ *
+ * @param nColumn column
+ * @param nStage stage of the result
+ * @param rCount number of values
+ * @return start address of the values (NULL if the column is not available)
+ */
+const void *
+KpfaColumnarCtgView::GetColumn(uint32_t nColumn, uint32_t nStage, uint32_t &rCount) {
+
+	rCount = 0;
+
+	if(m_pBlock == NULL || nColumn >= m_nColumnCount || nStage >= KPFA_RESULT_STAGE_MAX) {
+		return NULL;
+	}
+
+	const KpfaColumnarColumn_t *column = &m_pColumnList[nColumn * KPFA_RESULT_STAGE_MAX + nStage];
+
+	// Reject a column out of the block
+	if(column->nOffset > m_pBlock->nBlockSize ||
+	   column->nCount > (m_pBlock->nBlockSize - column->nOffset) / KPFA_COLUMNAR_WIDTH) {
+		return NULL;
+	}
+
+	rCount = column->nCount;
+
+	return (const char *)m_pBlock + column->nOffset;
+}
+
+const int32_t *
+KpfaColumnarCtgView::GetIntColumn(uint32_t nColumn, uint32_t nStage, uint32_t &rCount) {
+
+	if(nColumn >= KPFA_COLUMN_MAX || KpfaGetColumnType(nColumn) != KPFA_COLUMN_TYPE_INT32) {
+		rCount = 0;
+		return NULL;
+	}
+
+	return (const int32_t *)GetColumn(nColumn, nStage, rCount);
+}
+
+const float *
+KpfaColumnarCtgView::GetFloatColumn(uint32_t nColumn, uint32_t nStage, uint32_t &rCount) {
+
+	if(nColumn >= KPFA_COLUMN_MAX || KpfaGetColumnType(nColumn) != KPFA_COLUMN_TYPE_FLOAT32) {
+		rCount = 0;
+		return NULL;
+	}
+
+	return (const float *)GetColumn(nColumn, nStage, rCount);
+}
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaColumnarCtgView::Write(ostream &rOut) {
+
+	if(m_pBlock == NULL) {
+		rOut << "KPFA COLUMNAR CTG VIEW: INVALID" << endl;
+		return;
+	}
+
+	rOut << "KPFA COLUMNAR CTG VIEW: " << endl;
+
+	rOut << "\tINDEX: " << m_pBlock->nIndex << endl;
+
+	rOut << "\tNAME: " << m_pBlock->rName << endl;
+
+	rOut << "\tBLOCK SIZE: " << m_pBlock->nBlockSize << endl;
+}
+
+ostream &operator << (ostream &rOut, KpfaColumnarCtgView *pView) {
+
+	pView->Write(rOut);
+	return rOut;
+}
+
+///////////////////////////////////////////////////////////////////
+// Columnar Result Reader
+///////////////////////////////////////////////////////////////////
+
+KpfaColumnarResultReader::KpfaColumnarResultReader() {
+
+	m_pHeader = NULL;
+	m_pIndexList = NULL;
+}
+
+KpfaColumnarResultReader::~KpfaColumnarResultReader() {
+
+	Close();
+}
+
+/**
+ * This function will map the result file and validate its header and index.
+ *
+ * @param pFilePath file path
+ * @return error information
+ */
+KpfaError_t
+KpfaColumnarResultReader::Open(const char *pFilePath) {
+
+	Close();
+
+	KpfaError_t error = m_rFile.Open(pFilePath);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	const char *data = m_rFile.GetData();
+	size_t nsize = m_rFile.GetSize();
+
+	const KpfaColumnarHeader_t *header = (const KpfaColumnarHeader_t *)data;
+
+	if(nsize < sizeof(KpfaColumnarHeader_t) ||
+	   header->nMagic != KPFA_COLUMNAR_RESULT_MAGIC ||
+	   header->nVersion != KPFA_COLUMNAR_RESULT_VERSION ||
+	   header->nHeaderSize < sizeof(KpfaColumnarHeader_t) ||
+	   header->nIndexOffset < header->nHeaderSize ||
+	   header->nIndexOffset > nsize ||
+	   header->nCtgCount > (nsize - header->nIndexOffset) / sizeof(KpfaColumnarIndex_t)) {
+
+		KPFA_ERROR("Invalid columnar result file: %s", pFilePath);
+		m_rFile.Close();
+		return KPFA_ERROR_FILE_FORMAT;
+	}
+
+	m_pHeader = header;
+	m_pIndexList = (const KpfaColumnarIndex_t *)(data + header->nIndexOffset);
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will unmap the result file. All the views become invalid.
+ */
+void
+KpfaColumnarResultReader::Close() {
+
+	m_rFile.Close();
+
+	m_pHeader = NULL;
+	m_pIndexList = NULL;
+}
+
+/**
+ * This function will return the view of the contingency at the given
+ * position of the index (in the order of the contingency name).
+ *
+ * @param nPosition position in the index
+ * @param rView view of the contingency
+ * @return error information
+ */
+KpfaError_t
+KpfaColumnarResultReader::GetCtg(uint32_t nPosition, KpfaColumnarCtgView &rView) {
+
+	KPFA_CHECK(m_pHeader != NULL, KPFA_ERROR_FILE_OPEN);
+	KPFA_CHECK(nPosition < m_pHeader->nCtgCount, KPFA_ERROR_INVALID_ARGUMENT);
+
+	uint64_t offset = m_pIndexList[nPosition].nOffset;
+
+	size_t nheader = sizeof(KpfaColumnarBlock_t) +
+					 (size_t)m_pHeader->nColumnCount * KPFA_RESULT_STAGE_MAX * sizeof(KpfaColumnarColumn_t);
+
+	// Reject a block out of the data area
+	if(offset < m_pHeader->nHeaderSize ||
+	   offset > m_pHeader->nIndexOffset ||
+	   m_pHeader->nIndexOffset - offset < nheader) {
+		return KPFA_ERROR_FILE_FORMAT;
+	}
+
+	const char *block = m_rFile.GetData() + offset;
+
+	uint32_t nblock = ((const KpfaColumnarBlock_t *)block)->nBlockSize;
+
+	if(nblock < nheader || nblock > m_pHeader->nIndexOffset - offset) {
+		return KPFA_ERROR_FILE_FORMAT;
+	}
+
+	rView.Assign(block, m_pHeader->nColumnCount);
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will look up a contingency by its name with a binary
+ * search on the index and return its view.
+ *
+ * @param pName contingency name
+ * @param rView view of the contingency
+ * @return error information
+ */
+KpfaError_t
+KpfaColumnarResultReader::FindCtg(const char *pName, KpfaColumnarCtgView &rView) {
+
+	KPFA_CHECK(m_pHeader != NULL, KPFA_ERROR_FILE_OPEN);
+	KPFA_CHECK(pName != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	uint32_t low = 0;
+	uint32_t high = m_pHeader->nCtgCount;
+
+	// Find the first entry not less than the name
+	while(low < high) {
+
+		uint32_t mid = low + (high - low) / 2;
+
+		if(strncmp(m_pIndexList[mid].rName, pName, KPFA_MAX_STR_LEN - 1) < 0) {
+			low = mid + 1;
+		}
+		else {
+			high = mid;
+		}
+	}
+
+	if(low == m_pHeader->nCtgCount ||
+	   strncmp(m_pIndexList[low].rName, pName, KPFA_MAX_STR_LEN - 1) != 0) {
+		return KPFA_ERROR_RESULT_NOT_FOUND;
+	}
+
+	return GetCtg(low, rView);
+}
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaColumnarResultReader::Write(ostream &rOut) {
+
+	rOut << "KPFA COLUMNAR RESULT READER: " << endl;
+
+	rOut << "\tVERSION: " << ((m_pHeader != NULL) ? m_pHeader->nVersion : 0) << endl;
+
+	rOut << "\tCOLUMN COUNT: " << ((m_pHeader != NULL) ? m_pHeader->nColumnCount : 0) << endl;
+
+	rOut << "\tCTG COUNT: " << GetCtgCount() << endl;
+}
+
+ostream &operator << (ostream &rOut, KpfaColumnarResultReader *pReader) {
+
+	pReader->Write(rOut);
+	return rOut;
+}
@@ -0,0 +1,340 @@
+/*
+ * KpfaColumnarResult.h
+ */
+
+#ifndef _KPFA_COLUMNAR_RESULT_H_
+#define _KPFA_COLUMNAR_RESULT_H_
+
+#include <stdint.h>
+
+#include "KpfaDebug.h"
+#include "KpfaConfig.h"
+#include "KpfaMappedFile.h"
+#include "KpfaResultSink.h"
+
+/**
+ * Layout of the columnar result file (native byte order):
+ *
+ *   header | block 0 | block 1 | ... | block N-1 | index
+ *
+ * Each block holds the results of a contingency: the scalar values,
+ * a column directory of (offset, count) pairs for the columns of the
+ * previous and next results, and the column data. Every column is a
+ * fixed-width array of 4-byte values aligned to 8 bytes. The index is
+ * sorted by the contingency name and points to the blocks.
+ *
+ * The column count is written in the header so that a reader can skip
+ * the columns appended by later versions of the same format.
+ */
+
+// Magic number and version of the columnar result file
+#define KPFA_COLUMNAR_RESULT_MAGIC		0x4346504B	// "KPFC"
+#define KPFA_COLUMNAR_RESULT_VERSION	1
+
+// Alignment of the blocks and the columns
+#define KPFA_COLUMNAR_ALIGNMENT			8
+
+// Width of a column value
+#define KPFA_COLUMNAR_WIDTH				4
+
+#define KPFA_COLUMNAR_ALIGN(SIZE)		(((SIZE) + KPFA_COLUMNAR_ALIGNMENT - 1) & ~((size_t)KPFA_COLUMNAR_ALIGNMENT - 1))
+
+// Stages of the result (before and after the contingency analysis)
+#define KPFA_RESULT_STAGE_PREV			0
+#define KPFA_RESULT_STAGE_NEXT			1
+#define KPFA_RESULT_STAGE_MAX			2
+
+/**
+ * Columns of the columnar result file. New columns must be appended.
+ */
+typedef enum {
+	// Powerflow - BUS
+	KPFA_COLUMN_BUS_ID = 0,
+	KPFA_COLUMN_BUS_VOLTAGE,
+	// Powerflow - BRANCH
+	KPFA_COLUMN_BRANCH_START_ID,
+	KPFA_COLUMN_BRANCH_END_ID,
+	KPFA_COLUMN_BRANCH_CKT,
+	KPFA_COLUMN_BRANCH_P,
+	KPFA_COLUMN_BRANCH_Q1,
+	KPFA_COLUMN_BRANCH_Q2,
+	// Powerflow - GENERATOR
+	KPFA_COLUMN_GEN_BUS_ID,
+	KPFA_COLUMN_GEN_QGEN,
+	// GV (previous stage only)
+	KPFA_COLUMN_GV_GEN_PARAM,
+	KPFA_COLUMN_GV_VOLTAGE,
+	// EQR
+	KPFA_COLUMN_EQR_BUS_ID,
+	KPFA_COLUMN_EQR_VALUE_L,
+	KPFA_COLUMN_EQR_VALUE_C,
+	// FACTS
+	KPFA_COLUMN_FACTS_BUS_ID,
+	KPFA_COLUMN_FACTS_VOLTAGE,
+	KPFA_COLUMN_FACTS_QGEN,
+	KPFA_COLUMN_MAX,
+} KpfaResultColumn_t;
+
+/**
+ * Value types of the columns
+ */
+typedef enum {
+	KPFA_COLUMN_TYPE_INT32 = 0,
+	KPFA_COLUMN_TYPE_FLOAT32,
+} KpfaResultColumnType_t;
+
+/**
+ * File header
+ */
+typedef struct {
+	uint32_t nMagic;
+	uint32_t nVersion;
+	uint32_t nHeaderSize;
+	uint32_t nColumnCount;
+	uint32_t nCtgCount;
+	uint32_t nReserved;
+	// Offset of the index
+	uint64_t nIndexOffset;
+	// OPF
+	float nLossBefore;
+	float nLossAfter;
+	uint32_t rReserved[6];
+} KpfaColumnarHeader_t;
+
+/**
+ * Block header with the scalar values of a contingency
+ */
+typedef struct {
+	uint32_t nIndex;
+	int32_t nFactsStatus;
+	char rName[KPFA_MAX_STR_LEN];
+	float nGvMargin;
+	float rCqrValueL[KPFA_RESULT_STAGE_MAX];
+	float rCqrValueC[KPFA_RESULT_STAGE_MAX];
+	float rEqrMarginL[KPFA_RESULT_STAGE_MAX];
+	float rEqrMarginC[KPFA_RESULT_STAGE_MAX];
+	// Size of the block including the header
+	uint32_t nBlockSize;
+} KpfaColumnarBlock_t;
+
+/**
+ * Column directory entry (offset from the start of the block)
+ */
+typedef struct {
+	uint32_t nOffset;
+	uint32_t nCount;
+} KpfaColumnarColumn_t;
+
+/**
+ * Index entry
+ */
+typedef struct {
+	char rName[KPFA_MAX_STR_LEN];
+	uint32_t nIndex;
+	uint32_t nReserved;
+	uint64_t nOffset;
+} KpfaColumnarIndex_t;
+
+/**
+ * The declaration of the class for the result sink in the columnar format
+ */
+class KpfaColumnarResultSink: public KpfaResultSink {
+
+private:
+
+	// Output file path
+	string m_rFilePath;
+
+	// Output file
+	FILE *m_pFile;
+
+	// Current file offset
+	uint64_t m_nOffset;
+
+	// Column count of the file
+	uint32_t m_nColumnCount;
+
+	// Index entries of the written blocks
+	std::vector<KpfaColumnarIndex_t> m_rIndexList;
+
+	// Buffer to build a block
+	std::vector<char> m_rBuffer;
+
+public:
+
+	KpfaColumnarResultSink(const string &rFilePath);
+
+	virtual ~KpfaColumnarResultSink();
+
+	KpfaError_t Open();
+
+	KpfaError_t Push(KpfaCtgResult_t *pResult);
+
+	KpfaError_t Close(KpfaResultData_t *pResultData);
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+
+private:
+
+	void *AppendColumn(uint32_t nColumn, uint32_t nStage, uint32_t nCount);
+
+	KpfaError_t WriteHeader(KpfaResultData_t *pResultData);
+};
+
+/**
+ * The declaration of the class for a zero-copy view of the results of
+ * a contingency. The view points into the mapped file and is valid
+ * until the reader is closed.
+ */
+class KpfaColumnarCtgView {
+
+private:
+
+	// Block of the contingency
+	const KpfaColumnarBlock_t *m_pBlock;
+
+	// Column directory of the block
+	const KpfaColumnarColumn_t *m_pColumnList;
+
+	// Column count of the file
+	uint32_t m_nColumnCount;
+
+public:
+
+	KpfaColumnarCtgView();
+
+	virtual ~KpfaColumnarCtgView() {
+		// Do nothing
+	}
+
+	void Assign(const char *pBlock, uint32_t nColumnCount);
+
+	const void *GetColumn(uint32_t nColumn, uint32_t nStage, uint32_t &rCount);
+
+	const int32_t *GetIntColumn(uint32_t nColumn, uint32_t nStage, uint32_t &rCount);
+
+	const float *GetFloatColumn(uint32_t nColumn, uint32_t nStage, uint32_t &rCount);
+
+	/**
+	 * This function will check whether the view points to a contingency.
+	 *
+	 * @return true if valid
+	 */
+	inline bool IsValid() {
+		return (m_pBlock != NULL);
+	}
+
+	inline uint32_t GetIndex() {
+		return m_pBlock->nIndex;
+	}
+
+	inline const char *GetName() {
+		return m_pBlock->rName;
+	}
+
+	inline int32_t GetFactsStatus() {
+		return m_pBlock->nFactsStatus;
+	}
+
+	inline float GetGvMargin() {
+		return m_pBlock->nGvMargin;
+	}
+
+	inline float GetCqrValueL(uint32_t nStage) {
+		return m_pBlock->rCqrValueL[nStage];
+	}
+
+	inline float GetCqrValueC(uint32_t nStage) {
+		return m_pBlock->rCqrValueC[nStage];
+	}
+
+	inline float GetEqrMarginL(uint32_t nStage) {
+		return m_pBlock->rEqrMarginL[nStage];
+	}
+
+	inline float GetEqrMarginC(uint32_t nStage) {
+		return m_pBlock->rEqrMarginC[nStage];
+	}
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+
+	friend ostream &operator << (ostream &rOut, KpfaColumnarCtgView *pView);
+};
+
+/**
+ * The declaration of the class for the reader of the columnar result file
+ */
+class KpfaColumnarResultReader {
+
+private:
+
+	// Mapped result file
+	KpfaMappedFile m_rFile;
+
+	// File header
+	const KpfaColumnarHeader_t *m_pHeader;
+
+	// Index sorted by the contingency name
+	const KpfaColumnarIndex_t *m_pIndexList;
+
+public:
+
+	KpfaColumnarResultReader();
+
+	virtual ~KpfaColumnarResultReader();
+
+	KpfaError_t Open(const char *pFilePath);
+
+	void Close();
+
+	KpfaError_t GetCtg(uint32_t nPosition, KpfaColumnarCtgView &rView);
+
+	KpfaError_t FindCtg(const char *pName, KpfaColumnarCtgView &rView);
+
+	/**
+	 * This function will return the number of contingencies in the file.
+	 *
+	 * @return contingency count
+	 */
+	inline uint32_t GetCtgCount() {
+		return (m_pHeader != NULL) ? m_pHeader->nCtgCount : 0;
+	}
+
+	inline float GetLossBefore() {
+		return (m_pHeader != NULL) ? m_pHeader->nLossBefore : 0;
+	}
+
+	inline float GetLossAfter() {
+		return (m_pHeader != NULL) ? m_pHeader->nLossAfter : 0;
+	}
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+
+	friend ostream &operator << (ostream &rOut, KpfaColumnarResultReader *pReader);
+
+private:
+
+	KpfaColumnarResultReader(const KpfaColumnarResultReader &);
+
+	KpfaColumnarResultReader &operator = (const KpfaColumnarResultReader &);
+};
+
+////////////////////////////////////////////////////////
+// Function declaration
+////////////////////////////////////////////////////////
+
+KpfaResultColumnType_t KpfaGetColumnType(uint32_t nColumn);
+
+#endif /* _KPFA_COLUMNAR_RESULT_H_ */
@@ -131,6 +131,8 @@ typedef complex<double> KpfaComplex_t;
 
 typedef compressed_matrix<double> KpfaDoubleMatrix_t;
 
+typedef matrix<double> KpfaDenseMatrix_t;
+
 typedef compressed_matrix<KpfaComplex_t> KpfaComplexMatrix_t;
 
 typedef boost::numeric::ublas::vector<double> KpfaDoubleVector_t;
@@ -99,6 +99,10 @@ typedef enum {
 	KPFA_ERROR_FACTS_LIMITED,
 	KPFA_ERROR_INVALID_HVDC_P,
 
+	KPFA_ERROR_FILE_WRITE,
+	KPFA_ERROR_FILE_FORMAT,
+	KPFA_ERROR_RESULT_NOT_FOUND,
+
 	KPFA_FAILURE,
 
 } KpfaError_t;
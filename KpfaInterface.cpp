@@ -12,9 +12,12 @@
 #include "KpfaGvModule.h"
 #include "KpfaEqrModule.h"
 #include "KpfaFactsModule.h"
+#include "KpfaModalModule.h"
+#include "KpfaCheckpoint.h"
 
 #ifdef KPFA_RESULT_SUPPORT
 #include "KpfaResultData.h"
+#include "KpfaResultSink.h"
 #endif
 
 static KpfaError_t CheckValidity(KpfaRawDataReader *pRawDataReader,
@@ -25,6 +28,11 @@ static KpfaError_t AnalyzeStability(KpfaRawDataMgmt *pRawDataMgmt,
 				     	 	 	 	KpfaCtrlDataMgmt *pCtrlDataMgmt,
 									KpfaCtgData *pCtgData);
 
+static KpfaError_t AnalyzeEqr(KpfaRawDataMgmt *pRawDataMgmt,
+							  KpfaCtrlDataMgmt *pCtrlDataMgmt,
+							  KpfaPowerflow *pPowerflow,
+							  uint32_t nIndex, int nPfIndex);
+
 /**
  * This function will be used to check the validity of the given raw data.
  *
@@ -107,10 +115,64 @@ AnalyzeStability(KpfaRawDataMgmt *pRawDataMgmt,
 	KPFA_CHECK(error == KPFA_SUCCESS, error);
 #endif
 
-	// Powerflow analysis with contingency
-	error = pfa.DoAnalysis(pRawDataMgmt, pCtgData);
+	// Powerflow analysis with contingency. The contingency is left applied while
+	// the solution is screened, so that the EQR can take the solution as it is.
+	error = pRawDataMgmt->ApplyContingencyData(pCtgData);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	error = pfa.DoAnalysis(pRawDataMgmt);
+
+	if(error != KPFA_SUCCESS) {
+		KPFA_ERROR("KpfaPerformPowerflowAnalysis: error - %d", error);
+	}
+
+	// Screen out the contingency comfortably stable by the L-index of its solution,
+	// so that the GV is not performed
+	bool_t stable = FALSE;
+	double lthreshold = pCtrlDataMgmt->m_nLIndexThreshold;
+
+	if(error == KPFA_SUCCESS && lthreshold > 0 &&
+	   (pCtgData->HasOutageGen() || pCtgData->HasOutageHvdc())) {
+
+		if(eqr.CalculateLIndex(pRawDataMgmt, &pfa) == KPFA_SUCCESS &&
+		   eqr.GetMaxLIndex() < lthreshold) {
+
+			KPFA_DEBUG("AnalyzeStability", "contingency(%d) screened: L-index %f at bus %d",
+					   i, eqr.GetMaxLIndex(), eqr.GetMaxLIndexBusId());
+
+			stable = TRUE;
+
+#ifdef KPFA_RESULT_SUPPORT
+			// No GV curve as for the contingency without the outages for GV
+			g_pResultData->hGvList.pList[KpfaGetResultSlot(i)].nSize = 0;
+#endif
+		}
+	}
+
+	// Report the critical mode of the contingency solution by the modal analysis
+	if(error == KPFA_SUCCESS && pCtrlDataMgmt->m_nModalCount > 0) {
+
+		KpfaModalModule modal(pCtrlDataMgmt);
+
+		if(modal.Calculate(pRawDataMgmt, &pfa) == KPFA_SUCCESS &&
+		   modal.GetModeList().empty() == false) {
+
+			KPFA_DEBUG("AnalyzeStability", "contingency(%d) modal: eigenvalue %f at bus %d",
+					   i, modal.GetMinEigenvalue(), modal.GetModeList()[0].nWeakestBusId);
+		}
+	}
+
+	// The solution is up to date for the EQR only if the GV is not performed
+	bool_t applied = (stable == TRUE && pCtrlDataMgmt->m_bEqrCheck == TRUE) ? TRUE : FALSE;
 
-	if(true /*error == KPFA_ERROR_NOT_CONVERGED*/) {
+	if(applied == FALSE) {
+
+		// Retrieve the current system for the GV and the next contingency data
+		KpfaError_t rerror = pRawDataMgmt->RetrieveFromContingency();
+		KPFA_CHECK(rerror == KPFA_SUCCESS, rerror);
+	}
+
+	if(stable == FALSE /*error == KPFA_ERROR_NOT_CONVERGED*/) {
 
 		// Perform GV module
 		error = gv.Execute(pRawDataMgmt, pCtgData);
@@ -121,17 +183,17 @@ AnalyzeStability(KpfaRawDataMgmt *pRawDataMgmt,
 		if(margin0 < 1.0) {
 
 #ifdef KPFA_RESULT_SUPPORT
-			g_pResultData->hFactsList.pList[i].nStatus = KPFA_STATUS_1;
+			g_pResultData->hFactsList.pList[KpfaGetResultSlot(i)].nStatus = KPFA_STATUS_1;
 #endif
 
 KPFA_REPEAT_GV:
 			// capacitive
-			if(facts.Execute(pRawDataMgmt, FALSE) == FALSE) {
+			if(facts.Execute(pRawDataMgmt, FALSE, gv.GetMaxMargin(), gv.GetConvergedBusList()) == FALSE) {
 				goto KPFA_STOP_REPEAT_GV;
 			}
 
-			// Perform GV module
-			error = gv.Execute(pRawDataMgmt, pCtgData);
+			// Perform GV module (from the last converged point if incremental)
+			error = gv.Resume(pRawDataMgmt, pCtgData);
 			KPFA_CHECK(error == KPFA_SUCCESS, error);
 
 			if(gv.GetMaxMargin() < 1.0) {
@@ -151,45 +213,22 @@ KPFA_STOP_REPEAT_GV:
 	}
 	else KPFA_CHECK(error == KPFA_SUCCESS, error);
 
-#if 1
-#ifdef KPFA_RESULT_SUPPORT
-		error = KpfaGatherResultData(pRawDataMgmt, &pfa, i, pfIndex);
-		KPFA_CHECK(error == KPFA_SUCCESS, error);
+	if(pCtrlDataMgmt->m_bEqrCheck == TRUE) {
 
-		error = KpfaGatherFactsData(pRawDataMgmt, i);
-		KPFA_CHECK(error == KPFA_SUCCESS, error);
-#endif
-#else
-	// Perform powerflow analysis for each system
-	error = pRawDataMgmt->ApplyContingencyData(pCtgData);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
-
-    // Call the EQR module to check whether the EQR value is greater than the given margin or not.
-	error = eqr.Calculate(pRawDataMgmt);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
-
-    // If the EQR value is greater than the margin, call the FACTS module finally.
-    // Otherwise, call the OPT module optionally.
-	double eqrMarginC = pCtrlDataMgmt->m_nEqrMarginC;
-	double eqrMarginL = pCtrlDataMgmt->m_nEqrMarginL;
-	
-	if(eqr.GetEqrC() < eqrMarginC && eqr.GetEqrL() > eqrMarginL) {
-		pRawDataMgmt->RetrieveFromContingency();
-		return KPFA_ERROR_EQR_INVALID_MARGIN;
-	}
-	else if(eqr.GetEqrC() < eqrMarginC || eqr.GetEqrL() > eqrMarginL) {
+		// Apply the contingency again after the GV
+		if(applied == FALSE) {
+			error = pRawDataMgmt->ApplyContingencyData(pCtgData);
+			KPFA_CHECK(error == KPFA_SUCCESS, error);
+		}
 
-#ifdef KPFA_RESULT_SUPPORT
-		g_pResultData->hFactsList.pList[i].nStatus = KPFA_STATUS_2;
-#endif
-		error = eqr.Execute(pRawDataMgmt, pCtrlDataMgmt);
-		KPFA_CHECK(error == KPFA_SUCCESS, error);
+		error = AnalyzeEqr(pRawDataMgmt, pCtrlDataMgmt, &pfa, i, pfIndex);
 
-		error = facts.Execute(pRawDataMgmt);
+		// Do not leave the outages applied to the raw data
+		KpfaError_t rerror = pRawDataMgmt->RetrieveFromContingency();
 		KPFA_CHECK(error == KPFA_SUCCESS, error);
 
-		error = eqr.Calculate(pRawDataMgmt, FALSE);
-		KPFA_CHECK(error == KPFA_SUCCESS, error);
+		return rerror;
+	}
 
 #ifdef KPFA_RESULT_SUPPORT
 		error = KpfaGatherResultData(pRawDataMgmt, &pfa, i, pfIndex);
@@ -198,9 +237,6 @@ KPFA_STOP_REPEAT_GV:
 		error = KpfaGatherFactsData(pRawDataMgmt, i);
 		KPFA_CHECK(error == KPFA_SUCCESS, error);
 #endif
-		return pRawDataMgmt->RetrieveFromContingency();
-	}
-#endif
 
 #if 0
 	KpfaRawDataList_t::iterator biter;
@@ -262,6 +298,69 @@ KDA_REPEAT_PF_CAP:
 	return KPFA_SUCCESS;
 }
 
+/**
+ * This function will check the EQR of the given raw data with the contingency
+ * applied. If the EQR is out of one of the margins, the FACTS are set by their
+ * required Q and the EQR is calculated again. The solution of the given
+ * powerflow is taken as it is if the raw data has not been modified since it
+ * was solved, e.g. the contingency screened out by the L-index.
+ *
+ * @param pRawDataMgmt raw data management with the contingency applied
+ * @param pCtrlDataMgmt control data management
+ * @param pPowerflow powerflow of the contingency
+ * @param nIndex index of the contingency
+ * @param nPfIndex index of the powerflow result
+ * @return error information
+ */
+static KpfaError_t
+AnalyzeEqr(KpfaRawDataMgmt *pRawDataMgmt,
+		   KpfaCtrlDataMgmt *pCtrlDataMgmt,
+		   KpfaPowerflow *pPowerflow,
+		   uint32_t nIndex, int nPfIndex) {
+
+	KpfaError_t error;
+
+	KpfaEqrModule eqr(pCtrlDataMgmt);
+	KpfaFactsModule facts(pCtrlDataMgmt);
+
+    // Call the EQR module to check whether the EQR value is greater than the given margin or not.
+	error = eqr.Calculate(pRawDataMgmt, TRUE, pPowerflow);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+    // If the EQR value is greater than the margin, call the FACTS module finally.
+	double eqrMarginC = pCtrlDataMgmt->m_nEqrMarginC;
+	double eqrMarginL = pCtrlDataMgmt->m_nEqrMarginL;
+
+	if(eqr.GetEqrC() < eqrMarginC && eqr.GetEqrL() > eqrMarginL) {
+		return KPFA_ERROR_EQR_INVALID_MARGIN;
+	}
+	else if(eqr.GetEqrC() < eqrMarginC || eqr.GetEqrL() > eqrMarginL) {
+
+#ifdef KPFA_RESULT_SUPPORT
+		g_pResultData->hFactsList.pList[KpfaGetResultSlot(nIndex)].nStatus = KPFA_STATUS_2;
+#endif
+		error = eqr.Execute(pRawDataMgmt, pCtrlDataMgmt);
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+		error = facts.Execute(pRawDataMgmt);
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+		// solved again since the FACTS have been updated
+		error = eqr.Calculate(pRawDataMgmt, FALSE, pPowerflow);
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+	}
+
+#ifdef KPFA_RESULT_SUPPORT
+	error = KpfaGatherResultData(pRawDataMgmt, pPowerflow, nIndex, nPfIndex);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	error = KpfaGatherFactsData(pRawDataMgmt, nIndex);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+#endif
+
+	return KPFA_SUCCESS;
+}
+
 //////////////////////////////////////////////////////////////////////
 // Interface functions for stability analysis
 //////////////////////////////////////////////////////////////////////
@@ -279,18 +378,28 @@ KpfaDoAnalysis(KpfaInputParam_t *pParam, KpfaResultData_t *pResultData) {
 	g_pResultData = pResultData;
 #endif
 
-    // Contingency data file read
-    KpfaCtgDataMgmt *ctgDataMgmt = new KpfaCtgDataMgmt();
-    error = ctgDataMgmt->ReadCtgDataFile(pParam->pCtgFilePath);
-    KPFA_CHECK(error == KPFA_SUCCESS, -3);
-
     // Control data file read
     KpfaCtrlDataMgmt *ctrlDataMgmt = new KpfaCtrlDataMgmt();
     error = ctrlDataMgmt->ReadCtrlDataFile(pParam->pCtrlFilePath);
     KPFA_CHECK(error == KPFA_SUCCESS, -4);
 
+    // Contingency data file read (streamed unless the results of all the
+    // contingencies are retained, which need the number of contingencies)
+    KpfaCtgDataMgmt *ctgDataMgmt = new KpfaCtgDataMgmt();
+
+    if(ctrlDataMgmt->m_bStreamCtg == TRUE && ctrlDataMgmt->m_bRetainResult == FALSE) {
+        error = ctgDataMgmt->OpenCtgDataFile(pParam->pCtgFilePath);
+    }
+    else {
+        error = ctgDataMgmt->ReadCtgDataFile(pParam->pCtgFilePath);
+    }
+
+    KPFA_CHECK(error == KPFA_SUCCESS, -3);
+
 	// Raw(network) data file read
 	KpfaRawDataReader *rawDataReader = new KpfaRawDataReader();
+	rawDataReader->SetParallel(ctrlDataMgmt->m_bParallelRead == TRUE);
+	rawDataReader->SetSnapshotPath(ctrlDataMgmt->m_rSnapshotFilePath.c_str());
 	error = rawDataReader->ReadRawDataFile(pParam->pRawFilePath);
     KPFA_CHECK(error == KPFA_SUCCESS, -5);
 
@@ -305,10 +414,6 @@ KpfaDoAnalysis(KpfaInputParam_t *pParam, KpfaResultData_t *pResultData) {
 
 	KPFA_DEBUG("main", ">> Stability Check Completed.");
 
-    // Contingency data list
-    KpfaCtgDataList_t::iterator citer;
-    KpfaCtgDataList_t &ctgDataList = ctgDataMgmt->GetCtgDataList();
-
     // Raw data management list
 	KpfaRawDataMgmtList_t &rawDataMgmtList = rawDataReader->GetRawDataMgmts();
 	KPFA_CHECK(rawDataMgmtList.size() > 0, -7);
@@ -316,161 +421,150 @@ KpfaDoAnalysis(KpfaInputParam_t *pParam, KpfaResultData_t *pResultData) {
 	// 1st raw data management
     KpfaRawDataMgmt *rawDataMgmt = rawDataMgmtList[0];
 
-#ifdef KPFA_RESULT_SUPPORT
-	// ResultData Initialization
-	error = KpfaAllocResultData(rawDataMgmt, ctgDataMgmt);
-	KPFA_CHECK(error == KPFA_SUCCESS, -8);
-#endif
-
-    // For each contingency
-	for(citer = ctgDataList.begin(); citer != ctgDataList.end(); citer++) {
+	// Checkpoint of the finished contingencies (NULL if not used)
+	KpfaCheckpoint *checkpoint = NULL;
 
-		KpfaCtgData *ctgData = *citer;
+	if(ctrlDataMgmt->m_rCheckpointFilePath.empty() == false) {
+		checkpoint = new KpfaCheckpoint(ctrlDataMgmt->m_rCheckpointFilePath,
+										ctrlDataMgmt->m_bResume,
+										ctrlDataMgmt->m_nCheckpointInterval);
 
-		cout << ctgData << endl;
-
-		error = AnalyzeStability(rawDataMgmt, ctrlDataMgmt, ctgData);
-		KPFA_CHECK(error == KPFA_SUCCESS, -9);
+		checkpoint->SetSourceFiles(pParam->pRawFilePath, pParam->pCtgFilePath);
 	}
 
-	return 0;
-}
-
-void
-KpfaReleaseResult(KpfaResultData_t *pResultData) {
-
-	int i;
-
-	if(pResultData == NULL) {
-		return;
-	}
-
-	// FACTS
-	///////////////////////////////////////////////////////////
-	KpfaFactsList_t *factsList = &pResultData->hFactsList;
-
-	KpfaFactsCtg_t *factsCtgList = factsList->pList;
-
-	for(i = 0; i < factsList->nSize; i++) {
-
-		delete factsCtgList[i].pPrevList;
-		delete factsCtgList[i].pNextList;
-	}
-
-	delete factsCtgList;
-
-	factsList->nSize = 0;
+#ifdef KPFA_RESULT_SUPPORT
+	// ResultData Initialization
+	error = KpfaAllocResultData(rawDataMgmt, ctgDataMgmt, ctrlDataMgmt->m_bRetainResult);
+	KPFA_CHECK(error == KPFA_SUCCESS, -8);
 
-	// Final Operating Point
-	///////////////////////////////////////////////////////////
-	KpfaFactsCtg_t *finalOpPoint = pResultData->pFinalOpFacts;
+	// The checkpoint records the result of each contingency as a result sink
+	KpfaAttachResultSink(checkpoint, TRUE);
 
-	if(finalOpPoint) {
-		delete finalOpPoint->pPrevList;
-		delete finalOpPoint->pNextList;
-		delete finalOpPoint;
+	// Result sinks receiving the result of each contingency
+	error = KpfaOpenResultSinks(ctrlDataMgmt);
+	KPFA_CHECK(error == KPFA_SUCCESS, -8);
+#else
+	if(checkpoint != NULL) {
+		error = checkpoint->Open();
+		KPFA_CHECK(error == KPFA_SUCCESS, -11);
 	}
+#endif
 
-	pResultData->pFinalOpFacts = NULL;
-
-	// GV
-	///////////////////////////////////////////////////////////
-	KpfaGvList_t *gvList = &pResultData->hGvList;
-
-	KpfaGvCtg_t *gvCtgList = gvList->pList;
+    // For each contingency
+	while(true) {
 
-	for(i = 0; i < gvList->nSize; i++) {
+		KpfaCtgData *ctgData = NULL;
 
-		KpfaGv_t *tmp = gvCtgList[i].pList;
+		error = ctgDataMgmt->GetNextCtgData(ctgData);
 
-		if(tmp != NULL) {
-			delete gvCtgList[i].pList;
+		if(error != KPFA_SUCCESS) {
+#ifdef KPFA_RESULT_SUPPORT
+			KpfaCloseResultSinks(g_pResultData);
+#else
+			delete checkpoint;
+#endif
+			return -3;
 		}
-	}
-
-	delete gvCtgList;
-
-	gvList->nSize = 0;
-
-#if 0
-	// EQR
-	///////////////////////////////////////////////////////////
-	KpfaEqrList_t *eqrList = &pResultData->hEqrList;
-
-	KpfaEqrCtg_t *eqrCtgList = eqrList->pPrevList;
-
-	for(i = 0; i < eqrList->nSize; i++) {
-
-		KpfaEqr_t *tmp = eqrCtgList[i].pList;
 
-		if(tmp != NULL) {
-			delete eqrCtgList[i].pList;
+		if(ctgData == NULL) {
+			break;
 		}
-	}
-
-	delete eqrCtgList;
 
-	eqrCtgList = eqrList->pNextList;
+		// Skip the contingency finished in the previous run
+		if(checkpoint != NULL && checkpoint->IsFinished(ctgData->GetIndex()) == true) {
 
-	for(i = 0; i < eqrList->nSize; i++) {
-
-		KpfaEqr_t *tmp = eqrCtgList[i].pList;
-
-		if(tmp != NULL) {
-			delete eqrCtgList[i].pList;
+#ifdef KPFA_RESULT_SUPPORT
+			// Replay its result to the result data and the result sinks
+			error = checkpoint->Replay(ctgData);
+
+			if(error != KPFA_SUCCESS) {
+				KPFA_ERROR("KpfaDoAnalysis: contingency(%d) replay error - %d", ctgData->GetIndex(), error);
+				ctgDataMgmt->CloseCtgDataFile();
+				KpfaCloseResultSinks(g_pResultData);
+				return -11;
+			}
+#endif
+			continue;
 		}
-	}
 
-	delete eqrCtgList;
+		cout << ctgData << endl;
 
-	eqrList->nSize = 0;
+		error = AnalyzeStability(rawDataMgmt, ctrlDataMgmt, ctgData);
 
-	// POWERFLOW
-	///////////////////////////////////////////////////////////
-	for(int k = 0; k < 2; k++) {
+		// Record the failed contingency and go on to the next one
+		if(error != KPFA_SUCCESS && ctrlDataMgmt->m_bContinueCtg == TRUE) {
 
-		// BUS ------------------------------------------------
-		KpfaBusList_t *busList = &pResultData->hPowerflow.hBusList[k];
+			KPFA_ERROR("KpfaDoAnalysis: contingency(%d) error - %d", ctgData->GetIndex(), error);
 
-		KpfaBusCtg_t *busCtgList = busList->pList;
+			rawDataMgmt->RetrieveFromContingency();
 
-		for(i = 0; i < busList->nSize; i++) {
+#ifdef KPFA_RESULT_SUPPORT
+			KpfaDropResultData(ctgData);
+#endif
+			if(checkpoint != NULL) {
+				checkpoint->Record(ctgData->GetIndex(), error);
+			}
 
-			delete busCtgList[i].pList;
+			continue;
 		}
 
-		delete busCtgList;
-
-		busList->nSize = 0;
-
-		// BRANCH ------------------------------------------------
-		KpfaBranchList_t *branchList = &pResultData->hPowerflow.hBranchList[k];
-
-		KpfaBranchCtg_t *branchCtgList = branchList->pList;
+#ifdef KPFA_RESULT_SUPPORT
+		if(error != KPFA_SUCCESS) {
+			ctgDataMgmt->CloseCtgDataFile();
+			KpfaCloseResultSinks(g_pResultData);
+			return -9;
+		}
 
-		for(i = 0; i < branchList->nSize; i++) {
+		// Push the result of the contingency to the result sinks
+		error = KpfaPushResultData(ctgData);
 
-			delete branchCtgList[i].pList;
+		if(error != KPFA_SUCCESS) {
+			ctgDataMgmt->CloseCtgDataFile();
+			KpfaCloseResultSinks(g_pResultData);
+			return -10;
+		}
+#else
+		if(error != KPFA_SUCCESS) {
+			ctgDataMgmt->CloseCtgDataFile();
+			delete checkpoint;
 		}
 
-		delete branchCtgList;
-
-		branchList->nSize = 0;
+		KPFA_CHECK(error == KPFA_SUCCESS, -9);
 
-		// GENERATOR ------------------------------------------------
-		KpfaGeneratorList_t *genList = &pResultData->hPowerflow.hGeneratorList[k];
+		if(checkpoint != NULL) {
+			checkpoint->Record(ctgData->GetIndex(), KPFA_SUCCESS);
+		}
+#endif
+	}
 
-		KpfaGeneratorCtg_t *genCtgList = genList->pList;
+	// Stop the parse of the streamed contingency file
+	ctgDataMgmt->CloseCtgDataFile();
 
-		for(i = 0; i < genList->nSize; i++) {
+#ifdef KPFA_RESULT_SUPPORT
+	error = KpfaCloseResultSinks(g_pResultData);
+	KPFA_CHECK(error == KPFA_SUCCESS, -10);
+#else
+	if(checkpoint != NULL) {
+		error = checkpoint->Close(NULL);
+		delete checkpoint;
+		KPFA_CHECK(error == KPFA_SUCCESS, -11);
+	}
+#endif
 
-			delete genCtgList[i].pList;
-		}
+	return 0;
+}
 
-		delete genCtgList;
+void
+KpfaReleaseResult(KpfaResultData_t *pResultData) {
 
-		genList->nSize = 0;
+	if(pResultData == NULL) {
+		return;
 	}
+
+#ifdef KPFA_RESULT_SUPPORT
+	// All the result lists are carved out of a single arena,
+	// so that they can be released at once.
+	KpfaFreeResultData(pResultData);
 #endif
 }
 
@@ -478,7 +572,7 @@ KpfaReleaseResult(KpfaResultData_t *pResultData) {
 void
 KpfaPrintResult(char *pFilePath, KpfaResultData_t *pResultData) {
 
-	int i, j;
+	int i;
 
 	FILE *fp = NULL;
 
@@ -500,17 +594,7 @@ KpfaPrintResult(char *pFilePath, KpfaResultData_t *pResultData) {
 	fprintf(fp, ">> 1. FACTS ============\n");
 
 	for(i = 0; i < factsList->nSize; i++) {
-
-		KpfaFactsCtg_t *factsCtgList = &factsList->pList[i];
-
-		fprintf(fp, "facts ctg[id - %d, status - %d, name - %s] ===\n", i, factsCtgList->nStatus, factsCtgList->rName);
-
-		for(j = 0; j < factsCtgList->nSize; j++) {
-
-			fprintf(fp, "\tBus ID: %d -> %d\n", factsCtgList->pPrevList[j].nBusId, factsCtgList->pNextList[j].nBusId);
-			fprintf(fp, "\tVoltage: %6.5f -> %6.5f\n", factsCtgList->pPrevList[j].nVoltage, factsCtgList->pNextList[j].nVoltage);
-			fprintf(fp, "\tQGen: %6.5f -> %6.5f\n\n", factsCtgList->pPrevList[j].nQGen, factsCtgList->pNextList[j].nQGen);
-		}
+		KpfaPrintFactsCtg(fp, i, &factsList->pList[i]);
 	}
 
 	fprintf(fp, ">> Final Operating Point ============\n");
@@ -534,17 +618,7 @@ KpfaPrintResult(char *pFilePath, KpfaResultData_t *pResultData) {
 	KpfaGvList_t *gvList = &pResultData->hGvList;
 
 	for(i = 0; i < gvList->nSize; i++) {
-
-		KpfaGvCtg_t *gvCtgList = &gvList->pList[i];
-
-		fprintf(fp, "gv ctg[name - %s] ===\n", gvCtgList->rName);
-		fprintf(fp, "gv Margin - %6.5f\n", gvCtgList->nMargin);
-
-		for(int j = 0; j < gvCtgList->nSize; j++) {
-			fprintf(fp, "gv[%d]: GenParam - %6.5f, Voltage - %6.5f\n", j,
-					gvCtgList->pList[j].nGenParam,
-					gvCtgList->pList[j].nVoltage);
-		}
+		KpfaPrintGvCtg(fp, &gvList->pList[i]);
 	}
 
 	fprintf(fp, ">> 3. EQR ============\n");
@@ -554,41 +628,13 @@ KpfaPrintResult(char *pFilePath, KpfaResultData_t *pResultData) {
 	fprintf(fp, ">> Prev ==========================\n");
 	
 	for(i = 0; i < eqrList->nSize; i++) {
-
-		KpfaEqrCtg_t *eqrCtgList = &eqrList->pPrevList[i];
-
-		fprintf(fp, "eqr ctg[name - %s] ===\n", eqrCtgList->rName);
-		fprintf(fp, "eqr margin L - %6.5f\n", eqrCtgList->nEqrMarginL);
-		fprintf(fp, "eqr margin C - %6.5f\n", eqrCtgList->nEqrMarginC);
-		fprintf(fp, "cqr value L - %6.5f\n", eqrCtgList->nCqrValueL);
-		fprintf(fp, "cqr value C - %6.5f\n", eqrCtgList->nCqrValueC);
-
-		for(int j = 0; j < eqrCtgList->nSize; j++) {
-			fprintf(fp, "eqr[%d]: Bus ID - %d, EqrValue L - %6.5f, EqrValue C - %6.5f\n", j,
-					eqrCtgList->pList[j].nBusId,
-					eqrCtgList->pList[j].nEqrValueL, 
-					eqrCtgList->pList[j].nEqrValueC);
-		}
+		KpfaPrintEqrCtg(fp, &eqrList->pPrevList[i]);
 	}
 
 	fprintf(fp, ">> Next ==========================\n");
 
 	for(i = 0; i < eqrList->nSize; i++) {
-
-		KpfaEqrCtg_t *eqrCtgList = &eqrList->pNextList[i];
-
-		fprintf(fp, "eqr ctg[name - %s] ===\n", eqrCtgList->rName);
-		fprintf(fp, "eqr margin L - %6.5f\n", eqrCtgList->nEqrMarginL);
-		fprintf(fp, "eqr margin C - %6.5f\n", eqrCtgList->nEqrMarginC);
-		fprintf(fp, "cqr value L - %6.5f\n", eqrCtgList->nCqrValueL);
-		fprintf(fp, "cqr value C - %6.5f\n", eqrCtgList->nCqrValueC);
-
-		for(int j = 0; j < eqrCtgList->nSize; j++) {
-			fprintf(fp, "eqr[%d]: Bus ID - %d, EqrValue L - %6.5f, EqrValue C - %6.5f\n", j,
-					eqrCtgList->pList[j].nBusId,
-					eqrCtgList->pList[j].nEqrValueL, 
-					eqrCtgList->pList[j].nEqrValueC);
-		}
+		KpfaPrintEqrCtg(fp, &eqrList->pNextList[i]);
 	}
 
 	fprintf(fp, ">> 4. OPF ============\n");
@@ -607,16 +653,7 @@ KpfaPrintResult(char *pFilePath, KpfaResultData_t *pResultData) {
 		KpfaBusList_t *busList = &pResultData->hPowerflow.hBusList[k];
 
 		for(i = 0; i < busList->nSize; i++) {
-
-			KpfaBusCtg_t *busCtg = &busList->pList[i];
-			fprintf(fp, "bus ctg[name - %s] ===\n", busCtg->rName);
-
-			for(j = 0; j < busCtg->nSize; j++) {
-
-				fprintf(fp, "bus[%d]: Bus ID - %d, Voltage - %6.5f\n", j,
-							busCtg->pList[j].nBusId,
-							busCtg->pList[j].nVoltage);
-			}
+			KpfaPrintBusCtg(fp, &busList->pList[i]);
 		}
 
 		fprintf(fp, ">> 5. Powerflow - BRANCH ============\n");
@@ -624,20 +661,7 @@ KpfaPrintResult(char *pFilePath, KpfaResultData_t *pResultData) {
 		KpfaBranchList_t *branchList = &pResultData->hPowerflow.hBranchList[k];
 
 		for(i = 0; i < branchList->nSize; i++) {
-
-			KpfaBranchCtg_t *branchCtg = &branchList->pList[i];
-			fprintf(fp, "branch ctg[name - %s] ===\n", branchCtg->rName);
-
-			for(j = 0; j < branchCtg->nSize; j++) {
-
-				fprintf(fp, "branch[%d]: Bus ID0 - %d, Bus ID1: %d, Branch Ckt: %d, P: %6.5f, Q1: %6.5f, Q2: %6.5f\n", j,
-							branchCtg->pList[j].nStartId,
-							branchCtg->pList[j].nEndId,
-							branchCtg->pList[j].nCkt,
-							branchCtg->pList[j].nFlowValueP,
-							branchCtg->pList[j].nFlowValueQ1,
-							branchCtg->pList[j].nFlowValueQ2);
-			}
+			KpfaPrintBranchCtg(fp, &branchList->pList[i]);
 		}
 
 		fprintf(fp, ">> 5. Powerflow - GENERATOR ============\n");
@@ -645,16 +669,7 @@ KpfaPrintResult(char *pFilePath, KpfaResultData_t *pResultData) {
 		KpfaGeneratorList_t *genList = &pResultData->hPowerflow.hGeneratorList[k];
 
 		for(i = 0; i < genList->nSize; i++) {
-
-			KpfaGeneratorCtg_t *genCtg = &genList->pList[i];
-			fprintf(fp, "generator ctg[name - %s] ===\n", genCtg->rName);
-
-			for(j = 0; j < genCtg->nSize; j++) {
-
-				fprintf(fp, "generator[%d]: Bus ID: %d, Q Gen - %6.5f\n", j,
-							genCtg->pList[j].nBusId,
-							genCtg->pList[j].nQGen);
-			}
+			KpfaPrintGeneratorCtg(fp, &genList->pList[i]);
 		}
 	}
 
@@ -0,0 +1,191 @@
+/*
+ * KpfaMappedFile.cpp
+ */
+
+#include "KpfaMappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// Contents of an empty file, which cannot be mapped
+static const char s_rEmptyData[1] = { 0 };
+
+KpfaMappedFile::KpfaMappedFile() {
+
+	m_pData = NULL;
+	m_nSize = 0;
+	m_nModifyTime = 0;
+
+#ifdef _WIN32
+	m_hFile = INVALID_HANDLE_VALUE;
+	m_hMapping = NULL;
+#else
+	m_nFd = -1;
+#endif
+}
+
+KpfaMappedFile::~KpfaMappedFile() {
+
+	Close();
+}
+
+/**
+ * This function will map the given file into the memory for reading.
+ *
+ * @param pFilePath file path
+ * @return error information
+ */
+KpfaError_t
+KpfaMappedFile::Open(const char *pFilePath) {
+
+	KPFA_CHECK(pFilePath != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	Close();
+
+	m_rFilePath = pFilePath;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(pFilePath, GENERIC_READ, FILE_SHARE_READ, NULL,
+							  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if(file == INVALID_HANDLE_VALUE) {
+		cerr << "File Not Open: " << pFilePath << endl;
+		return KPFA_ERROR_FILE_OPEN;
+	}
+
+	LARGE_INTEGER size;
+
+	if(GetFileSizeEx(file, &size) == 0) {
+		CloseHandle(file);
+		return KPFA_ERROR_FILE_OPEN;
+	}
+
+	FILETIME time;
+
+	if(GetFileTime(file, NULL, NULL, &time) == 0) {
+		CloseHandle(file);
+		return KPFA_ERROR_FILE_OPEN;
+	}
+
+	m_hFile = file;
+	m_nSize = (size_t)size.QuadPart;
+	m_nModifyTime = ((int64_t)time.dwHighDateTime << 32) | time.dwLowDateTime;
+
+	if(m_nSize == 0) {
+		m_pData = s_rEmptyData;
+		return KPFA_SUCCESS;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	if(mapping == NULL) {
+		Close();
+		return KPFA_ERROR_FILE_OPEN;
+	}
+
+	m_hMapping = mapping;
+	m_pData = (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if(m_pData == NULL) {
+		Close();
+		return KPFA_ERROR_FILE_OPEN;
+	}
+#else
+	int fd = open(pFilePath, O_RDONLY);
+
+	if(fd < 0) {
+		cerr << "File Not Open: " << pFilePath << endl;
+		return KPFA_ERROR_FILE_OPEN;
+	}
+
+	struct stat st;
+
+	if(fstat(fd, &st) != 0) {
+		close(fd);
+		return KPFA_ERROR_FILE_OPEN;
+	}
+
+	m_nFd = fd;
+	m_nSize = (size_t)st.st_size;
+	m_nModifyTime = (int64_t)st.st_mtime;
+
+	if(m_nSize == 0) {
+		m_pData = s_rEmptyData;
+		return KPFA_SUCCESS;
+	}
+
+	void *data = mmap(NULL, m_nSize, PROT_READ, MAP_SHARED, fd, 0);
+
+	if(data == MAP_FAILED) {
+		Close();
+		return KPFA_ERROR_FILE_OPEN;
+	}
+
+	m_pData = (const char *)data;
+#endif
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will unmap the file. All the pointers into the mapped
+ * file become invalid.
+ */
+void
+KpfaMappedFile::Close() {
+
+#ifdef _WIN32
+	if(m_pData != NULL && m_pData != s_rEmptyData) {
+		UnmapViewOfFile(m_pData);
+	}
+
+	if(m_hMapping != NULL) {
+		CloseHandle((HANDLE)m_hMapping);
+		m_hMapping = NULL;
+	}
+
+	if(m_hFile != INVALID_HANDLE_VALUE) {
+		CloseHandle((HANDLE)m_hFile);
+		m_hFile = INVALID_HANDLE_VALUE;
+	}
+#else
+	if(m_pData != NULL && m_pData != s_rEmptyData) {
+		munmap((void *)m_pData, m_nSize);
+	}
+
+	if(m_nFd >= 0) {
+		close(m_nFd);
+		m_nFd = -1;
+	}
+#endif
+
+	m_pData = NULL;
+	m_nSize = 0;
+	m_nModifyTime = 0;
+}
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaMappedFile::Write(ostream &rOut) {
+
+	rOut << "KPFA MAPPED FILE: " << endl;
+
+	rOut << "\tPATH: " << m_rFilePath << endl;
+
+	rOut << "\tSIZE: " << m_nSize << endl;
+}
+
+ostream &operator << (ostream &rOut, KpfaMappedFile *pFile) {
+
+	pFile->Write(rOut);
+	return rOut;
+}
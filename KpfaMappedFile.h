@@ -0,0 +1,103 @@
+/*
+ * KpfaMappedFile.h
+ */
+
+#ifndef _KPFA_MAPPED_FILE_H_
+#define _KPFA_MAPPED_FILE_H_
+
+#include <stdint.h>
+
+#include "KpfaDebug.h"
+#include "KpfaConfig.h"
+
+/**
+ * The declaration of the class for a read-only memory-mapped file.
+ * The whole file is mapped into the address space so that its contents
+ * can be accessed in place without any copy.
+ */
+class KpfaMappedFile {
+
+private:
+
+	// File path
+	string m_rFilePath;
+
+	// Start address and size of the mapped file
+	const char *m_pData;
+	size_t m_nSize;
+
+	// Last modification time of the file
+	int64_t m_nModifyTime;
+
+#ifdef _WIN32
+	// Handles of the file and the file mapping
+	void *m_hFile;
+	void *m_hMapping;
+#else
+	// File descriptor
+	int m_nFd;
+#endif
+
+public:
+
+	KpfaMappedFile();
+
+	virtual ~KpfaMappedFile();
+
+	KpfaError_t Open(const char *pFilePath);
+
+	void Close();
+
+	/**
+	 * This function will return the start address of the mapped file.
+	 *
+	 * @return start address (NULL if not opened)
+	 */
+	inline const char *GetData() {
+		return m_pData;
+	}
+
+	/**
+	 * This function will return the size of the mapped file.
+	 *
+	 * @return file size
+	 */
+	inline size_t GetSize() {
+		return m_nSize;
+	}
+
+	/**
+	 * This function will return the last modification time of the mapped file.
+	 * The unit depends on the platform.
+	 *
+	 * @return modification time
+	 */
+	inline int64_t GetModifyTime() {
+		return m_nModifyTime;
+	}
+
+	/**
+	 * This function will check whether a file is mapped.
+	 *
+	 * @return true if a file is mapped
+	 */
+	inline bool IsOpen() {
+		return (m_pData != NULL);
+	}
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+
+	friend ostream &operator << (ostream &rOut, KpfaMappedFile *pFile);
+
+private:
+
+	KpfaMappedFile(const KpfaMappedFile &);
+
+	KpfaMappedFile &operator = (const KpfaMappedFile &);
+};
+
+#endif /* _KPFA_MAPPED_FILE_H_ */
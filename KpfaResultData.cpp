@@ -6,6 +6,7 @@
  */
 
 #include "KpfaResultData.h"
+#include "KpfaResultSink.h"
 
 ////////////////////////////////////////////////////////
 // Global handle for the result data
@@ -13,10 +14,303 @@
 
 KpfaResultData_t *g_pResultData = NULL;
 
+////////////////////////////////////////////////////////
+// Arenas owning the memory of the result data
+////////////////////////////////////////////////////////
+
+typedef struct {
+	// Result lists retained until the result data is released
+	KpfaArena *pArena;
+	// Results of the current contingency if they are not retained
+	KpfaArena *pCtgArena;
+	// Retain the results of all the contingencies
+	bool_t bRetain;
+} KpfaResultStore_t;
+
+typedef std::map<KpfaResultData_t *, KpfaResultStore_t> KpfaResultStoreTable_t;
+
+static KpfaResultStoreTable_t s_rResultStoreTable;
+
+static std::mutex s_rResultStoreLock;
+
 ////////////////////////////////////////////////////////
 // Function definition
 ////////////////////////////////////////////////////////
 
+/**
+ * Returns the store of the given result data. It is created on the first access.
+ */
+static KpfaResultStore_t *
+GetResultStore(KpfaResultData_t *pResultData) {
+
+	std::lock_guard<std::mutex> guard(s_rResultStoreLock);
+
+	KpfaResultStoreTable_t::iterator iter = s_rResultStoreTable.find(pResultData);
+
+	if(iter != s_rResultStoreTable.end()) {
+		return &iter->second;
+	}
+
+	KpfaResultStore_t &store = s_rResultStoreTable[pResultData];
+
+	store.pArena = new KpfaArena();
+	store.pCtgArena = new KpfaArena();
+	store.bRetain = TRUE;
+
+	return &store;
+}
+
+/**
+ * Allocates a zero-filled memory block from the arena of the given result data.
+ * The block is kept until the result data is released.
+ */
+void *
+KpfaAllocResultMemory(KpfaResultData_t *pResultData, size_t nSize) {
+
+	if(pResultData == NULL) {
+		return NULL;
+	}
+
+	void *block = GetResultStore(pResultData)->pArena->Allocate(nSize);
+
+	if(block != NULL) {
+		memset(block, 0, nSize);
+	}
+
+	return block;
+}
+
+/**
+ * Allocates a zero-filled memory block for the results of the current contingency.
+ * If the results are not retained, the block is released after they are pushed.
+ */
+void *
+KpfaAllocCtgResultMemory(KpfaResultData_t *pResultData, size_t nSize) {
+
+	if(pResultData == NULL) {
+		return NULL;
+	}
+
+	KpfaResultStore_t *store = GetResultStore(pResultData);
+	KpfaArena *arena = (store->bRetain == TRUE) ? store->pArena : store->pCtgArena;
+
+	void *block = arena->Allocate(nSize);
+
+	if(block != NULL) {
+		memset(block, 0, nSize);
+	}
+
+	return block;
+}
+
+/**
+ * Releases all the memory of the given result data at once, and resets its lists.
+ */
+void
+KpfaFreeResultData(KpfaResultData_t *pResultData) {
+
+	if(pResultData == NULL) {
+		return;
+	}
+
+	KpfaResultStore_t store;
+
+	store.pArena = NULL;
+	store.pCtgArena = NULL;
+
+	{
+		std::lock_guard<std::mutex> guard(s_rResultStoreLock);
+
+		KpfaResultStoreTable_t::iterator iter = s_rResultStoreTable.find(pResultData);
+
+		if(iter != s_rResultStoreTable.end()) {
+			store = iter->second;
+			s_rResultStoreTable.erase(iter);
+		}
+	}
+
+	if(store.pArena != NULL) 	delete store.pArena;
+	if(store.pCtgArena != NULL) delete store.pCtgArena;
+
+	memset(pResultData, 0, sizeof(KpfaResultData_t));
+}
+
+/**
+ * Returns the slot of the result lists for the given contingency.
+ * If the results are not retained, all the contingencies share the slot 0.
+ */
+int
+KpfaGetResultSlot(int nCtgIndex) {
+
+	if(g_pResultData == NULL || nCtgIndex < 0) {
+		return nCtgIndex;
+	}
+
+	return (GetResultStore(g_pResultData)->bRetain == TRUE) ? nCtgIndex : 0;
+}
+
+/**
+ * Clears the given slot except the FACTS data before the analysis. If the
+ * results are not retained, the slot is shared by the contingencies and the
+ * memory of the contingency is released too.
+ */
+static void
+ClearResultSlot(KpfaResultStore_t *pStore, int nSlot) {
+
+	KpfaPowerFlow_t *pf = &g_pResultData->hPowerflow;
+
+	KpfaFactsCtg_t *facts = &g_pResultData->hFactsList.pList[nSlot];
+
+	facts->nStatus = KPFA_STATUS_0;
+	memset(facts->pNextList, 0, sizeof(KpfaFacts_t) * facts->nSize);
+
+	memset(&g_pResultData->hGvList.pList[nSlot], 0, sizeof(KpfaGvCtg_t));
+
+	memset(&g_pResultData->hEqrList.pPrevList[nSlot], 0, sizeof(KpfaEqrCtg_t));
+	memset(&g_pResultData->hEqrList.pNextList[nSlot], 0, sizeof(KpfaEqrCtg_t));
+
+	for(int k = 0; k < 2; k++) {
+		memset(&pf->hBusList[k].pList[nSlot], 0, sizeof(KpfaBusCtg_t));
+		memset(&pf->hBranchList[k].pList[nSlot], 0, sizeof(KpfaBranchCtg_t));
+		memset(&pf->hGeneratorList[k].pList[nSlot], 0, sizeof(KpfaGeneratorCtg_t));
+	}
+
+	if(pStore->bRetain == FALSE) {
+		pStore->pCtgArena->Release();
+	}
+}
+
+/**
+ * Sets the result of a contingency to the lists of the given slot.
+ */
+static void
+SetCtgResult(KpfaCtgResult_t *pResult, int nSlot) {
+
+	KpfaPowerFlow_t *pf = &g_pResultData->hPowerflow;
+
+	pResult->pFacts = &g_pResultData->hFactsList.pList[nSlot];
+	pResult->pGv = &g_pResultData->hGvList.pList[nSlot];
+	pResult->pEqr[0] = &g_pResultData->hEqrList.pPrevList[nSlot];
+	pResult->pEqr[1] = &g_pResultData->hEqrList.pNextList[nSlot];
+
+	for(int k = 0; k < 2; k++) {
+		pResult->pBus[k] = &pf->hBusList[k].pList[nSlot];
+		pResult->pBranch[k] = &pf->hBranchList[k].pList[nSlot];
+		pResult->pGenerator[k] = &pf->hGeneratorList[k].pList[nSlot];
+	}
+}
+
+/**
+ * Pushes the results of the given contingency to the result sinks as soon as
+ * its analysis finishes. If the results are not retained, the slot is cleared
+ * for the next contingency and its memory is released.
+ */
+KpfaError_t
+KpfaPushResultData(KpfaCtgData *pCtgData) {
+
+	KPFA_CHECK(pCtgData != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	if(g_pResultData == NULL) {
+		return KPFA_ERROR_INVALID_RESULT;
+	}
+
+	KpfaError_t error;
+
+	KpfaResultStore_t *store = GetResultStore(g_pResultData);
+
+	int i = KpfaGetResultSlot(pCtgData->GetIndex());
+
+	// Contingency result
+	KpfaCtgResult_t result;
+
+	result.nIndex = pCtgData->GetIndex();
+
+	SetCtgResult(&result, i);
+
+	// The slot may be shared, so that the name is updated here
+	char ctgName[KPFA_MAX_STR_LEN];
+
+	memset(ctgName, 0, sizeof(ctgName));
+	strncpy(ctgName, pCtgData->GetName().c_str(), KPFA_MAX_STR_LEN - 1);
+
+	strcpy(result.pFacts->rName, ctgName);
+	strcpy(result.pGv->rName, ctgName);
+
+	for(int k = 0; k < 2; k++) {
+		strcpy(result.pEqr[k]->rName, ctgName);
+		strcpy(result.pBus[k]->rName, ctgName);
+		strcpy(result.pBranch[k]->rName, ctgName);
+		strcpy(result.pGenerator[k]->rName, ctgName);
+	}
+
+	result.pName = result.pFacts->rName;
+
+	error = KpfaPushResultSinks(&result);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	if(store->bRetain == TRUE) {
+		return KPFA_SUCCESS;
+	}
+
+	ClearResultSlot(store, i);
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * Restores the results of the given contingency from a binary record of a
+ * previous run, and pushes them to the result sinks as if the contingency
+ * was analyzed in this run.
+ */
+KpfaError_t
+KpfaRestoreResultData(KpfaCtgData *pCtgData, FILE *fp) {
+
+	KPFA_CHECK(pCtgData != NULL && fp != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	if(g_pResultData == NULL) {
+		return KPFA_ERROR_INVALID_RESULT;
+	}
+
+	KpfaCtgResult_t result;
+
+	SetCtgResult(&result, KpfaGetResultSlot(pCtgData->GetIndex()));
+
+	KpfaError_t error = KpfaReadBinaryResult(fp, &result);
+
+	if(error == KPFA_SUCCESS && result.nIndex != pCtgData->GetIndex()) {
+		error = KPFA_ERROR_FILE_FORMAT;
+	}
+
+	if(error != KPFA_SUCCESS) {
+		KpfaDropResultData(pCtgData);
+		return error;
+	}
+
+	return KpfaPushResultData(pCtgData);
+}
+
+/**
+ * Drops the results of the given contingency whose analysis failed without
+ * pushing them to the result sinks. The slot is cleared in both modes, so that
+ * the partial results are not reported, and its memory is released if the
+ * results are not retained.
+ */
+KpfaError_t
+KpfaDropResultData(KpfaCtgData *pCtgData) {
+
+	KPFA_CHECK(pCtgData != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	if(g_pResultData == NULL) {
+		return KPFA_ERROR_INVALID_RESULT;
+	}
+
+	KpfaResultStore_t *store = GetResultStore(g_pResultData);
+
+	ClearResultSlot(store, KpfaGetResultSlot(pCtgData->GetIndex()));
+
+	return KPFA_SUCCESS;
+}
+
 /**
  * Gathers the data of FACTS.
  */
@@ -28,7 +322,7 @@ KpfaGatherFactsData(KpfaRawDataMgmt *pRawDataMgmt, int nCtgIndex) {
 		return KPFA_ERROR_INVALID_RESULT;
 	}
 
-	KpfaFactsCtg_t *factsCtg = &g_pResultData->hFactsList.pList[nCtgIndex];
+	KpfaFactsCtg_t *factsCtg = &g_pResultData->hFactsList.pList[KpfaGetResultSlot(nCtgIndex)];
 
 	int factsIndex = 0;
 
@@ -64,6 +358,9 @@ KpfaGatherResultData(KpfaRawDataMgmt *pRawDataMgmt, KpfaPowerflow *pPowerflow, i
 		return KPFA_ERROR_INVALID_RESULT;
 	}
 
+	// slot of the result lists
+	nCtgIndex = KpfaGetResultSlot(nCtgIndex);
+
 	// POWERFLOW
 	KpfaRawDataList_t::iterator iter;
 
@@ -72,7 +369,7 @@ KpfaGatherResultData(KpfaRawDataMgmt *pRawDataMgmt, KpfaPowerflow *pPowerflow, i
 	KpfaBusCtg_t *busList = &g_pResultData->hPowerflow.hBusList[nPfIndex].pList[nCtgIndex];
 
 	busList->nSize = busDataList.size();
-	busList->pList = (KpfaBus_t *)malloc(sizeof(KpfaBus_t) * busList->nSize);
+	busList->pList = KPFA_RESULT_ALLOC(KpfaBus_t, busList->nSize);
 
 	KPFA_CHECK(busList->pList != NULL, KPFA_ERROR_MEMORY_ALLOC);
 
@@ -105,7 +402,7 @@ KpfaGatherResultData(KpfaRawDataMgmt *pRawDataMgmt, KpfaPowerflow *pPowerflow, i
 	KpfaBranchCtg_t *branchList = &g_pResultData->hPowerflow.hBranchList[nPfIndex].pList[nCtgIndex];
 
 	branchList->nSize = branchDataList.size();
-	branchList->pList = (KpfaBranch_t *)malloc(sizeof(KpfaBranch_t) * branchList->nSize);
+	branchList->pList = KPFA_RESULT_ALLOC(KpfaBranch_t, branchList->nSize);
 
 	KPFA_CHECK(branchList->pList != NULL, KPFA_ERROR_MEMORY_ALLOC);
 
@@ -126,7 +423,7 @@ KpfaGatherResultData(KpfaRawDataMgmt *pRawDataMgmt, KpfaPowerflow *pPowerflow, i
 	KpfaGeneratorCtg_t *genList = &g_pResultData->hPowerflow.hGeneratorList[nPfIndex].pList[nCtgIndex];
 
 	genList->nSize = genDataList.size();
-	genList->pList = (KpfaGenerator_t *)malloc(sizeof(KpfaGenerator_t) * genList->nSize);
+	genList->pList = KPFA_RESULT_ALLOC(KpfaGenerator_t, genList->nSize);
 
 	KPFA_CHECK(genList->pList != NULL, KPFA_ERROR_MEMORY_ALLOC);
 
@@ -143,77 +440,72 @@ KpfaGatherResultData(KpfaRawDataMgmt *pRawDataMgmt, KpfaPowerflow *pPowerflow, i
 }
 
 /**
- * Allocates the memory of the Facts data.
+ * Allocates the memory of the result lists.
+ * If the results are not retained, only a single slot shared by all the
+ * contingencies is allocated and the lists are reported as empty.
  */
+#define _ALLOC(TYPE, COUNT)	(TYPE *)KpfaAllocResultMemory(g_pResultData, sizeof(TYPE) * (COUNT))
+
 KpfaError_t
 KpfaAllocResultData(KpfaRawDataMgmt *pRawDataMgmt,
-					KpfaCtgDataMgmt *pCtgDataMgmt) {
+					KpfaCtgDataMgmt *pCtgDataMgmt,
+					bool_t bRetain) {
 
 	if(g_pResultData == NULL) {
 		return KPFA_ERROR_INVALID_RESULT;
 	}
 
 	uint32_t i = 0;
-	uint32_t len = 0;
 	uint32_t nctg = pCtgDataMgmt->GetCtgDataList().size();
 	uint32_t nfacts = pRawDataMgmt->GetFactsDataList().size();
 
+	// Release the results of the previous analysis at once
+	KpfaFreeResultData(g_pResultData);
+
+	GetResultStore(g_pResultData)->bRetain = bRetain;
+
+	// # of slots and # of reported items of the lists
+	uint32_t nslot = (bRetain == TRUE) ? nctg : 1;
+	uint32_t nsize = (bRetain == TRUE) ? nctg : 0;
+
 	//EQR
 	KpfaEqrList_t *eqrList = &g_pResultData->hEqrList;
 
-	if(eqrList->pPrevList != NULL) delete eqrList->pPrevList;
-	if(eqrList->pNextList != NULL) delete eqrList->pNextList;
-
-	eqrList->nSize = nctg;
-	len = sizeof(KpfaEqrCtg_t) * nctg;
-	eqrList->pPrevList = (KpfaEqrCtg_t *)malloc(len);
-	eqrList->pNextList = (KpfaEqrCtg_t *)malloc(len);
+	eqrList->nSize = nsize;
+	eqrList->pPrevList = _ALLOC(KpfaEqrCtg_t, nslot);
+	eqrList->pNextList = _ALLOC(KpfaEqrCtg_t, nslot);
 
 	if(eqrList->pPrevList == NULL || eqrList->pNextList == NULL) {
 		return KPFA_ERROR_MEMORY_ALLOC;
 	}
 
-	memset(eqrList->pPrevList, 0, len);
-	memset(eqrList->pNextList, 0, len);
-
 	// GV
 	KpfaGvList_t *gvList = &g_pResultData->hGvList;
 
-	if(gvList->pList != NULL) {
-		delete gvList->pList;
-	}
-
-	gvList->nSize = nctg;
-	len = sizeof(KpfaGvCtg_t) * nctg;
-	gvList->pList = (KpfaGvCtg_t *)malloc(len);
+	gvList->nSize = nsize;
+	gvList->pList = _ALLOC(KpfaGvCtg_t, nslot);
 
 	if(gvList->pList == NULL) {
 		return KPFA_ERROR_MEMORY_ALLOC;
 	}
 
-	memset(gvList->pList, 0, len);
-
 	// FACTS
 	KpfaFactsList_t *factsList = &g_pResultData->hFactsList;
 
-	if(factsList->pList != NULL) {
-		delete factsList->pList;
-	}
-
-	factsList->nSize = nctg;
-	factsList->pList = (KpfaFactsCtg_t *)malloc(sizeof(KpfaFactsCtg_t) * nctg);
+	factsList->nSize = nsize;
+	factsList->pList = _ALLOC(KpfaFactsCtg_t, nslot);
 
 	if(factsList->pList == NULL) {
 		return KPFA_ERROR_MEMORY_ALLOC;
 	}
 
-	for(i = 0; i < nctg; i++) {
+	for(i = 0; i < nslot; i++) {
 
 		int factsIdx = 0;
 		KpfaFactsCtg_t *factsCtg = &factsList->pList[i];
 
-		factsCtg->pPrevList = (KpfaFacts_t *)malloc(sizeof(KpfaFacts_t) * nfacts);
-		factsCtg->pNextList = (KpfaFacts_t *)malloc(sizeof(KpfaFacts_t) * nfacts);
+		factsCtg->pPrevList = _ALLOC(KpfaFacts_t, nfacts);
+		factsCtg->pNextList = _ALLOC(KpfaFacts_t, nfacts);
 		factsCtg->nStatus = KPFA_STATUS_0;
 
 		if(factsCtg->pPrevList == NULL || factsCtg->pNextList == NULL) {
@@ -245,16 +537,24 @@ KpfaAllocResultData(KpfaRawDataMgmt *pRawDataMgmt,
 
 		// POWER FLOW (BUS, BRANCH, GENERATOR)
 		KpfaBusList_t *busList = &g_pResultData->hPowerflow.hBusList[k];
-		busList->pList = (KpfaBusCtg_t *)malloc(sizeof(KpfaBusCtg_t) * nctg);
-		busList->nSize = nctg;
+		busList->pList = _ALLOC(KpfaBusCtg_t, nslot);
+		busList->nSize = nsize;
 
 		KpfaBranchList_t *branchList = &g_pResultData->hPowerflow.hBranchList[k];
-		branchList->pList = (KpfaBranchCtg_t *)malloc(sizeof(KpfaBranchCtg_t) * nctg);
-		branchList->nSize = nctg;
+		branchList->pList = _ALLOC(KpfaBranchCtg_t, nslot);
+		branchList->nSize = nsize;
 
 		KpfaGeneratorList_t *genList = &g_pResultData->hPowerflow.hGeneratorList[k];
-		genList->pList = (KpfaGeneratorCtg_t *)malloc(sizeof(KpfaGeneratorCtg_t) * nctg);
-		genList->nSize = nctg;
+		genList->pList = _ALLOC(KpfaGeneratorCtg_t, nslot);
+		genList->nSize = nsize;
+
+		if(busList->pList == NULL || branchList->pList == NULL || genList->pList == NULL) {
+			return KPFA_ERROR_MEMORY_ALLOC;
+		}
+
+		if(bRetain == FALSE) {
+			continue;
+		}
 
 		KpfaCtgDataList_t::iterator citer;
 		KpfaCtgDataList_t &ctgList = pCtgDataMgmt->GetCtgDataList();
@@ -282,3 +582,5 @@ KpfaAllocResultData(KpfaRawDataMgmt *pRawDataMgmt,
 
 	return KPFA_SUCCESS;
 }
+
+#undef _ALLOC
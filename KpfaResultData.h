@@ -9,6 +9,7 @@
 
 #include "KpfaDebug.h"
 #include "KpfaConfig.h"
+#include "KpfaArena.h"
 #include "KpfaPowerflow.h"
 #include "KpfaInterface.h"
 #include "KpfaRawDataMgmt.h"
@@ -19,12 +20,38 @@
 
 extern KpfaResultData_t *g_pResultData;
 
+////////////////////////////////////////////////////////
+// Macros for the result memory
+////////////////////////////////////////////////////////
+
+/**
+ * Allocates an array of the given type for the results of the current contingency
+ * from the arena of the global result data.
+ */
+#define KPFA_RESULT_ALLOC(TYPE, COUNT)	\
+	(TYPE *)KpfaAllocCtgResultMemory(g_pResultData, sizeof(TYPE) * (COUNT))
+
 ////////////////////////////////////////////////////////
 // Function declaration
 ////////////////////////////////////////////////////////
 
+void *KpfaAllocResultMemory(KpfaResultData_t *pResultData, size_t nSize);
+
+void *KpfaAllocCtgResultMemory(KpfaResultData_t *pResultData, size_t nSize);
+
+void KpfaFreeResultData(KpfaResultData_t *pResultData);
+
+int KpfaGetResultSlot(int nCtgIndex);
+
+KpfaError_t KpfaPushResultData(KpfaCtgData *pCtgData);
+
+KpfaError_t KpfaRestoreResultData(KpfaCtgData *pCtgData, FILE *fp);
+
+KpfaError_t KpfaDropResultData(KpfaCtgData *pCtgData);
+
 KpfaError_t KpfaAllocResultData(KpfaRawDataMgmt *pRawDataMgmt,
-								KpfaCtgDataMgmt *pCtgDataMgmt);
+								KpfaCtgDataMgmt *pCtgDataMgmt,
+								bool_t bRetain = TRUE);
 
 KpfaError_t KpfaGatherResultData(KpfaRawDataMgmt *pRawDataMgmt,	
 								 KpfaPowerflow *pPowerflow,
@@ -0,0 +1,732 @@
+/*
+ * KpfaResultSink.cpp
+ */
+
+#include "KpfaResultSink.h"
+#include "KpfaResultData.h"
+#include "KpfaColumnarResult.h"
+
+////////////////////////////////////////////////////////
+// Registered result sinks
+////////////////////////////////////////////////////////
+
+typedef struct {
+	KpfaResultSink *pSink;
+	bool_t bOwned;
+} KpfaResultSinkEntry_t;
+
+static std::vector<KpfaResultSinkEntry_t> s_rResultSinkList;
+
+////////////////////////////////////////////////////////
+// Function definition
+////////////////////////////////////////////////////////
+
+/**
+ * Registers a result sink to receive the result of each contingency.
+ *
+ * @param pSink result sink
+ * @param bOwned whether the sink is deleted when the sinks are closed
+ */
+void
+KpfaAttachResultSink(KpfaResultSink *pSink, bool_t bOwned) {
+
+	if(pSink == NULL) {
+		return;
+	}
+
+	KpfaResultSinkEntry_t entry;
+
+	entry.pSink = pSink;
+	entry.bOwned = bOwned;
+
+	s_rResultSinkList.push_back(entry);
+}
+
+/**
+ * Creates the built-in result sink selected in the control data and
+ * opens all the registered result sinks.
+ *
+ * @param pCtrlDataMgmt control data management
+ * @return error information
+ */
+KpfaError_t
+KpfaOpenResultSinks(KpfaCtrlDataMgmt *pCtrlDataMgmt) {
+
+	KPFA_CHECK(pCtrlDataMgmt != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	KpfaError_t error;
+
+	string &path = pCtrlDataMgmt->m_rResultFilePath;
+
+	switch(pCtrlDataMgmt->m_nResultSink) {
+		case KPFA_RESULT_SINK_TEXT:
+			KpfaAttachResultSink(new KpfaTextResultSink(path), TRUE);
+			break;
+		case KPFA_RESULT_SINK_BINARY:
+			KpfaAttachResultSink(new KpfaBinaryResultSink(path), TRUE);
+			break;
+		case KPFA_RESULT_SINK_COLUMNAR:
+			KpfaAttachResultSink(new KpfaColumnarResultSink(path), TRUE);
+			break;
+		default:
+			break;
+	}
+
+	std::vector<KpfaResultSinkEntry_t>::iterator iter;
+
+	for(iter = s_rResultSinkList.begin(); iter != s_rResultSinkList.end(); iter++) {
+
+		error = iter->pSink->Open();
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * Pushes the result of a contingency to all the registered result sinks.
+ *
+ * @param pResult the result of the contingency
+ * @return error information
+ */
+KpfaError_t
+KpfaPushResultSinks(KpfaCtgResult_t *pResult) {
+
+	KPFA_CHECK(pResult != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	KpfaError_t error;
+
+	std::vector<KpfaResultSinkEntry_t>::iterator iter;
+
+	for(iter = s_rResultSinkList.begin(); iter != s_rResultSinkList.end(); iter++) {
+
+		error = iter->pSink->Push(pResult);
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * Closes all the registered result sinks and unregisters them.
+ *
+ * @param pResultData the result data with the system-wide results
+ * @return error information
+ */
+KpfaError_t
+KpfaCloseResultSinks(KpfaResultData_t *pResultData) {
+
+	KpfaError_t result = KPFA_SUCCESS;
+
+	std::vector<KpfaResultSinkEntry_t>::iterator iter;
+
+	for(iter = s_rResultSinkList.begin(); iter != s_rResultSinkList.end(); iter++) {
+
+		KpfaError_t error = iter->pSink->Close(pResultData);
+
+		if(error != KPFA_SUCCESS) {
+			result = error;
+		}
+
+		if(iter->bOwned == TRUE) {
+			delete iter->pSink;
+		}
+	}
+
+	s_rResultSinkList.clear();
+
+	return result;
+}
+
+////////////////////////////////////////////////////////
+// Text format of the result data
+////////////////////////////////////////////////////////
+
+void
+KpfaPrintFactsCtg(FILE *fp, int nIndex, KpfaFactsCtg_t *pFactsCtg) {
+
+	fprintf(fp, "facts ctg[id - %d, status - %d, name - %s] ===\n", nIndex, pFactsCtg->nStatus, pFactsCtg->rName);
+
+	for(int j = 0; j < pFactsCtg->nSize; j++) {
+
+		fprintf(fp, "\tBus ID: %d -> %d\n", pFactsCtg->pPrevList[j].nBusId, pFactsCtg->pNextList[j].nBusId);
+		fprintf(fp, "\tVoltage: %6.5f -> %6.5f\n", pFactsCtg->pPrevList[j].nVoltage, pFactsCtg->pNextList[j].nVoltage);
+		fprintf(fp, "\tQGen: %6.5f -> %6.5f\n\n", pFactsCtg->pPrevList[j].nQGen, pFactsCtg->pNextList[j].nQGen);
+	}
+}
+
+void
+KpfaPrintGvCtg(FILE *fp, KpfaGvCtg_t *pGvCtg) {
+
+	fprintf(fp, "gv ctg[name - %s] ===\n", pGvCtg->rName);
+	fprintf(fp, "gv Margin - %6.5f\n", pGvCtg->nMargin);
+
+	for(int j = 0; j < pGvCtg->nSize; j++) {
+		fprintf(fp, "gv[%d]: GenParam - %6.5f, Voltage - %6.5f\n", j,
+				pGvCtg->pList[j].nGenParam,
+				pGvCtg->pList[j].nVoltage);
+	}
+}
+
+void
+KpfaPrintEqrCtg(FILE *fp, KpfaEqrCtg_t *pEqrCtg) {
+
+	fprintf(fp, "eqr ctg[name - %s] ===\n", pEqrCtg->rName);
+	fprintf(fp, "eqr margin L - %6.5f\n", pEqrCtg->nEqrMarginL);
+	fprintf(fp, "eqr margin C - %6.5f\n", pEqrCtg->nEqrMarginC);
+	fprintf(fp, "cqr value L - %6.5f\n", pEqrCtg->nCqrValueL);
+	fprintf(fp, "cqr value C - %6.5f\n", pEqrCtg->nCqrValueC);
+
+	for(int j = 0; j < pEqrCtg->nSize; j++) {
+		fprintf(fp, "eqr[%d]: Bus ID - %d, EqrValue L - %6.5f, EqrValue C - %6.5f\n", j,
+				pEqrCtg->pList[j].nBusId,
+				pEqrCtg->pList[j].nEqrValueL,
+				pEqrCtg->pList[j].nEqrValueC);
+	}
+}
+
+void
+KpfaPrintBusCtg(FILE *fp, KpfaBusCtg_t *pBusCtg) {
+
+	fprintf(fp, "bus ctg[name - %s] ===\n", pBusCtg->rName);
+
+	for(int j = 0; j < pBusCtg->nSize; j++) {
+
+		fprintf(fp, "bus[%d]: Bus ID - %d, Voltage - %6.5f\n", j,
+					pBusCtg->pList[j].nBusId,
+					pBusCtg->pList[j].nVoltage);
+	}
+}
+
+void
+KpfaPrintBranchCtg(FILE *fp, KpfaBranchCtg_t *pBranchCtg) {
+
+	fprintf(fp, "branch ctg[name - %s] ===\n", pBranchCtg->rName);
+
+	for(int j = 0; j < pBranchCtg->nSize; j++) {
+
+		fprintf(fp, "branch[%d]: Bus ID0 - %d, Bus ID1: %d, Branch Ckt: %d, P: %6.5f, Q1: %6.5f, Q2: %6.5f\n", j,
+					pBranchCtg->pList[j].nStartId,
+					pBranchCtg->pList[j].nEndId,
+					pBranchCtg->pList[j].nCkt,
+					pBranchCtg->pList[j].nFlowValueP,
+					pBranchCtg->pList[j].nFlowValueQ1,
+					pBranchCtg->pList[j].nFlowValueQ2);
+	}
+}
+
+void
+KpfaPrintGeneratorCtg(FILE *fp, KpfaGeneratorCtg_t *pGenCtg) {
+
+	fprintf(fp, "generator ctg[name - %s] ===\n", pGenCtg->rName);
+
+	for(int j = 0; j < pGenCtg->nSize; j++) {
+
+		fprintf(fp, "generator[%d]: Bus ID: %d, Q Gen - %6.5f\n", j,
+					pGenCtg->pList[j].nBusId,
+					pGenCtg->pList[j].nQGen);
+	}
+}
+
+///////////////////////////////////////////////////////////////////
+// Text Result Sink
+///////////////////////////////////////////////////////////////////
+
+KpfaTextResultSink::KpfaTextResultSink(const string &rFilePath) {
+
+	m_rFilePath = rFilePath;
+	m_pFile = NULL;
+}
+
+KpfaTextResultSink::~KpfaTextResultSink() {
+
+	if(m_pFile != NULL && m_pFile != stdout) {
+		fclose(m_pFile);
+	}
+}
+
+/**
+ * This function will open the output file (stdout if no path is given).
+ *
+ * @return error information
+ */
+KpfaError_t
+KpfaTextResultSink::Open() {
+
+	if(m_rFilePath.empty()) {
+		m_pFile = stdout;
+		return KPFA_SUCCESS;
+	}
+
+	m_pFile = fopen(m_rFilePath.c_str(), "w+");
+
+	if(m_pFile == NULL) {
+		cerr << "File Not Open: " << m_rFilePath << endl;
+		return KPFA_ERROR_FILE_OPEN;
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will write the result of a contingency in the text format.
+ *
+ * @param pResult the result of the contingency
+ * @return error information
+ */
+KpfaError_t
+KpfaTextResultSink::Push(KpfaCtgResult_t *pResult) {
+
+	KPFA_CHECK(m_pFile != NULL, KPFA_ERROR_FILE_OPEN);
+
+	FILE *fp = m_pFile;
+
+	fprintf(fp, ">> CTG [id - %d, name - %s] ============\n", pResult->nIndex, pResult->pName);
+
+	fprintf(fp, ">> 1. FACTS ============\n");
+	KpfaPrintFactsCtg(fp, pResult->nIndex, pResult->pFacts);
+
+	fprintf(fp, ">> 2. GV ============\n");
+	KpfaPrintGvCtg(fp, pResult->pGv);
+
+	fprintf(fp, ">> 3. EQR ============\n");
+	fprintf(fp, ">> Prev ==========================\n");
+	KpfaPrintEqrCtg(fp, pResult->pEqr[0]);
+	fprintf(fp, ">> Next ==========================\n");
+	KpfaPrintEqrCtg(fp, pResult->pEqr[1]);
+
+	for(int k = 0; k < 2; k++) {
+
+		if(k == 0) 	fprintf(fp, ">> Prev ==========================\n");
+		else        fprintf(fp, ">> Next ==========================\n");
+
+		fprintf(fp, ">> 5. Powerflow - BUS ============\n");
+		KpfaPrintBusCtg(fp, pResult->pBus[k]);
+
+		fprintf(fp, ">> 5. Powerflow - BRANCH ============\n");
+		KpfaPrintBranchCtg(fp, pResult->pBranch[k]);
+
+		fprintf(fp, ">> 5. Powerflow - GENERATOR ============\n");
+		KpfaPrintGeneratorCtg(fp, pResult->pGenerator[k]);
+	}
+
+	return (ferror(fp) == 0) ? KPFA_SUCCESS : KPFA_ERROR_FILE_WRITE;
+}
+
+/**
+ * This function will write the system-wide results and close the output file.
+ *
+ * @param pResultData the result data with the system-wide results
+ * @return error information
+ */
+KpfaError_t
+KpfaTextResultSink::Close(KpfaResultData_t *pResultData) {
+
+	if(m_pFile == NULL) {
+		return KPFA_SUCCESS;
+	}
+
+	FILE *fp = m_pFile;
+
+	if(pResultData != NULL) {
+
+		fprintf(fp, ">> Final Operating Point ============\n");
+
+		KpfaFactsCtg_t *finalOpPoint = pResultData->pFinalOpFacts;
+
+		if(finalOpPoint) {
+
+			fprintf(fp, "facts ctg[status - %d, name - %s] ===\n", finalOpPoint->nStatus, finalOpPoint->rName);
+
+			for(int j = 0; j < finalOpPoint->nSize; j++) {
+
+				fprintf(fp, "\tBus ID: %d -> %d\n", finalOpPoint->pPrevList[j].nBusId, finalOpPoint->pNextList[j].nBusId);
+				fprintf(fp, "\tVoltage: %6.5f -> %6.5f\n", finalOpPoint->pPrevList[j].nVoltage, finalOpPoint->pNextList[j].nVoltage);
+				fprintf(fp, "\tQGen: %6.5f -> %6.5f\n\n", finalOpPoint->pPrevList[j].nQGen, finalOpPoint->pNextList[j].nQGen);
+			}
+		}
+
+		fprintf(fp, ">> 4. OPF ============\n");
+
+		KpfaOpf_t *opf = &pResultData->hOpf;
+
+		fprintf(fp, "opf: Before Loss - %6.5f, After Loss - %6.5f\n", opf->nLossBefore, opf->nLossAfter);
+	}
+
+	KpfaError_t error = (ferror(fp) == 0) ? KPFA_SUCCESS : KPFA_ERROR_FILE_WRITE;
+
+	if(fp != stdout) {
+		fclose(fp);
+	}
+	else {
+		fflush(fp);
+	}
+
+	m_pFile = NULL;
+
+	return error;
+}
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaTextResultSink::Write(ostream &rOut) {
+
+	rOut << "KPFA TEXT RESULT SINK: " << endl;
+
+	rOut << "\tPATH: " << m_rFilePath << endl;
+}
+
+ostream &operator << (ostream &rOut, KpfaResultSink *pSink) {
+
+	pSink->Write(rOut);
+	return rOut;
+}
+
+///////////////////////////////////////////////////////////////////
+// Binary Result Sink
+///////////////////////////////////////////////////////////////////
+
+/**
+ * Writes a 32-bit value into the binary result stream.
+ */
+static inline void
+WriteBinaryU32(FILE *fp, uint32_t nValue) {
+	fwrite(&nValue, sizeof(uint32_t), 1, fp);
+}
+
+static inline void
+WriteBinaryF32(FILE *fp, float nValue) {
+	fwrite(&nValue, sizeof(float), 1, fp);
+}
+
+/**
+ * Writes an array of result items into the binary result stream.
+ */
+static inline void
+WriteBinaryList(FILE *fp, const void *pList, int nSize, size_t nItemSize) {
+
+	if(pList != NULL && nSize > 0) {
+		fwrite(pList, nItemSize, nSize, fp);
+	}
+}
+
+/**
+ * Reads a 32-bit value from the binary result stream.
+ */
+static inline bool
+ReadBinaryU32(FILE *fp, uint32_t &rValue) {
+	return fread(&rValue, sizeof(uint32_t), 1, fp) == 1;
+}
+
+static inline bool
+ReadBinaryF32(FILE *fp, float &rValue) {
+	return fread(&rValue, sizeof(float), 1, fp) == 1;
+}
+
+/**
+ * Reads an array of result items from the binary result stream into a list
+ * allocated for the results of the current contingency (NULL if no item or
+ * the stream is already broken).
+ */
+static inline void *
+ReadBinaryList(FILE *fp, uint32_t nCount, size_t nItemSize, bool &rValid) {
+
+	if(nCount == 0 || rValid == false) {
+		return NULL;
+	}
+
+	void *list = KpfaAllocCtgResultMemory(g_pResultData, nItemSize * nCount);
+
+	if(list == NULL || fread(list, nItemSize, nCount, fp) != nCount) {
+		rValid = false;
+	}
+
+	return list;
+}
+
+/**
+ * Returns the number of valid items of a result list.
+ */
+#define _COUNT(LIST, SIZE)	(uint32_t)(((LIST) != NULL && (SIZE) > 0) ? (SIZE) : 0)
+
+KpfaBinaryResultSink::KpfaBinaryResultSink(const string &rFilePath) {
+
+	m_rFilePath = rFilePath;
+	m_pFile = NULL;
+}
+
+KpfaBinaryResultSink::~KpfaBinaryResultSink() {
+
+	if(m_pFile != NULL) {
+		fclose(m_pFile);
+	}
+}
+
+/**
+ * This function will open the output file and write the stream header.
+ *
+ * @return error information
+ */
+KpfaError_t
+KpfaBinaryResultSink::Open() {
+
+	KPFA_CHECK(m_rFilePath.empty() == false, KPFA_ERROR_INVALID_ARGUMENT);
+
+	m_pFile = fopen(m_rFilePath.c_str(), "wb");
+
+	if(m_pFile == NULL) {
+		cerr << "File Not Open: " << m_rFilePath << endl;
+		return KPFA_ERROR_FILE_OPEN;
+	}
+
+	WriteBinaryU32(m_pFile, KPFA_BINARY_RESULT_MAGIC);
+	WriteBinaryU32(m_pFile, KPFA_BINARY_RESULT_VERSION);
+
+	return (ferror(m_pFile) == 0) ? KPFA_SUCCESS : KPFA_ERROR_FILE_WRITE;
+}
+
+/**
+ * Writes the result of a contingency as a binary record: scalar values and
+ * item counts first, then the raw item arrays.
+ *
+ * @param fp output file
+ * @param pResult the result of the contingency
+ * @return error information
+ */
+KpfaError_t
+KpfaWriteBinaryResult(FILE *fp, KpfaCtgResult_t *pResult) {
+
+	KPFA_CHECK(fp != NULL && pResult != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	char name[KPFA_MAX_STR_LEN];
+
+	memset(name, 0, sizeof(name));
+	strncpy(name, pResult->pName, KPFA_MAX_STR_LEN - 1);
+
+	KpfaFactsCtg_t *facts = pResult->pFacts;
+	KpfaGvCtg_t *gv = pResult->pGv;
+
+	uint32_t nfacts = _COUNT(facts->pNextList, facts->nSize);
+	uint32_t ngv = _COUNT(gv->pList, gv->nSize);
+
+	// Header
+	WriteBinaryU32(fp, KPFA_BINARY_RESULT_TAG_CTG);
+	WriteBinaryU32(fp, pResult->nIndex);
+	fwrite(name, 1, KPFA_MAX_STR_LEN, fp);
+
+	// Scalar values
+	WriteBinaryU32(fp, (uint32_t)facts->nStatus);
+	WriteBinaryF32(fp, gv->nMargin);
+
+	for(int k = 0; k < 2; k++) {
+
+		KpfaEqrCtg_t *eqr = pResult->pEqr[k];
+
+		WriteBinaryF32(fp, eqr->nCqrValueL);
+		WriteBinaryF32(fp, eqr->nCqrValueC);
+		WriteBinaryF32(fp, eqr->nEqrMarginL);
+		WriteBinaryF32(fp, eqr->nEqrMarginC);
+	}
+
+	// Item counts
+	WriteBinaryU32(fp, nfacts);
+	WriteBinaryU32(fp, ngv);
+
+	for(int k = 0; k < 2; k++) {
+		WriteBinaryU32(fp, _COUNT(pResult->pEqr[k]->pList, pResult->pEqr[k]->nSize));
+		WriteBinaryU32(fp, _COUNT(pResult->pBus[k]->pList, pResult->pBus[k]->nSize));
+		WriteBinaryU32(fp, _COUNT(pResult->pBranch[k]->pList, pResult->pBranch[k]->nSize));
+		WriteBinaryU32(fp, _COUNT(pResult->pGenerator[k]->pList, pResult->pGenerator[k]->nSize));
+	}
+
+	// Item arrays
+	WriteBinaryList(fp, facts->pPrevList, nfacts, sizeof(KpfaFacts_t));
+	WriteBinaryList(fp, facts->pNextList, nfacts, sizeof(KpfaFacts_t));
+	WriteBinaryList(fp, gv->pList, ngv, sizeof(KpfaGv_t));
+
+	for(int k = 0; k < 2; k++) {
+		WriteBinaryList(fp, pResult->pEqr[k]->pList, pResult->pEqr[k]->nSize, sizeof(KpfaEqr_t));
+		WriteBinaryList(fp, pResult->pBus[k]->pList, pResult->pBus[k]->nSize, sizeof(KpfaBus_t));
+		WriteBinaryList(fp, pResult->pBranch[k]->pList, pResult->pBranch[k]->nSize, sizeof(KpfaBranch_t));
+		WriteBinaryList(fp, pResult->pGenerator[k]->pList, pResult->pGenerator[k]->nSize, sizeof(KpfaGenerator_t));
+	}
+
+	return (ferror(fp) == 0) ? KPFA_SUCCESS : KPFA_ERROR_FILE_WRITE;
+}
+
+/**
+ * Reads a binary record written by KpfaWriteBinaryResult into the given result.
+ * The item lists are allocated for the results of the current contingency,
+ * except the FACTS lists which are allocated in advance with the same number
+ * of items.
+ *
+ * @param fp input file
+ * @param pResult output result of the contingency
+ * @return error information
+ */
+KpfaError_t
+KpfaReadBinaryResult(FILE *fp, KpfaCtgResult_t *pResult) {
+
+	KPFA_CHECK(fp != NULL && pResult != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	char name[KPFA_MAX_STR_LEN];
+
+	KpfaFactsCtg_t *facts = pResult->pFacts;
+	KpfaGvCtg_t *gv = pResult->pGv;
+
+	uint32_t tag = 0, status = 0;
+	uint32_t count[10];
+
+	// Header and scalar values
+	bool valid = ReadBinaryU32(fp, tag) && ReadBinaryU32(fp, pResult->nIndex) &&
+				 fread(name, 1, KPFA_MAX_STR_LEN, fp) == KPFA_MAX_STR_LEN &&
+				 ReadBinaryU32(fp, status) && ReadBinaryF32(fp, gv->nMargin);
+
+	for(int k = 0; k < 2; k++) {
+
+		KpfaEqrCtg_t *eqr = pResult->pEqr[k];
+
+		valid = valid && ReadBinaryF32(fp, eqr->nCqrValueL) && ReadBinaryF32(fp, eqr->nCqrValueC) &&
+				ReadBinaryF32(fp, eqr->nEqrMarginL) && ReadBinaryF32(fp, eqr->nEqrMarginC);
+	}
+
+	// Item counts
+	for(int k = 0; k < 10; k++) {
+		valid = valid && ReadBinaryU32(fp, count[k]);
+	}
+
+	uint32_t nfacts = _COUNT(facts->pNextList, facts->nSize);
+
+	if(valid == false || tag != KPFA_BINARY_RESULT_TAG_CTG || count[0] != nfacts) {
+		return KPFA_ERROR_FILE_FORMAT;
+	}
+
+	facts->nStatus = (int)status;
+
+	// Item arrays
+	if(nfacts > 0) {
+		valid = fread(facts->pPrevList, sizeof(KpfaFacts_t), nfacts, fp) == nfacts &&
+				fread(facts->pNextList, sizeof(KpfaFacts_t), nfacts, fp) == nfacts;
+	}
+
+	gv->nSize = count[1];
+	gv->pList = (KpfaGv_t *)ReadBinaryList(fp, count[1], sizeof(KpfaGv_t), valid);
+
+	for(int k = 0; k < 2; k++) {
+
+		uint32_t *kcount = &count[2 + 4 * k];
+
+		pResult->pEqr[k]->nSize = kcount[0];
+		pResult->pEqr[k]->pList = (KpfaEqr_t *)ReadBinaryList(fp, kcount[0], sizeof(KpfaEqr_t), valid);
+
+		pResult->pBus[k]->nSize = kcount[1];
+		pResult->pBus[k]->pList = (KpfaBus_t *)ReadBinaryList(fp, kcount[1], sizeof(KpfaBus_t), valid);
+
+		pResult->pBranch[k]->nSize = kcount[2];
+		pResult->pBranch[k]->pList = (KpfaBranch_t *)ReadBinaryList(fp, kcount[2], sizeof(KpfaBranch_t), valid);
+
+		pResult->pGenerator[k]->nSize = kcount[3];
+		pResult->pGenerator[k]->pList = (KpfaGenerator_t *)ReadBinaryList(fp, kcount[3], sizeof(KpfaGenerator_t), valid);
+	}
+
+	return (valid == true) ? KPFA_SUCCESS : KPFA_ERROR_FILE_FORMAT;
+}
+
+/**
+ * Returns the size of the binary record which KpfaWriteBinaryResult writes for
+ * the result of a contingency.
+ *
+ * @param pResult the result of the contingency
+ * @return size of the record in bytes
+ */
+size_t
+KpfaGetBinaryResultSize(KpfaCtgResult_t *pResult) {
+
+	if(pResult == NULL) {
+		return 0;
+	}
+
+	KpfaFactsCtg_t *facts = pResult->pFacts;
+	KpfaGvCtg_t *gv = pResult->pGv;
+
+	uint32_t nfacts = _COUNT(facts->pNextList, facts->nSize);
+
+	// Header, scalar values and item counts
+	size_t size = sizeof(uint32_t) * 2 + KPFA_MAX_STR_LEN;
+
+	size += sizeof(uint32_t) + sizeof(float) * 9;
+	size += sizeof(uint32_t) * 10;
+
+	// Item arrays
+	size += _COUNT(facts->pPrevList, nfacts) * sizeof(KpfaFacts_t);
+	size += nfacts * sizeof(KpfaFacts_t);
+	size += _COUNT(gv->pList, gv->nSize) * sizeof(KpfaGv_t);
+
+	for(int k = 0; k < 2; k++) {
+		size += _COUNT(pResult->pEqr[k]->pList, pResult->pEqr[k]->nSize) * sizeof(KpfaEqr_t);
+		size += _COUNT(pResult->pBus[k]->pList, pResult->pBus[k]->nSize) * sizeof(KpfaBus_t);
+		size += _COUNT(pResult->pBranch[k]->pList, pResult->pBranch[k]->nSize) * sizeof(KpfaBranch_t);
+		size += _COUNT(pResult->pGenerator[k]->pList, pResult->pGenerator[k]->nSize) * sizeof(KpfaGenerator_t);
+	}
+
+	return size;
+}
+
+/**
+ * This function will write the result of a contingency as a binary record.
+ *
+ * @param pResult the result of the contingency
+ * @return error information
+ */
+KpfaError_t
+KpfaBinaryResultSink::Push(KpfaCtgResult_t *pResult) {
+
+	KPFA_CHECK(m_pFile != NULL, KPFA_ERROR_FILE_OPEN);
+
+	return KpfaWriteBinaryResult(m_pFile, pResult);
+}
+
+/**
+ * This function will write the end record with the system-wide results
+ * and close the output file.
+ *
+ * @param pResultData the result data with the system-wide results
+ * @return error information
+ */
+KpfaError_t
+KpfaBinaryResultSink::Close(KpfaResultData_t *pResultData) {
+
+	if(m_pFile == NULL) {
+		return KPFA_SUCCESS;
+	}
+
+	FILE *fp = m_pFile;
+
+	WriteBinaryU32(fp, KPFA_BINARY_RESULT_TAG_END);
+	WriteBinaryF32(fp, (pResultData != NULL) ? pResultData->hOpf.nLossBefore : 0);
+	WriteBinaryF32(fp, (pResultData != NULL) ? pResultData->hOpf.nLossAfter : 0);
+
+	KpfaError_t error = (ferror(fp) == 0) ? KPFA_SUCCESS : KPFA_ERROR_FILE_WRITE;
+
+	fclose(fp);
+	m_pFile = NULL;
+
+	return error;
+}
+
+#undef _COUNT
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaBinaryResultSink::Write(ostream &rOut) {
+
+	rOut << "KPFA BINARY RESULT SINK: " << endl;
+
+	rOut << "\tPATH: " << m_rFilePath << endl;
+}
@@ -0,0 +1,191 @@
+/*
+ * KpfaResultSink.h
+ */
+
+#ifndef _KPFA_RESULT_SINK_H_
+#define _KPFA_RESULT_SINK_H_
+
+#include "KpfaDebug.h"
+#include "KpfaConfig.h"
+#include "KpfaInterface.h"
+#include "KpfaCtrlDataMgmt.h"
+
+// Magic number and version of the binary result stream
+#define KPFA_BINARY_RESULT_MAGIC		0x5246504B	// "KPFR"
+#define KPFA_BINARY_RESULT_VERSION		1
+
+// Record tags of the binary result stream
+#define KPFA_BINARY_RESULT_TAG_CTG		0x00475443	// "CTG"
+#define KPFA_BINARY_RESULT_TAG_END		0x00444E45	// "END"
+
+/**
+ * The results of a contingency pushed to the result sinks.
+ * Index 0 of the pair lists is the result before the contingency
+ * analysis and index 1 is the result after it.
+ */
+typedef struct {
+	// Contingency index
+	uint32_t nIndex;
+	// Contingency name
+	const char *pName;
+	// FACTS
+	KpfaFactsCtg_t *pFacts;
+	// GV
+	KpfaGvCtg_t *pGv;
+	// EQR
+	KpfaEqrCtg_t *pEqr[2];
+	// Powerflow (BUS, BRANCH, GENERATOR)
+	KpfaBusCtg_t *pBus[2];
+	KpfaBranchCtg_t *pBranch[2];
+	KpfaGeneratorCtg_t *pGenerator[2];
+} KpfaCtgResult_t;
+
+/**
+ * The declaration of the interface class for result sinks
+ */
+class KpfaResultSink {
+
+public:
+
+	KpfaResultSink() {
+		// Do nothing
+	}
+
+	virtual ~KpfaResultSink() {
+		// Do nothing
+	}
+
+	/**
+	 * This function will be called before the first contingency is analyzed.
+	 *
+	 * @return error information
+	 */
+	virtual KpfaError_t Open() = 0;
+
+	/**
+	 * This function will be called as soon as the analysis of a contingency finishes.
+	 * The given result is only valid during the call.
+	 *
+	 * @param pResult the result of the contingency
+	 * @return error information
+	 */
+	virtual KpfaError_t Push(KpfaCtgResult_t *pResult) = 0;
+
+	/**
+	 * This function will be called after all the contingencies are analyzed.
+	 *
+	 * @param pResultData the result data with the system-wide results
+	 * @return error information
+	 */
+	virtual KpfaError_t Close(KpfaResultData_t *pResultData) = 0;
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut) = 0;
+
+	friend ostream &operator << (ostream &rOut, KpfaResultSink *pSink);
+};
+
+/**
+ * The declaration of the class for the result sink in the text format
+ */
+class KpfaTextResultSink: public KpfaResultSink {
+
+private:
+
+	// Output file path
+	string m_rFilePath;
+
+	// Output file
+	FILE *m_pFile;
+
+public:
+
+	KpfaTextResultSink(const string &rFilePath);
+
+	virtual ~KpfaTextResultSink();
+
+	KpfaError_t Open();
+
+	KpfaError_t Push(KpfaCtgResult_t *pResult);
+
+	KpfaError_t Close(KpfaResultData_t *pResultData);
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+};
+
+/**
+ * The declaration of the class for the result sink in a compact binary format.
+ * The stream consists of a header (magic, version) followed by one record
+ * per contingency and an end record with the system-wide results.
+ */
+class KpfaBinaryResultSink: public KpfaResultSink {
+
+private:
+
+	// Output file path
+	string m_rFilePath;
+
+	// Output file
+	FILE *m_pFile;
+
+public:
+
+	KpfaBinaryResultSink(const string &rFilePath);
+
+	virtual ~KpfaBinaryResultSink();
+
+	KpfaError_t Open();
+
+	KpfaError_t Push(KpfaCtgResult_t *pResult);
+
+	KpfaError_t Close(KpfaResultData_t *pResultData);
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+};
+
+////////////////////////////////////////////////////////
+// Function declaration
+////////////////////////////////////////////////////////
+
+void KpfaAttachResultSink(KpfaResultSink *pSink, bool_t bOwned = FALSE);
+
+KpfaError_t KpfaOpenResultSinks(KpfaCtrlDataMgmt *pCtrlDataMgmt);
+
+KpfaError_t KpfaPushResultSinks(KpfaCtgResult_t *pResult);
+
+KpfaError_t KpfaCloseResultSinks(KpfaResultData_t *pResultData);
+
+KpfaError_t KpfaWriteBinaryResult(FILE *fp, KpfaCtgResult_t *pResult);
+
+KpfaError_t KpfaReadBinaryResult(FILE *fp, KpfaCtgResult_t *pResult);
+
+size_t KpfaGetBinaryResultSize(KpfaCtgResult_t *pResult);
+
+////////////////////////////////////////////////////////
+// Text format of the result data
+////////////////////////////////////////////////////////
+
+void KpfaPrintFactsCtg(FILE *fp, int nIndex, KpfaFactsCtg_t *pFactsCtg);
+
+void KpfaPrintGvCtg(FILE *fp, KpfaGvCtg_t *pGvCtg);
+
+void KpfaPrintEqrCtg(FILE *fp, KpfaEqrCtg_t *pEqrCtg);
+
+void KpfaPrintBusCtg(FILE *fp, KpfaBusCtg_t *pBusCtg);
+
+void KpfaPrintBranchCtg(FILE *fp, KpfaBranchCtg_t *pBranchCtg);
+
+void KpfaPrintGeneratorCtg(FILE *fp, KpfaGeneratorCtg_t *pGenCtg);
+
+#endif /* _KPFA_RESULT_SINK_H_ */
@@ -45,56 +45,448 @@ trim(string &s) {
 }
 
 /**
- * This function will separate the given string with the delimiters
- * into a list of the string tokens.
+ * This function will remove small quotes from the given string.
  *
  * @param rString input string
- * @param rToken a list of output string tokens
- * @param rDelimiters delimiters to separate the input string
- * @return the number of output string tokens
+ */
+string &
+KpfaStripQuotes(string &rString) {
+    rString.erase(remove(rString.begin(), rString.end(), '\''), rString.end());
+    return trim(rString);
+}
+
+/**
+ * Checks whether the given character is a white space (locale-independent).
+ */
+static inline bool
+IsSpace(char c) {
+	return (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f');
+}
+
+/**
+ * This function will read the next line of the buffer. The line does not
+ * include the line terminator ("\n" or "\r\n").
+ *
+ * @param rLine view of the line
+ * @return false if there is no more line
+ */
+bool
+KpfaLineReader::GetLine(KpfaStringView_t &rLine) {
+
+	if(m_pCurrent == NULL || m_pCurrent >= m_pEnd) {
+		return false;
+	}
+
+	const char *eol = (const char *)memchr(m_pCurrent, '\n', m_pEnd - m_pCurrent);
+	const char *next = (eol != NULL) ? eol + 1 : m_pEnd;
+
+	if(eol == NULL) {
+		eol = m_pEnd;
+	}
+
+	if(eol > m_pCurrent && eol[-1] == '\r') {
+		eol--;
+	}
+
+	rLine.pData = m_pCurrent;
+	rLine.nSize = eol - m_pCurrent;
+
+	m_pCurrent = next;
+
+	return true;
+}
+
+/**
+ * This function will read the next line of the buffer into the given string.
+ * The string keeps its capacity so that no allocation is required in most cases.
+ *
+ * @param rLine line
+ * @return false if there is no more line
+ */
+bool
+KpfaLineReader::GetLine(string &rLine) {
+
+	KpfaStringView_t line;
+
+	if(GetLine(line) == false) {
+		return false;
+	}
+
+	rLine.assign(line.pData, line.nSize);
+
+	return true;
+}
+
+/**
+ * This function will check whether the given view contains the pattern.
+ *
+ * @param rString input view
+ * @param pPattern pattern to find
+ * @return true if found
+ */
+bool
+KpfaContainsString(const KpfaStringView_t &rString, const char *pPattern) {
+
+	size_t nlen = strlen(pPattern);
+
+	if(nlen == 0) {
+		return true;
+	}
+
+	const char *pos = rString.pData;
+	const char *end = rString.pData + rString.nSize;
+
+	while((size_t)(end - pos) >= nlen) {
+
+		pos = (const char *)memchr(pos, pPattern[0], end - pos - nlen + 1);
+
+		if(pos == NULL) {
+			return false;
+		}
+
+		if(memcmp(pos, pPattern, nlen) == 0) {
+			return true;
+		}
+
+		pos++;
+	}
+
+	return false;
+}
+
+/**
+ * Checks whether the given character is one of the delimiters.
+ */
+static inline bool
+IsDelimiter(char c, const char *pDelimiters) {
+
+	for(const char *d = pDelimiters; *d != '\0'; d++) {
+		if(c == *d) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * This function will separate the given view with the delimiters into an array
+ * of views into the input in a single pass without any copy or allocation.
+ * Empty fields are skipped, a field is cut at the comment character ('/'),
+ * and the white spaces at both of the sides of each token are trimmed.
+ * The delimiters and the comment character between small quotes belong to
+ * the field (e.g. a bus name 'A/B, C'), and the quotes are kept in the token.
+ *
+ * @param rString input view
+ * @param pTokens an array of output views
+ * @param nMaxTokens capacity of the output array
+ * @param pDelimiters delimiters to separate the input view
+ * @return the number of tokens (can exceed the capacity, in which case the extra tokens are not stored)
  */
 uint32_t
-KpfaTokenize(const string &rString, KpfaStringList_t &rTokens, const string &rDelimiters) {
+KpfaTokenizeView(const KpfaStringView_t &rString, KpfaStringView_t *pTokens, uint32_t nMaxTokens, const char *pDelimiters) {
+
+	const char *pos = rString.pData;
+	const char *end = rString.pData + rString.nSize;
+
+	uint32_t nTokens = 0;
+
+	while(pos < end) {
+
+		// Skip delimiters
+		if(IsDelimiter(*pos, pDelimiters)) {
+			pos++;
+			continue;
+		}
+
+		const char *first = pos;
+		const char *comment = NULL;
+		bool quoted = false;
+
+		// Find the end of the field and the comment in it
+		for(; pos < end; pos++) {
+
+			char c = *pos;
+
+			if(comment != NULL) {
+				if(IsDelimiter(c, pDelimiters)) break;
+			}
+			else if(c == '\'') {
+				quoted = !quoted;
+			}
+			else if(quoted == false) {
+				if(IsDelimiter(c, pDelimiters)) break;
+				if(c == '/') comment = pos;
+			}
+		}
 
-    // Skip delimiters at beginning.
-    string::size_type lastPos = rString.find_first_not_of(rDelimiters, 0);
-    // Find first "non-delimiter".
-    string::size_type pos     = rString.find_first_of(rDelimiters, lastPos);
+		// An unmatched quote does not hide the delimiters after it
+		if(quoted == true) {
 
-    // Clear token list
-    rTokens.clear();
+			comment = NULL;
 
-    while (string::npos != pos || string::npos != lastPos) {
+			for(pos = first; pos < end && IsDelimiter(*pos, pDelimiters) == false; pos++) {
+				if(*pos == '/' && comment == NULL) comment = pos;
+			}
+		}
 
-    	string token = rString.substr(lastPos, pos - lastPos);
+		const char *tail = (comment != NULL) ? comment : pos;
 
-    	// Ignore the comment data
-    	string::size_type pos_comment = token.find('/');
+		while(first < tail && IsSpace(*first))		first++;
+		while(tail > first && IsSpace(tail[-1]))	tail--;
 
-    	if(pos_comment != string::npos) {
-    		token = token.substr(0, pos_comment);
-    	}
+		if(nTokens < nMaxTokens) {
+			pTokens[nTokens].pData = first;
+			pTokens[nTokens].nSize = tail - first;
+		}
 
-        // Found a token, add it to the vector.
-    	rTokens.push_back(trim(token));
-        // Skip rDelimiters.  Note the "not_of"
-        lastPos = rString.find_first_not_of(rDelimiters, pos);
-        // Find next "non-delimiter"
-        pos = rString.find_first_of(rDelimiters, lastPos);
-    }
+		nTokens++;
+	}
 
-    return (uint32_t)rTokens.size();
+	return nTokens;
 }
 
 /**
- * This function will remove small quotes from the given string.
+ * This function will check whether the given view is equal to the string.
  *
- * @param rString input string
+ * @param rString input view
+ * @param pValue null-terminated string to compare with
+ * @return true if equal
  */
-string &
-KpfaStripQuotes(string &rString) {
-    rString.erase(remove(rString.begin(), rString.end(), '\''), rString.end());
-    return trim(rString);
+bool
+KpfaEqualString(const KpfaStringView_t &rString, const char *pValue) {
+	return (strncmp(rString.pData, pValue, rString.nSize) == 0 && pValue[rString.nSize] == '\0');
+}
+
+/**
+ * This function will remove small quotes and white spaces at both of the sides of the given view.
+ *
+ * @param rString input view
+ * @return the stripped view
+ */
+KpfaStringView_t &
+KpfaStripQuotesView(KpfaStringView_t &rString) {
+
+	const char *first = rString.pData;
+	const char *last = rString.pData + rString.nSize;
+
+	while(first < last && (IsSpace(*first) || *first == '\''))		first++;
+	while(last > first && (IsSpace(last[-1]) || last[-1] == '\''))	last--;
+
+	rString.pData = first;
+	rString.nSize = last - first;
+
+	return rString;
+}
+
+/**
+ * This function will convert the given view into an integer like atoi.
+ *
+ * @param rString input view
+ * @return integer value (0 if no digits)
+ */
+int32_t
+KpfaParseInt(const KpfaStringView_t &rString) {
+
+	const char *pos = rString.pData;
+	const char *end = rString.pData + rString.nSize;
+
+	while(pos < end && IsSpace(*pos)) {
+		pos++;
+	}
+
+	bool negative = false;
+
+	if(pos < end && (*pos == '-' || *pos == '+')) {
+		negative = (*pos == '-');
+		pos++;
+	}
+
+	int64_t value = 0;
+
+	while(pos < end && *pos >= '0' && *pos <= '9') {
+		value = value * 10 + (*pos - '0');
+		pos++;
+	}
+
+	return (int32_t)(negative ? -value : value);
+}
+
+/**
+ * Converts a null-terminated copy of the given characters with strtod.
+ */
+static double
+ParseDoubleSlow(const char *pBegin, const char *pEnd) {
+
+	char buffer[MAX_BUF_LEN];
+
+	size_t nsize = pEnd - pBegin;
+
+	if(nsize == 0) {
+		return 0;
+	}
+
+	if(nsize >= MAX_BUF_LEN) {
+		string copy(pBegin, nsize);
+		return strtod(copy.c_str(), NULL);
+	}
+
+	memcpy(buffer, pBegin, nsize);
+	buffer[nsize] = '\0';
+
+	return strtod(buffer, NULL);
+}
+
+/**
+ * Powers of ten that are exactly representable as doubles
+ */
+static const double s_rExactPow10[] = {
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+ * This function will convert the given view into a floating-point number like atof.
+ * Decimal numbers with up to 15 significant digits and a small exponent are
+ * converted exactly without strtod. The others fall back to strtod.
+ *
+ * @param rString input view
+ * @return floating-point value (0 if no digits)
+ */
+double
+KpfaParseDouble(const KpfaStringView_t &rString) {
+
+	const char *pos = rString.pData;
+	const char *end = rString.pData + rString.nSize;
+
+	while(pos < end && IsSpace(*pos)) {
+		pos++;
+	}
+
+	const char *start = pos;
+
+	bool negative = false;
+
+	if(pos < end && (*pos == '-' || *pos == '+')) {
+		negative = (*pos == '-');
+		pos++;
+	}
+
+	uint64_t mantissa = 0;
+	int32_t ndigits = 0;
+	int32_t exponent = 0;
+	bool valid = false;
+
+	// Integer part
+	while(pos < end && *pos >= '0' && *pos <= '9') {
+		if(mantissa != 0 || *pos != '0') {
+			mantissa = mantissa * 10 + (*pos - '0');
+			ndigits++;
+		}
+		valid = true;
+		pos++;
+	}
+
+	// Fraction part
+	if(pos < end && *pos == '.') {
+
+		pos++;
+
+		while(pos < end && *pos >= '0' && *pos <= '9') {
+			if(mantissa != 0 || *pos != '0') {
+				mantissa = mantissa * 10 + (*pos - '0');
+				ndigits++;
+			}
+			exponent--;
+			valid = true;
+			pos++;
+		}
+	}
+
+	if(valid == false) {
+		// No digits (or special values such as inf and nan)
+		return ParseDoubleSlow(start, end);
+	}
+
+	// Exponent part
+	if(pos < end && (*pos == 'e' || *pos == 'E')) {
+
+		const char *epos = pos + 1;
+
+		bool eneg = false;
+
+		if(epos < end && (*epos == '-' || *epos == '+')) {
+			eneg = (*epos == '-');
+			epos++;
+		}
+
+		if(epos < end && *epos >= '0' && *epos <= '9') {
+
+			int32_t evalue = 0;
+
+			while(epos < end && *epos >= '0' && *epos <= '9') {
+				if(evalue < 10000) {
+					evalue = evalue * 10 + (*epos - '0');
+				}
+				epos++;
+			}
+
+			exponent += eneg ? -evalue : evalue;
+			pos = epos;
+		}
+	}
+
+	// Hexadecimal numbers
+	if(pos < end && (*pos == 'x' || *pos == 'X')) {
+		return ParseDoubleSlow(start, end);
+	}
+
+	if(mantissa == 0) {
+		return negative ? -0.0 : 0.0;
+	}
+
+	// Exact conversion if both of the mantissa and the power of ten are exact
+	if(ndigits <= 15 && exponent >= -22 && exponent <= 22) {
+
+		double value = (double)mantissa;
+
+		if(exponent < 0)	value /= s_rExactPow10[-exponent];
+		else				value *= s_rExactPow10[exponent];
+
+		return negative ? -value : value;
+	}
+
+	return ParseDoubleSlow(start, end);
+}
+
+/**
+ * This function will return the 64-bit FNV-1a hash of the given data, which is
+ * taken over 8-byte words to be fast enough for a large file.
+ *
+ * @param pData data
+ * @param nSize size of the data
+ * @return hash value
+ */
+uint64_t
+KpfaHashData(const void *pData, size_t nSize) {
+
+	const uint64_t prime = 0x100000001b3ULL;
+
+	const char *data = (const char *)pData;
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	uint64_t word;
+	size_t i;
+
+	for(i = 0; i + sizeof(word) <= nSize; i += sizeof(word)) {
+		memcpy(&word, data + i, sizeof(word));
+		hash = (hash ^ word) * prime;
+	}
+
+	for(; i < nSize; i++) {
+		hash = (hash ^ (uint8_t)data[i]) * prime;
+	}
+
+	return hash;
 }
 
 /**
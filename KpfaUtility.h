@@ -69,14 +69,101 @@ do {                                        \
 #define KPFA_DUMP_DOUBLE_VECTOR(PATH, VEC)	//
 #endif
 
-/**
- * Utility function for parsing the raw data
- */
-extern uint32_t KpfaTokenize(const string &rString, KpfaStringList_t &rTokens, const string &rDelimiters);
-
 /**
  * Utility function for removing the specified character from the given string
  */ 
 extern string& KpfaStripQuotes(string &rString);
 
+/**
+ * A view of a part of a character buffer (not null-terminated)
+ */
+typedef struct {
+
+	const char *pData;
+
+	size_t nSize;
+
+} KpfaStringView_t;
+
+/**
+ * This function will return a view of the whole of the given string.
+ *
+ * @param rString input string
+ * @return view of the string
+ */
+static inline KpfaStringView_t
+KpfaMakeStringView(const string &rString) {
+
+	KpfaStringView_t view = { rString.data(), rString.size() };
+
+	return view;
+}
+
+/**
+ * The declaration of the class for reading the lines of a text buffer
+ * (e.g. a memory-mapped file) as views without any copy
+ */
+class KpfaLineReader {
+
+private:
+
+	// Current position and end of the buffer
+	const char *m_pCurrent;
+	const char *m_pEnd;
+
+public:
+
+	KpfaLineReader(const char *pBegin = NULL, const char *pEnd = NULL) {
+		m_pCurrent = pBegin;
+		m_pEnd = pEnd;
+	}
+
+	/**
+	 * This function will make the reader read the given buffer.
+	 *
+	 * @param pBegin start of the buffer
+	 * @param pEnd end of the buffer
+	 */
+	inline void Assign(const char *pBegin, const char *pEnd) {
+		m_pCurrent = pBegin;
+		m_pEnd = pEnd;
+	}
+
+	/**
+	 * This function will return the start of the next line.
+	 *
+	 * @return current position
+	 */
+	inline const char *GetPosition() {
+		return m_pCurrent;
+	}
+
+	bool GetLine(KpfaStringView_t &rLine);
+
+	bool GetLine(string &rLine);
+};
+
+/**
+ * Utility functions for parsing the raw data without any copy
+ */
+extern bool KpfaContainsString(const KpfaStringView_t &rString, const char *pPattern);
+
+extern uint32_t KpfaTokenizeView(const KpfaStringView_t &rString, KpfaStringView_t *pTokens, uint32_t nMaxTokens, const char *pDelimiters);
+
+extern KpfaStringView_t &KpfaStripQuotesView(KpfaStringView_t &rString);
+
+extern bool KpfaEqualString(const KpfaStringView_t &rString, const char *pValue);
+
+/**
+ * Locale-independent number parsers with the semantics of atoi and atof
+ */
+extern int32_t KpfaParseInt(const KpfaStringView_t &rString);
+
+extern double KpfaParseDouble(const KpfaStringView_t &rString);
+
+/**
+ * Hash function to check whether the contents of a file have been changed
+ */
+extern uint64_t KpfaHashData(const void *pData, size_t nSize);
+
 #endif
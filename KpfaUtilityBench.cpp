@@ -0,0 +1,447 @@
+/*
+ * KpfaUtilityBench.cpp
+ */
+
+/**
+ * Micro-benchmark of the raw data tokenizer. For each section of a raw data
+ * file, it measures the throughput (records per second) of
+ *
+ *   - the string tokenizer used before the string views (KpfaTokenize, kept
+ *     below as it was), which copies each token into a list of strings,
+ *   - KpfaTokenizeView on the same lines, and
+ *   - ParseInput of the sections parsed by the reader, including the creation
+ *     of the raw data in the pool.
+ *
+ * The lines are read from the memory-mapped file once, and only the loops
+ * above are timed (CPU time, single thread). The benchmark is compiled only
+ * with KPFA_ENABLE_UTILITY_BENCH. From the top directory of the source tree:
+ *
+ *   g++ -std=c++11 -O2 -DKPFA_ENABLE_UTILITY_BENCH -I. -Idatamgmt -Idatamgmt/rawdat30 \
+ *       KpfaUtilityBench.cpp KpfaUtility.cpp KpfaMappedFile.cpp KpfaArena.cpp KpfaDebug.cpp \
+ *       datamgmt/KpfaRawData.cpp datamgmt/KpfaRawDataArchive.cpp datamgmt/KpfaRawDataPool.cpp \
+ *       datamgmt/rawdat30/Kpfa*.cpp -lpthread -o KpfaUtilityBench
+ *
+ *   ./KpfaUtilityBench input.raw [repetitions]
+ */
+#ifdef KPFA_ENABLE_UTILITY_BENCH
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "KpfaUtility.h"
+#include "KpfaMappedFile.h"
+#include "KpfaRawDataPool.h"
+#include "KpfaTransformerData.h"
+
+// The number of repetitions if not given
+#define KPFA_BENCH_DEFAULT_REPS		10
+
+// Maximum number of the tokens of a line kept by KpfaTokenizeView
+#define KPFA_BENCH_MAX_TOKENS		64
+
+/**
+ * Sections following the case ID data in the order of the raw data file
+ */
+static const struct {
+
+	KpfaRawDataType_t nDataType;
+
+	const char *pName;
+
+	// Whether the records are parsed by the reader
+	bool bParsed;
+
+} s_rBenchSectionList[] = {
+	{ KPFA_RAW_BUS,					"bus",					true },
+	{ KPFA_RAW_LOAD,				"load",					true },
+#if KPFA_RAW_DATA_VERSION == 33
+	{ KPFA_RAW_FIXED_SHUNT,			"fixed shunt",			true },
+#endif
+	{ KPFA_RAW_GEN,					"generator",			true },
+	{ KPFA_RAW_BRANCH,				"branch",				true },
+	{ KPFA_RAW_TRANSFORMER,			"transformer",			true },
+	{ KPFA_RAW_AREA_INTERCHANGE,	"area",					true },
+	{ KPFA_RAW_TWO_TERM,			"two-terminal dc",		false },
+	{ KPFA_RAW_VSC,					"vsc dc line",			false },
+	{ KPFA_RAW_SWITCHED_SHUNT,		"switched shunt",		true },
+	{ KPFA_RAW_IMP_CORRECT,			"impedance correction",	false },
+	{ KPFA_RAW_MULTI_TERM,			"multi-terminal dc",	false },
+	{ KPFA_RAW_MULTI_SECTION,		"multi-section line",	false },
+	{ KPFA_RAW_ZONE,				"zone",					false },
+	{ KPFA_RAW_AREA_TRANSFER,		"inter-area transfer",	false },
+	{ KPFA_RAW_OWNER,				"owner",				false },
+	{ KPFA_RAW_FACTS,				"facts device",			true },
+};
+
+#define KPFA_NUM_BENCH_SECTIONS	(uint32_t)(sizeof(s_rBenchSectionList) / sizeof(s_rBenchSectionList[0]))
+
+/**
+ * Lines of a section of the raw data file grouped into records
+ */
+typedef struct {
+
+	// Raw data type and name of the section
+	KpfaRawDataType_t nDataType;
+	const char *pName;
+	bool bParsed;
+
+	// All the lines of the section (and their copies for the string tokenizer)
+	std::vector<KpfaStringView_t> rLineList;
+	KpfaStringList_t rStringList;
+
+	// First line of each record and the end of the last record
+	std::vector<uint32_t> rRecordList;
+
+} KpfaBenchSection_t;
+
+/*
+ * The string tokenizer before the string views (KpfaTokenize) and its helpers
+ * as they were, to measure the throughput before the change.
+ */
+static inline string &
+ltrim(string &s) {
+	s.erase(s.begin(), find_if(s.begin(), s.end(), not1(ptr_fun<int, int>(isspace))));
+	return s;
+}
+
+static inline string &
+rtrim(string &s) {
+	s.erase(find_if(s.rbegin(), s.rend(), not1(ptr_fun<int, int>(isspace))).base(), s.end());
+	return s;
+}
+
+static inline string &
+trim(string &s) {
+	return ltrim(rtrim(s));
+}
+
+static uint32_t
+KpfaTokenizeString(const string &rString, KpfaStringList_t &rTokens, const string &rDelimiters) {
+
+    // Skip delimiters at beginning.
+    string::size_type lastPos = rString.find_first_not_of(rDelimiters, 0);
+    // Find first "non-delimiter".
+    string::size_type pos     = rString.find_first_of(rDelimiters, lastPos);
+
+    // Clear token list
+    rTokens.clear();
+
+    while (string::npos != pos || string::npos != lastPos) {
+
+    	string token = rString.substr(lastPos, pos - lastPos);
+
+    	// Ignore the comment data
+    	string::size_type pos_comment = token.find('/');
+
+    	if(pos_comment != string::npos) {
+    		token = token.substr(0, pos_comment);
+    	}
+
+        // Found a token, add it to the vector.
+    	rTokens.push_back(trim(token));
+        // Skip rDelimiters.  Note the "not_of"
+        lastPos = rString.find_first_not_of(rDelimiters, pos);
+        // Find next "non-delimiter"
+        pos = rString.find_first_of(rDelimiters, lastPos);
+    }
+
+    return (uint32_t)rTokens.size();
+}
+
+/**
+ * Checks whether the given line terminates the section.
+ */
+static inline bool
+IsSectionEnd(KpfaRawDataType_t nDataType, const KpfaStringView_t &rLine) {
+
+#if KPFA_RAW_DATA_VERSION == 33
+	if(nDataType == KPFA_RAW_FIXED_SHUNT) {
+		return (rLine.nSize > 0 && rLine.pData[0] == '0');
+	}
+#else
+	(void)nDataType;
+#endif
+
+	return KpfaContainsString(rLine, "0 /");
+}
+
+/**
+ * This function will return the number of lines of the transformer record
+ * starting with the given lines.
+ *
+ * @param pLines lines of the record
+ * @param nLines the number of lines left in the section
+ * @return the number of lines of the record (0 if failed)
+ */
+static uint32_t
+GetTransformerLineCount(const KpfaStringView_t *pLines, uint32_t nLines) {
+
+	KpfaTransformerData transData;
+
+	if(nLines < 2 ||
+	   transData.ParseInput(pLines[0], 0) != KPFA_SUCCESS ||
+	   transData.ParseInput(pLines[1], 1) != KPFA_SUCCESS) {
+		return 0;
+	}
+
+	// Lines #1, #2, the windings and line #4 of a two-winding transformer
+	uint32_t count = 2 + transData.m_nWindingCount;
+
+	if(transData.m_nWindingCount == 1) {
+		count++;
+	}
+
+	return (count <= nLines) ? count : 0;
+}
+
+/**
+ * This function will read the sections of the raw data file into records.
+ *
+ * @param rRawFile line reader for raw file
+ * @param rSectionList list to keep the sections
+ * @return error information
+ */
+static KpfaError_t
+ReadSections(KpfaLineReader &rRawFile, std::vector<KpfaBenchSection_t> &rSectionList) {
+
+	KpfaStringView_t linebuf;
+
+	// Skip the case ID data
+	for(uint32_t i = 0; i < 3; i++) {
+		if(rRawFile.GetLine(linebuf) == false) {
+			return KPFA_ERROR_CASE_READ;
+		}
+	}
+
+	rSectionList.resize(KPFA_NUM_BENCH_SECTIONS);
+
+	for(uint32_t i = 0; i < KPFA_NUM_BENCH_SECTIONS; i++) {
+
+		KpfaBenchSection_t &section = rSectionList[i];
+
+		section.nDataType = s_rBenchSectionList[i].nDataType;
+		section.pName = s_rBenchSectionList[i].pName;
+		section.bParsed = s_rBenchSectionList[i].bParsed;
+
+		while(rRawFile.GetLine(linebuf) && IsSectionEnd(section.nDataType, linebuf) == false) {
+			section.rLineList.push_back(linebuf);
+			section.rStringList.push_back(string(linebuf.pData, linebuf.nSize));
+		}
+
+		uint32_t nLines = (uint32_t)section.rLineList.size();
+
+		for(uint32_t k = 0; k < nLines; ) {
+
+			uint32_t count = 1;
+
+			// Transformers have three or four lines more
+			if(section.nDataType == KPFA_RAW_TRANSFORMER) {
+
+				count = GetTransformerLineCount(&section.rLineList[k], nLines - k);
+
+				if(count == 0) {
+					return KPFA_ERROR_TRANSFORMER_READ;
+				}
+			}
+
+			section.rRecordList.push_back(k);
+
+			k += count;
+		}
+
+		section.rRecordList.push_back(nLines);
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will tokenize all the lines of the given section repeatedly
+ * with the string tokenizer or KpfaTokenizeView.
+ *
+ * @param rSection section of the raw data file
+ * @param nReps the number of repetitions
+ * @param bView true to use KpfaTokenizeView
+ * @return elapsed CPU time in seconds
+ */
+static double
+TimeTokenize(KpfaBenchSection_t &rSection, uint32_t nReps, bool bView) {
+
+	KpfaStringList_t tokenList;
+	KpfaStringView_t tokens[KPFA_BENCH_MAX_TOKENS];
+
+	// Keeps the tokens in use
+	size_t nTotal = 0;
+
+	clock_t start = clock();
+
+	for(uint32_t r = 0; r < nReps; r++) {
+
+		for(uint32_t k = 0; k < rSection.rLineList.size(); k++) {
+
+			if(bView == true) {
+				nTotal += KpfaTokenizeView(rSection.rLineList[k], tokens, KPFA_BENCH_MAX_TOKENS, ",");
+				nTotal += tokens[0].nSize;
+			}
+			else {
+				nTotal += KpfaTokenizeString(rSection.rStringList[k], tokenList, ",");
+				nTotal += tokenList.empty() ? 0 : tokenList[0].size();
+			}
+		}
+	}
+
+	double elapsed = (clock() - start) / (double)CLOCKS_PER_SEC;
+
+	return (nTotal != 0) ? elapsed : 0.0;
+}
+
+/**
+ * This function will parse all the records of the given section repeatedly.
+ *
+ * @param rSection section of the raw data file
+ * @param rPool pool to create the raw data in
+ * @param nReps the number of repetitions
+ * @param rElapsed elapsed CPU time in seconds
+ * @return error information
+ */
+static KpfaError_t
+TimeParseInput(KpfaBenchSection_t &rSection, KpfaRawDataPool &rPool, uint32_t nReps, double &rElapsed) {
+
+	uint32_t nRecords = (uint32_t)rSection.rRecordList.size() - 1;
+
+	rElapsed = 0.0;
+
+	for(uint32_t r = 0; r < nReps; r++) {
+
+		clock_t start = clock();
+
+		for(uint32_t i = 0; i < nRecords; i++) {
+
+			KpfaRawData *rawData = rPool.NewRawData(rSection.nDataType);
+			KPFA_CHECK(rawData != NULL, KPFA_ERROR_MEMORY_ALLOC);
+
+			uint32_t first = rSection.rRecordList[i];
+			uint32_t last = rSection.rRecordList[i + 1];
+
+			for(uint32_t k = first; k < last; k++) {
+
+				KpfaError_t error = rawData->ParseInput(rSection.rLineList[k], k - first);
+				KPFA_CHECK(error == KPFA_SUCCESS, error);
+			}
+		}
+
+		rElapsed += (clock() - start) / (double)CLOCKS_PER_SEC;
+
+		// The destruction is not timed
+		rPool.Release();
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will print out the throughput of the given elapsed time.
+ *
+ * @param nRecords the number of records
+ * @param nReps the number of repetitions
+ * @param nElapsed elapsed CPU time in seconds (not measured if 0)
+ */
+static void
+PrintThroughput(uint32_t nRecords, uint32_t nReps, double nElapsed) {
+
+	if(nElapsed > 0.0) {
+		printf(" %14.0f", nRecords * (double)nReps / nElapsed);
+	}
+	else {
+		printf(" %14s", "-");
+	}
+}
+
+/**
+ * This function will measure the throughput of the given section and print it out.
+ *
+ * @param rSection section of the raw data file
+ * @param rPool pool to create the raw data in
+ * @param nReps the number of repetitions
+ * @return error information
+ */
+static KpfaError_t
+BenchSection(KpfaBenchSection_t &rSection, KpfaRawDataPool &rPool, uint32_t nReps) {
+
+	uint32_t nRecords = (uint32_t)rSection.rRecordList.size() - 1;
+
+	if(nRecords == 0) {
+		return KPFA_SUCCESS;
+	}
+
+	double parse = 0.0;
+
+	if(rSection.bParsed == true) {
+
+		KpfaError_t error = TimeParseInput(rSection, rPool, nReps, parse);
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+	}
+
+	printf("%-24s %10u", rSection.pName, nRecords);
+
+	PrintThroughput(nRecords, nReps, TimeTokenize(rSection, nReps, false));
+	PrintThroughput(nRecords, nReps, TimeTokenize(rSection, nReps, true));
+	PrintThroughput(nRecords, nReps, parse);
+
+	printf("\n");
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * Main function
+ */
+int main(int argc, char **argv) {
+
+	if(argc < 2) {
+		printf("Usage: %s <raw file> [repetitions]\n", argv[0]);
+		return -1;
+	}
+
+	uint32_t nReps = (argc > 2) ? (uint32_t)atoi(argv[2]) : KPFA_BENCH_DEFAULT_REPS;
+
+	KpfaMappedFile rawFile;
+
+	KpfaError_t error = rawFile.Open(argv[1]);
+
+	if(error != KPFA_SUCCESS) {
+		printf("Cannot open the raw data file: %s\n", argv[1]);
+		return -1;
+	}
+
+	KpfaLineReader reader(rawFile.GetData(), rawFile.GetData() + rawFile.GetSize());
+
+	std::vector<KpfaBenchSection_t> sectionList;
+
+	error = ReadSections(reader, sectionList);
+
+	if(error != KPFA_SUCCESS) {
+		printf("Cannot read the raw data file: %d\n", error);
+		return -1;
+	}
+
+	KpfaRawDataPool pool;
+
+	printf("%-24s %10s %14s %14s %14s\n", "records/s", "records", "KpfaTokenize",
+		   "TokenizeView", "ParseInput");
+
+	for(uint32_t i = 0; i < sectionList.size(); i++) {
+
+		error = BenchSection(sectionList[i], pool, nReps);
+
+		if(error != KPFA_SUCCESS) {
+			printf("Cannot parse the %s data: %d\n", sectionList[i].pName, error);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+#endif /* KPFA_ENABLE_UTILITY_BENCH */
@@ -11,73 +11,361 @@
  * This function will be used to initialize all the data structures for adjacency graph.
  */
 KpfaAdjacencyGraph::KpfaAdjacencyGraph() {
-    m_rAdjacencyList.clear();
-    m_rSubgraphTable.clear();
+    m_nMark = 0;
+    m_bBuilt = false;
 }
 
 /**
  * This function will be used to finalize all the data structures for adjacency graph.
  */
 KpfaAdjacencyGraph::~KpfaAdjacencyGraph() {
-    m_rAdjacencyList.clear();
-    m_rSubgraphTable.clear();
+    // Do nothing
 }
 
 /**
- * This function will traverse all the vertices and assign different ID numbers
- * to each of different groups with connected components.
+ * This function will return the vertex index of the given vertex ID.
+ *
+ * @param nId vertex ID
+ * @return vertex index (KPFA_NO_VERTEX if not found)
+ */
+uint32_t
+KpfaAdjacencyGraph::FindVertex(uint32_t nId) {
+
+	KpfaVertexList_t::iterator iter;
+	iter = std::lower_bound(m_rVertexIds.begin(), m_rVertexIds.end(), nId);
+
+	if(iter == m_rVertexIds.end() || *iter != nId) {
+		return KPFA_NO_VERTEX;
+	}
+
+	return (uint32_t)(iter - m_rVertexIds.begin());
+}
+
+/**
+ * This function will build the CSR form of the graph with the inserted edges.
+ * The end points of the edges are sorted by the vertex ID with a radix sort on
+ * the 16-bit halves of the ID, which gives the dense vertex indices in a single
+ * pass over the sorted end points.
+ */
+void
+KpfaAdjacencyGraph::Build() {
+
+	uint32_t i, nedge = (uint32_t)m_rEdgeI.size();
+	uint32_t nend = nedge * 2;
+
+	// End points as the pairs of vertex ID (upper) and end point index (lower)
+	std::vector<uint64_t> ends(nend), sorted(nend);
+
+	for(i = 0; i < nedge; i++) {
+		ends[i * 2] = ((uint64_t)m_rEdgeI[i] << 32) | (i * 2);
+		ends[i * 2 + 1] = ((uint64_t)m_rEdgeJ[i] << 32) | (i * 2 + 1);
+	}
+
+	// Sort the end points by the lower and then the upper half of the vertex ID
+	for(uint32_t shift = 32; shift < 64; shift += 16) {
+
+		KpfaVertexList_t count(0x10001, 0);
+
+		for(i = 0; i < nend; i++) {
+			count[((ends[i] >> shift) & 0xFFFF) + 1]++;
+		}
+
+		for(i = 0; i < 0x10000; i++) {
+			count[i + 1] += count[i];
+		}
+
+		for(i = 0; i < nend; i++) {
+			sorted[count[(ends[i] >> shift) & 0xFFFF]++] = ends[i];
+		}
+
+		ends.swap(sorted);
+	}
+
+	// Give the dense indices to the vertex IDs in the sorted order
+	KpfaVertexList_t &endVertex = m_rEndVertex;
+	endVertex.resize(nend);
+
+	m_rVertexIds.clear();
+
+	for(i = 0; i < nend; i++) {
+
+		uint32_t id = (uint32_t)(ends[i] >> 32);
+
+		if(m_rVertexIds.empty() || m_rVertexIds.back() != id) {
+			m_rVertexIds.push_back(id);
+		}
+
+		endVertex[(uint32_t)ends[i]] = GetVertexCount() - 1;
+	}
+
+	uint32_t nvertex = GetVertexCount();
+
+	// Count the neighbors of each vertex, then place them
+	m_rOffsets.assign(nvertex + 1, 0);
+
+	for(i = 0; i < nend; i++) {
+		m_rOffsets[endVertex[i] + 1]++;
+	}
+
+	for(i = 0; i < nvertex; i++) {
+		m_rOffsets[i + 1] += m_rOffsets[i];
+	}
+
+	// The vertex at the other end of the end point i is at i ^ 1
+	KpfaVertexList_t next(m_rOffsets.begin(), m_rOffsets.end() - 1);
+
+	m_rAdjacency.resize(nend);
+	m_rAdjacencyEdge.resize(nend);
+
+	for(i = 0; i < nend; i++) {
+		uint32_t slot = next[endVertex[i]]++;
+		m_rAdjacency[slot] = endVertex[i ^ 1];
+		m_rAdjacencyEdge[slot] = i / 2;
+	}
+
+	m_rMarkList.assign(nvertex, 0);
+	m_nMark = 0;
+
+	m_bBuilt = true;
+}
+
+/**
+ * This function will remove all the edges.
+ */
+void
+KpfaAdjacencyGraph::Clear() {
+
+	m_rEdgeI.clear();
+	m_rEdgeJ.clear();
+	m_rVertexIds.clear();
+	m_rOffsets.clear();
+	m_rAdjacency.clear();
+	m_rAdjacencyEdge.clear();
+	m_rEndVertex.clear();
+	m_rSubgraphList.clear();
+	m_rMarkList.clear();
+
+	m_nMark = 0;
+	m_bBuilt = false;
+}
+
+/**
+ * This function will assign different ID numbers to each of different groups
+ * with connected components. The components are found with a union-find over
+ * the edges, and numbered in the order of their smallest vertex ID.
  *
  * @param nSubgraphCount the number of subgraphs
- * @return a table with the entries of vertex ID and subgraph ID
+ * @param pEdgeOut flags of the edges to be left out (NULL if all the edges are used)
+ * @return a list of subgraph IDs indexed by the vertex index
  */
-KpfaVertexTable_t &
-KpfaAdjacencyGraph::SplitSubgraphs(uint32_t &nSubgraphCount) {
+KpfaVertexList_t &
+KpfaAdjacencyGraph::SplitSubgraphs(uint32_t &nSubgraphCount, const KpfaEdgeFlagList_t *pEdgeOut) {
 
-	nSubgraphCount = 0;
-	m_rSubgraphTable.clear();
-	KpfaVertexSetTable_t::iterator iter;
+	if(m_bBuilt == false) {
+		Build();
+	}
+
+	uint32_t i, nvertex = GetVertexCount();
+
+	// Each vertex starts as the root of its own set
+	KpfaVertexList_t parent(nvertex);
+
+	for(i = 0; i < nvertex; i++) {
+		parent[i] = i;
+	}
+
+	// Join both ends of each edge, halving the paths while finding the roots
+	for(i = 0; i < nvertex; i++) {
+		for(uint32_t e = m_rOffsets[i]; e < m_rOffsets[i + 1]; e++) {
+
+			uint32_t a = i, b = m_rAdjacency[e];
+
+			// Each edge is kept for both ends
+			if(b <= a) continue;
 
-	// Traverse each vertex with DFS and split subgraphs
-	for(iter = m_rAdjacencyList.begin(); iter != m_rAdjacencyList.end(); iter++) {
-		if(m_rSubgraphTable.count(iter->first) == 0) {
-			TraverseDFS(iter->first, nSubgraphCount++);
+			if(pEdgeOut != NULL && (*pEdgeOut)[m_rAdjacencyEdge[e]] != 0) continue;
+
+			while(parent[a] != a) a = parent[a] = parent[parent[a]];
+			while(parent[b] != b) b = parent[b] = parent[parent[b]];
+
+			// The smaller index becomes the root
+			if(a < b) parent[b] = a;
+			else if(b < a) parent[a] = b;
 		}
 	}
 
-	return m_rSubgraphTable;
+	// Number the sets in the order of the vertex IDs. The parent of a vertex is
+	// never larger than the vertex, so it has been numbered already.
+	nSubgraphCount = 0;
+	m_rSubgraphList.resize(nvertex);
+
+	for(i = 0; i < nvertex; i++) {
+		m_rSubgraphList[i] = (parent[i] == i) ? nSubgraphCount++ : m_rSubgraphList[parent[i]];
+	}
+
+	return m_rSubgraphList;
 }
 
 /**
- * This function will traverse the vertex with the given ID and its connected vertices
- * and assign the given subgraph ID to all of them.
+ * This function will find the bridges, the edges whose removal splits the
+ * connected component containing them, with the Tarjan's algorithm. The depth
+ * first search keeps its own stack instead of recursing.
  *
- * @param nId the current vertex ID
- * @param nSubgraphId the curret subgraph ID
- * @return if any vertex is newly included into the current subgraph
+ * @param rEdgeOut flags of the edges to be left out
+ * @param rBridges output flags of the bridges
  */
-bool 
-KpfaAdjacencyGraph::TraverseDFS(uint32_t nId, uint32_t nSubgraphId) {
+void
+KpfaAdjacencyGraph::FindBridges(const KpfaEdgeFlagList_t &rEdgeOut, KpfaEdgeFlagList_t &rBridges) {
 
-  uint32_t ntraversed = 0;
+	if(m_bBuilt == false) {
+		Build();
+	}
 
-  // If there is no vertex with the given ID, finish to traverse.
-  if(m_rAdjacencyList.count(nId) == 0)	return false;
+	uint32_t nvertex = GetVertexCount();
+	uint32_t order = 0;
 
-  // If the vertex with the given ID is already traversed, finish to traverse.
-  // Otherwise traverse the vertex and assign the current subgraph ID.
-  if(m_rSubgraphTable.count(nId) == 0)	m_rSubgraphTable[nId] = nSubgraphId;
-  else return false;
+	rBridges.assign(GetEdgeCount(), 0);
 
-  // For all of the sub-vertices,
-  KpfaVertexSet_t::iterator iter;
-  KpfaVertexSet_t &vset = m_rAdjacencyList[nId];
+	// Discovery order and the lowest order reachable with a back edge
+	KpfaVertexList_t disc(nvertex, KPFA_NO_VERTEX);
+	KpfaVertexList_t low(nvertex, 0);
 
-  for(iter = vset.begin(); iter != vset.end(); iter++) {
-    // Traverse sub-vertices recursively
-    if(TraverseDFS(*iter, nSubgraphId)) ntraversed++;
-  }
+	// Stack of the vertices, the edges from their parents and the next neighbors
+	KpfaVertexList_t stackVertex, stackEdge, stackNext;
+
+	for(uint32_t root = 0; root < nvertex; root++) {
+
+		if(disc[root] != KPFA_NO_VERTEX) continue;
+
+		disc[root] = low[root] = order++;
+		stackVertex.push_back(root);
+		stackEdge.push_back(KPFA_NO_VERTEX);
+		stackNext.push_back(m_rOffsets[root]);
+
+		while(stackVertex.empty() == false) {
+
+			uint32_t v = stackVertex.back();
+			uint32_t &next = stackNext.back();
+
+			if(next < m_rOffsets[v + 1]) {
+
+				uint32_t slot = next++;
+				uint32_t e = m_rAdjacencyEdge[slot];
+				uint32_t w = m_rAdjacency[slot];
+
+				// Skip the edges out of service and the edge to the parent
+				if(rEdgeOut[e] != 0 || e == stackEdge.back()) continue;
+
+				if(disc[w] == KPFA_NO_VERTEX) {
+					disc[w] = low[w] = order++;
+					stackVertex.push_back(w);
+					stackEdge.push_back(e);
+					stackNext.push_back(m_rOffsets[w]);
+				}
+				else if(disc[w] < low[v]) {
+					low[v] = disc[w];
+				}
+				continue;
+			}
+
+			// All the neighbors are visited, so return to the parent
+			uint32_t e = stackEdge.back();
+
+			stackVertex.pop_back();
+			stackEdge.pop_back();
+			stackNext.pop_back();
+
+			if(e == KPFA_NO_VERTEX) continue;
+
+			uint32_t p = stackVertex.back();
+
+			if(low[v] < low[p]) {
+				low[p] = low[v];
+			}
+
+			if(low[v] > disc[p]) {
+				rBridges[e] = 1;
+			}
+		}
+	}
+}
+
+/**
+ * This function will check whether the given vertices are connected without the
+ * edges out of service. The breadth first search runs from both vertices and
+ * always extends the side which has visited fewer vertices, so it stops after
+ * visiting about twice the smaller side if the vertices are not connected, or
+ * the neighborhood of the shortest path if they are.
+ *
+ * @param nI 1'st vertex index
+ * @param nJ 2'nd vertex index
+ * @param rEdgeOut flags of the edges to be left out
+ * @return true if connected
+ */
+bool
+KpfaAdjacencyGraph::IsConnected(uint32_t nI, uint32_t nJ, const KpfaEdgeFlagList_t &rEdgeOut) {
+
+	if(m_bBuilt == false) {
+		Build();
+	}
+
+	if(nI == nJ) {
+		return true;
+	}
+
+	// Marks of both sides
+	uint32_t mark[2];
+	mark[0] = NextMark();
+	mark[1] = NextMark();
+
+	KpfaVertexList_t queue[2];
+	size_t head[2] = {0, 0};
+
+	queue[0].push_back(nI);
+	queue[1].push_back(nJ);
+	m_rMarkList[nI] = mark[0];
+	m_rMarkList[nJ] = mark[1];
+
+	while(head[0] < queue[0].size() && head[1] < queue[1].size()) {
+
+		uint32_t side = (queue[0].size() <= queue[1].size()) ? 0 : 1;
+		uint32_t v = queue[side][head[side]++];
+
+		for(uint32_t slot = m_rOffsets[v]; slot < m_rOffsets[v + 1]; slot++) {
 
-  return (ntraversed> 0);
+			if(rEdgeOut[m_rAdjacencyEdge[slot]] != 0) continue;
+
+			uint32_t w = m_rAdjacency[slot];
+
+			if(m_rMarkList[w] == mark[side ^ 1]) {
+				return true;
+			}
+
+			if(m_rMarkList[w] != mark[side]) {
+				m_rMarkList[w] = mark[side];
+				queue[side].push_back(w);
+			}
+		}
+	}
+
+	return false;
+}
+
+/**
+ * This function will return a new mark of the visited vertices. All the marks
+ * are cleared when the marks wrap around.
+ *
+ * @return new mark
+ */
+uint32_t
+KpfaAdjacencyGraph::NextMark() {
+
+	if(++m_nMark == 0) {
+		std::fill(m_rMarkList.begin(), m_rMarkList.end(), 0);
+		m_nMark = 1;
+	}
+
+	return m_nMark;
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -87,18 +375,16 @@ KpfaAdjacencyGraph::TraverseDFS(uint32_t nId, uint32_t nSubgraphId) {
 void
 KpfaAdjacencyGraph::Write(ostream &rOut) {
 
-  KpfaVertexSet_t::iterator viter;
-  KpfaVertexSetTable_t::iterator siter;
-
-  for(siter = m_rAdjacencyList.begin(); siter != m_rAdjacencyList.end(); siter++) {
+  uint32_t i, e;
 
-    KpfaVertexSet_t &vset = siter->second;
+  for(i = 0; i < GetVertexCount() && i + 1 < m_rOffsets.size(); i++) {
 
-    rOut << "Adjacent Table Entry[" << m_rSubgraphTable[siter->first];
-    rOut << ", " << siter->first << "]: ";
+    rOut << "Adjacent Table Entry[";
+    rOut << ((i < m_rSubgraphList.size()) ? m_rSubgraphList[i] : 0);
+    rOut << ", " << m_rVertexIds[i] << "]: ";
 
-    for(viter = vset.begin(); viter != vset.end(); viter++) {
-      rOut << *viter << "/";
+    for(e = m_rOffsets[i]; e < m_rOffsets[i + 1]; e++) {
+      rOut << m_rVertexIds[m_rAdjacency[e]] << "/";
     }
 
     rOut << endl;
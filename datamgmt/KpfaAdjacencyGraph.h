@@ -8,24 +8,58 @@
 #ifndef _KPFA_ADJACENCY_GRAPH_H_
 #define _KPFA_ADJACENCY_GRAPH_H_
 
+#include <algorithm>
+
 #include "KpfaDebug.h"
 
-typedef set<uint32_t> KpfaVertexSet_t;
-typedef map<uint32_t, uint32_t> KpfaVertexTable_t;
-typedef map<uint32_t, KpfaVertexSet_t> KpfaVertexSetTable_t;
+// Index of a vertex that is not in the graph
+#define KPFA_NO_VERTEX	0xFFFFFFFF
+
+typedef std::vector<uint32_t> KpfaVertexList_t;
+
+// Flag of each edge (e.g. out of service, bridge)
+typedef std::vector<uint8_t> KpfaEdgeFlagList_t;
 
 /**
- * The declaration of the class for Raw Data Management
+ * The declaration of the class for the adjacency graph of the buses.
+ * The edges are collected first, and then the graph is built in the compressed
+ * sparse row (CSR) form: the vertex IDs are sorted into dense vertex indices, and
+ * the neighbors of the vertex i are kept in m_rAdjacency from m_rOffsets[i] to
+ * m_rOffsets[i + 1]. None of the functions recurse, so long radial feeders
+ * cannot overflow the stack. The edges are identified by the order of AddEdge,
+ * and the functions checking the connectivity take a list of flags to leave
+ * out the edges which are out of service.
  */
 class KpfaAdjacencyGraph {
 
 private:
 
-    // adjacency lists
-    KpfaVertexSetTable_t m_rAdjacencyList;
+	// Both vertex IDs of the edges
+	KpfaVertexList_t m_rEdgeI;
+	KpfaVertexList_t m_rEdgeJ;
+
+	// Sorted vertex IDs (indexed by the vertex index)
+	KpfaVertexList_t m_rVertexIds;
+
+	// Offsets of the neighbors of each vertex (the number of vertices + 1)
+	KpfaVertexList_t m_rOffsets;
+
+	// Vertex indices of the neighbors and the edges to them
+	KpfaVertexList_t m_rAdjacency;
+	KpfaVertexList_t m_rAdjacencyEdge;
 
-    // a list of the pairs of vertex ID and subgraph ID
-    KpfaVertexTable_t m_rSubgraphTable;
+	// Vertex index of both end points of each edge (2 * edge + 0 or 1)
+	KpfaVertexList_t m_rEndVertex;
+
+	// Marks of the visited vertices and the current mark
+	KpfaVertexList_t m_rMarkList;
+	uint32_t m_nMark;
+
+	// Subgraph ID of each vertex (indexed by the vertex index)
+	KpfaVertexList_t m_rSubgraphList;
+
+	// Whether the CSR form is up to date with the edges
+	bool m_bBuilt;
 
 public:
 
@@ -41,11 +75,88 @@ public:
 	 */
 	inline void AddEdge(uint32_t nI, uint32_t nJ) {
 
-		m_rAdjacencyList[nI].insert(nJ);
-		m_rAdjacencyList[nJ].insert(nI);
-	}    
+		m_rEdgeI.push_back(nI);
+		m_rEdgeJ.push_back(nJ);
+		m_bBuilt = false;
+	}
+
+	/**
+	 * This function will return the number of vertices.
+	 *
+	 * @return vertex number
+	 */
+	inline uint32_t GetVertexCount() {
+		return (uint32_t)m_rVertexIds.size();
+	}
+
+	/**
+	 * This function will return the number of edges.
+	 *
+	 * @return edge number
+	 */
+	inline uint32_t GetEdgeCount() {
+		return (uint32_t)m_rEdgeI.size();
+	}
 
-	KpfaVertexTable_t &SplitSubgraphs(uint32_t &nSubgraphCount);
+	/**
+	 * This function will return the vertex index of an end point of the given edge.
+	 * The graph must have been built.
+	 *
+	 * @param nEdge edge index
+	 * @param nEnd 0 for the 1'st vertex, 1 for the 2'nd vertex
+	 * @return vertex index
+	 */
+	inline uint32_t GetEdgeVertex(uint32_t nEdge, uint32_t nEnd) {
+		return m_rEndVertex[nEdge * 2 + nEnd];
+	}
+
+	/**
+	 * This function will return the sorted vertex IDs.
+	 *
+	 * @return vertex ID list
+	 */
+	inline KpfaVertexList_t &GetVertexIds() {
+		return m_rVertexIds;
+	}
+
+	/**
+	 * This function will return the offsets of the neighbors of each vertex.
+	 *
+	 * @return offset list
+	 */
+	inline KpfaVertexList_t &GetOffsets() {
+		return m_rOffsets;
+	}
+
+	/**
+	 * This function will return the vertex indices of the neighbors.
+	 *
+	 * @return adjacency list
+	 */
+	inline KpfaVertexList_t &GetAdjacency() {
+		return m_rAdjacency;
+	}
+
+	/**
+	 * This function will return the edge indices to the neighbors.
+	 *
+	 * @return adjacency edge list
+	 */
+	inline KpfaVertexList_t &GetAdjacencyEdge() {
+		return m_rAdjacencyEdge;
+	}
+
+	uint32_t FindVertex(uint32_t nId);
+
+	void Build();
+
+	void Clear();
+
+	KpfaVertexList_t &SplitSubgraphs(uint32_t &nSubgraphCount, const KpfaEdgeFlagList_t *pEdgeOut = NULL);
+
+	void FindBridges(const KpfaEdgeFlagList_t &rEdgeOut, KpfaEdgeFlagList_t &rBridges);
+
+	bool IsConnected(uint32_t nI, uint32_t nJ, const KpfaEdgeFlagList_t &rEdgeOut);
 
 	///////////////////////////////////////////////////////////////////
 	// Debugging Functions
@@ -57,8 +168,11 @@ public:
 
 private:
 
-    bool TraverseDFS(uint32_t nId, uint32_t nSubgraphId);
+	uint32_t NextMark();
+
+	KpfaAdjacencyGraph(const KpfaAdjacencyGraph &);
 
+	KpfaAdjacencyGraph &operator = (const KpfaAdjacencyGraph &);
 };
 
 #endif /* _KPFA_ADJACENCY_GRAPH_H_ */
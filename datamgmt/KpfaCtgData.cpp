@@ -33,6 +33,12 @@ KpfaCtgData::KpfaCtgData(uint32_t nIdx) {
  * This function will be used to finalize all the data structures for contingency data.
  */
 KpfaCtgData::~KpfaCtgData() {
+
+	// The outage data are owned by the contingency data
+	for(uint32_t i = 0; i < m_rOutageDataList.size(); i++) {
+		delete m_rOutageDataList[i];
+	}
+
     m_rOutageDataList.clear();
 }
 
@@ -115,23 +121,23 @@ KpfaError_t
 KpfaCtgData::ReadCtgHeader(ifstream &rCtgFile) {
 
 	string linebuf;
-    KpfaStringList_t tokens;
+    KpfaStringView_t tokens[2];
     
     // Read contingency name
     if(getline(rCtgFile, linebuf).fail() || _NOT_FOUND(KPFA_CTG_TAG_NAME) ||
-       KpfaTokenize(linebuf, tokens, "=") != 2) {
+       KpfaTokenizeView(KpfaMakeStringView(linebuf), tokens, 2, "=") != 2) {
         return KPFA_ERROR_CTG_NAME_READ;
     }
 
-    m_rName = tokens[1];
+    m_rName.assign(tokens[1].pData, tokens[1].nSize);
     
     // Read contingency status
     if(getline(rCtgFile, linebuf).fail() || _NOT_FOUND(KPFA_CTG_TAG_STATUS) ||
-       KpfaTokenize(linebuf, tokens, "=") != 2) {
+       KpfaTokenizeView(KpfaMakeStringView(linebuf), tokens, 2, "=") != 2) {
         return KPFA_ERROR_CTG_STATUS_READ;
     }
 
-	m_bStatus = (atoi(tokens[1].c_str()) == 1) ? TRUE : FALSE;
+	m_bStatus = (KpfaParseInt(tokens[1]) == 1) ? TRUE : FALSE;
 
     return KPFA_SUCCESS;
 }
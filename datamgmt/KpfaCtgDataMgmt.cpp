@@ -46,9 +46,183 @@ KpfaCtgDataMgmt::ReadCtgDataFile(const char *pFilePath) {
     }
 
 	ctgfile.close();
+
+	m_nNextCtgIndex = 0;
+	return KPFA_SUCCESS;
+}
+
+/**
+* This function will open a file including contingency data on the given path, and
+* start to parse the contingencies on a background thread. The analysis takes the
+* parsed contingencies in batches, and the parse stops while the given number of
+* contingencies are waiting for the analysis to take the next batch.
+*
+* @param pFilePath file path
+* @param nQueueSize maximum number of the parsed contingencies waiting for the analysis
+* @return error information
+*/
+KpfaError_t
+KpfaCtgDataMgmt::OpenCtgDataFile(const char *pFilePath, uint32_t nQueueSize) {
+
+	CloseCtgDataFile();
+
+	m_rCtgFile.clear();
+	m_rCtgFile.open(pFilePath);
+
+	if(!m_rCtgFile.is_open()) {
+		cerr << "File Not Open: " << pFilePath << endl;
+		return KPFA_ERROR_FILE_OPEN;
+	}
+
+	m_bStreaming = true;
+	m_nQueueSize = (nQueueSize > 0) ? nQueueSize : 1;
+	m_bParseEnd = false;
+	m_bParseStop = false;
+	m_nParseError = KPFA_SUCCESS;
+
+	m_rParseThread = std::thread(&KpfaCtgDataMgmt::ParseCtgDataFile, this);
+
 	return KPFA_SUCCESS;
 }
 
+/**
+* This function will be run by the background thread to parse the contingencies
+* one by one into the queue.
+*/
+void
+KpfaCtgDataMgmt::ParseCtgDataFile() {
+
+	bool_t ctgend = FALSE;
+	KpfaError_t error = KPFA_SUCCESS;
+
+	for(uint32_t i = 0; ; i++) {
+
+		KpfaCtgData *ctgData = new KpfaCtgData(i);
+		error = ctgData->ReadCtgData(m_rCtgFile, ctgend);
+
+		if(error != KPFA_SUCCESS || ctgend == TRUE) {
+			delete ctgData;
+			break;
+		}
+
+		std::unique_lock<std::mutex> lock(m_rQueueLock);
+
+		// Wait for the analysis to take the parsed contingencies
+		while(m_rCtgQueue.size() >= m_nQueueSize && m_bParseStop == false) {
+			m_rQueueCond.wait(lock);
+		}
+
+		if(m_bParseStop == true) {
+			delete ctgData;
+			return;
+		}
+
+		m_rCtgQueue.push_back(ctgData);
+
+		// Wake up the analysis only if it may be waiting for the queue
+		if(m_rCtgQueue.size() == 1) {
+			m_rQueueCond.notify_all();
+		}
+	}
+
+	std::lock_guard<std::mutex> guard(m_rQueueLock);
+
+	m_nParseError = error;
+	m_bParseEnd = true;
+	m_rQueueCond.notify_all();
+}
+
+/**
+* This function will return the next contingency in the order of the file. In the
+* streaming mode, it waits for the contingency to be parsed, and the contingency
+* returned before is deleted.
+*
+* @param rCtgData the next contingency (NULL after the last one)
+* @return error information (the parse error after the contingencies parsed before it)
+*/
+KpfaError_t
+KpfaCtgDataMgmt::GetNextCtgData(KpfaCtgData *&rCtgData) {
+
+	rCtgData = NULL;
+
+	if(m_bStreaming == false) {
+
+		if(m_nNextCtgIndex < m_rCtgDataList.size()) {
+			rCtgData = m_rCtgDataList[m_nNextCtgIndex++];
+		}
+
+		return KPFA_SUCCESS;
+	}
+
+	if(m_pCurrentCtg != NULL) {
+		delete m_pCurrentCtg;
+		m_pCurrentCtg = NULL;
+	}
+
+	// Take all the parsed contingencies at once when the batch is used up
+	if(m_rCtgBatch.empty() == true) {
+
+		std::unique_lock<std::mutex> lock(m_rQueueLock);
+
+		while(m_rCtgQueue.empty() == true && m_bParseEnd == false) {
+			m_rQueueCond.wait(lock);
+		}
+
+		if(m_rCtgQueue.empty() == true) {
+			return m_nParseError;
+		}
+
+		m_rCtgBatch.swap(m_rCtgQueue);
+		m_rQueueCond.notify_all();
+	}
+
+	m_pCurrentCtg = m_rCtgBatch.front();
+	m_rCtgBatch.pop_front();
+
+	rCtgData = m_pCurrentCtg;
+	return KPFA_SUCCESS;
+}
+
+/**
+* This function will stop the parse of the streamed contingency file, and delete
+* the contingencies which have not been deleted yet.
+*/
+void
+KpfaCtgDataMgmt::CloseCtgDataFile() {
+
+	if(m_bStreaming == false) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(m_rQueueLock);
+		m_bParseStop = true;
+		m_rQueueCond.notify_all();
+	}
+
+	if(m_rParseThread.joinable()) {
+		m_rParseThread.join();
+	}
+
+	while(m_rCtgQueue.empty() == false) {
+		delete m_rCtgQueue.front();
+		m_rCtgQueue.pop_front();
+	}
+
+	while(m_rCtgBatch.empty() == false) {
+		delete m_rCtgBatch.front();
+		m_rCtgBatch.pop_front();
+	}
+
+	if(m_pCurrentCtg != NULL) {
+		delete m_pCurrentCtg;
+		m_pCurrentCtg = NULL;
+	}
+
+	m_rCtgFile.close();
+	m_bStreaming = false;
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
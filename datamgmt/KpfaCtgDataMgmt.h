@@ -8,10 +8,18 @@
 #ifndef _KPFA_CTG_DATA_MGMT_H_
 #define _KPFA_CTG_DATA_MGMT_H_
 
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
 #include "KpfaDebug.h"
 #include "KpfaConfig.h"
 #include "KpfaCtgData.h"
 
+// The number of contingencies parsed ahead of the analysis in the streaming mode
+#define KPFA_CTG_STREAM_QUEUE_SIZE	64
+
 /**
  * Data type for a list of contingency data
  */
@@ -19,6 +27,12 @@ typedef std::vector<KpfaCtgData *> KpfaCtgDataList_t;
 
 /**
  * The declaration of the class for Contingency Data Management
+ *
+ * The contingency file is either read as a whole into the contingency data list,
+ * or streamed: a background thread parses the contingencies into a bounded queue
+ * while they are analyzed, so that the analysis starts at once and only a few
+ * contingencies are in memory at a time. Both ways give the contingencies in the
+ * order of the file through GetNextCtgData().
  */
 class KpfaCtgDataMgmt {
 
@@ -27,22 +41,76 @@ private:
     // Contingency data list
     KpfaCtgDataList_t m_rCtgDataList;
 
+	// Index of the next contingency in the list
+	uint32_t m_nNextCtgIndex;
+
+	// Whether the contingency file is streamed
+	bool m_bStreaming;
+
+	// Contingency file stream and the thread parsing it
+	ifstream m_rCtgFile;
+	std::thread m_rParseThread;
+
+	// Parsed contingencies waiting for the analysis and the maximum number of them
+	std::deque<KpfaCtgData *> m_rCtgQueue;
+	uint32_t m_nQueueSize;
+
+	// Batch of the contingencies taken by the analysis from the queue
+	std::deque<KpfaCtgData *> m_rCtgBatch;
+
+	// Lock and condition of the queue
+	std::mutex m_rQueueLock;
+	std::condition_variable m_rQueueCond;
+
+	// Whether the parse has ended (or has been stopped) and its result
+	bool m_bParseEnd;
+	bool m_bParseStop;
+	KpfaError_t m_nParseError;
+
+	// Contingency returned last in the streaming mode (deleted on the next call)
+	KpfaCtgData *m_pCurrentCtg;
+
 public:
 
     /**
      * This function will be used to initialize all the data structures for contingency data.
      */
 	KpfaCtgDataMgmt() {
+
 	    m_rCtgDataList.clear();
+		m_nNextCtgIndex = 0;
+
+		m_bStreaming = false;
+		m_nQueueSize = KPFA_CTG_STREAM_QUEUE_SIZE;
+		m_bParseEnd = false;
+		m_bParseStop = false;
+		m_nParseError = KPFA_SUCCESS;
+		m_pCurrentCtg = NULL;
 	}
 
 	/**
 	 * This function will be used to finalize all the data structures for contingency data.
 	 */
 	virtual ~KpfaCtgDataMgmt() {
+
+		CloseCtgDataFile();
+
+		for(uint32_t i = 0; i < m_rCtgDataList.size(); i++) {
+			delete m_rCtgDataList[i];
+		}
+
 	    m_rCtgDataList.clear();
 	}
 
+	/**
+	 * This function will check whether the contingency file is streamed.
+	 *
+	 * @return true if streamed
+	 */
+	inline bool IsStreaming() {
+		return m_bStreaming;
+	}
+
     /**
      * This function will return the number of contingency data
      *
@@ -63,6 +131,12 @@ public:
 
 	KpfaError_t ReadCtgDataFile(const char *pFilePath);
 
+	KpfaError_t OpenCtgDataFile(const char *pFilePath, uint32_t nQueueSize = KPFA_CTG_STREAM_QUEUE_SIZE);
+
+	KpfaError_t GetNextCtgData(KpfaCtgData *&rCtgData);
+
+	void CloseCtgDataFile();
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Functions
 	///////////////////////////////////////////////////////////////////
@@ -70,6 +144,14 @@ public:
 	virtual void Write(ostream &rOut);
 
 	friend ostream &operator << (ostream &rOut, KpfaCtgDataMgmt *pDataMgmt);
+
+private:
+
+	void ParseCtgDataFile();
+
+	KpfaCtgDataMgmt(const KpfaCtgDataMgmt &);
+
+	KpfaCtgDataMgmt &operator = (const KpfaCtgDataMgmt &);
 };
 
 #endif /* _KPFA_CTG_DATA_MGMT_H_ */
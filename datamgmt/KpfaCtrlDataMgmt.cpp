@@ -22,6 +22,26 @@ KpfaCtrlDataMgmt::KpfaCtrlDataMgmt() {
 	m_nIncrement0 = 1;
 	m_nIncrement1 = 1;
 
+	m_nResultSink = KPFA_RESULT_SINK_NONE;
+	m_rResultFilePath = "";
+	m_bRetainResult = TRUE;
+	m_bParallelRead = FALSE;
+	m_rSnapshotFilePath = "";
+	m_bStreamCtg = FALSE;
+	m_bContinueCtg = FALSE;
+	m_rCheckpointFilePath = "";
+	m_nCheckpointInterval = 16;
+	m_bResume = FALSE;
+	m_bParallelGv = FALSE;
+	m_bSearchGv = FALSE;
+	m_nGvResolution = 0.0;
+	m_bIncrementalGv = FALSE;
+	m_bAdaptiveFacts = FALSE;
+	m_nLIndexThreshold = 0.0;
+	m_nModalCount = 0;
+	m_bCurrentInjection = FALSE;
+	m_bEqrCheck = FALSE;
+
 	m_rFactsParamList.clear();
 }
 
@@ -39,11 +59,26 @@ KpfaCtrlDataMgmt::~KpfaCtrlDataMgmt() {
 #define _NOT_FOUND(STR)  (linebuf.find(STR) == string::npos)
 #define _FOUND(STR)		 (linebuf.find(STR) != string::npos)
 
+/**
+ * This function will return the value of the given control line as it is,
+ * since a file path may include '/' which is regarded as a comment by KpfaTokenizeView.
+ *
+ * @param rLine control line
+ * @return value string without surrounding spaces and quotes
+ */
+static string
+GetCtrlPathValue(const string &rLine) {
+
+	string value = rLine.substr(rLine.find('=') + 1);
+
+	return KpfaStripQuotes(value);
+}
+
 KpfaError_t
 KpfaCtrlDataMgmt::ReadCtrlDataFile(const char *pFilePath) {
 
 	string linebuf;
-	KpfaStringList_t tokens;
+	KpfaStringView_t tokens[2];
 
     // open the control file with the given path
 	ifstream ctrlfile(pFilePath);
@@ -64,47 +99,112 @@ KpfaCtrlDataMgmt::ReadCtrlDataFile(const char *pFilePath) {
 
 		// parse each control data item
 		////////////////////////////////////////////////////////
-		if(KpfaTokenize(linebuf, tokens, "=") != 2) {
+		if(KpfaTokenizeView(KpfaMakeStringView(linebuf), tokens, 2, "=") != 2) {
 			return KPFA_ERROR_CONTROL_PARAM_PARSE;
 		}
 
-		if(tokens[0] == KPFA_CTRL_TAG_TAPOP) {
-			m_bAdjustTap = (tokens[1] == "T") ? TRUE : FALSE;
+		if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_TAPOP)) {
+			m_bAdjustTap = KpfaEqualString(tokens[1], "T") ? TRUE : FALSE;
 		}
-		else if(tokens[0] == KPFA_CTRL_TAG_SHUNTOP) {
-			m_bAdjustShunt = (tokens[1] == "T") ? TRUE : FALSE;
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_SHUNTOP)) {
+			m_bAdjustShunt = KpfaEqualString(tokens[1], "T") ? TRUE : FALSE;
 		}
-		else if(tokens[0] == KPFA_CTRL_TAG_FLATSTART) {
-			m_bAdjustShunt = (tokens[1] == "T") ? TRUE : FALSE;
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_FLATSTART)) {
+			m_bAdjustShunt = KpfaEqualString(tokens[1], "T") ? TRUE : FALSE;
 		}
-		else if(tokens[0] == KPFA_CTRL_TAG_HVDCFREQ) {
-			m_nHvdcFreqControl = (uint32_t)atoi(tokens[1].c_str());
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_HVDCFREQ)) {
+			m_nHvdcFreqControl = (uint32_t)KpfaParseInt(tokens[1]);
 		}
-		else if(tokens[0] == KPFA_CTRL_TAG_MAXITER) {
-			m_nMaxIteration = (uint32_t)atoi(tokens[1].c_str());
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_MAXITER)) {
+			m_nMaxIteration = (uint32_t)KpfaParseInt(tokens[1]);
 		}
-		else if(tokens[0] == KPFA_CTRL_TAG_TOLERANCE) {
-			m_nTolerence = atof(tokens[1].c_str());
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_TOLERANCE)) {
+			m_nTolerence = KpfaParseDouble(tokens[1]);
 		}
-		else if(tokens[0] == KPFA_CTRL_TAG_GSTEP) {
-			m_nGstep = atof(tokens[1].c_str());
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_GSTEP)) {
+			m_nGstep = KpfaParseDouble(tokens[1]);
 		}
-		else if(tokens[0] == KPFA_CTRL_TAG_EQRMARGIN_L) {
-			m_nEqrMarginL = atof(tokens[1].c_str());
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_EQRMARGIN_L)) {
+			m_nEqrMarginL = KpfaParseDouble(tokens[1]);
 		}
-		else if(tokens[0] == KPFA_CTRL_TAG_EQRMARGIN_C) {
-			m_nEqrMarginC = atof(tokens[1].c_str());
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_EQRMARGIN_C)) {
+			m_nEqrMarginC = KpfaParseDouble(tokens[1]);
 		}
-		else if(tokens[0] == KPFA_CTRL_TAG_INCREMENT) {
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_INCREMENT)) {
 
-			KpfaStringList_t subtokens;
+			KpfaStringView_t subtokens[2];
 
-			if(KpfaTokenize(tokens[1], subtokens, ",") != 2) {
+			if(KpfaTokenizeView(tokens[1], subtokens, 2, ",") != 2) {
 				return KPFA_ERROR_CONTROL_PARAM_PARSE;
 			}
 
-			m_nIncrement0 = (uint32_t)atoi(subtokens[0].c_str());
-			m_nIncrement1 = (uint32_t)atoi(subtokens[1].c_str());
+			m_nIncrement0 = (uint32_t)KpfaParseInt(subtokens[0]);
+			m_nIncrement1 = (uint32_t)KpfaParseInt(subtokens[1]);
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_RESULTSINK)) {
+
+			if(KpfaEqualString(tokens[1], "TEXT"))			m_nResultSink = KPFA_RESULT_SINK_TEXT;
+			else if(KpfaEqualString(tokens[1], "BINARY"))	m_nResultSink = KPFA_RESULT_SINK_BINARY;
+			else if(KpfaEqualString(tokens[1], "COLUMNAR"))	m_nResultSink = KPFA_RESULT_SINK_COLUMNAR;
+			else if(KpfaEqualString(tokens[1], "NONE"))	m_nResultSink = KPFA_RESULT_SINK_NONE;
+			else return KPFA_ERROR_CONTROL_PARAM_PARSE;
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_RESULTFILE)) {
+			m_rResultFilePath = GetCtrlPathValue(linebuf);
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_RESULTRETAIN)) {
+			m_bRetainResult = KpfaEqualString(tokens[1], "T") ? TRUE : FALSE;
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_PARALLELREAD)) {
+			m_bParallelRead = KpfaEqualString(tokens[1], "T") ? TRUE : FALSE;
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_RAWSNAPSHOT)) {
+			m_rSnapshotFilePath = GetCtrlPathValue(linebuf);
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_CTGSTREAM)) {
+			m_bStreamCtg = KpfaEqualString(tokens[1], "T") ? TRUE : FALSE;
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_CTGFAILURE)) {
+
+			if(KpfaEqualString(tokens[1], "ABORT"))				m_bContinueCtg = FALSE;
+			else if(KpfaEqualString(tokens[1], "CONTINUE"))	m_bContinueCtg = TRUE;
+			else return KPFA_ERROR_CONTROL_PARAM_PARSE;
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_CHECKPOINTFILE)) {
+			m_rCheckpointFilePath = GetCtrlPathValue(linebuf);
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_CHECKPOINTINTERVAL)) {
+			m_nCheckpointInterval = (uint32_t)KpfaParseInt(tokens[1]);
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_RESUME)) {
+			m_bResume = KpfaEqualString(tokens[1], "T") ? TRUE : FALSE;
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_PARALLELGV)) {
+			m_bParallelGv = KpfaEqualString(tokens[1], "T") ? TRUE : FALSE;
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_GVSEARCH)) {
+			m_bSearchGv = KpfaEqualString(tokens[1], "T") ? TRUE : FALSE;
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_GVRESOLUTION)) {
+			m_nGvResolution = KpfaParseDouble(tokens[1]);
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_GVINCREMENTAL)) {
+			m_bIncrementalGv = KpfaEqualString(tokens[1], "T") ? TRUE : FALSE;
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_FACTSADAPTIVE)) {
+			m_bAdaptiveFacts = KpfaEqualString(tokens[1], "T") ? TRUE : FALSE;
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_LINDEXTHRESHOLD)) {
+			m_nLIndexThreshold = KpfaParseDouble(tokens[1]);
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_MODALCOUNT)) {
+			m_nModalCount = (uint32_t)KpfaParseInt(tokens[1]);
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_CURRENTINJECTION)) {
+			m_bCurrentInjection = KpfaEqualString(tokens[1], "T") ? TRUE : FALSE;
+		}
+		else if(KpfaEqualString(tokens[0], KPFA_CTRL_TAG_EQRCHECK)) {
+			m_bEqrCheck = KpfaEqualString(tokens[1], "T") ? TRUE : FALSE;
 		}
 		else {
 			return KPFA_ERROR_CONTROL_UNKNOWN_PARAM;
@@ -150,6 +250,44 @@ KpfaCtrlDataMgmt::Write(ostream &rOut) {
 	rOut << "Increment 0: " << m_nIncrement0 << endl;
 
 	rOut << "Increment 1: " << m_nIncrement1 << endl;
+
+	rOut << "Result sink: " << m_nResultSink << endl;
+
+	rOut << "Result file: " << m_rResultFilePath << endl;
+
+	rOut << "Retain result: " << (uint32_t)m_bRetainResult << endl;
+
+	rOut << "Parallel read: " << (uint32_t)m_bParallelRead << endl;
+
+	rOut << "Raw snapshot: " << m_rSnapshotFilePath << endl;
+
+	rOut << "Stream contingency: " << (uint32_t)m_bStreamCtg << endl;
+
+	rOut << "Continue failed contingency: " << (uint32_t)m_bContinueCtg << endl;
+
+	rOut << "Checkpoint file: " << m_rCheckpointFilePath << endl;
+
+	rOut << "Checkpoint interval: " << m_nCheckpointInterval << endl;
+
+	rOut << "Resume: " << (uint32_t)m_bResume << endl;
+
+	rOut << "Parallel GV: " << (uint32_t)m_bParallelGv << endl;
+
+	rOut << "GV search: " << (uint32_t)m_bSearchGv << endl;
+
+	rOut << "GV resolution: " << m_nGvResolution << endl;
+
+	rOut << "Incremental GV: " << (uint32_t)m_bIncrementalGv << endl;
+
+	rOut << "Adaptive FACTS: " << (uint32_t)m_bAdaptiveFacts << endl;
+
+	rOut << "L-index threshold: " << m_nLIndexThreshold << endl;
+
+	rOut << "Modal count: " << m_nModalCount << endl;
+
+	rOut << "Current injection: " << (uint32_t)m_bCurrentInjection << endl;
+
+	rOut << "EQR check: " << (uint32_t)m_bEqrCheck << endl;
 }
 
 ostream &operator << (ostream &rOut, KpfaCtrlDataMgmt *pDataMgmt) {
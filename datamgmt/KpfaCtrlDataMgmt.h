@@ -28,6 +28,35 @@
 #define KPFA_CTRL_TAG_EQRMARGIN_C  	"EQRMARGIN_C"
 #define KPFA_CTRL_TAG_HVDCFREQ   	"HVDCFREQCONTROL"
 #define KPFA_CTRL_TAG_INCREMENT   	"INCREMENT"
+#define KPFA_CTRL_TAG_RESULTSINK   	"RESULTSINK"
+#define KPFA_CTRL_TAG_RESULTFILE   	"RESULTFILE"
+#define KPFA_CTRL_TAG_RESULTRETAIN 	"RESULTRETAIN"
+#define KPFA_CTRL_TAG_PARALLELREAD 	"PARALLELREAD"
+#define KPFA_CTRL_TAG_RAWSNAPSHOT 	"RAWSNAPSHOT"
+#define KPFA_CTRL_TAG_CTGSTREAM 	"CTGSTREAM"
+#define KPFA_CTRL_TAG_CTGFAILURE 	"CTGFAILURE"
+#define KPFA_CTRL_TAG_CHECKPOINTFILE 	"CHECKPOINTFILE"
+#define KPFA_CTRL_TAG_CHECKPOINTINTERVAL 	"CHECKPOINTINTERVAL"
+#define KPFA_CTRL_TAG_RESUME 		"RESUME"
+#define KPFA_CTRL_TAG_PARALLELGV 	"PARALLELGV"
+#define KPFA_CTRL_TAG_GVSEARCH 		"GVSEARCH"
+#define KPFA_CTRL_TAG_GVRESOLUTION 	"GVRESOLUTION"
+#define KPFA_CTRL_TAG_GVINCREMENTAL 	"GVINCREMENTAL"
+#define KPFA_CTRL_TAG_FACTSADAPTIVE 	"FACTSADAPTIVE"
+#define KPFA_CTRL_TAG_LINDEXTHRESHOLD 	"LINDEXTHRESHOLD"
+#define KPFA_CTRL_TAG_MODALCOUNT 	"MODALCOUNT"
+#define KPFA_CTRL_TAG_CURRENTINJECTION 	"CURRENTINJECTION"
+#define KPFA_CTRL_TAG_EQRCHECK 		"EQRCHECK"
+
+/**
+ * Result sink type
+ */
+typedef enum {
+	KPFA_RESULT_SINK_NONE = 0,
+	KPFA_RESULT_SINK_TEXT,
+	KPFA_RESULT_SINK_BINARY,
+	KPFA_RESULT_SINK_COLUMNAR,
+} KpfaResultSinkType_t;
 
 /**
  * Facts control parameter class
@@ -96,6 +125,63 @@ public:
 	uint32_t m_nIncrement0;
 	uint32_t m_nIncrement1;
 
+	// Result sink type
+	KpfaResultSinkType_t m_nResultSink;
+
+	// Output file path of the result sink
+	string m_rResultFilePath;
+
+	// Retain the results of all contingencies in memory
+	bool_t m_bRetainResult;
+
+	// Parse the sections of the raw data file on several threads
+	bool_t m_bParallelRead;
+
+	// Snapshot file of the parsed raw data (empty if not used)
+	string m_rSnapshotFilePath;
+
+	// Stream the contingency file while analyzing the contingencies
+	bool_t m_bStreamCtg;
+
+	// Record a failed contingency and go on to the next one instead of aborting
+	bool_t m_bContinueCtg;
+
+	// Checkpoint file of the finished contingencies (empty if not used)
+	string m_rCheckpointFilePath;
+
+	// Number of contingencies between the flushes of the checkpoint file
+	uint32_t m_nCheckpointInterval;
+
+	// Skip the contingencies finished in the checkpoint file of a previous run
+	bool_t m_bResume;
+
+	// Sweep the outages of a contingency for GV on several threads
+	bool_t m_bParallelGv;
+
+	// Search the GV collapse point by bisection instead of the G-steps
+	bool_t m_bSearchGv;
+
+	// Margin resolution of the GV search (G-step if not positive)
+	double m_nGvResolution;
+
+	// Resume the GV from the last converged point after each FACTS update
+	bool_t m_bIncrementalGv;
+
+	// Move the FACTS setpoints by the steps estimated from the GV margin
+	bool_t m_bAdaptiveFacts;
+
+	// Skip the GV of a contingency if its maximum L-index is below this (no screening if not positive)
+	double m_nLIndexThreshold;
+
+	// Number of the critical modes of the modal analysis of each contingency (no modal analysis if zero)
+	uint32_t m_nModalCount;
+
+	// Solve the powerflow with the rectangular current injection formulation instead of the polar one
+	bool_t m_bCurrentInjection;
+
+	// Check the EQR of each contingency after the GV against the EQR margins
+	bool_t m_bEqrCheck;
+
 	// Facts Control Parameters
 	std::vector<KpfaFactsParam> m_rFactsParamList;
 
@@ -0,0 +1,253 @@
+/*
+ * KpfaNetworkModel.cpp
+ */
+
+#include "KpfaNetworkModel.h"
+#include "KpfaRawDataMgmt.h"
+
+/**
+ * This function will return the bus index of the given bus ID.
+ *
+ * @param pDataMgmt raw data management
+ * @param nBusId bus ID
+ * @return bus index (KPFA_NETWORK_NO_INDEX if not found)
+ */
+static inline uint32_t
+KpfaGetNetworkBusIndex(KpfaRawDataMgmt *pDataMgmt, uint32_t nBusId) {
+
+	KpfaBusData *bus = pDataMgmt->GetBusData(nBusId);
+	return (bus != NULL) ? bus->m_nIdx : KPFA_NETWORK_NO_INDEX;
+}
+
+KpfaNetworkModel::KpfaNetworkModel() {
+	// Do nothing
+}
+
+/**
+ * This function will build the topology of the network from the given raw data
+ * management, and then copy the values of the raw data.
+ *
+ * @param pDataMgmt raw data management
+ * @return error information
+ */
+KpfaError_t
+KpfaNetworkModel::Build(KpfaRawDataMgmt *pDataMgmt) {
+
+	KPFA_CHECK(pDataMgmt != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	Clear();
+
+	uint32_t i;
+
+	// Bus
+	KpfaRawDataList_t &busList = pDataMgmt->GetBusDataList();
+	uint32_t nbus = (uint32_t)busList.size();
+
+	m_rBus.rIde.resize(nbus);
+	m_rBus.rVm.resize(nbus);
+	m_rBus.rVa.resize(nbus);
+	m_rBus.rPg.resize(nbus);
+	m_rBus.rQg.resize(nbus);
+	m_rBus.rPl.resize(nbus);
+	m_rBus.rQl.resize(nbus);
+	m_rBus.rGl.resize(nbus);
+	m_rBus.rBl.resize(nbus);
+	m_rBus.rId.resize(nbus);
+	m_rBus.rGen.assign(nbus, KPFA_NETWORK_NO_INDEX);
+
+	for(i = 0; i < nbus; i++) {
+		KpfaBusData *bus = (KpfaBusData *)busList[i];
+		KPFA_CHECK(bus->m_nIdx == i, KPFA_ERROR_INVALID_BUS_INDEX);
+		m_rBus.rId[i] = bus->m_nI;
+	}
+
+	// Branch
+	KpfaRawDataList_t &branchList = pDataMgmt->GetBranchDataList();
+	uint32_t nbranch = (uint32_t)branchList.size();
+
+	m_rBranch.rFrom.resize(nbranch);
+	m_rBranch.rTo.resize(nbranch);
+	m_rBranch.rSt.resize(nbranch);
+	m_rBranch.rR.resize(nbranch);
+	m_rBranch.rX.resize(nbranch);
+	m_rBranch.rB.resize(nbranch);
+	m_rBranch.rTap.resize(nbranch);
+
+	for(i = 0; i < nbranch; i++) {
+		KpfaBranchData *branch = (KpfaBranchData *)branchList[i];
+		m_rBranch.rFrom[i] = KpfaGetNetworkBusIndex(pDataMgmt, branch->m_nI);
+		m_rBranch.rTo[i] = KpfaGetNetworkBusIndex(pDataMgmt, branch->m_nJ);
+	}
+
+	// Generator (the last one at a bus is kept as GetGenData does)
+	KpfaRawDataList_t &genList = pDataMgmt->GetGenDataList();
+	uint32_t ngen = (uint32_t)genList.size();
+
+	m_rGen.rBus.resize(ngen);
+	m_rGen.rStat.resize(ngen);
+	m_rGen.rPg.resize(ngen);
+	m_rGen.rQt.resize(ngen);
+	m_rGen.rQb.resize(ngen);
+
+	for(i = 0; i < ngen; i++) {
+		KpfaGenData *gen = (KpfaGenData *)genList[i];
+		uint32_t k = KpfaGetNetworkBusIndex(pDataMgmt, gen->m_nI);
+
+		m_rGen.rBus[i] = k;
+
+		if(k != KPFA_NETWORK_NO_INDEX) {
+			m_rBus.rGen[k] = i;
+		}
+	}
+
+	// Load
+	KpfaRawDataList_t &loadList = pDataMgmt->GetLoadDataList();
+	uint32_t nload = (uint32_t)loadList.size();
+
+	m_rLoad.rBus.resize(nload);
+	m_rLoad.rStatus.resize(nload);
+	m_rLoad.rPl.resize(nload);
+	m_rLoad.rQl.resize(nload);
+
+	for(i = 0; i < nload; i++) {
+		KpfaLoadData *load = (KpfaLoadData *)loadList[i];
+		m_rLoad.rBus[i] = KpfaGetNetworkBusIndex(pDataMgmt, load->m_nI);
+	}
+
+	// Switched Shunt
+	KpfaRawDataList_t &shuntList = pDataMgmt->GetSwitchedShuntDataList();
+	uint32_t nshunt = (uint32_t)shuntList.size();
+
+	m_rShunt.rBus.resize(nshunt);
+	m_rShunt.rBinit.resize(nshunt);
+
+	for(i = 0; i < nshunt; i++) {
+		KpfaSwitchedShuntData *shunt = (KpfaSwitchedShuntData *)shuntList[i];
+		m_rShunt.rBus[i] = KpfaGetNetworkBusIndex(pDataMgmt, shunt->m_nI);
+	}
+
+	return Update(pDataMgmt);
+}
+
+/**
+ * This function will copy the current values of the raw data into the arrays.
+ * The topology must have been built from the same raw data management.
+ *
+ * @param pDataMgmt raw data management
+ * @return error information
+ */
+KpfaError_t
+KpfaNetworkModel::Update(KpfaRawDataMgmt *pDataMgmt) {
+
+	KPFA_CHECK(pDataMgmt != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	uint32_t i;
+
+	// Bus
+	KpfaRawDataList_t &busList = pDataMgmt->GetBusDataList();
+	uint32_t nbus = (uint32_t)busList.size();
+
+	KPFA_CHECK(nbus == GetBusCount(), KPFA_ERROR_INVALID_BUS_INDEX);
+
+	for(i = 0; i < nbus; i++) {
+		KpfaBusData *bus = (KpfaBusData *)busList[i];
+		m_rBus.rIde[i] = (uint8_t)bus->m_nIde;
+		m_rBus.rVm[i] = bus->m_nVm;
+		m_rBus.rVa[i] = bus->m_nVa;
+		m_rBus.rPg[i] = bus->m_nPg;
+		m_rBus.rQg[i] = bus->m_nQg;
+		m_rBus.rPl[i] = bus->m_nPl;
+		m_rBus.rQl[i] = bus->m_nQl;
+		m_rBus.rGl[i] = bus->m_nGl;
+		m_rBus.rBl[i] = bus->m_nBl;
+	}
+
+	// Branch
+	KpfaRawDataList_t &branchList = pDataMgmt->GetBranchDataList();
+	uint32_t nbranch = (uint32_t)branchList.size();
+
+	KPFA_CHECK(nbranch == GetBranchCount(), KPFA_ERROR_INVALID_ARGUMENT);
+
+	for(i = 0; i < nbranch; i++) {
+		KpfaBranchData *branch = (KpfaBranchData *)branchList[i];
+		m_rBranch.rSt[i] = (uint8_t)branch->m_bSt;
+		m_rBranch.rR[i] = branch->m_nR;
+		m_rBranch.rX[i] = branch->m_nX;
+		m_rBranch.rB[i] = branch->m_nB;
+		m_rBranch.rTap[i] = branch->m_nTap;
+	}
+
+	// Generator
+	KpfaRawDataList_t &genList = pDataMgmt->GetGenDataList();
+	uint32_t ngen = (uint32_t)genList.size();
+
+	KPFA_CHECK(ngen == GetGenCount(), KPFA_ERROR_INVALID_ARGUMENT);
+
+	for(i = 0; i < ngen; i++) {
+		KpfaGenData *gen = (KpfaGenData *)genList[i];
+		m_rGen.rStat[i] = (uint8_t)gen->m_bStat;
+		m_rGen.rPg[i] = gen->m_nPg;
+		m_rGen.rQt[i] = gen->m_nQt;
+		m_rGen.rQb[i] = gen->m_nQb;
+	}
+
+	// Load
+	KpfaRawDataList_t &loadList = pDataMgmt->GetLoadDataList();
+	uint32_t nload = (uint32_t)loadList.size();
+
+	KPFA_CHECK(nload == GetLoadCount(), KPFA_ERROR_INVALID_ARGUMENT);
+
+	for(i = 0; i < nload; i++) {
+		KpfaLoadData *load = (KpfaLoadData *)loadList[i];
+		m_rLoad.rStatus[i] = (uint8_t)load->m_bStatus;
+		m_rLoad.rPl[i] = load->m_nPl;
+		m_rLoad.rQl[i] = load->m_nQl;
+	}
+
+	// Switched Shunt
+	KpfaRawDataList_t &shuntList = pDataMgmt->GetSwitchedShuntDataList();
+	uint32_t nshunt = (uint32_t)shuntList.size();
+
+	KPFA_CHECK(nshunt == GetShuntCount(), KPFA_ERROR_INVALID_ARGUMENT);
+
+	for(i = 0; i < nshunt; i++) {
+		KpfaSwitchedShuntData *shunt = (KpfaSwitchedShuntData *)shuntList[i];
+		m_rShunt.rBinit[i] = shunt->m_nBinit;
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will clear all the arrays.
+ */
+void
+KpfaNetworkModel::Clear() {
+
+	m_rBus = KpfaNetworkBus_t();
+	m_rBranch = KpfaNetworkBranch_t();
+	m_rGen = KpfaNetworkGen_t();
+	m_rLoad = KpfaNetworkLoad_t();
+	m_rShunt = KpfaNetworkShunt_t();
+}
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaNetworkModel::Write(ostream &rOut) {
+
+	rOut << "KPFA NETWORK MODEL: " << endl;
+	rOut << "\tBUS: " << GetBusCount() << endl;
+	rOut << "\tBRANCH: " << GetBranchCount() << endl;
+	rOut << "\tGENERATOR: " << GetGenCount() << endl;
+	rOut << "\tLOAD: " << GetLoadCount() << endl;
+	rOut << "\tSWITCHED SHUNT: " << GetShuntCount() << endl;
+}
+
+ostream &operator << (ostream &rOut, KpfaNetworkModel *pModel) {
+
+	pModel->Write(rOut);
+	return rOut;
+}
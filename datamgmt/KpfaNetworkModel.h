@@ -0,0 +1,236 @@
+/*
+ * KpfaNetworkModel.h
+ */
+
+#ifndef _KPFA_NETWORK_MODEL_H_
+#define _KPFA_NETWORK_MODEL_H_
+
+#include <stdint.h>
+
+#include "KpfaDebug.h"
+#include "KpfaConfig.h"
+
+// Index of a bus that is not in the network
+#define KPFA_NETWORK_NO_INDEX	0xFFFFFFFF
+
+class KpfaRawDataMgmt;
+
+/**
+ * Bus arrays indexed by the bus index
+ */
+typedef struct {
+
+	// Hot fields (read in every iteration of the solvers)
+	std::vector<uint8_t> rIde;
+	std::vector<double> rVm;
+	std::vector<double> rVa;
+	std::vector<double> rPg;
+	std::vector<double> rQg;
+	std::vector<double> rPl;
+	std::vector<double> rQl;
+
+	// Cold fields (read once per solution)
+	std::vector<double> rGl;
+	std::vector<double> rBl;
+	std::vector<uint32_t> rId;
+
+	// Index of the generator at the bus (KPFA_NETWORK_NO_INDEX if none)
+	std::vector<uint32_t> rGen;
+
+} KpfaNetworkBus_t;
+
+/**
+ * Branch arrays indexed by the order of the branch data list
+ */
+typedef struct {
+
+	// Bus indices of both ends
+	std::vector<uint32_t> rFrom;
+	std::vector<uint32_t> rTo;
+
+	std::vector<uint8_t> rSt;
+	std::vector<double> rR;
+	std::vector<double> rX;
+	std::vector<double> rB;
+	std::vector<double> rTap;
+
+} KpfaNetworkBranch_t;
+
+/**
+ * Generator arrays indexed by the order of the generator data list
+ */
+typedef struct {
+
+	std::vector<uint32_t> rBus;
+	std::vector<uint8_t> rStat;
+	std::vector<double> rPg;
+	std::vector<double> rQt;
+	std::vector<double> rQb;
+
+} KpfaNetworkGen_t;
+
+/**
+ * Load arrays indexed by the order of the load data list
+ */
+typedef struct {
+
+	std::vector<uint32_t> rBus;
+	std::vector<uint8_t> rStatus;
+	std::vector<double> rPl;
+	std::vector<double> rQl;
+
+} KpfaNetworkLoad_t;
+
+/**
+ * Switched shunt arrays indexed by the order of the switched shunt data list
+ */
+typedef struct {
+
+	std::vector<uint32_t> rBus;
+	std::vector<double> rBinit;
+
+} KpfaNetworkShunt_t;
+
+/**
+ * The declaration of the class for the network model used by the solvers.
+ * The values of the raw data objects are copied into contiguous arrays per
+ * field, and the bus IDs of the branches, generators, loads and shunts are
+ * resolved to bus indices once. The raw data objects stay the owner of the
+ * values; the topology is built once and the values are updated from the
+ * raw data before each solution, since contingencies and modules modify the
+ * raw data between the solutions.
+ */
+class KpfaNetworkModel {
+
+private:
+
+	KpfaNetworkBus_t m_rBus;
+
+	KpfaNetworkBranch_t m_rBranch;
+
+	KpfaNetworkGen_t m_rGen;
+
+	KpfaNetworkLoad_t m_rLoad;
+
+	KpfaNetworkShunt_t m_rShunt;
+
+public:
+
+	KpfaNetworkModel();
+
+	virtual ~KpfaNetworkModel() {
+		// Do nothing
+	}
+
+	/**
+	 * This function will return the bus arrays.
+	 *
+	 * @return bus arrays
+	 */
+	inline KpfaNetworkBus_t &GetBus() {
+		return m_rBus;
+	}
+
+	/**
+	 * This function will return the branch arrays.
+	 *
+	 * @return branch arrays
+	 */
+	inline KpfaNetworkBranch_t &GetBranch() {
+		return m_rBranch;
+	}
+
+	/**
+	 * This function will return the generator arrays.
+	 *
+	 * @return generator arrays
+	 */
+	inline KpfaNetworkGen_t &GetGen() {
+		return m_rGen;
+	}
+
+	/**
+	 * This function will return the load arrays.
+	 *
+	 * @return load arrays
+	 */
+	inline KpfaNetworkLoad_t &GetLoad() {
+		return m_rLoad;
+	}
+
+	/**
+	 * This function will return the switched shunt arrays.
+	 *
+	 * @return switched shunt arrays
+	 */
+	inline KpfaNetworkShunt_t &GetShunt() {
+		return m_rShunt;
+	}
+
+	/**
+	 * This function will return the number of buses.
+	 *
+	 * @return bus number
+	 */
+	inline uint32_t GetBusCount() {
+		return (uint32_t)m_rBus.rId.size();
+	}
+
+	/**
+	 * This function will return the number of branches.
+	 *
+	 * @return branch number
+	 */
+	inline uint32_t GetBranchCount() {
+		return (uint32_t)m_rBranch.rFrom.size();
+	}
+
+	/**
+	 * This function will return the number of generators.
+	 *
+	 * @return generator number
+	 */
+	inline uint32_t GetGenCount() {
+		return (uint32_t)m_rGen.rBus.size();
+	}
+
+	/**
+	 * This function will return the number of loads.
+	 *
+	 * @return load number
+	 */
+	inline uint32_t GetLoadCount() {
+		return (uint32_t)m_rLoad.rBus.size();
+	}
+
+	/**
+	 * This function will return the number of switched shunts.
+	 *
+	 * @return switched shunt number
+	 */
+	inline uint32_t GetShuntCount() {
+		return (uint32_t)m_rShunt.rBus.size();
+	}
+
+	KpfaError_t Build(KpfaRawDataMgmt *pDataMgmt);
+
+	KpfaError_t Update(KpfaRawDataMgmt *pDataMgmt);
+
+	void Clear();
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+
+	friend ostream &operator << (ostream &rOut, KpfaNetworkModel *pModel);
+
+private:
+
+	KpfaNetworkModel(const KpfaNetworkModel &);
+
+	KpfaNetworkModel &operator = (const KpfaNetworkModel &);
+};
+
+#endif /* _KPFA_NETWORK_MODEL_H_ */
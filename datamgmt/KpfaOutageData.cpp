@@ -44,10 +44,10 @@ KpfaError_t
 KpfaOutageData::ParseOutageData(string &rInputString) {
 
     KpfaError_t error;
-    KpfaStringList_t tokens;
 
     // get the outage substring after '=' character
-    string otgstr = rInputString.substr(rInputString.find("=") + 1);
+    string::size_type pos = rInputString.find("=") + 1;
+    KpfaStringView_t otgstr = { rInputString.data() + pos, rInputString.size() - pos };
 
     // check the type of outage
     if(_FOUND(KPFA_OTG_TAG_BUS)) {
@@ -85,10 +85,10 @@ KpfaOutageData::ParseOutageData(string &rInputString) {
 #undef _FOUND
 
 KpfaError_t 
-KpfaOutageData::ParseOutageBus(string &rInputString) {
+KpfaOutageData::ParseOutageBus(const KpfaStringView_t &rInput) {
 
-    KpfaStringList_t tokens;
-    uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+    KpfaStringView_t tokens[KPFA_NUM_OTG_BUS_DATA_ITEMS];
+    uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_OTG_BUS_DATA_ITEMS, ",");
 
     if(nTokens != KPFA_NUM_OTG_BUS_DATA_ITEMS) {
         return KPFA_ERROR_OUTAGE_BUS_PARSE;
@@ -97,17 +97,17 @@ KpfaOutageData::ParseOutageBus(string &rInputString) {
     m_nDataType = KPFA_OUTAGE_BUS;
 
     // Bus ID
-    m_nI = (uint32_t)atoi(tokens[0].c_str());
+    m_nI = (uint32_t)KpfaParseInt(tokens[0]);
         
     return KPFA_SUCCESS;
 }
 
 KpfaError_t 
-KpfaOutageData::ParseOutageBranch(string &rInputString) {
+KpfaOutageData::ParseOutageBranch(const KpfaStringView_t &rInput) {
 
     uint32_t i = 0;
-    KpfaStringList_t tokens;
-    uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+    KpfaStringView_t tokens[KPFA_NUM_OTG_BRANCH_DATA_ITEMS];
+    uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_OTG_BRANCH_DATA_ITEMS, ",");
 
     if(nTokens != KPFA_NUM_OTG_BRANCH_DATA_ITEMS) {
         return KPFA_ERROR_OUTAGE_BRANCH_PARSE;
@@ -116,22 +116,22 @@ KpfaOutageData::ParseOutageBranch(string &rInputString) {
     m_nDataType = KPFA_OUTAGE_BRANCH;
 
     // Branch from bus ID
-    m_nI = (uint32_t)atoi(tokens[i++].c_str());
+    m_nI = (uint32_t)KpfaParseInt(tokens[i++]);
 
     // Branch to bus ID
-    m_nJ = (uint32_t)atoi(tokens[i++].c_str());
+    m_nJ = (uint32_t)KpfaParseInt(tokens[i++]);
 
     // Branch circuit ID
-    m_nCkt = (uint32_t)atoi(KpfaStripQuotes(tokens[i]).c_str());
+    m_nCkt = (uint32_t)KpfaParseInt(KpfaStripQuotesView(tokens[i]));
     
     return KPFA_SUCCESS;
 }
 
 KpfaError_t 
-KpfaOutageData::ParseOutageGenerator(string &rInputString) {
+KpfaOutageData::ParseOutageGenerator(const KpfaStringView_t &rInput) {
 
-    KpfaStringList_t tokens;
-    uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+    KpfaStringView_t tokens[KPFA_NUM_OTG_GEN_DATA_ITEMS];
+    uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_OTG_GEN_DATA_ITEMS, ",");
 
     if(nTokens != KPFA_NUM_OTG_GEN_DATA_ITEMS) {
         return KPFA_ERROR_OUTAGE_GEN_PARSE;
@@ -140,17 +140,17 @@ KpfaOutageData::ParseOutageGenerator(string &rInputString) {
     m_nDataType = KPFA_OUTAGE_GEN;
 
     // Generator bus ID
-    m_nI = (uint32_t)atoi(tokens[0].c_str());
+    m_nI = (uint32_t)KpfaParseInt(tokens[0]);
 
     return KPFA_SUCCESS;
 }
 
 KpfaError_t 
-KpfaOutageData::ParseOutageTransformer(string &rInputString) {
+KpfaOutageData::ParseOutageTransformer(const KpfaStringView_t &rInput) {
 
     uint32_t i = 0;
-    KpfaStringList_t tokens;
-    uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+    KpfaStringView_t tokens[KPFA_NUM_OTG_TRANS_DATA_ITEMS_1];
+    uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_OTG_TRANS_DATA_ITEMS_1, ",");
 
     if(nTokens != KPFA_NUM_OTG_TRANS_DATA_ITEMS_1 &&
        nTokens != KPFA_NUM_OTG_TRANS_DATA_ITEMS_2) {
@@ -160,28 +160,28 @@ KpfaOutageData::ParseOutageTransformer(string &rInputString) {
     m_nDataType = KPFA_OUTAGE_TRANSFORMER;
 
     // Transformer 1st bus ID
-    m_nI = (uint32_t)atoi(tokens[i++].c_str());
+    m_nI = (uint32_t)KpfaParseInt(tokens[i++]);
 
     // Transformer 2nd bus ID
-    m_nJ = (uint32_t)atoi(tokens[i++].c_str());
+    m_nJ = (uint32_t)KpfaParseInt(tokens[i++]);
 
     if(nTokens == KPFA_NUM_OTG_TRANS_DATA_ITEMS_1) {
 
         // Transformer 3rd bus ID
-        m_nK = (uint32_t)atoi(tokens[i++].c_str());
+        m_nK = (uint32_t)KpfaParseInt(tokens[i++]);
     }
 
     // Transformer Circuit ID
-    m_nCkt = (uint32_t)atoi(KpfaStripQuotes(tokens[i]).c_str());
+    m_nCkt = (uint32_t)KpfaParseInt(KpfaStripQuotesView(tokens[i]));
     
     return KPFA_SUCCESS;
 }
 
 KpfaError_t 
-KpfaOutageData::ParseOutageWind(string &rInputString) {
+KpfaOutageData::ParseOutageWind(const KpfaStringView_t &rInput) {
 
-    KpfaStringList_t tokens;
-    uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+    KpfaStringView_t tokens[KPFA_NUM_OTG_WIND_DATA_ITEMS];
+    uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_OTG_WIND_DATA_ITEMS, ",");
 
     if(nTokens != KPFA_NUM_OTG_WIND_DATA_ITEMS) {
         return KPFA_ERROR_OUTAGE_WIND_PARSE;
@@ -190,20 +190,20 @@ KpfaOutageData::ParseOutageWind(string &rInputString) {
     m_nDataType = KPFA_OUTAGE_WIND;
 
     // Wind bus ID
-    m_nI = (uint32_t)atoi(tokens[0].c_str());
+    m_nI = (uint32_t)KpfaParseInt(tokens[0]);
 
     // Wind rate
-    m_nWindRate = atof(tokens[1].c_str());
+    m_nWindRate = KpfaParseDouble(tokens[1]);
 
     return KPFA_SUCCESS;
 }
 
 KpfaError_t 
-KpfaOutageData::ParseOutageHvdc(string &rInputString) {
+KpfaOutageData::ParseOutageHvdc(const KpfaStringView_t &rInput) {
 
     uint32_t i = 0;
-    KpfaStringList_t tokens;
-    uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+    KpfaStringView_t tokens[KPFA_NUM_OTG_HVDC_DATA_ITEMS];
+    uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_OTG_HVDC_DATA_ITEMS, ",");
 
     if(nTokens != KPFA_NUM_OTG_HVDC_DATA_ITEMS) {
         return KPFA_ERROR_OUTAGE_HVDC_PARSE;
@@ -212,10 +212,10 @@ KpfaOutageData::ParseOutageHvdc(string &rInputString) {
     m_nDataType = KPFA_OUTAGE_HVDC;
 
     // HVDC 1st bus ID
-    m_nI = (uint32_t)atoi(tokens[i++].c_str());
+    m_nI = (uint32_t)KpfaParseInt(tokens[i++]);
 
     // HVDC 2nd bus ID
-    m_nJ = (uint32_t)atoi(tokens[i++].c_str());
+    m_nJ = (uint32_t)KpfaParseInt(tokens[i++]);
     
     return KPFA_SUCCESS;
 }
@@ -109,17 +109,17 @@ public:
 
 private:
 
-    KpfaError_t ParseOutageBus(string &rInputString);
+    KpfaError_t ParseOutageBus(const KpfaStringView_t &rInput);
 
-    KpfaError_t ParseOutageBranch(string &rInputString);
+    KpfaError_t ParseOutageBranch(const KpfaStringView_t &rInput);
 
-    KpfaError_t ParseOutageGenerator(string &rInputString);
+    KpfaError_t ParseOutageGenerator(const KpfaStringView_t &rInput);
 
-    KpfaError_t ParseOutageTransformer(string &rInputString);
+    KpfaError_t ParseOutageTransformer(const KpfaStringView_t &rInput);
 
-    KpfaError_t ParseOutageWind(string &rInputString);
+    KpfaError_t ParseOutageWind(const KpfaStringView_t &rInput);
 
-    KpfaError_t ParseOutageHvdc(string &rInputString);    
+    KpfaError_t ParseOutageHvdc(const KpfaStringView_t &rInput);
     
 };
 
@@ -43,12 +43,34 @@ KpfaRawData::~KpfaRawData() {
 	// Do nothing
 }
 
+/**
+ * This function will parse the input line given as a view. The line is copied
+ * into a string for the raw data classes which parse only strings.
+ *
+ * @param rInput a line with the internal information to be parsed
+ * @param nId line number of the record
+ * @return error information
+ */
+KpfaError_t
+KpfaRawData::ParseInput(const KpfaStringView_t &rInput, uint32_t nId) {
+
+	string input(rInput.pData, rInput.nSize);
+
+	return ParseInput(input, nId);
+}
+
 KpfaError_t
 KpfaRawData::TransformUnit(double nSbase) {
 	// Do nothing
 	return KPFA_SUCCESS;
 }
 
+void
+KpfaRawData::Serialize(KpfaRawDataArchive &rArchive) {
+	// Do nothing (no values to archive)
+	(void)rArchive;
+}
+
 ostream &operator << (ostream &rOut, KpfaRawData *pRawData) {
 	pRawData->Write(rOut);
 	return rOut;
@@ -13,6 +13,7 @@
 #include "KpfaDebug.h"
 #include "KpfaConfig.h"
 #include "KpfaUtility.h"
+#include "KpfaRawDataArchive.h"
 
 #define RAW_DATA_INITIALIZED
 
@@ -112,6 +113,8 @@ public:
 	 */
 	virtual KpfaError_t ParseInput(string &rInputString, uint32_t nId) = 0;
 
+	virtual KpfaError_t ParseInput(const KpfaStringView_t &rInput, uint32_t nId);
+
 	/**
 	 * This function will be used to transform the units of the values of the raw data.
 	 *
@@ -120,6 +123,14 @@ public:
 	 */
 	virtual KpfaError_t TransformUnit(double nSbase);
 
+	/**
+	 * This function will be used to store the values of the raw data into the archive
+	 * or load them from it.
+	 *
+	 * @param rArchive archive of the raw data
+	 */
+	virtual void Serialize(KpfaRawDataArchive &rArchive);
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Functions
 	///////////////////////////////////////////////////////////////////
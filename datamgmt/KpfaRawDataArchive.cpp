@@ -0,0 +1,136 @@
+/*
+ * KpfaRawDataArchive.cpp
+ */
+
+#include "KpfaRawDataArchive.h"
+
+/**
+ * This function will create an archive storing the values into the given buffer.
+ *
+ * @param rBuffer buffer to which the values are appended
+ */
+KpfaRawDataArchive::KpfaRawDataArchive(std::vector<char> &rBuffer) {
+
+	m_pBuffer = &rBuffer;
+	m_pCurrent = NULL;
+	m_pEnd = NULL;
+	m_bOverflow = false;
+}
+
+/**
+ * This function will create an archive loading the values from the given memory.
+ *
+ * @param pBegin start of the values
+ * @param pEnd end of the values
+ */
+KpfaRawDataArchive::KpfaRawDataArchive(const char *pBegin, const char *pEnd) {
+
+	m_pBuffer = NULL;
+	m_pCurrent = pBegin;
+	m_pEnd = pEnd;
+	m_bOverflow = false;
+}
+
+/**
+ * This function will store or load the given bytes. If the archive runs out of
+ * the values while loading, the bytes are cleared and the archive becomes invalid.
+ *
+ * @param pData bytes
+ * @param nSize the number of bytes
+ */
+void
+KpfaRawDataArchive::Bytes(void *pData, size_t nSize) {
+
+	if(m_pBuffer != NULL) {
+		m_pBuffer->insert(m_pBuffer->end(), (const char *)pData, (const char *)pData + nSize);
+		return;
+	}
+
+	if(m_bOverflow == true || (size_t)(m_pEnd - m_pCurrent) < nSize) {
+		m_bOverflow = true;
+		memset(pData, 0, nSize);
+		return;
+	}
+
+	memcpy(pData, m_pCurrent, nSize);
+	m_pCurrent += nSize;
+}
+
+/**
+ * This function will store or load a string with its length.
+ *
+ * @param rValue string
+ */
+void
+KpfaRawDataArchive::Field(string &rValue) {
+
+	uint32_t size = (uint32_t)rValue.size();
+
+	Bytes(&size, sizeof(size));
+
+	if(m_pBuffer != NULL) {
+		m_pBuffer->insert(m_pBuffer->end(), rValue.begin(), rValue.end());
+		return;
+	}
+
+	if(m_bOverflow == true || (size_t)(m_pEnd - m_pCurrent) < size) {
+		m_bOverflow = true;
+		rValue.clear();
+		return;
+	}
+
+	rValue.assign(m_pCurrent, size);
+	m_pCurrent += size;
+}
+
+/**
+ * This function will store or load a list of values with its length.
+ *
+ * @param rValue list of values
+ */
+void
+KpfaRawDataArchive::Field(std::vector<double> &rValue) {
+
+	uint32_t size = (uint32_t)rValue.size();
+
+	Bytes(&size, sizeof(size));
+
+	if(m_pBuffer == NULL) {
+
+		if(m_bOverflow == true || (size_t)(m_pEnd - m_pCurrent) / sizeof(double) < size) {
+			m_bOverflow = true;
+			rValue.clear();
+			return;
+		}
+
+		rValue.resize(size);
+	}
+
+	if(size > 0) {
+		Bytes(&rValue[0], sizeof(double) * size);
+	}
+}
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaRawDataArchive::Write(ostream &rOut) {
+
+	rOut << "KPFA RAW DATA ARCHIVE: " << endl;
+
+	if(m_pBuffer != NULL) {
+		rOut << "\tSTORED: " << m_pBuffer->size() << endl;
+	}
+	else {
+		rOut << "\tREMAINING: " << (size_t)(m_pEnd - m_pCurrent) << endl;
+		rOut << "\tVALID: " << IsValid() << endl;
+	}
+}
+
+ostream &operator << (ostream &rOut, KpfaRawDataArchive *pArchive) {
+
+	pArchive->Write(rOut);
+	return rOut;
+}
@@ -0,0 +1,111 @@
+/*
+ * KpfaRawDataArchive.h
+ */
+
+#ifndef _KPFA_RAW_DATA_ARCHIVE_H_
+#define _KPFA_RAW_DATA_ARCHIVE_H_
+
+#include <stdint.h>
+
+#include "KpfaDebug.h"
+#include "KpfaConfig.h"
+
+/**
+ * The declaration of the class for a binary archive of the raw data.
+ * The same function of a raw data class stores its values into the archive
+ * or loads them from it, so that both use the same layout. The values are
+ * kept in the native byte order without any padding.
+ */
+class KpfaRawDataArchive {
+
+private:
+
+	// Buffer to store the values (NULL if loading)
+	std::vector<char> *m_pBuffer;
+
+	// Current position and end of the values to be loaded
+	const char *m_pCurrent;
+	const char *m_pEnd;
+
+	// Whether more values have been requested than the archive has
+	bool m_bOverflow;
+
+public:
+
+	KpfaRawDataArchive(std::vector<char> &rBuffer);
+
+	KpfaRawDataArchive(const char *pBegin, const char *pEnd);
+
+	virtual ~KpfaRawDataArchive() {
+		// Do nothing
+	}
+
+	/**
+	 * This function will check whether the archive stores the values.
+	 *
+	 * @return true if storing, false if loading
+	 */
+	inline bool IsStoring() {
+		return (m_pBuffer != NULL);
+	}
+
+	/**
+	 * This function will check whether all the loaded values were in the archive.
+	 *
+	 * @return true if valid
+	 */
+	inline bool IsValid() {
+		return (m_bOverflow == false);
+	}
+
+	/**
+	 * This function will check whether all the values have been loaded.
+	 *
+	 * @return true if there is no more value
+	 */
+	inline bool IsEnd() {
+		return (m_pCurrent == m_pEnd);
+	}
+
+	/**
+	 * This function will store or load a value of a plain type.
+	 *
+	 * @param rValue value
+	 */
+	template<class T>
+	inline void Field(T &rValue) {
+		Bytes(&rValue, sizeof(T));
+	}
+
+	/**
+	 * This function will store or load an array of a plain type.
+	 *
+	 * @param rArray array
+	 */
+	template<class T, size_t N>
+	inline void Field(T (&rArray)[N]) {
+		Bytes(rArray, sizeof(T) * N);
+	}
+
+	void Field(string &rValue);
+
+	void Field(std::vector<double> &rValue);
+
+	void Bytes(void *pData, size_t nSize);
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+
+	friend ostream &operator << (ostream &rOut, KpfaRawDataArchive *pArchive);
+
+private:
+
+	KpfaRawDataArchive(const KpfaRawDataArchive &);
+
+	KpfaRawDataArchive &operator = (const KpfaRawDataArchive &);
+};
+
+#endif /* _KPFA_RAW_DATA_ARCHIVE_H_ */
@@ -40,17 +40,20 @@ KpfaRawDataMgmt::KpfaRawDataMgmt(KpfaCaseData *pCaseData) {
 
     m_pCaseData = pCaseData;
 
+	// The pool is set by the reader
+	m_pDataPool = NULL;
+
 	// Bus Data
 	m_rBusDataList.clear();
-	m_rBusDataTable.clear();
+	m_rBusDataTable.Clear();
 
 	// Generator Data
 	m_rGenDataList.clear();
-	m_rGenDataTable.clear();
+	m_rGenDataTable.Clear();
 
 	// Load Data
 	m_rLoadDataList.clear();
-	m_rLoadDataTable.clear();
+	m_rLoadDataTable.Clear();
 
 #if KPFA_RAW_DATA_VERSION == 33
 	// Fixed Shunt Data
@@ -83,6 +86,18 @@ KpfaRawDataMgmt::KpfaRawDataMgmt(KpfaCaseData *pCaseData) {
 
     // Clear the applied contingency data
     m_pCtgData = NULL;
+
+	// The network model is built on demand
+	m_bNetworkModelValid = false;
+
+	// The graph is built when the first contingency is applied
+	m_bGraphValid = false;
+
+	// No island is split
+	m_nIslandCount = 0;
+
+	// Not modified yet
+	m_nModifyCount = 0;
 }
 
 /**
@@ -92,15 +107,15 @@ KpfaRawDataMgmt::~KpfaRawDataMgmt() {
 
 	// Bus Data
 	m_rBusDataList.clear();
-	m_rBusDataTable.clear();
+	m_rBusDataTable.Clear();
 
 	// Generator Data
 	m_rGenDataList.clear();
-	m_rGenDataTable.clear();
+	m_rGenDataTable.Clear();
 
 	// Load Data
 	m_rLoadDataList.clear();
-	m_rLoadDataTable.clear();
+	m_rLoadDataTable.Clear();
 
 #if KPFA_RAW_DATA_VERSION == 33
 	// Fixed Shunt Data
@@ -127,6 +142,12 @@ KpfaRawDataMgmt::~KpfaRawDataMgmt() {
 
 	// FACTS
 	m_rFactsDataList.clear();
+
+	// Network model
+	m_rNetworkModel.Clear();
+
+	// Graph
+	m_rGraph.Clear();
 }
 
 /**
@@ -196,12 +217,34 @@ KpfaRawDataMgmt::GetHvdcEntry(uint32_t nTableId, uint32_t nIncrement, double nPo
 KpfaError_t 
 KpfaRawDataMgmt::ApplyContingencyData(KpfaCtgData *pCtgData) {
 
-    if(m_pCtgData == NULL)				 return KPFA_SUCCESS;
-	if(m_pCtgData->GetStatus() == FALSE) return KPFA_SUCCESS;
+    if(pCtgData == NULL)				 return KPFA_SUCCESS;
+	if(pCtgData->GetStatus() == FALSE)	 return KPFA_SUCCESS;
+
+	// The contingency is applied already
+	if(m_pCtgData == pCtgData)			 return KPFA_SUCCESS;
+
+	// Retrieve the one still applied (e.g. by a failed analysis) first
+	if(m_pCtgData != NULL) {
+		KpfaError_t error = RetrieveFromContingency();
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+	}
 
     // Keep the applied contingency data for restoring
     m_pCtgData = pCtgData;
 
+    SetModified();
+
+    // Build the graph of the base topology to check the islands
+    if(m_bGraphValid == false || m_rGraph.GetEdgeCount() != m_rBranchDataList.size() ||
+       m_rTransBranchList.size() != m_rTransformerDataList.size() + 1) {
+        KpfaError_t error = BuildGraph();
+        KPFA_CHECK(error == KPFA_SUCCESS, error);
+    }
+
+    // Branches and buses (vertex indices) taken out by the contingency
+    KpfaVertexList_t outBranches;
+    KpfaVertexList_t outBuses;
+
     // Get the iterator of outage list
     KpfaOutageDataList_t::iterator oiter;
     KpfaOutageDataList_t &otgDataList = pCtgData->GetOutageDataList();
@@ -221,6 +264,11 @@ KpfaRawDataMgmt::ApplyContingencyData(KpfaCtgData *pCtgData) {
                 KPFA_CHECK(bus != NULL, KPFA_ERROR_INVALID_BUS_ID);
                 otg->m_nOrigState = (uint32_t)bus->m_nIde;
                 bus->m_nIde = KPFA_ISOLATED_BUS;
+
+                uint32_t v = m_rGraph.FindVertex(bus->m_nI);
+                if(v != KPFA_NO_VERTEX && otg->m_nOrigState != KPFA_ISOLATED_BUS) {
+                    outBuses.push_back(v);
+                }
                 break;
             }
 
@@ -232,6 +280,10 @@ KpfaRawDataMgmt::ApplyContingencyData(KpfaCtgData *pCtgData) {
                     if(branch->m_nI == otg->m_nI && branch->m_nJ == otg->m_nJ && branch->m_nCkt == otg->m_nCkt) {
                         otg->m_nOrigState = (uint32_t)branch->m_bSt;
                         branch->m_bSt = FALSE;
+
+                        if(otg->m_nOrigState != FALSE) {
+                            outBranches.push_back((uint32_t)(riter - branchDataList.begin()));
+                        }
                         break;
                     }
                 }
@@ -247,6 +299,17 @@ KpfaRawDataMgmt::ApplyContingencyData(KpfaCtgData *pCtgData) {
                        trans->m_nK == otg->m_nK && trans->m_nCkt == otg->m_nCkt) {
                        otg->m_nOrigState = (uint32_t)trans->m_nStat;
                        trans->m_nStat = 0;
+
+                       // Take out its equivalent branches, which the Y matrix is built with
+                       uint32_t t = (uint32_t)(riter - transDataList.begin());
+
+                       for(uint32_t e = m_rTransBranchList[t]; e < m_rTransBranchList[t + 1]; e++) {
+                           KpfaBranchData *branch = (KpfaBranchData *)m_rBranchDataList[e];
+                           if(otg->m_nOrigState != 0 && branch->m_bSt != FALSE) {
+                               branch->m_bSt = FALSE;
+                               outBranches.push_back(e);
+                           }
+                       }
                        break;
                     }
                 }
@@ -312,7 +375,8 @@ KpfaRawDataMgmt::ApplyContingencyData(KpfaCtgData *pCtgData) {
         }
     }
     
-    return KPFA_SUCCESS;
+    // De-energize the islands split from the swing bus
+    return CheckIslands(outBranches, outBuses);
 }
 
 /**
@@ -323,15 +387,19 @@ KpfaRawDataMgmt::ApplyContingencyData(KpfaCtgData *pCtgData) {
 KpfaError_t
 KpfaRawDataMgmt::RetrieveFromContingency() {
 
-    // If there is no registered contingency data, just return.
+    // If there is no applied contingency data, just return.
     // Otherwise, retrieve original raw data and clear the applied contigency data information.
     if(m_pCtgData == NULL)				 return KPFA_SUCCESS;
-	if(m_pCtgData->GetStatus() == FALSE) return KPFA_SUCCESS;
+
+    SetModified();
 
     // Get the iterator of outage list
     KpfaOutageDataList_t::iterator oiter;
     KpfaOutageDataList_t &otgDataList = m_pCtgData->GetOutageDataList();
 
+    // Energize the islands again before the outages are retrieved
+    RestoreIslands();
+
     // Retrieve from all the outages
     KpfaRawDataList_t::iterator riter;
 	KpfaRawDataList_t &busDataList = GetBusDataList(); 
@@ -340,6 +408,8 @@ KpfaRawDataMgmt::RetrieveFromContingency() {
 
 		KpfaBusData *bus = (KpfaBusData *)*riter;
 		bus->m_nVm = bus->m_nOrigVm;
+		// The type may be switched by the reactive power limits of the analysis
+		bus->m_nIde = bus->m_nOrigIde;
 	}
         
     for(oiter = otgDataList.begin(); oiter != otgDataList.end(); oiter++) {
@@ -375,6 +445,13 @@ KpfaRawDataMgmt::RetrieveFromContingency() {
                     if(trans->m_nI == otg->m_nI && trans->m_nJ == otg->m_nJ && 
                        trans->m_nK == otg->m_nK && trans->m_nCkt == otg->m_nCkt) {
                        trans->m_nStat = (uint8_t)otg->m_nOrigState;
+
+                       if(otg->m_nOrigState != 0) {
+                           uint32_t t = (uint32_t)(riter - transDataList.begin());
+                           for(uint32_t e = m_rTransBranchList[t]; e < m_rTransBranchList[t + 1]; e++) {
+                               ((KpfaBranchData *)m_rBranchDataList[e])->m_bSt = TRUE;
+                           }
+                       }
                        break;
                     }
                 }
@@ -429,6 +506,403 @@ KpfaRawDataMgmt::RetrieveFromContingency() {
     return KPFA_SUCCESS;
 }
 
+/**
+ * This function will build the graph with an edge per branch, and find the
+ * bridges of the base topology, which split the network if taken out. The
+ * transformers are in the branch list as their equivalent branches (one, or
+ * three to the star bus of a three winding one), which follow the branches of
+ * the raw data in the order of the transformers. They are kept for each
+ * transformer, so that its outage takes them out.
+ *
+ * @return error information
+ */
+KpfaError_t
+KpfaRawDataMgmt::BuildGraph() {
+
+	uint32_t e, t, nbranch = (uint32_t)m_rBranchDataList.size();
+	uint32_t ntrans = (uint32_t)m_rTransformerDataList.size();
+
+	m_rGraph.Clear();
+
+	for(e = 0; e < nbranch; e++) {
+		KpfaBranchData *branch = (KpfaBranchData *)m_rBranchDataList[e];
+		m_rGraph.AddEdge(branch->m_nI, branch->m_nJ);
+	}
+
+	m_rGraph.Build();
+
+	// Equivalent branches of the transformers
+	uint32_t nwinding = 0;
+
+	for(t = 0; t < ntrans; t++) {
+		nwinding += (((KpfaTransformerData *)m_rTransformerDataList[t])->m_nK != 0) ? 3 : 1;
+	}
+
+	m_rTransBranchList.assign(1, (nwinding <= nbranch) ? nbranch - nwinding : nbranch);
+
+	for(t = 0; t < ntrans; t++) {
+
+		KpfaTransformerData *trans = (KpfaTransformerData *)m_rTransformerDataList[t];
+
+		uint32_t first = m_rTransBranchList[t];
+		uint32_t count = (trans->m_nK != 0) ? 3 : 1;
+
+		// The first one is from the bus I, and the second one of a three winding
+		// transformer is from the bus J
+		bool match = (first + count <= nbranch);
+
+		if(match == true) {
+
+			KpfaBranchData *branch = (KpfaBranchData *)m_rBranchDataList[first];
+
+			match = (branch->m_nI == trans->m_nI && branch->m_nCkt == trans->m_nCkt &&
+					 (count == 3 || branch->m_nJ == trans->m_nJ));
+
+			if(match == true && count == 3) {
+				match = (((KpfaBranchData *)m_rBranchDataList[first + 1])->m_nI == trans->m_nJ &&
+						 ((KpfaBranchData *)m_rBranchDataList[first + 2])->m_nI == trans->m_nK);
+			}
+		}
+
+		if(match == false) {
+			KPFA_ERROR("No equivalent branch of the transformer: %d, %d, %d",
+					   trans->m_nI, trans->m_nJ, trans->m_nK);
+			break;
+		}
+
+		m_rTransBranchList.push_back(first + count);
+	}
+
+	// The outages of the transformers without the equivalent branches take nothing out
+	m_rTransBranchList.resize(ntrans + 1, m_rTransBranchList.back());
+
+	// The branches out of service and the ones at the isolated buses are left out
+	m_rEdgeOutList.assign(nbranch, 0);
+
+	for(e = 0; e < nbranch; e++) {
+
+		KpfaBranchData *branch = (KpfaBranchData *)m_rBranchDataList[e];
+		KpfaBusData *busI = GetBusData(branch->m_nI);
+		KpfaBusData *busJ = GetBusData(branch->m_nJ);
+
+		if(branch->m_bSt == FALSE || busI == NULL || busJ == NULL ||
+		   busI->m_nIde == KPFA_ISOLATED_BUS || busJ->m_nIde == KPFA_ISOLATED_BUS) {
+			m_rEdgeOutList[e] = 1;
+		}
+	}
+
+	m_rGraph.FindBridges(m_rEdgeOutList, m_rBridgeList);
+
+	m_bGraphValid = true;
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will check whether the network is split by the branches and the
+ * buses taken out by the contingency, and de-energize the islands which are not
+ * connected to the swing bus any more. Only the neighborhood of the removed
+ * elements is examined: a bridge of the base topology always splits the network,
+ * and a single removed branch which is not a bridge never does. Otherwise the
+ * end points of each removed branch and the neighbors of each removed bus must
+ * still be connected to each other. The whole network is labelled only if it
+ * has been split.
+ *
+ * @param rOutBranches indices of the branches taken out
+ * @param rOutBuses vertex indices of the buses taken out
+ * @return error information
+ */
+KpfaError_t
+KpfaRawDataMgmt::CheckIslands(KpfaVertexList_t &rOutBranches, KpfaVertexList_t &rOutBuses) {
+
+	m_rIslandBusList.clear();
+	m_rIslandIdeList.clear();
+	m_nIslandCount = 0;
+
+	if(rOutBranches.empty() && rOutBuses.empty()) {
+		return KPFA_SUCCESS;
+	}
+
+	uint32_t i, slot;
+	bool split = false;
+
+	KpfaAdjacencyGraph &graph = m_rGraph;
+	KpfaVertexList_t &offsets = graph.GetOffsets();
+	KpfaVertexList_t &adjacency = graph.GetAdjacency();
+	KpfaVertexList_t &adjacencyEdge = graph.GetAdjacencyEdge();
+	KpfaVertexList_t &vertexIds = graph.GetVertexIds();
+
+	// Pairs of the vertices which must be still connected
+	KpfaVertexList_t pairs;
+
+	for(i = 0; i < rOutBranches.size(); i++) {
+
+		uint32_t e = rOutBranches[i];
+
+		if(m_rEdgeOutList[e] != 0) continue;
+
+		if(m_rBridgeList[e] != 0) {
+			split = true;
+		}
+
+		pairs.push_back(graph.GetEdgeVertex(e, 0));
+		pairs.push_back(graph.GetEdgeVertex(e, 1));
+	}
+
+	for(i = 0; i < rOutBuses.size(); i++) {
+
+		uint32_t v = rOutBuses[i], first = KPFA_NO_VERTEX;
+
+		for(slot = offsets[v]; slot < offsets[v + 1]; slot++) {
+
+			if(m_rEdgeOutList[adjacencyEdge[slot]] != 0) continue;
+
+			if(first == KPFA_NO_VERTEX) {
+				first = adjacency[slot];
+			}
+			else if(adjacency[slot] != first) {
+				pairs.push_back(first);
+				pairs.push_back(adjacency[slot]);
+			}
+		}
+	}
+
+	// Leave out the removed branches and the branches at the removed buses
+	KpfaVertexList_t changed;
+
+	for(i = 0; i < rOutBranches.size(); i++) {
+		if(m_rEdgeOutList[rOutBranches[i]] == 0) {
+			m_rEdgeOutList[rOutBranches[i]] = 1;
+			changed.push_back(rOutBranches[i]);
+		}
+	}
+
+	for(i = 0; i < rOutBuses.size(); i++) {
+
+		uint32_t v = rOutBuses[i];
+
+		for(slot = offsets[v]; slot < offsets[v + 1]; slot++) {
+			if(m_rEdgeOutList[adjacencyEdge[slot]] == 0) {
+				m_rEdgeOutList[adjacencyEdge[slot]] = 1;
+				changed.push_back(adjacencyEdge[slot]);
+			}
+		}
+	}
+
+	// A single branch which is not a bridge leaves the network connected
+	if(split == false && !(rOutBuses.empty() && changed.size() == 1)) {
+
+		for(i = 0; i + 1 < pairs.size() && split == false; i += 2) {
+
+			KpfaBusData *busI = GetBusData(vertexIds[pairs[i]]);
+			KpfaBusData *busJ = GetBusData(vertexIds[pairs[i + 1]]);
+
+			// Skip the buses taken out as well
+			if(busI->m_nIde == KPFA_ISOLATED_BUS || busJ->m_nIde == KPFA_ISOLATED_BUS) {
+				continue;
+			}
+
+			split = !graph.IsConnected(pairs[i], pairs[i + 1], m_rEdgeOutList);
+		}
+	}
+
+	if(split == true) {
+
+		uint32_t count = 0;
+		KpfaVertexList_t &labels = graph.SplitSubgraphs(count, &m_rEdgeOutList);
+
+		uint32_t swing = graph.FindVertex(m_nSwingBusId);
+
+		if(swing != KPFA_NO_VERTEX) {
+
+			KpfaEdgeFlagList_t islands(count, 0);
+
+			for(i = 0; i < labels.size(); i++) {
+
+				if(labels[i] == labels[swing]) continue;
+
+				KpfaBusData *bus = GetBusData(vertexIds[i]);
+
+				if(bus == NULL || bus->m_nIde == KPFA_ISOLATED_BUS) continue;
+
+				m_rIslandBusList.push_back(bus);
+				m_rIslandIdeList.push_back(bus->m_nIde);
+				bus->m_nIde = KPFA_ISOLATED_BUS;
+
+				if(islands[labels[i]] == 0) {
+					islands[labels[i]] = 1;
+					m_nIslandCount++;
+				}
+			}
+		}
+	}
+
+	// Restore the flags of the base topology
+	for(i = 0; i < changed.size(); i++) {
+		m_rEdgeOutList[changed[i]] = 0;
+	}
+
+	if(m_nIslandCount > 0) {
+		KPFA_DEBUG("Contingency", "%u island(s) with %u bus(es) are de-energized",
+				   m_nIslandCount, (uint32_t)m_rIslandBusList.size());
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will energize the buses of the islands split by the applied
+ * contingency again with their original bus types.
+ */
+void
+KpfaRawDataMgmt::RestoreIslands() {
+
+	for(uint32_t i = 0; i < m_rIslandBusList.size(); i++) {
+		KpfaBusData *bus = (KpfaBusData *)m_rIslandBusList[i];
+		bus->m_nIde = m_rIslandIdeList[i];
+	}
+
+	m_rIslandBusList.clear();
+	m_rIslandIdeList.clear();
+	m_nIslandCount = 0;
+}
+
+/**
+ * This function will update the network model with the current raw data.
+ * The topology is built again only if the raw data lists have been changed.
+ *
+ * @return error information
+ */
+KpfaError_t
+KpfaRawDataMgmt::UpdateNetworkModel() {
+
+	KpfaNetworkModel &model = m_rNetworkModel;
+
+	if(m_bNetworkModelValid == false ||
+	   model.GetBusCount() != m_rBusDataList.size() ||
+	   model.GetBranchCount() != m_rBranchDataList.size() ||
+	   model.GetGenCount() != m_rGenDataList.size() ||
+	   model.GetLoadCount() != m_rLoadDataList.size() ||
+	   model.GetShuntCount() != m_rSwitchedShuntDataList.size()) {
+
+		KpfaError_t error = model.Build(this);
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+		m_bNetworkModelValid = true;
+		return KPFA_SUCCESS;
+	}
+
+	return model.Update(this);
+}
+
+/**
+ * Creates a copy of the given raw data in the pool.
+ */
+template<class T>
+static inline T *
+CopyRawData(KpfaRawDataPool *pPool, KpfaRawDataType_t nDataType, KpfaRawData *pRawData) {
+
+	T *data = (T *)pPool->NewRawData(nDataType);
+
+	if(data != NULL) {
+		*data = *(T *)pRawData;
+	}
+
+	return data;
+}
+
+/**
+ * This function will copy the raw data into the given raw data management, so
+ * that the copy can be modified and solved apart from this one. The raw data
+ * modified by the analysis are created in the given pool, and the others (two
+ * terminal and VSC DC) are shared. The applied contingency is not copied.
+ *
+ * @param pTarget empty raw data management to be filled
+ * @param pPool pool of the copied raw data
+ * @return error information
+ */
+KpfaError_t
+KpfaRawDataMgmt::CopyTo(KpfaRawDataMgmt *pTarget, KpfaRawDataPool *pPool) {
+
+	KPFA_CHECK(pTarget != NULL && pPool != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+	KPFA_CHECK(pTarget->GetBusCount() == 0, KPFA_ERROR_INVALID_ARGUMENT);
+
+	uint32_t i;
+
+	pTarget->m_nSysBase = m_nSysBase;
+	pTarget->m_pCaseData = m_pCaseData;
+	pTarget->m_pDataPool = pPool;
+
+	for(i = 0; i < m_rBusDataList.size(); i++) {
+		KpfaBusData *data = CopyRawData<KpfaBusData>(pPool, KPFA_RAW_BUS, m_rBusDataList[i]);
+		KPFA_CHECK(data != NULL, KPFA_ERROR_MEMORY_ALLOC);
+		pTarget->InsertBusData(data);
+	}
+
+	for(i = 0; i < m_rGenDataList.size(); i++) {
+		KpfaGenData *data = CopyRawData<KpfaGenData>(pPool, KPFA_RAW_GEN, m_rGenDataList[i]);
+		KPFA_CHECK(data != NULL, KPFA_ERROR_MEMORY_ALLOC);
+		pTarget->InsertGenData(data);
+	}
+
+	for(i = 0; i < m_rLoadDataList.size(); i++) {
+		KpfaLoadData *data = CopyRawData<KpfaLoadData>(pPool, KPFA_RAW_LOAD, m_rLoadDataList[i]);
+		KPFA_CHECK(data != NULL, KPFA_ERROR_MEMORY_ALLOC);
+		pTarget->InsertLoadData(data);
+	}
+
+#if KPFA_RAW_DATA_VERSION == 33
+	for(i = 0; i < m_rFixedShuntDataList.size(); i++) {
+		KpfaFixedShuntData *data =
+				CopyRawData<KpfaFixedShuntData>(pPool, KPFA_RAW_FIXED_SHUNT, m_rFixedShuntDataList[i]);
+		KPFA_CHECK(data != NULL, KPFA_ERROR_MEMORY_ALLOC);
+		pTarget->m_rFixedShuntDataList.push_back(data);
+	}
+#endif
+
+	for(i = 0; i < m_rBranchDataList.size(); i++) {
+		KpfaBranchData *data = CopyRawData<KpfaBranchData>(pPool, KPFA_RAW_BRANCH, m_rBranchDataList[i]);
+		KPFA_CHECK(data != NULL, KPFA_ERROR_MEMORY_ALLOC);
+		pTarget->InsertBranchData(data);
+	}
+
+	for(i = 0; i < m_rTransformerDataList.size(); i++) {
+		KpfaTransformerData *data =
+				CopyRawData<KpfaTransformerData>(pPool, KPFA_RAW_TRANSFORMER, m_rTransformerDataList[i]);
+		KPFA_CHECK(data != NULL, KPFA_ERROR_MEMORY_ALLOC);
+		pTarget->InsertTransformerData(data);
+	}
+
+	for(i = 0; i < m_rAreaDataList.size(); i++) {
+		KpfaAreaData *data = CopyRawData<KpfaAreaData>(pPool, KPFA_RAW_AREA_INTERCHANGE, m_rAreaDataList[i]);
+		KPFA_CHECK(data != NULL, KPFA_ERROR_MEMORY_ALLOC);
+		pTarget->InsertAreaData(data);
+	}
+
+	for(i = 0; i < m_rSwitchedShuntDataList.size(); i++) {
+		KpfaSwitchedShuntData *data =
+				CopyRawData<KpfaSwitchedShuntData>(pPool, KPFA_RAW_SWITCHED_SHUNT, m_rSwitchedShuntDataList[i]);
+		KPFA_CHECK(data != NULL, KPFA_ERROR_MEMORY_ALLOC);
+		pTarget->InsertSwitchedShuntData(data);
+	}
+
+	for(i = 0; i < m_rFactsDataList.size(); i++) {
+		KpfaFactsData *data = CopyRawData<KpfaFactsData>(pPool, KPFA_RAW_FACTS, m_rFactsDataList[i]);
+		KPFA_CHECK(data != NULL, KPFA_ERROR_MEMORY_ALLOC);
+		pTarget->InsertFactsData(data);
+	}
+
+	// Not modified by the analysis
+	for(i = 0; i < m_rTwoTermDataList.size(); i++) {
+		pTarget->InsertTwoTermData((KpfaTwoTermData *)m_rTwoTermDataList[i]);
+	}
+
+	for(i = 0; i < m_rVscDataList.size(); i++) {
+		pTarget->InsertVscData((KpfaVscData *)m_rVscDataList[i]);
+	}
+
+	return KPFA_SUCCESS;
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
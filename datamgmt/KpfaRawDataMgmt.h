@@ -21,6 +21,10 @@
 #include "KpfaVscData.h"
 #include "KpfaFactsData.h"
 #include "KpfaRawData.h"
+#include "KpfaRawDataTable.h"
+#include "KpfaRawDataPool.h"
+#include "KpfaNetworkModel.h"
+#include "KpfaAdjacencyGraph.h"
 #include "KpfaCtgDataMgmt.h"
 
 #define KPFA_MAX_HVDC_1_P	300
@@ -38,7 +42,7 @@ typedef struct {
 typedef std::vector<KpfaRawData *> KpfaRawDataList_t;
 
 // Raw Data Table (Bus ID, Raw Data)
-typedef std::map<uint32_t, KpfaRawData *> KpfaRawDataTable_t;
+typedef KpfaRawDataTable KpfaRawDataTable_t;
 
 /**
  * The declaration of the class for Raw Data Management
@@ -55,6 +59,9 @@ private:
 	// Case ID
 	KpfaCaseData *m_pCaseData;
 
+	// Pool of the raw data created during the analysis (owned by the reader)
+	KpfaRawDataPool *m_pDataPool;
+
 	// Bus Data
 	KpfaRawDataList_t m_rBusDataList;
 	KpfaRawDataTable_t m_rBusDataTable;
@@ -99,6 +106,32 @@ private:
     // Applied contingency data
     KpfaCtgData *m_pCtgData;
 
+	// Network model for the solvers
+	KpfaNetworkModel m_rNetworkModel;
+
+	// Whether the topology of the network model is up to date
+	bool m_bNetworkModelValid;
+
+	// Graph with an edge per branch, the branches out of service and the bridges
+	KpfaAdjacencyGraph m_rGraph;
+	KpfaEdgeFlagList_t m_rEdgeOutList;
+	KpfaEdgeFlagList_t m_rBridgeList;
+	bool m_bGraphValid;
+
+	// First equivalent branch of each transformer (the ones of the transformer t
+	// are from m_rTransBranchList[t] up to m_rTransBranchList[t + 1])
+	KpfaVertexList_t m_rTransBranchList;
+
+	// Buses de-energized for the islands split by the applied contingency,
+	// their original bus types and the number of the islands
+	KpfaRawDataList_t m_rIslandBusList;
+	std::vector<KpfaBusType_t> m_rIslandIdeList;
+	uint32_t m_nIslandCount;
+
+	// Number of the modifications of the raw data, by which a solved powerflow
+	// can tell whether it still matches the current network
+	uint32_t m_nModifyCount;
+
 public:
 
     KpfaRawDataMgmt(KpfaCaseData *pCaseData = NULL);
@@ -162,6 +195,26 @@ public:
 	    m_pCaseData = pCaseData;
 	}    
 
+	/**
+	 * This function will set the pool of the raw data created during the analysis.
+	 *
+	 * @param pDataPool pool of the raw data
+	 */
+	inline void SetDataPool(KpfaRawDataPool *pDataPool) {
+		m_pDataPool = pDataPool;
+	}
+
+	/**
+	 * This function will create a new raw data of the given type in the pool.
+	 * The raw data is released together with the pool.
+	 *
+	 * @param nDataType raw data type
+	 * @return a new raw data (NULL if no pool has been set)
+	 */
+	inline KpfaRawData *NewRawData(KpfaRawDataType_t nDataType) {
+		return (m_pDataPool != NULL) ? m_pDataPool->NewRawData(nDataType) : NULL;
+	}
+
 	/**
 	 * This function will be used to add a new bus data into both bus table and list
 	 *
@@ -172,10 +225,12 @@ public:
 		pBusData->m_nIdx = GetBusCount();
 	
 		// <key, value> := <i, the bus data>
-		m_rBusDataTable[pBusData->m_nI] = pBusData;
+		m_rBusDataTable.Insert(pBusData->m_nI, pBusData);
 		
 		// Insert the new bus data into the bus data list
 		m_rBusDataList.push_back(pBusData);	
+		m_bNetworkModelValid = false;
+		m_bGraphValid = false;
 
         // Set the swing bus ID if the given bus is a swing bus
         if(pBusData->m_nIde == KPFA_SWING_BUS) {
@@ -191,10 +246,11 @@ public:
 	inline void InsertGenData(KpfaGenData *pGenData) {
 
 		// <key, value> := <i, the generator data>
-		m_rGenDataTable[pGenData->m_nI] = pGenData;
+		m_rGenDataTable.Insert(pGenData->m_nI, pGenData);
 		
 		// Insert the new generator data into the generator data list
 		m_rGenDataList.push_back(pGenData);	
+		m_bNetworkModelValid = false;
 	}	
 	
 	/**
@@ -205,10 +261,11 @@ public:
 	inline void InsertLoadData(KpfaLoadData *pLoadData) {
 	
 		// <key, value> := <i, the load data>
-		m_rLoadDataTable[pLoadData->m_nI] = pLoadData;
+		m_rLoadDataTable.Insert(pLoadData->m_nI, pLoadData);
 		
 		// Insert the new load data into the load data list
 		m_rLoadDataList.push_back(pLoadData);	
+		m_bNetworkModelValid = false;
 	}
 
 	/**
@@ -220,6 +277,8 @@ public:
 	
 		// Insert the new branch data into the branch data list
 		m_rBranchDataList.push_back(pBranchData);	
+		m_bNetworkModelValid = false;
+		m_bGraphValid = false;
 	}    
 
 	/**
@@ -231,6 +290,7 @@ public:
 	
 		// Insert the new transformer data into the transformer data list
 		m_rTransformerDataList.push_back(pTransformerData);	
+		m_bGraphValid = false;
 	}      
 
 	/**
@@ -314,10 +374,7 @@ public:
 	 * @return Raw bus data with the bus ID, 'nBusId'
 	 */
 	inline KpfaBusData *GetBusData(uint32_t nBusId) {
-		if(m_rBusDataTable.count(nBusId) != 0) {
-			return (KpfaBusData *)m_rBusDataTable[nBusId];
-		}
-		return NULL;
+		return (KpfaBusData *)m_rBusDataTable.Find(nBusId);
 	}
 
 	/**
@@ -336,10 +393,7 @@ public:
 	 * @return Raw load data with the bus ID, 'nBusId'
 	 */
 	inline KpfaLoadData *GetLoadData(uint32_t nBusId) {
-		if(m_rLoadDataTable.count(nBusId) != 0) {
-			return (KpfaLoadData *)m_rLoadDataTable[nBusId];
-		}
-		return NULL;
+		return (KpfaLoadData *)m_rLoadDataTable.Find(nBusId);
 	}
 
 	/**
@@ -378,10 +432,7 @@ public:
 	 * @return Raw generator data with the bus ID, 'nBusId'
 	 */
 	inline KpfaGenData *GetGenData(uint32_t nBusId) {
-		if(m_rGenDataTable.count(nBusId) != 0) {
-			return (KpfaGenData *)m_rGenDataTable[nBusId];
-		}
-		return NULL;
+		return (KpfaGenData *)m_rGenDataTable.Find(nBusId);
 	}
 
 	/**
@@ -482,6 +533,58 @@ public:
 
     KpfaError_t RetrieveFromContingency();
 
+	/**
+	 * This function will return the number of the islands split from the swing
+	 * bus by the applied contingency.
+	 *
+	 * @return island number
+	 */
+	inline uint32_t GetIslandCount() {
+		return m_nIslandCount;
+	}
+
+	/**
+	 * This function will return the list of the buses de-energized for the
+	 * islands split by the applied contingency.
+	 *
+	 * @return the de-energized bus data list
+	 */
+	inline KpfaRawDataList_t &GetIslandBusList() {
+		return m_rIslandBusList;
+	}
+
+	/**
+	 * This function will return the number of the modifications of the raw data.
+	 *
+	 * @return modification number
+	 */
+	inline uint32_t GetModifyCount() {
+		return m_nModifyCount;
+	}
+
+	/**
+	 * This function will be used to notify that the raw data was modified
+	 * (the topology, the set-points or the solved values), so that the
+	 * powerflow solved before is not reused.
+	 */
+	inline void SetModified() {
+		m_nModifyCount++;
+	}
+
+	/**
+	 * This function will return the network model for the solvers.
+	 * UpdateNetworkModel() must be called before reading it.
+	 *
+	 * @return network model
+	 */
+	inline KpfaNetworkModel *GetNetworkModel() {
+		return &m_rNetworkModel;
+	}
+
+	KpfaError_t UpdateNetworkModel();
+
+	KpfaError_t CopyTo(KpfaRawDataMgmt *pTarget, KpfaRawDataPool *pPool);
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Functions
 	///////////////////////////////////////////////////////////////////
@@ -489,6 +592,14 @@ public:
 	virtual void Write(ostream &rOut);
 
 	friend ostream &operator << (ostream &rOut, KpfaRawDataMgmt *pDataMgmt);
+
+private:
+
+	KpfaError_t BuildGraph();
+
+	KpfaError_t CheckIslands(KpfaVertexList_t &rOutBranches, KpfaVertexList_t &rOutBuses);
+
+	void RestoreIslands();
 };
 
 #endif /* _KPFA_RAW_DATA_MGMT_H_ */
@@ -0,0 +1,104 @@
+/*
+ * KpfaRawDataPool.cpp
+ */
+
+#include "KpfaRawDataPool.h"
+#include "KpfaAreaData.h"
+#include "KpfaBranchData.h"
+#include "KpfaBusData.h"
+#include "KpfaFixedShuntData.h"
+#include "KpfaGenData.h"
+#include "KpfaLoadData.h"
+#include "KpfaSwitchedShuntData.h"
+#include "KpfaTransformerData.h"
+#include "KpfaFactsData.h"
+
+KpfaRawDataPool::KpfaRawDataPool() {
+
+	for(uint32_t i = 0; i < KPFA_NUM_OF_RAW_DATA_TYPES; i++) {
+		m_pArenaList[i] = new KpfaArena(KPFA_RAW_DATA_POOL_CHUNK_SIZE);
+	}
+}
+
+KpfaRawDataPool::~KpfaRawDataPool() {
+
+	Release();
+
+	for(uint32_t i = 0; i < KPFA_NUM_OF_RAW_DATA_TYPES; i++) {
+		delete m_pArenaList[i];
+	}
+}
+
+/**
+ * This function will create a new raw data of the given type in the pool.
+ *
+ * @param nDataType raw data type
+ * @return a new raw data (NULL if the type is not supported or failed)
+ */
+KpfaRawData *
+KpfaRawDataPool::NewRawData(KpfaRawDataType_t nDataType) {
+
+	switch(nDataType) {
+		case KPFA_RAW_BUS:				return Create<KpfaBusData>(nDataType);
+		case KPFA_RAW_LOAD:				return Create<KpfaLoadData>(nDataType);
+#if KPFA_RAW_DATA_VERSION == 33
+		case KPFA_RAW_FIXED_SHUNT:		return Create<KpfaFixedShuntData>(nDataType);
+#endif
+		case KPFA_RAW_GEN:				return Create<KpfaGenData>(nDataType);
+		case KPFA_RAW_BRANCH:			return Create<KpfaBranchData>(nDataType);
+		case KPFA_RAW_TRANSFORMER:		return Create<KpfaTransformerData>(nDataType);
+		case KPFA_RAW_AREA_INTERCHANGE:	return Create<KpfaAreaData>(nDataType);
+		case KPFA_RAW_SWITCHED_SHUNT:	return Create<KpfaSwitchedShuntData>(nDataType);
+		case KPFA_RAW_FACTS:			return Create<KpfaFactsData>(nDataType);
+		default:						return NULL;
+	}
+}
+
+/**
+ * This function will destruct all the raw data in the pool and release the
+ * memory chunks of all the arenas at once.
+ */
+void
+KpfaRawDataPool::Release() {
+
+	std::lock_guard<std::mutex> guard(m_rLock);
+
+	for(uint32_t i = 0; i < KPFA_NUM_OF_RAW_DATA_TYPES; i++) {
+
+		std::vector<KpfaRawData *> &dataList = m_rDataList[i];
+
+		for(uint32_t j = 0; j < dataList.size(); j++) {
+			dataList[j]->~KpfaRawData();
+		}
+
+		dataList.clear();
+
+		m_pArenaList[i]->Release();
+	}
+}
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaRawDataPool::Write(ostream &rOut) {
+
+	rOut << "KPFA RAW DATA POOL: " << endl;
+
+	for(uint32_t i = 0; i < KPFA_NUM_OF_RAW_DATA_TYPES; i++) {
+
+		if(m_rDataList[i].empty() == true) {
+			continue;
+		}
+
+		rOut << "\t" << g_KpfaRawDataTypeString[i] << ": " << m_rDataList[i].size();
+		rOut << " (" << m_pArenaList[i]->GetUsedSize() << " bytes)" << endl;
+	}
+}
+
+ostream &operator << (ostream &rOut, KpfaRawDataPool *pPool) {
+
+	pPool->Write(rOut);
+	return rOut;
+}
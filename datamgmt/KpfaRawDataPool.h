@@ -0,0 +1,99 @@
+/*
+ * KpfaRawDataPool.h
+ */
+
+#ifndef _KPFA_RAW_DATA_POOL_H_
+#define _KPFA_RAW_DATA_POOL_H_
+
+#include <new>
+#include <mutex>
+
+#include "KpfaDebug.h"
+#include "KpfaConfig.h"
+#include "KpfaArena.h"
+#include "KpfaRawData.h"
+
+// Size of a memory chunk of the arena for each raw data type (256KB)
+#define KPFA_RAW_DATA_POOL_CHUNK_SIZE	(256 * 1024)
+
+/**
+ * The declaration of the class for the pool of the raw data.
+ * The raw data of each type are carved out of the arena of the type, so that
+ * the records of a type are contiguous in memory. The raw data cannot be
+ * deleted individually; a raw data dropped while reading stays in the pool
+ * until all the raw data are destructed and their arenas are released at once
+ * by Release(). The raw data can be created on several threads.
+ */
+class KpfaRawDataPool {
+
+private:
+
+	// Arena of each raw data type
+	KpfaArena *m_pArenaList[KPFA_NUM_OF_RAW_DATA_TYPES];
+
+	// Raw data created from each arena (to be destructed)
+	std::vector<KpfaRawData *> m_rDataList[KPFA_NUM_OF_RAW_DATA_TYPES];
+
+	// Lock for concurrent creations
+	std::mutex m_rLock;
+
+public:
+
+	KpfaRawDataPool();
+
+	virtual ~KpfaRawDataPool();
+
+	/**
+	 * This function will return the number of raw data of the given type in the pool.
+	 *
+	 * @param nDataType raw data type
+	 * @return the number of raw data
+	 */
+	inline uint32_t GetCount(KpfaRawDataType_t nDataType) {
+		return (uint32_t)m_rDataList[nDataType].size();
+	}
+
+	KpfaRawData *NewRawData(KpfaRawDataType_t nDataType);
+
+	void Release();
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+
+	friend ostream &operator << (ostream &rOut, KpfaRawDataPool *pPool);
+
+private:
+
+	/**
+	 * This function will construct a new raw data in the arena of the given type.
+	 *
+	 * @param nDataType raw data type
+	 * @return a new raw data (NULL if failed)
+	 */
+	template<class T>
+	inline T *Create(KpfaRawDataType_t nDataType) {
+
+		std::lock_guard<std::mutex> guard(m_rLock);
+
+		void *block = m_pArenaList[nDataType]->Allocate(sizeof(T));
+
+		if(block == NULL) {
+			return NULL;
+		}
+
+		T *data = new (block) T();
+
+		m_rDataList[nDataType].push_back(data);
+
+		return data;
+	}
+
+	KpfaRawDataPool(const KpfaRawDataPool &);
+
+	KpfaRawDataPool &operator = (const KpfaRawDataPool &);
+};
+
+#endif /* _KPFA_RAW_DATA_POOL_H_ */
@@ -7,6 +7,10 @@
 
 #include "KpfaRawDataReader.h"
 #include "KpfaAdjacencyGraph.h"
+#include "KpfaMappedFile.h"
+
+#include <atomic>
+#include <thread>
 
 /**
  * This function will be used to initialize all the data structures for raw data.
@@ -14,8 +18,10 @@
 KpfaRawDataReader::KpfaRawDataReader() {
 
 	m_bFlat = false;
+	m_bParallel = false;
 	m_nSysBase = 0.0;
 	m_nMaxBusId = 0;
+	m_nSysCount = 0;
 }
 
 /**
@@ -24,7 +30,7 @@ KpfaRawDataReader::KpfaRawDataReader() {
 KpfaRawDataReader::~KpfaRawDataReader() {
 
 	m_rBusDataList.clear();
-	m_rBusDataTable.clear();
+	m_rBusDataTable.Clear();
 	m_rGenDataList.clear();
 	m_rLoadDataList.clear();
 	m_rBranchDataList.clear();
@@ -37,20 +43,382 @@ KpfaRawDataReader::~KpfaRawDataReader() {
 	m_rVscDataList.clear();
 	m_rSwitchedShuntDataList.clear();
 	m_rFactsDataList.clear();
+
+	// Release all the raw data at once
+	m_rDataPool.Release();
+}
+
+// The number of lines of a part of a large section parsed by a thread
+#define KPFA_RAW_PARSE_CHUNK_LINES	4096
+
+/**
+ * Sections following the case ID data in the order of the raw data file
+ */
+static const KpfaRawDataType_t s_rRawSectionList[] = {
+	KPFA_RAW_BUS,
+	KPFA_RAW_LOAD,
+#if KPFA_RAW_DATA_VERSION == 33
+	KPFA_RAW_FIXED_SHUNT,
+#endif
+	KPFA_RAW_GEN,
+	KPFA_RAW_BRANCH,
+	KPFA_RAW_TRANSFORMER,
+	KPFA_RAW_AREA_INTERCHANGE,
+	KPFA_RAW_TWO_TERM,
+	KPFA_RAW_VSC,
+	KPFA_RAW_SWITCHED_SHUNT,
+	KPFA_RAW_IMP_CORRECT,
+	KPFA_RAW_MULTI_TERM,
+	KPFA_RAW_MULTI_SECTION,
+	KPFA_RAW_ZONE,
+	KPFA_RAW_AREA_TRANSFER,
+	KPFA_RAW_OWNER,
+	KPFA_RAW_FACTS,
+};
+
+#define KPFA_NUM_RAW_SECTIONS	(uint32_t)(sizeof(s_rRawSectionList) / sizeof(s_rRawSectionList[0]))
+
+/**
+ * A section of the raw data file, or a part of a large section, which is parsed at once
+ */
+typedef struct {
+
+	// Raw data type of the section
+	KpfaRawDataType_t nDataType;
+
+	// Range in the raw data file
+	const char *pBegin;
+	const char *pEnd;
+
+	// Whether the range ends with the terminator of the section
+	bool bLast;
+
+	// Parsed raw data in the order of the file
+	KpfaRawDataList_t rDataList;
+
+	// Parse result
+	KpfaError_t nError;
+
+} KpfaRawSection_t;
+
+typedef std::vector<KpfaRawSection_t> KpfaRawSectionList_t;
+
+/**
+ * This function will check whether the records of the given section are skipped.
+ * Two-terminal and VSC DC lines are not modeled yet.
+ *
+ * @param nDataType raw data type of the section
+ * @return true if the records are skipped
+ */
+static inline bool
+IsSkippedSection(KpfaRawDataType_t nDataType) {
+
+	switch(nDataType) {
+		case KPFA_RAW_TWO_TERM:
+		case KPFA_RAW_VSC:
+		case KPFA_RAW_IMP_CORRECT:
+		case KPFA_RAW_MULTI_TERM:
+		case KPFA_RAW_MULTI_SECTION:
+		case KPFA_RAW_ZONE:
+		case KPFA_RAW_AREA_TRANSFER:
+		case KPFA_RAW_OWNER:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/**
+ * This function will check whether the given line terminates the section.
+ *
+ * @param nDataType raw data type of the section
+ * @param rLine line of the raw data file
+ * @return true if the line is the terminator
+ */
+static inline bool
+IsSectionEnd(KpfaRawDataType_t nDataType, const KpfaStringView_t &rLine) {
+
+#if KPFA_RAW_DATA_VERSION == 33
+	if(nDataType == KPFA_RAW_FIXED_SHUNT) {
+		return (rLine.nSize > 0 && rLine.pData[0] == '0');
+	}
+#else
+	// Every section of the version 30 ends with the same terminator
+	(void)nDataType;
+#endif
+
+	return KpfaContainsString(rLine, "0 /");
+}
+
+/**
+ * This function will parse the lines following the first line of a transformer.
+ *
+ * @param rRawFile line reader for raw file
+ * @param pTransData transformer data with the first line parsed
+ * @return error information
+ */
+static KpfaError_t
+ParseTransformerData(KpfaLineReader &rRawFile, KpfaRawData *pTransData) {
+
+	KpfaStringView_t linebuf;
+
+	// Line #2
+	if(rRawFile.GetLine(linebuf) == false) {
+		return KPFA_ERROR_TRANSFORMER_READ;
+	}
+
+	KpfaError_t error = pTransData->ParseInput(linebuf, 1);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	uint32_t nWindingCount = ((KpfaTransformerData *)pTransData)->m_nWindingCount;
+
+	for(uint32_t i = 0; i < nWindingCount; i++) {
+
+		// Line #3 (#4, #5)
+		if(rRawFile.GetLine(linebuf) == false) {
+			return KPFA_ERROR_TRANSFORMER_READ;
+		}
+
+		error = pTransData->ParseInput(linebuf, 2 + i);
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+	}
+
+	if(nWindingCount == 1) {
+
+		// Line #4
+		if(rRawFile.GetLine(linebuf) == false) {
+			return KPFA_ERROR_TRANSFORMER_READ;
+		}
+
+		error = pTransData->ParseInput(linebuf, 3);
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will parse the records of a section until its terminator or
+ * the end of the line reader. The parsed raw data depend on nothing but the
+ * lines, so that the sections can be parsed in any order.
+ *
+ * @param rRawFile line reader for raw file
+ * @param nDataType raw data type of the section
+ * @param rPool pool to create the raw data in
+ * @param rDataList list to keep the parsed raw data
+ * @param rEnd true if the terminator of the section has been read
+ * @return error information
+ */
+static KpfaError_t
+ParseSection(KpfaLineReader &rRawFile, KpfaRawDataType_t nDataType, KpfaRawDataPool &rPool,
+			 KpfaRawDataList_t &rDataList, bool &rEnd) {
+
+	KpfaStringView_t linebuf;
+
+	rEnd = false;
+
+	while(rRawFile.GetLine(linebuf)) {
+
+		// Check the end of the section
+		if(IsSectionEnd(nDataType, linebuf)) {
+			rEnd = true;
+			return KPFA_SUCCESS;
+		}
+
+		if(IsSkippedSection(nDataType)) {
+			continue;
+		}
+
+		KpfaRawData *rawData = rPool.NewRawData(nDataType);
+
+		if(rawData == NULL) {
+			KPFA_ERROR("ParseSection - Error to allocate memory.");
+			return KPFA_ERROR_MEMORY_ALLOC;
+		}
+
+		// Line #1
+		KpfaError_t error = rawData->ParseInput(linebuf, 0);
+
+		// Transformers have three or four lines more
+		if(error == KPFA_SUCCESS && nDataType == KPFA_RAW_TRANSFORMER) {
+			error = ParseTransformerData(rRawFile, rawData);
+		}
+
+		// The raw data is left in the pool
+		if(error != KPFA_SUCCESS) {
+			return error;
+		}
+
+		rDataList.push_back(rawData);
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will parse all the sections one after another.
+ *
+ * @param rRawFile line reader for raw file
+ * @param rPool pool to create the raw data in
+ * @param rSectionList list to keep the parsed sections
+ * @return error information
+ */
+static KpfaError_t
+ParseRawSections(KpfaLineReader &rRawFile, KpfaRawDataPool &rPool, KpfaRawSectionList_t &rSectionList) {
+
+	rSectionList.resize(KPFA_NUM_RAW_SECTIONS);
+
+	for(uint32_t i = 0; i < KPFA_NUM_RAW_SECTIONS; i++) {
+
+		KpfaRawSection_t &section = rSectionList[i];
+
+		section.nDataType = s_rRawSectionList[i];
+		section.pBegin = rRawFile.GetPosition();
+		section.nError = ParseSection(rRawFile, section.nDataType, rPool, section.rDataList, section.bLast);
+		section.pEnd = rRawFile.GetPosition();
+
+		if(section.nError != KPFA_SUCCESS) {
+			return section.nError;
+		}
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will find the boundaries of the sections by their terminators.
+ * A large section of one-line records is split into several parts.
+ *
+ * @param rRawFile line reader for raw file
+ * @param rSectionList list to keep the sections and the parts
+ */
+static void
+SplitRawSections(KpfaLineReader &rRawFile, KpfaRawSectionList_t &rSectionList) {
+
+	KpfaStringView_t linebuf;
+	KpfaRawSection_t section;
+
+	for(uint32_t i = 0; i < KPFA_NUM_RAW_SECTIONS; i++) {
+
+		section.nDataType = s_rRawSectionList[i];
+		section.pBegin = rRawFile.GetPosition();
+		section.bLast = false;
+		section.nError = KPFA_SUCCESS;
+
+		// Transformers are the only records with several lines
+		bool split = (IsSkippedSection(section.nDataType) == false &&
+					  section.nDataType != KPFA_RAW_TRANSFORMER);
+		uint32_t lineCount = 0;
+
+		while(rRawFile.GetLine(linebuf)) {
+
+			if(IsSectionEnd(section.nDataType, linebuf)) {
+				section.bLast = true;
+				break;
+			}
+
+			if(split == true && ++lineCount == KPFA_RAW_PARSE_CHUNK_LINES) {
+
+				section.pEnd = rRawFile.GetPosition();
+				rSectionList.push_back(section);
+
+				section.pBegin = section.pEnd;
+				lineCount = 0;
+			}
+		}
+
+		section.pEnd = rRawFile.GetPosition();
+		rSectionList.push_back(section);
+	}
+}
+
+/**
+ * This function will be run by each thread to parse the sections taken one by one.
+ *
+ * @param pSectionList sections of the raw data file
+ * @param pPool pool to create the raw data in
+ * @param pNext index of the next section to be parsed
+ */
+static void
+ParseRawSectionWorker(KpfaRawSectionList_t *pSectionList, KpfaRawDataPool *pPool,
+					  std::atomic<uint32_t> *pNext) {
+
+	uint32_t i;
+	bool end;
+
+	while((i = pNext->fetch_add(1)) < pSectionList->size()) {
+
+		KpfaRawSection_t &section = (*pSectionList)[i];
+		KpfaLineReader rawfile(section.pBegin, section.pEnd);
+
+		section.nError = ParseSection(rawfile, section.nDataType, *pPool, section.rDataList, end);
+
+		// The range must be consumed as it is in the sequential parsing
+		if(section.nError == KPFA_SUCCESS &&
+		  (end != section.bLast || rawfile.GetPosition() != section.pEnd)) {
+			section.nError = KPFA_FAILURE;
+		}
+	}
+}
+
+/**
+ * This function will parse the sections on several threads after finding their boundaries.
+ *
+ * @param rRawFile line reader for raw file
+ * @param rPool pool to create the raw data in
+ * @param rSectionList list to keep the parsed sections
+ * @return false if any section could not be parsed independently
+ */
+static bool
+ParseRawSectionsParallel(KpfaLineReader &rRawFile, KpfaRawDataPool &rPool, KpfaRawSectionList_t &rSectionList) {
+
+	SplitRawSections(rRawFile, rSectionList);
+
+	uint32_t threadCount = std::thread::hardware_concurrency();
+
+	if(threadCount == 0) {
+		threadCount = 1;
+	}
+
+	if(threadCount > rSectionList.size()) {
+		threadCount = rSectionList.size();
+	}
+
+	std::atomic<uint32_t> next(0);
+	std::vector<std::thread> threadList;
+
+	for(uint32_t i = 1; i < threadCount; i++) {
+		threadList.push_back(std::thread(ParseRawSectionWorker, &rSectionList, &rPool, &next));
+	}
+
+	// The calling thread also parses the sections
+	ParseRawSectionWorker(&rSectionList, &rPool, &next);
+
+	for(uint32_t i = 0; i < threadList.size(); i++) {
+		threadList[i].join();
+	}
+
+	for(uint32_t i = 0; i < rSectionList.size(); i++) {
+		if(rSectionList[i].nError != KPFA_SUCCESS) {
+			return false;
+		}
+	}
+
+	return true;
 }
 
 /**
  * This function will read the case ID data from the raw data file.
  *
- * @param rRawFile input stream for raw file
+ * @param rRawFile line reader for raw file
  * @return error information
  */
 KpfaError_t
-KpfaRawDataReader::ReadCaseData(ifstream &rRawFile) {
+KpfaRawDataReader::ReadCaseData(KpfaLineReader &rRawFile) {
 
 	string linebuf;
 
-	if(getline(rRawFile, linebuf).fail()) {
+	if(rRawFile.GetLine(linebuf) == false) {
 		return KPFA_ERROR_CASE_READ;
 	}
 
@@ -62,8 +430,8 @@ KpfaRawDataReader::ReadCaseData(ifstream &rRawFile) {
 	}
 
 	// Skip the following two lines of the case ID data.
-	getline(rRawFile, linebuf);
-	getline(rRawFile, linebuf);
+	rRawFile.GetLine(linebuf);
+	rRawFile.GetLine(linebuf);
 
 	// System base
 	m_nSysBase = m_rCaseData.m_nSbase;
@@ -72,47 +440,25 @@ KpfaRawDataReader::ReadCaseData(ifstream &rRawFile) {
 }
 
 /**
- * This function will read the bus data from the raw data file and parse them.
+ * This function will accept the bus data parsed from the raw data file.
  *
- * @param rRawFile input stream for raw file
+ * @param rDataList parsed bus data in the order of the file
  * @return error information
  */
 KpfaError_t
-KpfaRawDataReader::ReadBusData(ifstream &rRawFile) {
-
-	string linebuf;
-	
-	m_rBusDataList.clear();
-	m_rBusDataTable.clear();
-
-	while(!getline(rRawFile, linebuf).fail()) {
-
-		// Check the end of the bus data
-#if 0
-		if(linebuf.find("0 / END OF BUS DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
-		}
+KpfaRawDataReader::AcceptBusData(KpfaRawDataList_t &rDataList) {
 
-		KpfaBusData *busData = new KpfaBusData();
+	KpfaError_t error;
 
-		if(busData == NULL) {
-			KPFA_ERROR("ReadBusData - Error to allocate memory.");
-			return KPFA_ERROR_MEMORY_ALLOC;
-		}
+	m_rBusDataList.clear();
+	m_rBusDataTable.Clear();
 
-		KpfaError_t error = busData->ParseInput(linebuf);
+	for(uint32_t i = 0; i < rDataList.size(); i++) {
 
-		if(error != KPFA_SUCCESS) {
-			delete busData;
-			return error;
-		}
+		KpfaBusData *busData = (KpfaBusData *)rDataList[i];
 
 		// Ignore isolated buses
 		if(busData->m_nIde == KPFA_ISOLATED_BUS) {
-			delete busData;
 			continue;
 		}
 		else if(m_bFlat == true) {
@@ -142,50 +488,27 @@ KpfaRawDataReader::ReadBusData(ifstream &rRawFile) {
 }
 
 /**
- * This function will read the load data from the raw data file and parse them.
+ * This function will accept the load data parsed from the raw data file.
  *
- * @param rRawFile input stream for raw file
+ * @param rDataList parsed load data in the order of the file
  * @return error information
  */
 KpfaError_t
-KpfaRawDataReader::ReadLoadData(ifstream &rRawFile) {
+KpfaRawDataReader::AcceptLoadData(KpfaRawDataList_t &rDataList) {
 
-	string linebuf;
+	KpfaError_t error;
 
 	KpfaLoadData *loadData = NULL;
 	KpfaLoadData *prevLoadData = NULL;
 
 	m_rLoadDataList.clear();
 
-	while(!getline(rRawFile, linebuf).fail()) {
-
-		// Check the end of the load data
-#if 0
-		if(linebuf.find("0 / END OF LOAD DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
-		}
-
-		loadData = new KpfaLoadData();
-
-		if(loadData == NULL) {
-			KPFA_ERROR("ReadLoadData - Error to allocate memory.");
-			return KPFA_ERROR_MEMORY_ALLOC;
-		}
-
-
-		KpfaError_t error = loadData->ParseInput(linebuf);
+	for(uint32_t i = 0; i < rDataList.size(); i++) {
 
-		if(error != KPFA_SUCCESS) {
-			delete loadData;
-			return error;
-		}
+		loadData = (KpfaLoadData *)rDataList[i];
 
 		// Check the load status
 		if(loadData->m_bStatus == false) {
-			delete loadData;
 			continue;
 		}
 
@@ -198,12 +521,10 @@ KpfaRawDataReader::ReadLoadData(ifstream &rRawFile) {
 #else
 		if(loadBus == NULL || loadBus->m_nIde != KPFA_LOAD_BUS) {
 #endif
-			delete loadData;
 			continue;
 		}
 
 		if(loadData->m_nPl == 0 && loadData->m_nQl == 0) {
-			delete loadData;
 			continue;
 		}
 
@@ -248,43 +569,20 @@ KpfaRawDataReader::ReadLoadData(ifstream &rRawFile) {
 
 #if KPFA_RAW_DATA_VERSION == 33
 /**
- * This function will read the fixed shunt data from the raw data file and parse them.
+ * This function will accept the fixed shunt data parsed from the raw data file.
  *
- * @param rRawFile input stream for raw file
+ * @param rDataList parsed fixed shunt data in the order of the file
  * @return error information
  */
 KpfaError_t
-KpfaRawDataReader::ReadFixedShuntData(ifstream &rRawFile) {
-
-	string linebuf;
-
-	while(!getline(rRawFile, linebuf).fail()) {
-
-		// Check the end of the fixed shunt data
-#if 0
-		if(linebuf.find("0 / END OF FIXED SHUNT DATA") != string::npos) {
-#else
-		if(linebuf.find("0") == 0) {
-#endif
-			return KPFA_SUCCESS;
-		}
-
-		KpfaFixedShuntData *shuntData = new KpfaFixedShuntData();
-
-		if(shuntData == NULL) {
-			KPFA_ERROR("ReadFixedShuntData - Error to allocate memory.");
-			return KPFA_ERROR_MEMORY_ALLOC;
-		}
+KpfaRawDataReader::AcceptFixedShuntData(KpfaRawDataList_t &rDataList) {
 
-		KpfaError_t error = shuntData->ParseInput(linebuf);
+	for(uint32_t i = 0; i < rDataList.size(); i++) {
 
-		if(error != KPFA_SUCCESS) {
-			delete shuntData;
-			return error;
-		}
+		KpfaFixedShuntData *shuntData = (KpfaFixedShuntData *)rDataList[i];
 
 		// Transform the unit to p.u.
-		error = shuntData->TransformUnit(m_nSysBase);
+		KpfaError_t error = shuntData->TransformUnit(m_nSysBase);
 		KPFA_CHECK(error == KPFA_SUCCESS, KPFA_ERROR_INVALID_SBASE);
 
 		// Insert the new generator data into the generator data list.
@@ -296,41 +594,21 @@ KpfaRawDataReader::ReadFixedShuntData(ifstream &rRawFile) {
 #endif
 
 /**
- * This function will read the generator data from the raw data file and parse them.
+ * This function will accept the generator data parsed from the raw data file.
  *
- * @param rRawFile input stream for raw file
+ * @param rDataList parsed generator data in the order of the file
  * @return error information
  */
 KpfaError_t
-KpfaRawDataReader::ReadGenData(ifstream &rRawFile) {
-
-	string linebuf;
-	m_rGenDataList.clear();
-
-	while(!getline(rRawFile, linebuf).fail()) {
-
-		// Check the end of the load data
-#if 0
-		if(linebuf.find("0 / END OF GENERATOR DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
-		}
+KpfaRawDataReader::AcceptGenData(KpfaRawDataList_t &rDataList) {
 
-		KpfaGenData *genData = new KpfaGenData();
+	KpfaError_t error;
 
-		if(genData == NULL) {
-			KPFA_ERROR("ReadGenData - Error to allocate memory.");
-			return KPFA_ERROR_MEMORY_ALLOC;
-		}
+	m_rGenDataList.clear();
 
-		KpfaError_t error = genData->ParseInput(linebuf);
+	for(uint32_t i = 0; i < rDataList.size(); i++) {
 
-		if(error != KPFA_SUCCESS) {
-			delete genData;
-			return error;
-		}
+		KpfaGenData *genData = (KpfaGenData *)rDataList[i];
 
 		// Exception Handling
 		KpfaBusData *genBus = GetBusData(genData->m_nI);
@@ -341,14 +619,12 @@ KpfaRawDataReader::ReadGenData(ifstream &rRawFile) {
 #else
 		if(genBus == NULL || genBus->m_nIde != KPFA_GEN_BUS) {
 #endif
-			delete genData;
 			continue;
 		}
 
 		// Change the generator bus to a load bus if it it now working
 		if(genData->m_bStat == FALSE) {
 			genBus->m_nIde = KPFA_LOAD_BUS;
-			delete genData;
 			continue;
 		}
 
@@ -363,7 +639,6 @@ KpfaRawDataReader::ReadGenData(ifstream &rRawFile) {
 
 		if(prevGenData != NULL) {
 			prevGenData->MergeWith(genData);
-			delete genData;
 			continue;
 		}
 #endif
@@ -373,6 +648,7 @@ KpfaRawDataReader::ReadGenData(ifstream &rRawFile) {
 		genBus->m_nQt = genData->m_nQt;
 		genBus->m_nQb = genData->m_nQb;
 		genBus->m_nVm = genData->m_nVs;
+		genBus->m_nOrigVm = genBus->m_nVm;
 
 		if(m_bFlat == true) {
 			genData->m_nQg = 0;
@@ -386,49 +662,25 @@ KpfaRawDataReader::ReadGenData(ifstream &rRawFile) {
 }
 
 /**
- * This function will read the branch data from the raw data file and parse them.
+ * This function will accept the branch data parsed from the raw data file.
  *
- * @param rRawFile input stream for raw file
+ * @param rDataList parsed branch data in the order of the file
  * @return error information
  */
 KpfaError_t
-KpfaRawDataReader::ReadBranchData(ifstream &rRawFile) {
-
-	string linebuf;
+KpfaRawDataReader::AcceptBranchData(KpfaRawDataList_t &rDataList) {
 
 	m_rBranchDataList.clear();
 
-	while(!getline(rRawFile, linebuf).fail()) {
-
-		// Check the end of the load data
-#if 0
-		if(linebuf.find("0 / END OF BRANCH DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
-		}
-
-		KpfaBranchData *branchData = new KpfaBranchData();
-
-		if(branchData == NULL) {
-			KPFA_ERROR("ReadBranchData - Error to allocate memory.");
-			return KPFA_ERROR_MEMORY_ALLOC;
-		}
-
-		KpfaError_t error = branchData->ParseInput(linebuf);
+	for(uint32_t i = 0; i < rDataList.size(); i++) {
 
-		if(error != KPFA_SUCCESS) {
-			delete branchData;
-			return error;
-		}
+		KpfaBranchData *branchData = (KpfaBranchData *)rDataList[i];
 
 		// Exception Handling
 		KpfaBusData *branchBus1 = GetBusData(branchData->m_nI);
 		KpfaBusData *branchBus2 = GetBusData(branchData->m_nJ);
 
 		if(!branchData->m_bSt || branchBus1 == NULL || branchBus2 == NULL) {
-			delete branchData;
 			continue;
 		}
 
@@ -450,92 +702,32 @@ KpfaRawDataReader::ReadBranchData(ifstream &rRawFile) {
 }
 
 /**
- * This function will read the transformer data from the raw data file and parse them.
+ * This function will accept the transformer data parsed from the raw data file.
+ * Each transformer is added as one or three branches.
  *
- * @param rRawFile input stream for raw file
+ * @param rDataList parsed transformer data in the order of the file
  * @return error information
  */
 KpfaError_t
-KpfaRawDataReader::ReadTransformerData(ifstream &rRawFile) {
-
-	string linebuf;
+KpfaRawDataReader::AcceptTransformerData(KpfaRawDataList_t &rDataList) {
 
 	m_rTransformerDataList.clear();
 
-	while(!getline(rRawFile, linebuf).fail()) {
+	for(uint32_t i = 0; i < rDataList.size(); i++) {
 
-		// Check the end of the transformer data
-#if 0
-		if(linebuf.find("0 / END OF TRANSFORMER DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
-		}
+		KpfaTransformerData *transData = (KpfaTransformerData *)rDataList[i];
 
-		KpfaTransformerData *transData = new KpfaTransformerData();
-
-		if(transData == NULL) {
-			KPFA_ERROR("ReadTransformerData - Error to allocate memory.");
-			return KPFA_ERROR_MEMORY_ALLOC;
-		}
-
-		// Line #1
-		KpfaError_t error = transData->ParseInput(linebuf);
-
-		if(error != KPFA_SUCCESS) {
-			delete transData;
-			return error;
-		}
-
-		// Line #2
-		getline(rRawFile, linebuf);
-		error = transData->ParseInput(linebuf, 1);
-
-		if(error != KPFA_SUCCESS) {
-			delete transData;
-			return error;
-		}
-
-		uint32_t nWindingCount = transData->m_nWindingCount;
-
-		for(uint32_t i = 0; i < nWindingCount; i++) {
-
-			// Line #3 (#4, #5)
-			getline(rRawFile, linebuf);
-			error = transData->ParseInput(linebuf, 2 + i);
-
-			if(error != KPFA_SUCCESS) {
-				delete transData;
-				return error;
-			}
-		}
-
-		if(nWindingCount == 1) {
-
-			// Line #4
-			getline(rRawFile, linebuf);
-			error = transData->ParseInput(linebuf, 3);
-
-			if(error != KPFA_SUCCESS) {
-				delete transData;
-				return error;
-			}
-		}
-
-		// Exception Handling
-		KpfaBusData *transBus1 = GetBusData(transData->m_nI);
-		KpfaBusData *transBus2 = GetBusData(transData->m_nJ);
-		KpfaBusData *transBus3 = GetBusData(transData->m_nK);
+		// Exception Handling
+		KpfaBusData *transBus1 = GetBusData(transData->m_nI);
+		KpfaBusData *transBus2 = GetBusData(transData->m_nJ);
+		KpfaBusData *transBus3 = GetBusData(transData->m_nK);
 
 		if(transData->m_nStat == 0) {
-			delete transData;
 			continue;
 		}
 		
 		if(transBus1 == NULL || transBus2 == NULL ||
 		  (transBus3 == NULL && transData->m_nK != 0)) {
-			delete transData;
 			continue;
 		}
 
@@ -544,7 +736,8 @@ KpfaRawDataReader::ReadTransformerData(ifstream &rRawFile) {
 		// 3 winding transformers
 		if(transBus3 != NULL) {
 
-			KpfaBusData *newBus = new KpfaBusData();
+			KpfaBusData *newBus = (KpfaBusData *)m_rDataPool.NewRawData(KPFA_RAW_BUS);
+			KPFA_CHECK(newBus != NULL, KPFA_ERROR_MEMORY_ALLOC);
 
             newBus->m_nI = ++m_nMaxBusId;
 			newBus->m_rName = transData->m_rName;
@@ -553,13 +746,18 @@ KpfaRawDataReader::ReadTransformerData(ifstream &rRawFile) {
 			newBus->m_nVa = transData->m_nAnstar;
 
 			newBus->TransformUnit(m_nSysBase);
+
+			// To keep the original type of the bus
+			newBus->m_nOrigIde = newBus->m_nIde;
+			newBus->m_nOrigVm  = newBus->m_nVm;
 			
 			InsertBusData(newBus);
 
 			// three branches for 3 winding transformers
-			KpfaBranchData *branch1 = new KpfaBranchData();
-			KpfaBranchData *branch2 = new KpfaBranchData();
-			KpfaBranchData *branch3 = new KpfaBranchData();
+			KpfaBranchData *branch1 = (KpfaBranchData *)m_rDataPool.NewRawData(KPFA_RAW_BRANCH);
+			KpfaBranchData *branch2 = (KpfaBranchData *)m_rDataPool.NewRawData(KPFA_RAW_BRANCH);
+			KpfaBranchData *branch3 = (KpfaBranchData *)m_rDataPool.NewRawData(KPFA_RAW_BRANCH);
+			KPFA_CHECK(branch1 != NULL && branch2 != NULL && branch3 != NULL, KPFA_ERROR_MEMORY_ALLOC);
 
 			branch1->m_nCkt = transData->m_nCkt;
 			branch2->m_nCkt = transData->m_nCkt;
@@ -600,7 +798,8 @@ KpfaRawDataReader::ReadTransformerData(ifstream &rRawFile) {
 		// 2 winding transformers
 		else {
 
-			KpfaBranchData *branch1 = new KpfaBranchData();
+			KpfaBranchData *branch1 = (KpfaBranchData *)m_rDataPool.NewRawData(KPFA_RAW_BRANCH);
+			KPFA_CHECK(branch1 != NULL, KPFA_ERROR_MEMORY_ALLOC);
 
 			branch1->m_nCkt = transData->m_nCkt;
 			branch1->m_nI = transData->m_nI;
@@ -634,517 +833,483 @@ KpfaRawDataReader::ReadTransformerData(ifstream &rRawFile) {
 }
 
 /**
- * This function will read the area data from the raw data file and parse them.
+ * This function will accept the area data parsed from the raw data file.
  *
- * @param rRawFile input stream for raw file
+ * @param rDataList parsed area data in the order of the file
  * @return error information
  */
 KpfaError_t
-KpfaRawDataReader::ReadAreaData(ifstream &rRawFile) {
-
-	string linebuf;
-
-	m_rAreaDataList.clear();
+KpfaRawDataReader::AcceptAreaData(KpfaRawDataList_t &rDataList) {
 
-	while(!getline(rRawFile, linebuf).fail()) {
-
-		// Check the end of the area data
-#if 0
-		if(linebuf.find("0 / END OF AREA DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
-		}
-
-		KpfaAreaData *areaData = new KpfaAreaData();
-
-		if(areaData == NULL) {
-			KPFA_ERROR("ReadAreaData - Error to allocate memory.");
-			return KPFA_ERROR_MEMORY_ALLOC;
-		}
-
-		KpfaError_t error = areaData->ParseInput(linebuf);
-
-		if(error != KPFA_SUCCESS) {
-			delete areaData;
-			return error;
-		}
-
-		m_rAreaDataList.push_back(areaData);
-	}
+	m_rAreaDataList.assign(rDataList.begin(), rDataList.end());
 
 	return KPFA_SUCCESS;
 }
 
 /**
- * This function will read the two terminal DC data from the raw data file and parse them.
+ * This function will accept the switched shunt data parsed from the raw data file.
  *
- * @param rRawFile input stream for raw file
+ * @param rDataList parsed switched shunt data in the order of the file
  * @return error information
  */
 KpfaError_t
-KpfaRawDataReader::ReadTwoTermData(ifstream &rRawFile) {
+KpfaRawDataReader::AcceptSwitchedShuntData(KpfaRawDataList_t &rDataList) {
 
-	string linebuf;
+	m_rSwitchedShuntDataList.clear();
 
-	m_rTwoTermDataList.clear();
+	for(uint32_t i = 0; i < rDataList.size(); i++) {
 
-	while(!getline(rRawFile, linebuf).fail()) {
+		KpfaSwitchedShuntData *shuntData = (KpfaSwitchedShuntData *)rDataList[i];
 
-		// Check the end of the two term DC data
-#if 0
-		if(linebuf.find("0 / END OF TWO-TERMINAL DC LINE DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
-		}
-
-#if 0
-		KpfaTwoTermData *twoTermData = new KpfaTwoTermData();
+		// Exception Handling
+		KpfaBusData *shuntBus = GetBusData(shuntData->m_nI);
 
-		if(twoTermData == NULL) {
-			KPFA_ERROR("ReadTwoTermData - Error to allocate memory.");
-			return KPFA_ERROR_MEMORY_ALLOC;
+		if(shuntBus == NULL) {
+			continue;
 		}
 
-		// Parse two terminal DC data
-		KpfaError_t error = twoTermData->ParseInput(linebuf);
+		// Transform the unit to p.u.
+		KpfaError_t error = shuntData->TransformUnit(m_nSysBase);
+		KPFA_CHECK(error == KPFA_SUCCESS, KPFA_ERROR_INVALID_SBASE);
 
-		if(error != KPFA_SUCCESS) {
-			delete twoTermData;
-			return error;
-		}
+		shuntBus->m_nBl -= shuntData->m_nBinit;
 
-		m_rTwoTermDataList.push_back(twoTermData);
-#endif
+		// Insert the new switchedShunt data into the switched shunt data list.
+		m_rSwitchedShuntDataList.push_back(shuntData);
 	}
 
 	return KPFA_SUCCESS;
 }
 
 /**
- * This function will read the VSC DC data from the raw data file and parse them.
+ * This function will accept the FACTS data parsed from the raw data file.
  *
- * @param rRawFile input stream for raw file
+ * @param rDataList parsed FACTS data in the order of the file
  * @return error information
  */
 KpfaError_t
-KpfaRawDataReader::ReadVscData(ifstream &rRawFile) {
+KpfaRawDataReader::AcceptFactsData(KpfaRawDataList_t &rDataList) {
 
-	string linebuf;
+	for(uint32_t i = 0; i < rDataList.size(); i++) {
 
-	m_rVscDataList.clear();
-
-	while(!getline(rRawFile, linebuf).fail()) {
-
-		// Check the end of the VSC DC data
-#if 0
-		if(linebuf.find("0 / END OF VSC DC LINE DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
-		}
+		KpfaFactsData *factsData = (KpfaFactsData *)rDataList[i];
 
-#if 0
-		KpfaVscData *vscData = new KpfaVscData();
+		// Exception Handling
+		KpfaGenData *genData = GetGenData(factsData->m_nI);
 
-		if(vscData == NULL) {
-			KPFA_ERROR("ReadVscData - Error to allocate memory.");
-			return KPFA_ERROR_MEMORY_ALLOC;
+		if(genData == NULL) {
+			continue;
 		}
 
-		// Parse VSC data
-		KpfaError_t error = vscData->ParseInput(linebuf);
-
-		if(error != KPFA_SUCCESS) {
-			delete vscData;
-			return error;
-		}
+		genData->m_bFacts = true;
 
-		m_rVscDataList.push_back(vscData);
-#endif
+		m_rFactsDataList.push_back(factsData);
 	}
 
 	return KPFA_SUCCESS;
 }
 
 /**
- * This function will read the switched shunt data from the raw data file and parse them.
+ * This function will accept the raw data of a section parsed from the raw data file.
+ * The sections must be accepted in the order of the file, since the records of a
+ * section refer to the buses and the generators accepted before.
  *
- * @param rRawFile input stream for raw file
+ * @param nDataType raw data type of the section
+ * @param rDataList parsed raw data in the order of the file
  * @return error information
  */
 KpfaError_t
-KpfaRawDataReader::ReadSwitchedShuntData(ifstream &rRawFile) {
+KpfaRawDataReader::AcceptSectionData(KpfaRawDataType_t nDataType, KpfaRawDataList_t &rDataList) {
 
-	string linebuf;
+	switch(nDataType) {
+		case KPFA_RAW_BUS:				return AcceptBusData(rDataList);
+		case KPFA_RAW_LOAD:				return AcceptLoadData(rDataList);
+#if KPFA_RAW_DATA_VERSION == 33
+		case KPFA_RAW_FIXED_SHUNT:		return AcceptFixedShuntData(rDataList);
+#endif
+		case KPFA_RAW_GEN:				return AcceptGenData(rDataList);
+		case KPFA_RAW_BRANCH:			return AcceptBranchData(rDataList);
+		case KPFA_RAW_TRANSFORMER:		return AcceptTransformerData(rDataList);
+		case KPFA_RAW_AREA_INTERCHANGE:	return AcceptAreaData(rDataList);
+		case KPFA_RAW_SWITCHED_SHUNT:	return AcceptSwitchedShuntData(rDataList);
+		case KPFA_RAW_FACTS:			return AcceptFactsData(rDataList);
+		default:						return KPFA_SUCCESS;
+	}
+}
 
-	m_rSwitchedShuntDataList.clear();
+/**
+* This function will be used to read a file including raw data on the given path.
+*
+* The sections are parsed first, on several threads if the parallel parsing
+* is enabled, and then accepted one by one in the order of the file. Thus
+* both ways give the same raw data including the order of the buses.
+*
+* @param pFilePath file path
+* @return error information
+*/
+KpfaError_t
+KpfaRawDataReader::ReadRawDataFile(const char *pFilePath) {
 
-	while(!getline(rRawFile, linebuf).fail()) {
+	KpfaError_t error;
+	KpfaMappedFile mappedfile;
 
-		// Check the end of the load data
-#if 0
-		if(linebuf.find("0 / END OF SWITCHED SHUNT DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
-		}
+	// Map the whole raw file and read its lines in place
+	error = mappedfile.Open(pFilePath);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
 
-		KpfaSwitchedShuntData *shuntData = new KpfaSwitchedShuntData();
+	// Load the snapshot instead if it has been written for the raw file
+	if(m_rSnapshotPath.empty() == false &&
+	   ReadSnapshotFile(m_rSnapshotPath.c_str(), mappedfile) == KPFA_SUCCESS) {
+		return KPFA_SUCCESS;
+	}
 
-		if(shuntData == NULL) {
-			KPFA_ERROR("ReadBranchData - Error to allocate memory.");
-			return KPFA_ERROR_MEMORY_ALLOC;
+	const char *fileEnd = mappedfile.GetData() + mappedfile.GetSize();
+	KpfaLineReader rawfile(mappedfile.GetData(), fileEnd);
+
+	m_rSysBusIds.clear();
+	m_rSysTable.clear();
+	m_nSysCount = 0;
+
+	// Case ID
+	error = ReadCaseData(rawfile);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	// Parse all the other sections
+	const char *sectionBegin = rawfile.GetPosition();
+	KpfaRawSectionList_t sectionList;
+	bool parsed = false;
+
+	if(m_bParallel == true) {
+
+		parsed = ParseRawSectionsParallel(rawfile, m_rDataPool, sectionList);
+
+		// Parse the whole file sequentially if a section has not been parsed as
+		// it is in the sequential parsing, which also reports the first error.
+		if(parsed == false) {
+			sectionList.clear();
+			ClearRawData(true);
+			rawfile.Assign(sectionBegin, fileEnd);
 		}
+	}
+
+	if(parsed == false) {
 
-		KpfaError_t error = shuntData->ParseInput(linebuf);
+		error = ParseRawSections(rawfile, m_rDataPool, sectionList);
 
 		if(error != KPFA_SUCCESS) {
-			delete shuntData;
+			ClearRawData(true);
 			return error;
 		}
+	}
 
-		// Exception Handling
-		KpfaBusData *shuntBus = GetBusData(shuntData->m_nI);
+	// Accept the sections in the order of the file
+	KpfaRawDataList_t dataList;
 
-		if(shuntBus == NULL) {
-			delete shuntBus;
+	m_nMaxBusId = 0;
+
+	for(uint32_t i = 0; i < sectionList.size(); i++) {
+
+		KpfaRawSection_t &section = sectionList[i];
+
+		dataList.insert(dataList.end(), section.rDataList.begin(), section.rDataList.end());
+		section.rDataList.clear();
+
+		// Merge the parts of a section
+		if(i + 1 < sectionList.size() && sectionList[i + 1].nDataType == section.nDataType) {
 			continue;
 		}
 
-		// Transform the unit to p.u.
-		error = shuntData->TransformUnit(m_nSysBase);
-		KPFA_CHECK(error == KPFA_SUCCESS, KPFA_ERROR_INVALID_SBASE);
+		error = AcceptSectionData(section.nDataType, dataList);
 
-		shuntBus->m_nBl -= shuntData->m_nBinit;
+		if(error != KPFA_SUCCESS) {
+			ClearRawData(true);
+			return error;
+		}
 
-		// Insert the new switchedShunt data into the switched shunt data list.
-		m_rSwitchedShuntDataList.push_back(shuntData);
+		dataList.clear();
 	}
 
-	return KPFA_SUCCESS;
-}
-
-/**
- * This function will read the impedance correction data from the raw data file and parse them.
- *
- * @param rRawFile input stream for raw file
- * @return error information
- */
-KpfaError_t
-KpfaRawDataReader::ReadImpCorrectData(ifstream &rRawFile) {
-
-	string linebuf;
+	// Keep the parsed raw data for the next run
+	if(m_rSnapshotPath.empty() == false) {
 
-	while(!getline(rRawFile, linebuf).fail()) {
+		error = WriteSnapshotFile(m_rSnapshotPath.c_str(), mappedfile);
 
-		// Check the end of the impedance correction data
-#if 0
-		if(linebuf.find("0 / END OF IMPEDANCE CORRECTION TABLE DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
+		if(error != KPFA_SUCCESS) {
+			KPFA_ERROR("ReadRawDataFile - Error to write the snapshot file.");
 		}
 	}
 
+	mappedfile.Close();
+
 	return KPFA_SUCCESS;
 }
 
 /**
- * This function will read the multi-terminal data from the raw data file and parse them.
+ * This function will store or load a list of the raw data of the given type.
  *
- * @param rRawFile input stream for raw file
- * @return error information
+ * @param rArchive archive of the raw data
+ * @param rPool pool to create the loaded raw data in
+ * @param nDataType raw data type of the list
+ * @param rDataList list of the raw data (empty if loading)
  */
-KpfaError_t
-KpfaRawDataReader::ReadMultiTermData(ifstream &rRawFile) {
+static void
+SerializeDataList(KpfaRawDataArchive &rArchive, KpfaRawDataPool &rPool,
+				  KpfaRawDataType_t nDataType, KpfaRawDataList_t &rDataList) {
 
-	string linebuf;
+	uint32_t count = (uint32_t)rDataList.size();
 
-	while(!getline(rRawFile, linebuf).fail()) {
+	rArchive.Field(count);
 
-		// Check the end of the multi-terminal dc line data
-#if 0
-		if(linebuf.find("0 / END OF MULTI-TERMINAL DC LINE DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
+	for(uint32_t i = 0; i < count && rArchive.IsValid(); i++) {
+
+		// Create the raw data to be loaded
+		if(rArchive.IsStoring() == false) {
+			rDataList.push_back(rPool.NewRawData(nDataType));
 		}
-	}
 
-	return KPFA_SUCCESS;
+		rDataList[i]->Serialize(rArchive);
+	}
 }
 
 /**
- * This function will read the multi-section data from the raw data file and parse them.
+ * This function will store the parsed raw data and the sub-systems into the archive
+ * or load them from it.
  *
- * @param rRawFile input stream for raw file
- * @return error information
+ * @param rArchive archive of the raw data
  */
-KpfaError_t
-KpfaRawDataReader::ReadMultiSectData(ifstream &rRawFile) {
+void
+KpfaRawDataReader::Serialize(KpfaRawDataArchive &rArchive) {
 
-	string linebuf;
+	rArchive.Field(m_nSysBase);
+	rArchive.Field(m_nMaxBusId);
 
-	while(!getline(rRawFile, linebuf).fail()) {
+	// Case ID
+	m_rCaseData.Serialize(rArchive);
 
-		// Check the end of the multi-section line data
-#if 0
-		if(linebuf.find("0 / END OF MULTI-SECTION LINE DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
+	SerializeDataList(rArchive, m_rDataPool, KPFA_RAW_BUS, m_rBusDataList);
+	SerializeDataList(rArchive, m_rDataPool, KPFA_RAW_LOAD, m_rLoadDataList);
+#if KPFA_RAW_DATA_VERSION == 33
+	SerializeDataList(rArchive, m_rDataPool, KPFA_RAW_FIXED_SHUNT, m_rFixedShuntDataList);
 #endif
-			return KPFA_SUCCESS;
-		}
-	}
+	SerializeDataList(rArchive, m_rDataPool, KPFA_RAW_GEN, m_rGenDataList);
+	SerializeDataList(rArchive, m_rDataPool, KPFA_RAW_BRANCH, m_rBranchDataList);
+	SerializeDataList(rArchive, m_rDataPool, KPFA_RAW_TRANSFORMER, m_rTransformerDataList);
+	SerializeDataList(rArchive, m_rDataPool, KPFA_RAW_AREA_INTERCHANGE, m_rAreaDataList);
+	SerializeDataList(rArchive, m_rDataPool, KPFA_RAW_SWITCHED_SHUNT, m_rSwitchedShuntDataList);
+	SerializeDataList(rArchive, m_rDataPool, KPFA_RAW_FACTS, m_rFactsDataList);
 
-	return KPFA_SUCCESS;
-}
+	// Sub-systems as the pairs of bus ID and sub-system ID
+	uint32_t id, sys, count = (uint32_t)m_rSysTable.size();
 
-/**
- * This function will read the zone data from the raw data file and parse them.
- *
- * @param rRawFile input stream for raw file
- * @return error information
- */
-KpfaError_t
-KpfaRawDataReader::ReadZoneData(ifstream &rRawFile) {
+	rArchive.Field(m_nSysCount);
+	rArchive.Field(count);
 
-	string linebuf;
+	if(rArchive.IsStoring() == true) {
 
-	while(!getline(rRawFile, linebuf).fail()) {
+		for(uint32_t i = 0; i < count; i++) {
 
-		// Check the end of the zone data
-#if 0
-		if(linebuf.find("0 / END OF ZONE DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
+			id = m_rSysBusIds[i];
+			sys = m_rSysTable[i];
+
+			rArchive.Field(id);
+			rArchive.Field(sys);
 		}
 	}
+	else {
 
-	return KPFA_SUCCESS;
-}
+		for(uint32_t i = 0; i < count && rArchive.IsValid(); i++) {
 
-/**
- * This function will read the inter-area data from the raw data file and parse them.
- *
- * @param rRawFile input stream for raw file
- * @return error information
- */
-KpfaError_t
-KpfaRawDataReader::ReadInterAreaData(ifstream &rRawFile) {
-
-	string linebuf;
+			rArchive.Field(id);
+			rArchive.Field(sys);
 
-	while(!getline(rRawFile, linebuf).fail()) {
-
-		// Check the end of the inter-area transfer data
-#if 0
-		if(linebuf.find("0 / END OF INTER-AREA TRANSFER DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
+			// The pairs are stored in the order of the bus ID
+			m_rSysBusIds.push_back(id);
+			m_rSysTable.push_back(sys);
 		}
 	}
-
-	return KPFA_SUCCESS;
 }
 
 /**
- * This function will read the owner data from the raw data file and parse them.
+ * This function will clear all the lists and tables of the raw data.
  *
- * @param rRawFile input stream for raw file
- * @return error information
+ * @param bDelete true to release the raw data in the pool as well
  */
-KpfaError_t
-KpfaRawDataReader::ReadOwnerData(ifstream &rRawFile) {
-
-	string linebuf;
-
-	while(!getline(rRawFile, linebuf).fail()) {
+void
+KpfaRawDataReader::ClearRawData(bool bDelete) {
 
-		// Check the end of the owner data
-#if 0
-		if(linebuf.find("0 / END OF OWNER DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
+	KpfaRawDataList_t *dataLists[] = {
+		&m_rBusDataList,
+		&m_rLoadDataList,
+#if KPFA_RAW_DATA_VERSION == 33
+		&m_rFixedShuntDataList,
 #endif
-			return KPFA_SUCCESS;
-		}
+		&m_rGenDataList,
+		&m_rBranchDataList,
+		&m_rTransformerDataList,
+		&m_rAreaDataList,
+		&m_rTwoTermDataList,
+		&m_rVscDataList,
+		&m_rSwitchedShuntDataList,
+		&m_rFactsDataList,
+	};
+
+	for(uint32_t i = 0; i < sizeof(dataLists) / sizeof(dataLists[0]); i++) {
+		dataLists[i]->clear();
 	}
 
-	return KPFA_SUCCESS;
+	// All the raw data including the dropped ones are released at once
+	if(bDelete == true) {
+		m_rDataPool.Release();
+	}
+
+	m_rBusDataTable.Clear();
+	m_rGenDataTable.Clear();
+	m_rLoadDataTable.Clear();
+
+	m_rSysBusIds.clear();
+	m_rSysTable.clear();
+	m_nSysCount = 0;
 }
 
 /**
- * This function will read the FACTS data from the raw data file and parse them.
+ * This function will load the parsed raw data from the snapshot file if it has been
+ * written for the given raw data file. The size, the modification time and the hash
+ * of the raw data file must be the same as when the snapshot was written.
  *
- * @param rRawFile input stream for raw file
+ * @param pFilePath snapshot file path
+ * @param rRawFile mapped raw data file
  * @return error information
  */
 KpfaError_t
-KpfaRawDataReader::ReadFactsData(ifstream &rRawFile) {
-
-	string linebuf;
+KpfaRawDataReader::ReadSnapshotFile(const char *pFilePath, KpfaMappedFile &rRawFile) {
 
-	while(!getline(rRawFile, linebuf).fail()) {
+	KpfaMappedFile snapshot;
 
-		// Check the end of the FACTS device data
-#if 0
-		if(linebuf.find("0 / END OF FACTS DEVICE DATA") != string::npos) {
-#else
-		if(linebuf.find("0 /") != string::npos) {
-#endif
-			return KPFA_SUCCESS;
-		}
+	KpfaError_t error = snapshot.Open(pFilePath);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
 
-		KpfaFactsData *factsData = new KpfaFactsData();
+	const KpfaRawSnapshotHeader_t *header = (const KpfaRawSnapshotHeader_t *)snapshot.GetData();
+	const char *data = snapshot.GetData() + sizeof(KpfaRawSnapshotHeader_t);
+	uint32_t flags = (m_bFlat == true) ? KPFA_RAW_SNAPSHOT_FLAT : 0;
+
+	// Check the format and the options of the snapshot
+	if(snapshot.GetSize() < sizeof(KpfaRawSnapshotHeader_t) ||
+	   header->nMagic != KPFA_RAW_SNAPSHOT_MAGIC ||
+	   header->nVersion != KPFA_RAW_SNAPSHOT_VERSION ||
+	   header->nHeaderSize != sizeof(KpfaRawSnapshotHeader_t) ||
+	   header->nRawDataVersion != KPFA_RAW_DATA_VERSION ||
+	   header->nFlags != flags ||
+	   header->nDataSize != snapshot.GetSize() - sizeof(KpfaRawSnapshotHeader_t)) {
+		return KPFA_ERROR_FILE_FORMAT;
+	}
 
-		if(factsData == NULL) {
-			KPFA_ERROR("ReadAreaData - Error to allocate memory.");
-			return KPFA_ERROR_MEMORY_ALLOC;
-		}
+	// Check the raw data file and the archived raw data
+	if(header->nSourceSize != rRawFile.GetSize() ||
+	   header->nSourceTime != rRawFile.GetModifyTime() ||
+	   header->nSourceHash != KpfaHashData(rRawFile.GetData(), rRawFile.GetSize()) ||
+	   header->nDataHash != KpfaHashData(data, header->nDataSize)) {
+		return KPFA_ERROR_FILE_FORMAT;
+	}
 
-		KpfaError_t error = factsData->ParseInput(linebuf);
+	ClearRawData(false);
 
-		if(error != KPFA_SUCCESS) {
-			delete factsData;
-			return error;
-		}
+	KpfaRawDataArchive archive(data, data + header->nDataSize);
+	Serialize(archive);
 
-		// Exception Handling
-		KpfaGenData *genData = GetGenData(factsData->m_nI);
+	if(archive.IsValid() == false || archive.IsEnd() == false) {
+		ClearRawData(true);
+		return KPFA_ERROR_FILE_FORMAT;
+	}
 
-		if(genData == NULL) {
-			delete factsData;
-			continue;
-		}
+	// Build the tables in the same order as the raw data were accepted
+	for(uint32_t i = 0; i < m_rBusDataList.size(); i++) {
+		m_rBusDataTable.Insert(((KpfaBusData *)m_rBusDataList[i])->m_nI, m_rBusDataList[i]);
+	}
 
-		genData->m_bFacts = true;
+	for(uint32_t i = 0; i < m_rGenDataList.size(); i++) {
+		m_rGenDataTable.Insert(((KpfaGenData *)m_rGenDataList[i])->m_nI, m_rGenDataList[i]);
+	}
 
-		m_rFactsDataList.push_back(factsData);
+	for(uint32_t i = 0; i < m_rLoadDataList.size(); i++) {
+		m_rLoadDataTable.Insert(((KpfaLoadData *)m_rLoadDataList[i])->m_nI, m_rLoadDataList[i]);
 	}
 
 	return KPFA_SUCCESS;
 }
 
 /**
-* This function will be used to read a file including raw data on the given path.
-*
-* @param pFilePath file path
-* @return error information
-*/
+ * This function will write the parsed raw data and the sub-systems into the snapshot
+ * file together with the information to check the given raw data file.
+ *
+ * @param pFilePath snapshot file path
+ * @param rRawFile mapped raw data file
+ * @return error information
+ */
 KpfaError_t
-KpfaRawDataReader::ReadRawDataFile(const char *pFilePath) {
-
-	KpfaError_t error;
-	ifstream rawfile(pFilePath);
+KpfaRawDataReader::WriteSnapshotFile(const char *pFilePath, KpfaMappedFile &rRawFile) {
 
-	if(!rawfile.is_open()) {
-		cerr << "File Not Open: " << pFilePath << endl;
-		return KPFA_ERROR_FILE_OPEN;
+	// Sub-systems are kept in the snapshot as well
+	if(m_nSysCount == 0) {
+		SplitSubSystems();
 	}
 
-	// Case ID
-	error = ReadCaseData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
-
-	// Bus
-	m_nMaxBusId = 0;
-	error = ReadBusData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
-
-	// Load
-	error = ReadLoadData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
-
- #if KPFA_RAW_DATA_VERSION == 33
-	// FixedShunt
-	error = ReadFixedShuntData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
-#endif
-
-	// Generator
-	error = ReadGenData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
-
-	// Branch
-	error = ReadBranchData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
-
-	// Transformer
-	error = ReadTransformerData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
-
-	// Area
-	error = ReadAreaData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
-
-	// Two Terminal DC
-	error = ReadTwoTermData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
-
-	// VSC DC
-	error = ReadVscData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
+	std::vector<char> buffer;
+	KpfaRawDataArchive archive(buffer);
 
-	// Switched Shunt
-	error = ReadSwitchedShuntData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
+	Serialize(archive);
 
-	// Impedance Correction Table
-	error = ReadImpCorrectData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
+	KpfaRawSnapshotHeader_t header;
+	memset(&header, 0, sizeof(header));
 
-	// Multi-terminal DC
-	error = ReadMultiTermData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
+	header.nMagic = KPFA_RAW_SNAPSHOT_MAGIC;
+	header.nVersion = KPFA_RAW_SNAPSHOT_VERSION;
+	header.nHeaderSize = sizeof(KpfaRawSnapshotHeader_t);
+	header.nRawDataVersion = KPFA_RAW_DATA_VERSION;
+	header.nFlags = (m_bFlat == true) ? KPFA_RAW_SNAPSHOT_FLAT : 0;
+	header.nSourceSize = rRawFile.GetSize();
+	header.nSourceTime = rRawFile.GetModifyTime();
+	header.nSourceHash = KpfaHashData(rRawFile.GetData(), rRawFile.GetSize());
+	header.nDataSize = buffer.size();
+	header.nDataHash = KpfaHashData(buffer.data(), buffer.size());
 
-	// Multi-section
-	error = ReadMultiSectData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
+	// Write a temporary file first not to leave a broken snapshot
+	string tempPath = string(pFilePath) + ".tmp";
+	FILE *file = fopen(tempPath.c_str(), "wb");
 
-	// Zone
-	error = ReadZoneData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
+	if(file == NULL) {
+		cerr << "File Not Open: " << tempPath << endl;
+		return KPFA_ERROR_FILE_OPEN;
+	}
 
-	// Inter-area transfer
-	error = ReadInterAreaData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
+	bool written = (fwrite(&header, sizeof(header), 1, file) == 1 &&
+					fwrite(buffer.data(), buffer.size(), 1, file) == 1);
 
-	// Owner
-	error = ReadOwnerData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
+	if(fclose(file) != 0) {
+		written = false;
+	}
 
-	// FACTS
-	error = ReadFactsData(rawfile);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
+#ifdef _WIN32
+	// The existing file must be removed before renaming
+	if(written == true) {
+		remove(pFilePath);
+	}
+#endif
 
-	rawfile.close();
+	if(written == false || rename(tempPath.c_str(), pFilePath) != 0) {
+		remove(tempPath.c_str());
+		return KPFA_ERROR_FILE_WRITE;
+	}
 
 	return KPFA_SUCCESS;
 }
 
 /**
- * This function will split seperated buses into several groups.
- *
- * @return error information
+ * This function will split the buses into the sub-systems connected by the branches
+ * and the transformers.
  */
+void
+KpfaRawDataReader::SplitSubSystems() {
 
-KpfaRawDataMgmtList_t &
-KpfaRawDataReader::GetRawDataMgmts() {
-
-    // split sub-systems with connected buses using adjacency graph
     KpfaAdjacencyGraph graph;
 
     // add the edges of branches
@@ -1166,12 +1331,30 @@ KpfaRawDataReader::GetRawDataMgmts() {
         }
     }
 
+	// find connected components using adjacency graph
+	m_nSysCount = 0;
+	m_rSysTable = graph.SplitSubgraphs(m_nSysCount);
+	m_rSysBusIds = graph.GetVertexIds();
+}
+
+/**
+ * This function will split seperated buses into several groups.
+ *
+ * @return error information
+ */
+
+KpfaRawDataMgmtList_t &
+KpfaRawDataReader::GetRawDataMgmts() {
+
+    // split sub-systems unless they have been loaded from the snapshot
+	if(m_nSysCount == 0) {
+		SplitSubSystems();
+	}
+
 	m_rRawDataMgmtList.clear();
 
-	// find connected components using adjacency graph
-    uint32_t i, numSys = 0;
-    KpfaVertexTable_t::iterator siter;
-    KpfaVertexTable_t &sysTable = graph.SplitSubgraphs(numSys);
+    uint32_t i, numSys = m_nSysCount;
+    KpfaRawDataList_t::iterator iter;
 
     if(numSys == 0) {
     	return m_rRawDataMgmtList;
@@ -1184,6 +1367,9 @@ KpfaRawDataReader::GetRawDataMgmts() {
 
 		rawDataMgmt->m_nSysBase = m_nSysBase;
 
+		// Raw data created during the analysis are kept in the pool as well
+		rawDataMgmt->SetDataPool(&m_rDataPool);
+
         // 0. case
         m_rRawDataMgmtList.push_back(rawDataMgmt);
     }
@@ -1192,40 +1378,42 @@ KpfaRawDataReader::GetRawDataMgmts() {
     KpfaRawDataList_t &busList = m_rBusDataList;
     for(iter = busList.begin(); iter != busList.end(); iter++) {
         KpfaBusData *tmp = (KpfaBusData *)*iter;
-        m_rRawDataMgmtList[sysTable[tmp->m_nI]]->InsertBusData(tmp);
+        m_rRawDataMgmtList[GetSubSystem(tmp->m_nI)]->InsertBusData(tmp);
     }   
 
     // 2. load
     KpfaRawDataList_t &loadList = m_rLoadDataList;
     for(iter = loadList.begin(); iter != loadList.end(); iter++) {
         KpfaLoadData *tmp = (KpfaLoadData *)*iter;
-        m_rRawDataMgmtList[sysTable[tmp->m_nI]]->InsertLoadData(tmp);
+        m_rRawDataMgmtList[GetSubSystem(tmp->m_nI)]->InsertLoadData(tmp);
     }   
 
     // 3. generator
     KpfaRawDataList_t &genList = m_rGenDataList;
     for(iter = genList.begin(); iter != genList.end(); iter++) {
         KpfaGenData *tmp = (KpfaGenData *)*iter;
-        m_rRawDataMgmtList[sysTable[tmp->m_nI]]->InsertGenData(tmp);
+        m_rRawDataMgmtList[GetSubSystem(tmp->m_nI)]->InsertGenData(tmp);
     }  
 
     // 4. branch
+    KpfaRawDataList_t &branchList = m_rBranchDataList;
     for(iter = branchList.begin(); iter != branchList.end(); iter++) {
         KpfaBranchData *tmp = (KpfaBranchData *)*iter;
-        m_rRawDataMgmtList[sysTable[tmp->m_nI]]->InsertBranchData(tmp);
+        m_rRawDataMgmtList[GetSubSystem(tmp->m_nI)]->InsertBranchData(tmp);
     }     
 
     // 5. transformer
+    KpfaRawDataList_t &transList = m_rTransformerDataList;
     for(iter = transList.begin(); iter != transList.end(); iter++) {
         KpfaTransformerData *tmp = (KpfaTransformerData *)*iter;
-        m_rRawDataMgmtList[sysTable[tmp->m_nI]]->InsertTransformerData(tmp);
+        m_rRawDataMgmtList[GetSubSystem(tmp->m_nI)]->InsertTransformerData(tmp);
     } 
 
     // 6. area
     KpfaRawDataList_t &areaList = m_rAreaDataList;
     for(iter = areaList.begin(); iter != areaList.end(); iter++) {
         KpfaAreaData *tmp = (KpfaAreaData *)*iter;
-        m_rRawDataMgmtList[sysTable[tmp->m_nI]]->InsertAreaData(tmp);
+        m_rRawDataMgmtList[GetSubSystem(tmp->m_nI)]->InsertAreaData(tmp);
     }     
 
     // YOUNGSUN - CHKME
@@ -1235,14 +1423,14 @@ KpfaRawDataReader::GetRawDataMgmts() {
     KpfaRawDataList_t &twoTermList = m_rTwoTermDataList;
     for(iter = twoTermList.begin(); iter != twoTermList.end(); iter++) {
         KpfaTwoTermData *tmp = (KpfaTwoTermData *)*iter;
-        m_rRawDataMgmtList[sysTable[tmp->m_nI]]->InsertTwoTermData(tmp);
+        m_rRawDataMgmtList[GetSubSystem(tmp->m_nI)]->InsertTwoTermData(tmp);
     } 
 
     // 8. vsc
     KpfaRawDataList_t &vscList = m_rVscDataList;
     for(iter = vscList.begin(); iter != vscList.end(); iter++) {
         KpfaVscData *tmp = (KpfaVscData *)*iter;
-        m_rRawDataMgmtList[sysTable[tmp->m_nI]]->InsertVscData(tmp);
+        m_rRawDataMgmtList[GetSubSystem(tmp->m_nI)]->InsertVscData(tmp);
     }      
 #endif
 
@@ -1250,14 +1438,14 @@ KpfaRawDataReader::GetRawDataMgmts() {
     KpfaRawDataList_t &switchedShuntList = m_rSwitchedShuntDataList;
     for(iter = switchedShuntList.begin(); iter != switchedShuntList.end(); iter++) {
         KpfaSwitchedShuntData *tmp = (KpfaSwitchedShuntData *)*iter;
-        m_rRawDataMgmtList[sysTable[tmp->m_nI]]->InsertSwitchedShuntData(tmp);
+        m_rRawDataMgmtList[GetSubSystem(tmp->m_nI)]->InsertSwitchedShuntData(tmp);
     }  
     
     // 10. FACTS
     KpfaRawDataList_t &factsList = m_rFactsDataList;
     for(iter = factsList.begin(); iter != factsList.end(); iter++) {
         KpfaFactsData *tmp = (KpfaFactsData *)*iter;
-        m_rRawDataMgmtList[sysTable[tmp->m_nI]]->InsertFactsData(tmp);
+        m_rRawDataMgmtList[GetSubSystem(tmp->m_nI)]->InsertFactsData(tmp);
     }
 
 	return m_rRawDataMgmtList;
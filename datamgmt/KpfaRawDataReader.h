@@ -8,11 +8,44 @@
 #ifndef _KPFA_RAW_DATA_READER_H_
 #define _KPFA_RAW_DATA_READER_H_
 
+#include <stdint.h>
+
 #include "KpfaRawDataMgmt.h"
+#include "KpfaRawDataPool.h"
+#include "KpfaAdjacencyGraph.h"
+#include "KpfaMappedFile.h"
 
 // Raw Data Mgmt List
 typedef std::vector<KpfaRawDataMgmt*> KpfaRawDataMgmtList_t;
 
+// Magic number and version of the snapshot file of the raw data. The version
+// must be increased whenever the Serialize function of a raw data class changes.
+#define KPFA_RAW_SNAPSHOT_MAGIC		0x5346504B	// "KPFS"
+#define KPFA_RAW_SNAPSHOT_VERSION	1
+
+// Flags of the reader options stored in the snapshot file
+#define KPFA_RAW_SNAPSHOT_FLAT		0x1
+
+/**
+ * Header of the snapshot file of the raw data (native byte order).
+ * The archived raw data follow the header.
+ */
+typedef struct {
+	uint32_t nMagic;
+	uint32_t nVersion;
+	uint32_t nHeaderSize;
+	uint32_t nRawDataVersion;
+	uint32_t nFlags;
+	uint32_t nReserved;
+	// Size, modification time and hash of the raw data file
+	uint64_t nSourceSize;
+	int64_t nSourceTime;
+	uint64_t nSourceHash;
+	// Size and hash of the archived raw data
+	uint64_t nDataSize;
+	uint64_t nDataHash;
+} KpfaRawSnapshotHeader_t;
+
 /**
  * The declaration of the class for Raw Data Management
  */
@@ -23,6 +56,12 @@ private:
 	// Flat
 	bool m_bFlat;
 
+	// Parse the sections of the raw data file on several threads
+	bool m_bParallel;
+
+	// Snapshot file of the parsed raw data (empty if not used)
+	string m_rSnapshotPath;
+
 	// System base
 	double m_nSysBase;
 
@@ -32,6 +71,9 @@ private:
 	// Case ID
 	KpfaCaseData m_rCaseData;
 
+	// Pool owning all the raw data
+	KpfaRawDataPool m_rDataPool;
+
 	// Bus Data
 	KpfaRawDataList_t m_rBusDataList;
 	KpfaRawDataTable_t m_rBusDataTable;
@@ -73,6 +115,11 @@ private:
     // Raw Data Mgmt List
     KpfaRawDataMgmtList_t m_rRawDataMgmtList;
 
+	// Sorted bus IDs, the sub-system of each of them and the number of sub-systems
+	KpfaVertexList_t m_rSysBusIds;
+	KpfaVertexList_t m_rSysTable;
+	uint32_t m_nSysCount;
+
 public:
 
 	KpfaRawDataReader();
@@ -87,7 +134,7 @@ public:
 	inline void InsertBusData(KpfaBusData *pBusData) {
 	
 		// <key, value> := <i, the bus data>
-		m_rBusDataTable[pBusData->m_nI] = pBusData;
+		m_rBusDataTable.Insert(pBusData->m_nI, pBusData);
 		
 		// Insert the new bus data into the bus data list
 		m_rBusDataList.push_back(pBusData);	
@@ -101,7 +148,7 @@ public:
 	inline void InsertGenData(KpfaGenData *pGenData) {
 
 		// <key, value> := <i, the generator data>
-		m_rGenDataTable[pGenData->m_nI] = pGenData;
+		m_rGenDataTable.Insert(pGenData->m_nI, pGenData);
 		
 		// Insert the new generator data into the generator data list
 		m_rGenDataList.push_back(pGenData);	
@@ -115,7 +162,7 @@ public:
 	inline void InsertLoadData(KpfaLoadData *pLoadData) {
 	
 		// <key, value> := <i, the load data>
-		m_rLoadDataTable[pLoadData->m_nI] = pLoadData;
+		m_rLoadDataTable.Insert(pLoadData->m_nI, pLoadData);
 		
 		// Insert the new load data into the load data list
 		m_rLoadDataList.push_back(pLoadData);	
@@ -128,10 +175,7 @@ public:
 	 * @return Raw bus data with the bus ID, 'nBusId'
 	 */
 	inline KpfaBusData *GetBusData(uint32_t nBusId) {
-		if(m_rBusDataTable.count(nBusId) != 0) {
-			return (KpfaBusData *)m_rBusDataTable[nBusId];
-		}
-		return NULL;
+		return (KpfaBusData *)m_rBusDataTable.Find(nBusId);
 	}
 
 	/**
@@ -141,10 +185,27 @@ public:
 	 * @return Raw generator data with the bus ID, 'nBusId'
 	 */
 	inline KpfaGenData *GetGenData(uint32_t nBusId) {
-		if(m_rGenDataTable.count(nBusId) != 0) {
-			return (KpfaGenData *)m_rGenDataTable[nBusId];
-		}
-		return NULL;
+		return (KpfaGenData *)m_rGenDataTable.Find(nBusId);
+	}
+
+	/**
+	 * This function will enable or disable the parallel parsing of the sections.
+	 *
+	 * @param bParallel true to parse the sections on several threads
+	 */
+	inline void SetParallel(bool bParallel) {
+		m_bParallel = bParallel;
+	}
+
+	/**
+	 * This function will set the snapshot file of the parsed raw data. If the
+	 * snapshot is valid for the raw data file, it is loaded instead of the raw
+	 * data file. Otherwise it is written after the raw data file is parsed.
+	 *
+	 * @param pSnapshotPath snapshot file path (NULL or empty if not used)
+	 */
+	inline void SetSnapshotPath(const char *pSnapshotPath) {
+		m_rSnapshotPath = (pSnapshotPath != NULL) ? pSnapshotPath : "";
 	}
 
 	KpfaError_t ReadRawDataFile(const char *pFilePath);
@@ -161,39 +222,58 @@ public:
 
 private:
 
-	KpfaError_t ReadCaseData(ifstream &rRawFile);
+	KpfaError_t ReadCaseData(KpfaLineReader &rRawFile);
+
+	KpfaError_t ReadSnapshotFile(const char *pFilePath, KpfaMappedFile &rRawFile);
+
+	KpfaError_t WriteSnapshotFile(const char *pFilePath, KpfaMappedFile &rRawFile);
 
-	KpfaError_t ReadBusData(ifstream &rRawFile);
+	void Serialize(KpfaRawDataArchive &rArchive);
 
-	KpfaError_t ReadGenData(ifstream &rRawFile);
+	void ClearRawData(bool bDelete);
 
-	KpfaError_t ReadLoadData(ifstream &rRawFile);
+	void SplitSubSystems();
 
-	KpfaError_t ReadBranchData(ifstream &rRawFile);
+	/**
+	 * This function will return the sub-system of the given bus ID.
+	 * A bus without any branch and transformer belongs to the first sub-system.
+	 *
+	 * @param nBusId bus ID
+	 * @return sub-system ID
+	 */
+	inline uint32_t GetSubSystem(uint32_t nBusId) {
+
+		KpfaVertexList_t::iterator iter;
+		iter = std::lower_bound(m_rSysBusIds.begin(), m_rSysBusIds.end(), nBusId);
 
-	KpfaError_t ReadTransformerData(ifstream &rRawFile);
+		if(iter == m_rSysBusIds.end() || *iter != nBusId) {
+			return 0;
+		}
 
-	KpfaError_t ReadAreaData(ifstream &rRawFile);
+		return m_rSysTable[iter - m_rSysBusIds.begin()];
+	}
 
-	KpfaError_t ReadTwoTermData(ifstream &rRawFile);
+	KpfaError_t AcceptSectionData(KpfaRawDataType_t nDataType, KpfaRawDataList_t &rDataList);
 
-	KpfaError_t ReadVscData(ifstream &rRawFile);
+	KpfaError_t AcceptBusData(KpfaRawDataList_t &rDataList);
 
-	KpfaError_t	ReadSwitchedShuntData(ifstream &rRawFile);
+	KpfaError_t AcceptGenData(KpfaRawDataList_t &rDataList);
 
-	KpfaError_t ReadImpCorrectData(ifstream &rRawFile);
+	KpfaError_t AcceptLoadData(KpfaRawDataList_t &rDataList);
 
-	KpfaError_t ReadMultiTermData(ifstream &rRawFile);
+#if KPFA_RAW_DATA_VERSION == 33
+	KpfaError_t AcceptFixedShuntData(KpfaRawDataList_t &rDataList);
+#endif
 
-	KpfaError_t ReadMultiSectData(ifstream &rRawFile);
+	KpfaError_t AcceptBranchData(KpfaRawDataList_t &rDataList);
 
-	KpfaError_t ReadZoneData(ifstream &rRawFile);
+	KpfaError_t AcceptTransformerData(KpfaRawDataList_t &rDataList);
 
-	KpfaError_t ReadInterAreaData(ifstream &rRawFile);
+	KpfaError_t AcceptAreaData(KpfaRawDataList_t &rDataList);
 
-	KpfaError_t ReadOwnerData(ifstream &rRawFile);
+	KpfaError_t	AcceptSwitchedShuntData(KpfaRawDataList_t &rDataList);
 
-	KpfaError_t ReadFactsData(ifstream &rRawFile);
+	KpfaError_t AcceptFactsData(KpfaRawDataList_t &rDataList);
 };
 
 #endif /* _KPFA_RAW_DATA_READER_H_ */
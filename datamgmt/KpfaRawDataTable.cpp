@@ -0,0 +1,190 @@
+/*
+ * KpfaRawDataTable.cpp
+ */
+
+#include "KpfaRawDataTable.h"
+
+KpfaRawDataTable::KpfaRawDataTable() {
+
+	m_nHashShift = 0;
+	m_nCount = 0;
+	m_nMaxId = 0;
+	m_bDense = true;
+}
+
+/**
+ * This function will insert the raw data with the given ID into the table.
+ * The raw data already in the table with the same ID are replaced.
+ *
+ * @param nId bus ID
+ * @param pData raw data
+ */
+void
+KpfaRawDataTable::Insert(uint32_t nId, KpfaRawData *pData) {
+
+	assert(pData != NULL);
+
+	if(Find(nId) == NULL) {
+		m_nCount++;
+	}
+
+	if(nId > m_nMaxId) {
+		m_nMaxId = nId;
+	}
+
+	// Check whether the IDs are still dense enough to be indexed directly
+	bool dense = (m_nMaxId < KPFA_RAW_DATA_TABLE_MIN_DENSE ||
+				  m_nMaxId / KPFA_RAW_DATA_TABLE_DENSITY < m_nCount);
+
+	if(dense != m_bDense) {
+		Rebuild(dense);
+	}
+	else if(dense == false && m_nCount * 2 > m_rHashTable.size()) {
+		Rebuild(dense);
+	}
+
+	if(m_bDense == true) {
+
+		if(nId >= m_rDenseTable.size()) {
+			m_rDenseTable.resize(nId + 1, NULL);
+		}
+
+		m_rDenseTable[nId] = pData;
+	}
+	else {
+		InsertHash(nId, pData);
+	}
+}
+
+/**
+ * This function will remove all the raw data from the table.
+ */
+void
+KpfaRawDataTable::Clear() {
+
+	std::vector<KpfaRawData *>().swap(m_rDenseTable);
+	std::vector<KpfaRawDataTableEntry_t>().swap(m_rHashTable);
+
+	m_nHashShift = 0;
+	m_nCount = 0;
+	m_nMaxId = 0;
+	m_bDense = true;
+}
+
+/**
+ * This function will insert the raw data into the hash table which has an empty slot.
+ *
+ * @param nId bus ID
+ * @param pData raw data
+ */
+void
+KpfaRawDataTable::InsertHash(uint32_t nId, KpfaRawData *pData) {
+
+	uint32_t mask = (uint32_t)m_rHashTable.size() - 1;
+	uint32_t i = HashId(nId);
+
+	while(m_rHashTable[i].pData != NULL && m_rHashTable[i].nId != nId) {
+		i = (i + 1) & mask;
+	}
+
+	m_rHashTable[i].nId = nId;
+	m_rHashTable[i].pData = pData;
+}
+
+/**
+ * This function will move the raw data into the dense table or a new hash table
+ * with enough slots for the current number of IDs.
+ *
+ * @param bDense true to index the raw data directly by ID
+ */
+void
+KpfaRawDataTable::Rebuild(bool bDense) {
+
+	std::vector<KpfaRawDataTableEntry_t> entries;
+	KpfaRawDataTableEntry_t entry;
+
+	entries.reserve(m_nCount);
+
+	// Collect the pairs of ID and raw data in the table
+	if(m_bDense == true) {
+
+		for(uint32_t i = 0; i < m_rDenseTable.size(); i++) {
+
+			if(m_rDenseTable[i] != NULL) {
+				entry.nId = i;
+				entry.pData = m_rDenseTable[i];
+				entries.push_back(entry);
+			}
+		}
+	}
+	else {
+
+		for(uint32_t i = 0; i < m_rHashTable.size(); i++) {
+
+			if(m_rHashTable[i].pData != NULL) {
+				entries.push_back(m_rHashTable[i]);
+			}
+		}
+	}
+
+	std::vector<KpfaRawData *>().swap(m_rDenseTable);
+	std::vector<KpfaRawDataTableEntry_t>().swap(m_rHashTable);
+
+	m_bDense = bDense;
+
+	if(m_bDense == true) {
+
+		m_rDenseTable.resize(m_nMaxId + 1, NULL);
+
+		for(uint32_t i = 0; i < entries.size(); i++) {
+			m_rDenseTable[entries[i].nId] = entries[i].pData;
+		}
+	}
+	else {
+
+		// At most a half of the slots are used
+		uint32_t size = 16;
+
+		m_nHashShift = 28;
+
+		while(size < m_nCount * 2) {
+			size <<= 1;
+			m_nHashShift--;
+		}
+
+		entry.nId = 0;
+		entry.pData = NULL;
+
+		m_rHashTable.assign(size, entry);
+
+		for(uint32_t i = 0; i < entries.size(); i++) {
+			InsertHash(entries[i].nId, entries[i].pData);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaRawDataTable::Write(ostream &rOut) {
+
+	rOut << "KPFA RAW DATA TABLE: " << endl;
+
+	rOut << "\tCOUNT: " << m_nCount << endl;
+	rOut << "\tMAX ID: " << m_nMaxId << endl;
+
+	if(m_bDense == true) {
+		rOut << "\tDENSE: " << m_rDenseTable.size() << endl;
+	}
+	else {
+		rOut << "\tHASH: " << m_rHashTable.size() << endl;
+	}
+}
+
+ostream &operator << (ostream &rOut, KpfaRawDataTable *pTable) {
+
+	pTable->Write(rOut);
+	return rOut;
+}
@@ -0,0 +1,144 @@
+/*
+ * KpfaRawDataTable.h
+ */
+
+#ifndef _KPFA_RAW_DATA_TABLE_H_
+#define _KPFA_RAW_DATA_TABLE_H_
+
+#include <stdint.h>
+
+#include "KpfaDebug.h"
+#include "KpfaConfig.h"
+#include "KpfaRawData.h"
+
+// The IDs are indexed directly while the largest ID is below this size
+#define KPFA_RAW_DATA_TABLE_MIN_DENSE	4096
+
+// ... or while at least one of this number of IDs is in use
+#define KPFA_RAW_DATA_TABLE_DENSITY		4
+
+/**
+ * Entry of the hash table for sparse IDs (empty if pData is NULL)
+ */
+typedef struct {
+
+	uint32_t nId;
+
+	KpfaRawData *pData;
+
+} KpfaRawDataTableEntry_t;
+
+/**
+ * The declaration of the class for the table of the raw data indexed by bus ID.
+ * While the bus IDs are dense, the raw data are kept in an array indexed by the
+ * bus ID itself, so that a lookup is a single array access. If the IDs become
+ * too sparse for the array (e.g. a small island with large bus numbers), the
+ * table switches to an open-addressing hash table with linear probing.
+ */
+class KpfaRawDataTable {
+
+private:
+
+	// Raw data indexed by ID (used while the IDs are dense)
+	std::vector<KpfaRawData *> m_rDenseTable;
+
+	// Hash table of the pairs of ID and raw data (used for sparse IDs)
+	std::vector<KpfaRawDataTableEntry_t> m_rHashTable;
+
+	// Shift of the hash value for the size of the hash table
+	uint32_t m_nHashShift;
+
+	// The number of IDs and the largest ID
+	uint32_t m_nCount;
+	uint32_t m_nMaxId;
+
+	// Whether the raw data are kept in the dense table
+	bool m_bDense;
+
+public:
+
+	KpfaRawDataTable();
+
+	virtual ~KpfaRawDataTable() {
+		// Do nothing
+	}
+
+	/**
+	 * This function will return the raw data with the given ID.
+	 *
+	 * @param nId bus ID
+	 * @return the raw data (NULL if not found)
+	 */
+	inline KpfaRawData *Find(uint32_t nId) {
+
+		if(m_bDense == true) {
+			return (nId < m_rDenseTable.size()) ? m_rDenseTable[nId] : NULL;
+		}
+
+		uint32_t mask = (uint32_t)m_rHashTable.size() - 1;
+		uint32_t i = HashId(nId);
+
+		while(m_rHashTable[i].pData != NULL) {
+
+			if(m_rHashTable[i].nId == nId) {
+				return m_rHashTable[i].pData;
+			}
+
+			i = (i + 1) & mask;
+		}
+
+		return NULL;
+	}
+
+	/**
+	 * This function will return the number of IDs in the table.
+	 *
+	 * @return the number of IDs
+	 */
+	inline uint32_t GetCount() {
+		return m_nCount;
+	}
+
+	/**
+	 * This function will check whether the table is indexed directly by ID.
+	 *
+	 * @return true if dense
+	 */
+	inline bool IsDense() {
+		return m_bDense;
+	}
+
+	void Insert(uint32_t nId, KpfaRawData *pData);
+
+	void Clear();
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+
+	friend ostream &operator << (ostream &rOut, KpfaRawDataTable *pTable);
+
+private:
+
+	/**
+	 * This function will return the home slot of the given ID in the hash table.
+	 *
+	 * @param nId bus ID
+	 * @return slot index
+	 */
+	inline uint32_t HashId(uint32_t nId) {
+		return (uint32_t)(nId * 2654435769U) >> m_nHashShift;
+	}
+
+	void InsertHash(uint32_t nId, KpfaRawData *pData);
+
+	void Rebuild(bool bDense);
+
+	KpfaRawDataTable(const KpfaRawDataTable &);
+
+	KpfaRawDataTable &operator = (const KpfaRawDataTable &);
+};
+
+#endif /* _KPFA_RAW_DATA_TABLE_H_ */
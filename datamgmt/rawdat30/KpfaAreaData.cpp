@@ -32,35 +32,50 @@ KpfaAreaData::~KpfaAreaData() {
 KpfaError_t
 KpfaAreaData::ParseInput(string &rInputString, uint32_t nId) {
 
-  KpfaStringList_t tokens;
-  uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+  KpfaStringView_t input = { rInputString.data(), rInputString.size() };
+
+  return ParseInput(input, nId);
+}
+
+/**
+ * This function will parse the area data directly from a view of the input line
+ * (e.g. a line of the memory-mapped raw file) without any intermediate string.
+ *
+ * @param rInput a view with the area data to be parsed
+ * @return error information
+ */
+KpfaError_t
+KpfaAreaData::ParseInput(const KpfaStringView_t &rInput, uint32_t nId) {
+
+  KpfaStringView_t tokens[KPFA_NUM_AREA_DATA_ITEMS];
+  uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_AREA_DATA_ITEMS, ",");
 
   if(nTokens != KPFA_NUM_AREA_DATA_ITEMS) {
     return KPFA_ERROR_AREA_PARSE;
   }
 
 #if 0
-  KPFA_DEBUG("KpfaAreaData", "%s\n", rInputString.c_str());
+  KPFA_DEBUG("KpfaAreaData", "%.*s\n", (int)rInput.nSize, rInput.pData);
 #endif
 
   // Bus number (1 ~ 999997)
-  m_nI = (uint32_t)atoi(tokens[0].c_str());
+  m_nI = (uint32_t)KpfaParseInt(tokens[0]);
 
   if(m_nI == 0) {
     return KPFA_ERROR_AREA_PARSE;
   }
 
   // Area slack bus number
-  m_nIsw = (uint32_t)atoi(tokens[1].c_str());
+  m_nIsw = (uint32_t)KpfaParseInt(tokens[1]);
 
   // Desired MW area interchange
-  m_nPdes = atof(tokens[2].c_str());
+  m_nPdes = KpfaParseDouble(tokens[2]);
 
   // Desired MW interchange tolerance
-  m_nPtol = atof(tokens[3].c_str());
+  m_nPtol = KpfaParseDouble(tokens[3]);
 
   // Area name
-  m_rName = tokens[4];
+  m_rName.assign(tokens[4].pData, tokens[4].nSize);
 
   return KPFA_SUCCESS;
 }
@@ -76,6 +91,21 @@ KpfaAreaData::TransformUnit(double nSbase) {
   return KPFA_SUCCESS;
 }
 
+/**
+ * This function will store the values of the raw data into the archive or load them from it.
+ *
+ * @param rArchive archive of the raw data
+ */
+void
+KpfaAreaData::Serialize(KpfaRawDataArchive &rArchive) {
+
+  rArchive.Field(m_nI);
+  rArchive.Field(m_nIsw);
+  rArchive.Field(m_nPdes);
+  rArchive.Field(m_nPtol);
+  rArchive.Field(m_rName);
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
@@ -63,74 +63,83 @@ KpfaBranchData::~KpfaBranchData() {
 KpfaError_t
 KpfaBranchData::ParseInput(string &rInputString, uint32_t nId) {
 
+  KpfaStringView_t input = { rInputString.data(), rInputString.size() };
+
+  return ParseInput(input, nId);
+}
+
+/**
+ * This function will parse the branch data directly from a view of the input line
+ * (e.g. a line of the memory-mapped raw file) without any intermediate string.
+ *
+ * @param rInput a view with the branch data to be parsed
+ * @return error information
+ */
+KpfaError_t
+KpfaBranchData::ParseInput(const KpfaStringView_t &rInput, uint32_t nId) {
+
   uint32_t i = 0, j;
-  KpfaStringList_t tokens;
-  uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+
+  // One more token for the missing fraction of an odd owner list
+  KpfaStringView_t tokens[KPFA_MAX_NUM_BRANCH_DATA_ITEMS + 1];
+  memset(tokens, 0, sizeof(tokens));
+
+  uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_MAX_NUM_BRANCH_DATA_ITEMS, ",");
 
   if(nTokens < KPFA_MIN_NUM_BRANCH_DATA_ITEMS ||
     nTokens > KPFA_MAX_NUM_BRANCH_DATA_ITEMS) {
     return KPFA_ERROR_BRANCH_PARSE;
   }
 
-#if 0
-  KPFA_DEBUG("KpfaBranchData", "%s\n", rInputString.c_str());
-#endif
-
   // Branch from bus number
-  m_nI = (uint32_t)abs(atoi(tokens[i++].c_str()));
+  m_nI = (uint32_t)abs(KpfaParseInt(tokens[i++]));
 
   if(m_nI == 0) {
     return KPFA_ERROR_BRANCH_PARSE;
   }
 
   // Branch to bus number
-  m_nJ = (uint32_t)abs(atoi(tokens[i++].c_str()));
+  m_nJ = (uint32_t)abs(KpfaParseInt(tokens[i++]));
 
   // Branch circuit ID
-#if 0
-  char *ckt = tokens[i++].c_str();
-  m_nCkt = (uint32_t)(ckt[1] - '0');
-#else
-  string &ckt = KpfaStripQuotes(tokens[i++]);
-  m_nCkt = (uint32_t)atoi(ckt.c_str());
-#endif
+  m_nCkt = (uint32_t)KpfaParseInt(KpfaStripQuotesView(tokens[i++]));
 
   // Branch resistance
-  m_nR = atof(tokens[i++].c_str());
+  m_nR = KpfaParseDouble(tokens[i++]);
 
   // Branch reactance
-  m_nX = atof(tokens[i++].c_str());
+  m_nX = KpfaParseDouble(tokens[i++]);
 
   // Total branch charging susceptance
-  m_nB = atof(tokens[i++].c_str());
+  m_nB = KpfaParseDouble(tokens[i++]);
 
   // First, second, and third ratings
-  m_nRatea = atof(tokens[i++].c_str());
-  m_nRateb = atof(tokens[i++].c_str());
-  m_nRatec = atof(tokens[i++].c_str());
+  m_nRatea = KpfaParseDouble(tokens[i++]);
+  m_nRateb = KpfaParseDouble(tokens[i++]);
+  m_nRatec = KpfaParseDouble(tokens[i++]);
 
   // Complex admittance of the line shunt at the bus I end of the branch
-  m_nGi = atof(tokens[i++].c_str());
-  m_nBi = atof(tokens[i++].c_str());
+  m_nGi = KpfaParseDouble(tokens[i++]);
+  m_nBi = KpfaParseDouble(tokens[i++]);
 
   // Complex admittance of the line shunt at the bus J end of the branch
-  m_nGj = atof(tokens[i++].c_str());
-  m_nBj = atof(tokens[i++].c_str());
+  m_nGj = KpfaParseDouble(tokens[i++]);
+  m_nBj = KpfaParseDouble(tokens[i++]);
 
   // Branch status (0: out-of-service, 1: in-service)
-  m_bSt = (bool_t)atoi(tokens[i++].c_str());
+  m_bSt = (bool_t)KpfaParseInt(tokens[i++]);
 
   // Line length
-  m_nLen = atof(tokens[i++].c_str());
+  m_nLen = KpfaParseDouble(tokens[i++]);
 
   // The number of owners
-  for(j = 0; i < nTokens; j++) {
+  for(j = 0; i + 1 < nTokens; j++) {
 
   // Owner number (1 ~ 9999).
-  m_nO[j] = (uint16_t)atoi(tokens[i++].c_str());
+  m_nO[j] = (uint16_t)KpfaParseInt(tokens[i++]);
 
   // Fraction of total ownership assigned to owner Qi
-  m_nF[j] = atof(tokens[i++].c_str());
+  m_nF[j] = KpfaParseDouble(tokens[i++]);
   }
 
   m_nOwnerCount = j;
@@ -138,6 +147,39 @@ KpfaBranchData::ParseInput(string &rInputString, uint32_t nId) {
   return KPFA_SUCCESS;
 }
 
+/**
+ * This function will store the values of the raw data into the archive or load them from it.
+ *
+ * @param rArchive archive of the raw data
+ */
+void
+KpfaBranchData::Serialize(KpfaRawDataArchive &rArchive) {
+
+	rArchive.Field(m_nI);
+	rArchive.Field(m_nJ);
+	rArchive.Field(m_nCkt);
+	rArchive.Field(m_nR);
+	rArchive.Field(m_nX);
+	rArchive.Field(m_nB);
+	rArchive.Field(m_nRatea);
+	rArchive.Field(m_nRateb);
+	rArchive.Field(m_nRatec);
+	rArchive.Field(m_nGi);
+	rArchive.Field(m_nBi);
+	rArchive.Field(m_nGj);
+	rArchive.Field(m_nBj);
+	rArchive.Field(m_bSt);
+	rArchive.Field(m_nLen);
+	rArchive.Field(m_nOwnerCount);
+	rArchive.Field(m_nO);
+	rArchive.Field(m_nF);
+	rArchive.Field(m_nTap);
+	rArchive.Field(m_nPflow);
+	rArchive.Field(m_nQflow);
+	rArchive.Field(m_nPflow_JI);
+	rArchive.Field(m_nQflow_JI);
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
@@ -48,51 +48,62 @@ KpfaBusData::~KpfaBusData() {
 KpfaError_t
 KpfaBusData::ParseInput(string &rInputString, uint32_t nId) {
 
-	KpfaStringList_t tokens;
-	uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+	KpfaStringView_t input = { rInputString.data(), rInputString.size() };
+
+	return ParseInput(input, nId);
+}
+
+/**
+ * This function will parse the bus data directly from a view of the input line
+ * (e.g. a line of the memory-mapped raw file) without any intermediate string.
+ *
+ * @param rInput a view with the bus data to be parsed
+ * @return error information
+ */
+KpfaError_t
+KpfaBusData::ParseInput(const KpfaStringView_t &rInput, uint32_t nId) {
+
+	KpfaStringView_t tokens[KPFA_NUM_BUS_DATA_ITEMS];
+	uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_BUS_DATA_ITEMS, ",");
 
 	if(nTokens != KPFA_NUM_BUS_DATA_ITEMS) {
 		return KPFA_ERROR_BUS_PARSE;
 	}
 
-#if 0
-	KPFA_DEBUG("KpfaBusData", "%s\n", rInputString.c_str());
-#endif
-
 	// Bus number (1 ~ 999997)
-	m_nI = (uint32_t)atoi(tokens[0].c_str());
+	m_nI = (uint32_t)KpfaParseInt(tokens[0]);
 
 	if(m_nI == 0) {
 		return KPFA_ERROR_BUS_PARSE;
 	}
 
 	// Bus name (up to 12 characters)
-	m_rName = tokens[1];
+	m_rName.assign(tokens[1].pData, tokens[1].nSize);
 
 	// Bus base voltage
-	m_nBaskv = atof(tokens[2].c_str());
+	m_nBaskv = KpfaParseDouble(tokens[2]);
 
 	// Bus type code
-	m_nIde = (KpfaBusType_t)atoi(tokens[3].c_str());
+	m_nIde = (KpfaBusType_t)KpfaParseInt(tokens[3]);
 
 	// Gl, Bl
-	m_nGl = atof(tokens[4].c_str());
-	m_nBl = atof(tokens[5].c_str());
+	m_nGl = KpfaParseDouble(tokens[4]);
+	m_nBl = KpfaParseDouble(tokens[5]);
 
 	// Area number (1 ~ 9999)
-	m_nArea = (uint16_t)atoi(tokens[6].c_str());
+	m_nArea = (uint16_t)KpfaParseInt(tokens[6]);
 
 	// Zone number (1 ~ 9999)
-	m_nZone = (uint16_t)atoi(tokens[7].c_str());
+	m_nZone = (uint16_t)KpfaParseInt(tokens[7]);
 
 	// Bus voltage magnitude
-	m_nVm = atof(tokens[8].c_str());
+	m_nVm = KpfaParseDouble(tokens[8]);
 
 	// Bus voltage phase angle
-	m_nVa = atof(tokens[9].c_str());
+	m_nVa = KpfaParseDouble(tokens[9]);
 
 	// Owner number (1 ~ 9999)
-	m_nOwner = (uint16_t)atoi(tokens[10].c_str());
+	m_nOwner = (uint16_t)KpfaParseInt(tokens[10]);
 
 	return KPFA_SUCCESS;
 }
@@ -119,6 +130,36 @@ KpfaBusData::TransformUnit(double nSbase) {
 	return KPFA_SUCCESS;
 }
 
+/**
+ * This function will store the values of the raw data into the archive or load them from it.
+ *
+ * @param rArchive archive of the raw data
+ */
+void
+KpfaBusData::Serialize(KpfaRawDataArchive &rArchive) {
+
+	rArchive.Field(m_nI);
+	rArchive.Field(m_rName);
+	rArchive.Field(m_nBaskv);
+	rArchive.Field(m_nIde);
+	rArchive.Field(m_nGl);
+	rArchive.Field(m_nBl);
+	rArchive.Field(m_nArea);
+	rArchive.Field(m_nZone);
+	rArchive.Field(m_nVm);
+	rArchive.Field(m_nVa);
+	rArchive.Field(m_nOwner);
+	rArchive.Field(m_nIdx);
+	rArchive.Field(m_nPl);
+	rArchive.Field(m_nQl);
+	rArchive.Field(m_nPg);
+	rArchive.Field(m_nQg);
+	rArchive.Field(m_nQt);
+	rArchive.Field(m_nQb);
+	rArchive.Field(m_nOrigVm);
+	rArchive.Field(m_nOrigIde);
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
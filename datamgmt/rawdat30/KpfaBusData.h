@@ -75,8 +75,12 @@ public:
 
 	virtual KpfaError_t ParseInput(string &rInputString, uint32_t nId = 0);
 
+	KpfaError_t ParseInput(const KpfaStringView_t &rInput, uint32_t nId = 0);
+
 	KpfaError_t TransformUnit(double nSbase);
 
+	void Serialize(KpfaRawDataArchive &rArchive);
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Functions
 	///////////////////////////////////////////////////////////////////
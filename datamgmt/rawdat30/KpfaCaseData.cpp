@@ -34,38 +34,69 @@ KpfaCaseData::~KpfaCaseData() {
 KpfaError_t
 KpfaCaseData::ParseInput(string &rInputString, uint32_t nId) {
 
-	KpfaStringList_t tokens;
-	uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+	KpfaStringView_t input = { rInputString.data(), rInputString.size() };
+
+	return ParseInput(input, nId);
+}
+
+/**
+ * This function will parse the case data directly from a view of the input line
+ * (e.g. a line of the memory-mapped raw file) without any intermediate string.
+ *
+ * @param rInput a view with the case data to be parsed
+ * @return error information
+ */
+KpfaError_t
+KpfaCaseData::ParseInput(const KpfaStringView_t &rInput, uint32_t nId) {
+
+	KpfaStringView_t tokens[KPFA_NUM_CASE_DATA_ITEMS];
+	uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_CASE_DATA_ITEMS, ",");
 
 	if(nTokens != KPFA_NUM_CASE_DATA_ITEMS) {
 		return KPFA_ERROR_CASE_PARSE;
 	}
 
 #if 0
-	KPFA_DEBUG("KpfaCaseData", "%s\n", rInputString.c_str());
+	KPFA_DEBUG("KpfaCaseData", "%.*s\n", (int)rInput.nSize, rInput.pData);
 #endif
 
 	// Case flag
-	m_bIc = (bool_t)atoi(tokens[0].c_str());
+	m_bIc = (bool_t)KpfaParseInt(tokens[0]);
 
 	// System MVA base
-	m_nSbase = atof(tokens[1].c_str());
+	m_nSbase = KpfaParseDouble(tokens[1]);
 
 	// PSSE revision number
-	m_nRev = (uint8_t)atoi(tokens[2].c_str());
+	m_nRev = (uint8_t)KpfaParseInt(tokens[2]);
 
 	// Units of transformer ratings
-	m_nXfrrat = atof(tokens[3].c_str());
+	m_nXfrrat = KpfaParseDouble(tokens[3]);
 
 	// Units of ratings of non-transformer branches
-	m_nNxfrat = atof(tokens[4].c_str());
+	m_nNxfrat = KpfaParseDouble(tokens[4]);
 
 	// System base frequency in Hertz
-	m_nBasfrq = atof(tokens[5].c_str());
+	m_nBasfrq = KpfaParseDouble(tokens[5]);
 
 	return KPFA_SUCCESS;
 }
 
+/**
+ * This function will store the values of the raw data into the archive or load them from it.
+ *
+ * @param rArchive archive of the raw data
+ */
+void
+KpfaCaseData::Serialize(KpfaRawDataArchive &rArchive) {
+
+	rArchive.Field(m_bIc);
+	rArchive.Field(m_nSbase);
+	rArchive.Field(m_nRev);
+	rArchive.Field(m_nXfrrat);
+	rArchive.Field(m_nNxfrat);
+	rArchive.Field(m_nBasfrq);
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
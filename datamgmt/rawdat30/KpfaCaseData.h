@@ -42,6 +42,10 @@ public:
 
 	KpfaError_t ParseInput(string &rInputString, uint32_t nId = 0);
 
+	KpfaError_t ParseInput(const KpfaStringView_t &rInput, uint32_t nId = 0);
+
+	void Serialize(KpfaRawDataArchive &rArchive);
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Functions
 	///////////////////////////////////////////////////////////////////
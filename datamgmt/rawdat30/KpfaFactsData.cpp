@@ -53,52 +53,67 @@ KpfaFactsData::~KpfaFactsData() {
 KpfaError_t
 KpfaFactsData::ParseInput(string &rInputString, uint32_t nId) {
 
-  KpfaStringList_t tokens;
-  uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+  KpfaStringView_t input = { rInputString.data(), rInputString.size() };
+
+  return ParseInput(input, nId);
+}
+
+/**
+ * This function will parse the FACTS data directly from a view of the input line
+ * (e.g. a line of the memory-mapped raw file) without any intermediate string.
+ *
+ * @param rInput a view with the FACTS data to be parsed
+ * @return error information
+ */
+KpfaError_t
+KpfaFactsData::ParseInput(const KpfaStringView_t &rInput, uint32_t nId) {
+
+  KpfaStringView_t tokens[KPFA_NUM_FACTS_DATA_ITEMS];
+  uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_FACTS_DATA_ITEMS, ",");
 
   if(nTokens != KPFA_NUM_FACTS_DATA_ITEMS) {
     return KPFA_ERROR_FACTS_PARSE;
   }
 
 #if 0
-  KPFA_DEBUG("KpfaFactsData", "%s\n", rInputString.c_str());
+  KPFA_DEBUG("KpfaFactsData", "%.*s\n", (int)rInput.nSize, rInput.pData);
 #endif
 
   uint32_t i = 0;
 
   // Facts ID
-  m_nN = (uint32_t)atoi(tokens[i++].c_str());
+  m_nN = (uint32_t)KpfaParseInt(tokens[i++]);
 
   // Bus number (1 ~ 999997)
-  m_nI = (uint32_t)atoi(tokens[i++].c_str());
+  m_nI = (uint32_t)KpfaParseInt(tokens[i++]);
 
   if(m_nI == 0) {
     return KPFA_ERROR_FACTS_PARSE;
   }
 
-  m_nJ = (uint32_t)atoi(tokens[i++].c_str());
+  m_nJ = (uint32_t)KpfaParseInt(tokens[i++]);
 
-  m_nMode = (uint32_t)atoi(tokens[i++].c_str());
+  m_nMode = (uint32_t)KpfaParseInt(tokens[i++]);
 
-  m_nPdes = atof(tokens[i++].c_str());
-  m_nQdes = atof(tokens[i++].c_str());
-  m_nVset = atof(tokens[i++].c_str());
-  m_nShmx = atof(tokens[i++].c_str());
+  m_nPdes = KpfaParseDouble(tokens[i++]);
+  m_nQdes = KpfaParseDouble(tokens[i++]);
+  m_nVset = KpfaParseDouble(tokens[i++]);
+  m_nShmx = KpfaParseDouble(tokens[i++]);
 
 #if 0
-  m_nTrmx = atof(tokens[i++].c_str());
-  m_nVtmn = atof(tokens[i++].c_str());
-  m_nVtmx = atof(tokens[i++].c_str());
-  m_nImx  = atof(tokens[i++].c_str());
-  m_nLinx = atof(tokens[i++].c_str());
-  m_nRmpct= atof(tokens[i++].c_str());
-
-  m_nOwner= (uint32_t)atoi(tokens[i++].c_str());
-
-  m_nSet1 = atof(tokens[i++].c_str());
-  m_nSet2 = atof(tokens[i++].c_str());
-  m_nVsref= atof(tokens[i++].c_str());
-  m_nQout = atof(tokens[i++].c_str());
+  m_nTrmx = KpfaParseDouble(tokens[i++]);
+  m_nVtmn = KpfaParseDouble(tokens[i++]);
+  m_nVtmx = KpfaParseDouble(tokens[i++]);
+  m_nImx  = KpfaParseDouble(tokens[i++]);
+  m_nLinx = KpfaParseDouble(tokens[i++]);
+  m_nRmpct= KpfaParseDouble(tokens[i++]);
+
+  m_nOwner= (uint32_t)KpfaParseInt(tokens[i++]);
+
+  m_nSet1 = KpfaParseDouble(tokens[i++]);
+  m_nSet2 = KpfaParseDouble(tokens[i++]);
+  m_nVsref= KpfaParseDouble(tokens[i++]);
+  m_nQout = KpfaParseDouble(tokens[i++]);
 #endif
 
   return KPFA_SUCCESS;
@@ -115,6 +130,37 @@ KpfaFactsData::TransformUnit(double nSbase) {
   return KPFA_SUCCESS;
 }
 
+/**
+ * This function will store the values of the raw data into the archive or load them from it.
+ *
+ * @param rArchive archive of the raw data
+ */
+void
+KpfaFactsData::Serialize(KpfaRawDataArchive &rArchive) {
+
+  rArchive.Field(m_nN);
+  rArchive.Field(m_nI);
+  rArchive.Field(m_nJ);
+  rArchive.Field(m_nMode);
+  rArchive.Field(m_nPdes);
+  rArchive.Field(m_nQdes);
+  rArchive.Field(m_nVset);
+  rArchive.Field(m_nShmx);
+  rArchive.Field(m_nTrmx);
+  rArchive.Field(m_nVtmn);
+  rArchive.Field(m_nVtmx);
+  rArchive.Field(m_nImx);
+  rArchive.Field(m_nLinx);
+  rArchive.Field(m_nRmpct);
+  rArchive.Field(m_nOwner);
+  rArchive.Field(m_nSet1);
+  rArchive.Field(m_nSet2);
+  rArchive.Field(m_nVsref);
+  rArchive.Field(m_nQout);
+  rArchive.Field(m_nRequiredQ);
+  rArchive.Field(m_nSensitivity);
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
@@ -35,31 +35,46 @@ KpfaFixedShuntData::~KpfaFixedShuntData() {
 KpfaError_t
 KpfaFixedShuntData::ParseInput(string &rInputString, uint32_t nId) {
 
-	KpfaStringList_t tokens;
-	uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+	KpfaStringView_t input = { rInputString.data(), rInputString.size() };
+
+	return ParseInput(input, nId);
+}
+
+/**
+ * This function will parse the fixed shunt data directly from a view of the input line
+ * (e.g. a line of the memory-mapped raw file) without any intermediate string.
+ *
+ * @param rInput a view with the fixed shunt data to be parsed
+ * @return error information
+ */
+KpfaError_t
+KpfaFixedShuntData::ParseInput(const KpfaStringView_t &rInput, uint32_t nId) {
+
+	KpfaStringView_t tokens[KPFA_NUM_FIXED_SHUNT_DATA_ITEMS];
+	uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_FIXED_SHUNT_DATA_ITEMS, ",");
 
 	if(nTokens != KPFA_NUM_FIXED_SHUNT_DATA_ITEMS) {
 		return KPFA_ERROR_FIXED_SHUNT_PARSE;
 	}
 
 #if 0
-	KPFA_DEBUG("KpfaFixedShuntData", "%s\n", rInputString.c_str());
+	KPFA_DEBUG("KpfaFixedShuntData", "%.*s\n", (int)rInput.nSize, rInput.pData);
 #endif
 
 	// Bus number
-	m_nI = (uint32_t)atoi(tokens[0].c_str());
+	m_nI = (uint32_t)KpfaParseInt(tokens[0]);
 
 	// Shunt ID
-	m_rId = tokens[1];
+	m_rId.assign(tokens[1].pData, tokens[1].nSize);
 
 	// Shunt status (1: in-service, 0: out-of-service)
-	m_bStatus = (bool_t)atoi(tokens[2].c_str());
+	m_bStatus = (bool_t)KpfaParseInt(tokens[2]);
 
 	// Active component of shunt admittance to ground
-	m_nGl = atof(tokens[3].c_str());
+	m_nGl = KpfaParseDouble(tokens[3]);
 
 	// Reactive component of shunt admittance to ground
-	m_nBl = atof(tokens[4].c_str());
+	m_nBl = KpfaParseDouble(tokens[4]);
 
 	return KPFA_SUCCESS;
 }
@@ -83,6 +98,21 @@ KpfaFixedShuntData::TransformUnit(double nSbase) {
 	return KPFA_SUCCESS;
 }
 
+/**
+ * This function will store the values of the raw data into the archive or load them from it.
+ *
+ * @param rArchive archive of the raw data
+ */
+void
+KpfaFixedShuntData::Serialize(KpfaRawDataArchive &rArchive) {
+
+	rArchive.Field(m_nI);
+	rArchive.Field(m_rId);
+	rArchive.Field(m_bStatus);
+	rArchive.Field(m_nGl);
+	rArchive.Field(m_nBl);
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
@@ -67,9 +67,24 @@ KpfaGenData::~KpfaGenData() {
 KpfaError_t
 KpfaGenData::ParseInput(string &rInputString, uint32_t nId) {
 
+	KpfaStringView_t input = { rInputString.data(), rInputString.size() };
+
+	return ParseInput(input, nId);
+}
+
+/**
+ * This function will parse the generator data directly from a view of the input line
+ * (e.g. a line of the memory-mapped raw file) without any intermediate string.
+ *
+ * @param rInput a view with the generator data to be parsed
+ * @return error information
+ */
+KpfaError_t
+KpfaGenData::ParseInput(const KpfaStringView_t &rInput, uint32_t nId) {
+
 	uint32_t i = 0, j;
-	KpfaStringList_t tokens;
-	uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+	KpfaStringView_t tokens[KPFA_MAX_NUM_GENERATOR_DATA_ITEMS];
+	uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_MAX_NUM_GENERATOR_DATA_ITEMS, ",");
 
 	if(nTokens < KPFA_MIN_NUM_GENERATOR_DATA_ITEMS ||
 	   nTokens > KPFA_MAX_NUM_GENERATOR_DATA_ITEMS) {
@@ -77,71 +92,72 @@ KpfaGenData::ParseInput(string &rInputString, uint32_t nId) {
 	}
 
 #if 0
-	KPFA_DEBUG("KpfaGenData", "%s\n", rInputString.c_str());
+	KPFA_DEBUG("KpfaGenData", "%.*s\n", (int)rInput.nSize, rInput.pData);
 #endif
 
 	// Bus number
-	m_nI = (uint32_t )atoi(tokens[i++].c_str());
+	m_nI = (uint32_t )KpfaParseInt(tokens[i++]);
 
 	if(m_nI == 0) {
 		return KPFA_ERROR_GENERATOR_PARSE;
 	}
 
 	// Machine identifier used to distinguish among multiple machines at bus I
-	m_rId = tokens[i++];
+	m_rId.assign(tokens[i].pData, tokens[i].nSize);
+	i++;
 
 	// Generator active power output
-	m_nPg = atof(tokens[i++].c_str());
+	m_nPg = KpfaParseDouble(tokens[i++]);
 
 	// Generator reactive power output
-	m_nQg = atof(tokens[i++].c_str());
+	m_nQg = KpfaParseDouble(tokens[i++]);
 
 	// Maximum generator reactive power output
-	m_nQt = atof(tokens[i++].c_str());
+	m_nQt = KpfaParseDouble(tokens[i++]);
 
 	// Minimum generator reactive power output
-	m_nQb = atof(tokens[i++].c_str());
+	m_nQb = KpfaParseDouble(tokens[i++]);
 
 	// Regulated voltage set-point
-	m_nVs = atof(tokens[i++].c_str());
+	m_nVs = KpfaParseDouble(tokens[i++]);
 
 	// Sub bus number
-	m_nIreg = (uint32_t)atoi(tokens[i++].c_str());
+	m_nIreg = (uint32_t)KpfaParseInt(tokens[i++]);
 
 	// Total MVA base of the units represented by this machine
-	m_nMbase = atof(tokens[i++].c_str());
+	m_nMbase = KpfaParseDouble(tokens[i++]);
 
 	// Complex machine impedance
-	m_nZr = atof(tokens[i++].c_str());
-	m_nZx = atof(tokens[i++].c_str());
+	m_nZr = KpfaParseDouble(tokens[i++]);
+	m_nZx = KpfaParseDouble(tokens[i++]);
 
 	// Step-up transformer impedance
-	m_nRt = atof(tokens[i++].c_str());
-	m_nXt = atof(tokens[i++].c_str());
+	m_nRt = KpfaParseDouble(tokens[i++]);
+	m_nXt = KpfaParseDouble(tokens[i++]);
 
 	// Step-up transformer off-nominal turns ratio
-	m_nGtap = atof(tokens[i++].c_str());
+	m_nGtap = KpfaParseDouble(tokens[i++]);
 
 	// Machine status (1: in-service, 0: out-of-service)
-	m_bStat = (bool_t)atoi(tokens[i++].c_str());
+	m_bStat = (bool_t)KpfaParseInt(tokens[i++]);
 
 	// Percent of the total Mvar required
-	m_nRmpct = atof(tokens[i++].c_str());
+	m_nRmpct = KpfaParseDouble(tokens[i++]);
 
 	// Maximum generator active power output
-	m_nPt = atof(tokens[i++].c_str());
+	m_nPt = KpfaParseDouble(tokens[i++]);
 
 	// Minimum generator active power output
-	m_nPb = atof(tokens[i++].c_str());
+	m_nPb = KpfaParseDouble(tokens[i++]);
 
 	// Owner, Fraction
-	for(j = 0; i < nTokens; j++) {
+	for(j = 0; i + 1 < nTokens; j++) {
 
 		// Owner number (1 ~ 9999).
-		m_nO[j] = (uint16_t)atoi(tokens[i++].c_str());
+		m_nO[j] = (uint16_t)KpfaParseInt(tokens[i++]);
 
 		// Fraction of total ownership assigned to owner Qi
-		m_nF[j] = atof(tokens[i++].c_str());
+		m_nF[j] = KpfaParseDouble(tokens[i++]);
 	}
 
 	m_nOwnerCount = j;
@@ -199,6 +215,42 @@ KpfaGenData::MergeWith(KpfaGenData *pGenData) {
 	m_nMbase += pGenData->m_nMbase;
 }
 
+/**
+ * This function will store the values of the raw data into the archive or load them from it.
+ *
+ * @param rArchive archive of the raw data
+ */
+void
+KpfaGenData::Serialize(KpfaRawDataArchive &rArchive) {
+
+	rArchive.Field(m_nI);
+	rArchive.Field(m_rId);
+	rArchive.Field(m_nPg);
+	rArchive.Field(m_nQg);
+	rArchive.Field(m_nQt);
+	rArchive.Field(m_nQb);
+	rArchive.Field(m_nVs);
+	rArchive.Field(m_nIreg);
+	rArchive.Field(m_nMbase);
+	rArchive.Field(m_nZr);
+	rArchive.Field(m_nZx);
+	rArchive.Field(m_nRt);
+	rArchive.Field(m_nXt);
+	rArchive.Field(m_nGtap);
+	rArchive.Field(m_bStat);
+	rArchive.Field(m_nRmpct);
+	rArchive.Field(m_nPt);
+	rArchive.Field(m_nPb);
+	rArchive.Field(m_nOwnerCount);
+	rArchive.Field(m_nO);
+	rArchive.Field(m_nF);
+	rArchive.Field(m_nWmod);
+	rArchive.Field(m_bQtx);
+	rArchive.Field(m_bQbx);
+	rArchive.Field(m_bFacts);
+	rArchive.Field(m_nWFactor);
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
@@ -104,10 +104,14 @@ public:
 
 	KpfaError_t ParseInput(string &rInputString, uint32_t nId = 0);
 
+	KpfaError_t ParseInput(const KpfaStringView_t &rInput, uint32_t nId = 0);
+
 	KpfaError_t TransformUnit(double nSbase);
 
 	void MergeWith(KpfaGenData *pGenData);
 
+	void Serialize(KpfaRawDataArchive &rArchive);
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Functions
 	///////////////////////////////////////////////////////////////////
@@ -44,56 +44,71 @@ KpfaLoadData::~KpfaLoadData() {
 KpfaError_t
 KpfaLoadData::ParseInput(string &rInputString, uint32_t nId) {
 
-	KpfaStringList_t tokens;
-	uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+	KpfaStringView_t input = { rInputString.data(), rInputString.size() };
+
+	return ParseInput(input, nId);
+}
+
+/**
+ * This function will parse the load data directly from a view of the input line
+ * (e.g. a line of the memory-mapped raw file) without any intermediate string.
+ *
+ * @param rInput a view with the load data to be parsed
+ * @return error information
+ */
+KpfaError_t
+KpfaLoadData::ParseInput(const KpfaStringView_t &rInput, uint32_t nId) {
+
+	KpfaStringView_t tokens[KPFA_NUM_LOAD_DATA_ITEMS];
+	uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_LOAD_DATA_ITEMS, ",");
 
 	if(nTokens != KPFA_NUM_LOAD_DATA_ITEMS) {
 		return KPFA_ERROR_LOAD_PARSE;
 	}
 
 #if 0
-	KPFA_DEBUG("KpfaLoadData", "%s\n", rInputString.c_str());
+	KPFA_DEBUG("KpfaLoadData", "%.*s\n", (int)rInput.nSize, rInput.pData);
 #endif
 
 	// Bus number (1 ~ 999997)
-	m_nI = (uint32_t)atoi(tokens[0].c_str());
+	m_nI = (uint32_t)KpfaParseInt(tokens[0]);
 
 	if(m_nI == 0) {
 		return KPFA_ERROR_LOAD_PARSE;
 	}
 
 	// Sub Load ID to distinguish among multiple loads at a bus.
-	m_rId = tokens[1];
+	m_rId.assign(tokens[1].pData, tokens[1].nSize);
 
 	// Load status (0: out-of-service, 1: in-service)
-	m_bStatus = (bool_t)atoi(tokens[2].c_str());
+	m_bStatus = (bool_t)KpfaParseInt(tokens[2]);
 
 	// Area to which the load is assigned (1 ~ 9999)
-	m_nArea = (uint16_t)atoi(tokens[3].c_str());
+	m_nArea = (uint16_t)KpfaParseInt(tokens[3]);
 
 	// Zone to which the load is assigned (1 ~ 9999)
-	m_nZone = (uint16_t)atoi(tokens[4].c_str());
+	m_nZone = (uint16_t)KpfaParseInt(tokens[4]);
 
 	// Active power of MVA load
-	m_nPl = atof(tokens[5].c_str());
+	m_nPl = KpfaParseDouble(tokens[5]);
 
 	// Reactive power of MVA load
-	m_nQl = atof(tokens[6].c_str());
+	m_nQl = KpfaParseDouble(tokens[6]);
 
 	// Active power of current load
-	m_nIp = atof(tokens[7].c_str());
+	m_nIp = KpfaParseDouble(tokens[7]);
 
 	// Reactive power of current load
-	m_nIq = atof(tokens[8].c_str());
+	m_nIq = KpfaParseDouble(tokens[8]);
 
 	// Active power of admittance load
-	m_nYp = atof(tokens[9].c_str());
+	m_nYp = KpfaParseDouble(tokens[9]);
 
 	// Reactive power of admittance load
-	m_nYq = atof(tokens[10].c_str());
+	m_nYq = KpfaParseDouble(tokens[10]);
 
 	// Owner to which the load is assigned (1 ~ 9999)
-	m_nOwner = (uint16_t)atoi(tokens[11].c_str());
+	m_nOwner = (uint16_t)KpfaParseInt(tokens[11]);
 
 	return KPFA_SUCCESS;
 }
@@ -123,6 +138,29 @@ KpfaLoadData::TransformUnit(double nSbase) {
 	return KPFA_SUCCESS;
 }
 
+/**
+ * This function will store the values of the raw data into the archive or load them from it.
+ *
+ * @param rArchive archive of the raw data
+ */
+void
+KpfaLoadData::Serialize(KpfaRawDataArchive &rArchive) {
+
+	rArchive.Field(m_nI);
+	rArchive.Field(m_rId);
+	rArchive.Field(m_bStatus);
+	rArchive.Field(m_nArea);
+	rArchive.Field(m_nZone);
+	rArchive.Field(m_nPl);
+	rArchive.Field(m_nQl);
+	rArchive.Field(m_nIp);
+	rArchive.Field(m_nIq);
+	rArchive.Field(m_nYp);
+	rArchive.Field(m_nYq);
+	rArchive.Field(m_nOwner);
+	rArchive.Field(m_nHvdcI);
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
@@ -47,9 +47,24 @@ KpfaSwitchedShuntData::~KpfaSwitchedShuntData() {
 KpfaError_t
 KpfaSwitchedShuntData::ParseInput(string &rInputString, uint32_t nId) {
 
+	KpfaStringView_t input = { rInputString.data(), rInputString.size() };
+
+	return ParseInput(input, nId);
+}
+
+/**
+ * This function will parse the switched shunt data directly from a view of the input line
+ * (e.g. a line of the memory-mapped raw file) without any intermediate string.
+ *
+ * @param rInput a view with the switched shunt data to be parsed
+ * @return error information
+ */
+KpfaError_t
+KpfaSwitchedShuntData::ParseInput(const KpfaStringView_t &rInput, uint32_t nId) {
+
 	uint32_t i = 0, j, k;
-	KpfaStringList_t tokens;
-	uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+	KpfaStringView_t tokens[KPFA_MAX_NUM_SWITCHED_SHUNT_DATA_ITEMS];
+	uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_MAX_NUM_SWITCHED_SHUNT_DATA_ITEMS, ",");
 
 	if(nTokens < KPFA_MIN_NUM_SWITCHED_SHUNT_DATA_ITEMS ||
 	   nTokens > KPFA_MAX_NUM_SWITCHED_SHUNT_DATA_ITEMS) {
@@ -57,47 +72,48 @@ KpfaSwitchedShuntData::ParseInput(string &rInputString, uint32_t nId) {
 	}
 
 #if 0
-	KPFA_DEBUG("KpfaSwitchedShuntData", "%s\n", rInputString.c_str());
+	KPFA_DEBUG("KpfaSwitchedShuntData", "%.*s\n", (int)rInput.nSize, rInput.pData);
 #endif
 
 	// Bus number
-	m_nI = (uint32_t)atoi(tokens[i++].c_str());
+	m_nI = (uint32_t)KpfaParseInt(tokens[i++]);
 
 	if(m_nI == 0) {
 		return KPFA_ERROR_SWITCHED_SHUNT_PARSE;
 	}
 
 	// Control mode
-	m_nModsw = (uint16_t)atoi(tokens[i++].c_str());
+	m_nModsw = (uint16_t)KpfaParseInt(tokens[i++]);
 
 	// Desired voltage upper limit
-	m_nVswhi = atof(tokens[i++].c_str());
+	m_nVswhi = KpfaParseDouble(tokens[i++]);
 
 	// Desired voltage lower limit
-	m_nVswlo = atof(tokens[i++].c_str());
+	m_nVswlo = KpfaParseDouble(tokens[i++]);
 
 	// Remote bus number
-	m_nSwrem = (uint32_t)atoi(tokens[i++].c_str());
+	m_nSwrem = (uint32_t)KpfaParseInt(tokens[i++]);
 
 	// Percent of contributed reactive power (100.0 by default)
-	m_nRmpct = atof(tokens[i++].c_str());
+	m_nRmpct = KpfaParseDouble(tokens[i++]);
 	
 	// VSC DC line name (MODSW = 4) or FACTS device name (MODSW = 6)
-	m_rRmidnt = tokens[i++];
+	m_rRmidnt.assign(tokens[i].pData, tokens[i].nSize);
+	i++;
 
 	// Switched shunt admittance
-	m_nBinit = atof(tokens[i++].c_str());
+	m_nBinit = KpfaParseDouble(tokens[i++]);
 
 	m_nMinShunt = 0;
 	m_nMaxShunt = 0;
 
-	for(j = 0; i < nTokens; j++) {
+	for(j = 0; i + 1 < nTokens; j++) {
 
 		// Number of steps for each block
-		m_nN[j] = (uint32_t)atoi(tokens[i++].c_str());;
+		m_nN[j] = (uint32_t)KpfaParseInt(tokens[i++]);;
 
 		// Admittance increment per step for each block
-		m_nB[j] = atof(tokens[i++].c_str());
+		m_nB[j] = KpfaParseDouble(tokens[i++]);
 
 		// For updating max, min shunt values
 		double tmp = m_nN[j] * m_nB[j];
@@ -176,6 +192,31 @@ KpfaSwitchedShuntData::TransformUnit(double nSbase) {
 	return KPFA_SUCCESS;
 }
 
+/**
+ * This function will store the values of the raw data into the archive or load them from it.
+ *
+ * @param rArchive archive of the raw data
+ */
+void
+KpfaSwitchedShuntData::Serialize(KpfaRawDataArchive &rArchive) {
+
+	rArchive.Field(m_nI);
+	rArchive.Field(m_nModsw);
+	rArchive.Field(m_nVswhi);
+	rArchive.Field(m_nVswlo);
+	rArchive.Field(m_nSwrem);
+	rArchive.Field(m_nRmpct);
+	rArchive.Field(m_rRmidnt);
+	rArchive.Field(m_nBinit);
+	rArchive.Field(m_nN);
+	rArchive.Field(m_nB);
+	rArchive.Field(m_nBlockNum);
+	rArchive.Field(m_nMaxShunt);
+	rArchive.Field(m_nMinShunt);
+	rArchive.Field(m_rBankShunt);
+	rArchive.Field(m_nShuntMode);
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
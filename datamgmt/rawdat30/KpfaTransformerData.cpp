@@ -72,15 +72,15 @@ KpfaTransformerData::~KpfaTransformerData() {
 /**
  * This function must be implemented to parse the input string into the transformer data.
  *
- * @param rInputString a string at line #1 with the transformer data to be parsed
+ * @param rInput a view of line #1 with the transformer data to be parsed
  * @return error information
  */
 KpfaError_t
-KpfaTransformerData::ParseRawDataLineType1(string &rInputString) {
+KpfaTransformerData::ParseRawDataLineType1(const KpfaStringView_t &rInput) {
 
 	uint32_t i = 0, j;
-	KpfaStringList_t tokens;
-	uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+	KpfaStringView_t tokens[KPFA_MAX_NUM_TRANSFORMER_DATA_ITEMS_1];
+	uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_MAX_NUM_TRANSFORMER_DATA_ITEMS_1, ",");
 
 	if(nTokens < KPFA_MIN_NUM_TRANSFORMER_DATA_ITEMS_1 ||
 	   nTokens > KPFA_MAX_NUM_TRANSFORMER_DATA_ITEMS_1) {
@@ -88,49 +88,44 @@ KpfaTransformerData::ParseRawDataLineType1(string &rInputString) {
 	}
 
 #if 0
-	KPFA_DEBUG("KpfaTransformerData Line #1", "%s\n", rInputString.c_str());
+	KPFA_DEBUG("KpfaTransformerData Line #1", "%.*s\n", (int)rInput.nSize, rInput.pData);
 #endif
 
 	// Bus number
-	m_nI = (uint32_t)atoi(tokens[i++].c_str());
+	m_nI = (uint32_t)KpfaParseInt(tokens[i++]);
 
 	if(m_nI == 0) {
 		return KPFA_ERROR_TRANSFORMER_PARSE;
 	}
 
 	// Bus number of Winding 2
-	m_nJ = (uint32_t)atoi(tokens[i++].c_str());
+	m_nJ = (uint32_t)KpfaParseInt(tokens[i++]);
 
 	// Bus number of Winding 3
-	m_nK = (uint32_t)atoi(tokens[i++].c_str());
+	m_nK = (uint32_t)KpfaParseInt(tokens[i++]);
 
 	// Transformer Circuit ID
-#if 0
-	char *ckt = tokens[i++].c_str();
-	m_nCkt = (uint32_t)(ckt[1] - '0');
-#else
-	string &ckt = KpfaStripQuotes(tokens[i++]);
-	m_nCkt = (uint32_t)atoi(ckt.c_str());
-#endif
+	m_nCkt = (uint32_t)KpfaParseInt(KpfaStripQuotesView(tokens[i++]));
 
 	// Winding data I/O code
-	m_nCw = (uint8_t)atoi(tokens[i++].c_str());
+	m_nCw = (uint8_t)KpfaParseInt(tokens[i++]);
 
 	// Impedance data I/O code
-	m_nCz = (uint8_t)atoi(tokens[i++].c_str());
+	m_nCz = (uint8_t)KpfaParseInt(tokens[i++]);
 
 	// Magnetizing admittance I/O code
-	m_nCm = (uint8_t)atoi(tokens[i++].c_str());
+	m_nCm = (uint8_t)KpfaParseInt(tokens[i++]);
 
 	// Transformer magnetizing admittance connected to ground at bus I
-	m_nMag1 = atof(tokens[i++].c_str());
-	m_nMag2 = atof(tokens[i++].c_str());
+	m_nMag1 = KpfaParseDouble(tokens[i++]);
+	m_nMag2 = KpfaParseDouble(tokens[i++]);
 
 	// Nonmetered end code of either 1 (for the Winding 1 bus) or 2 (for the Winding 2 bus)
-	m_nNmetr = (uint8_t)atoi(tokens[i++].c_str());
+	m_nNmetr = (uint8_t)KpfaParseInt(tokens[i++]);
 
 	// Transformer ID
-	m_rName = tokens[i++];
+	m_rName.assign(tokens[i].pData, tokens[i].nSize);
+	i++;
 
 	// Transformer status
 	// 0: out-of-service
@@ -138,18 +133,18 @@ KpfaTransformerData::ParseRawDataLineType1(string &rInputString) {
 	// 2: only Winding 2 out-of-service
 	// 3: only Winding 3 out-of-service
 	// 4: only Winding 1 out-of-service
-	m_nStat = (uint8_t)atoi(tokens[i++].c_str());
+	m_nStat = (uint8_t)KpfaParseInt(tokens[i++]);
 
 	// The number of windings
 	m_nWindingCount = (m_nK != 0) ? KPFA_MAX_NUM_WINDINGS : 1;
 
-	for(j = 0; i < nTokens; j++) {
+	for(j = 0; i + 1 < nTokens; j++) {
 
 		// Owner number (1 ~ 9999).
-		m_nO[j] = (uint16_t)atoi(tokens[i++].c_str());
+		m_nO[j] = (uint16_t)KpfaParseInt(tokens[i++]);
 
 		// Fraction of total ownership assigned to owner Qi
-		m_nF[j] = atof(tokens[i++].c_str());
+		m_nF[j] = KpfaParseDouble(tokens[i++]);
 	}
 
 	m_nOwnerCount = j;
@@ -160,18 +155,18 @@ KpfaTransformerData::ParseRawDataLineType1(string &rInputString) {
 /**
  * This function must be implemented to parse the input string into the transformer data.
  *
- * @param rInputString a string at line #2 with the transformer data to be parsed
+ * @param rInput a view of line #2 with the transformer data to be parsed
  * @return error information
  */
 KpfaError_t
-KpfaTransformerData::ParseRawDataLineType2(string &rInputString) {
+KpfaTransformerData::ParseRawDataLineType2(const KpfaStringView_t &rInput) {
 
-	KpfaStringList_t tokens;
+	KpfaStringView_t tokens[KPFA_MAX_NUM_TRANSFORMER_DATA_ITEMS_2];
 
-	uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+	uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_MAX_NUM_TRANSFORMER_DATA_ITEMS_2, ",");
 
 #if 0
-	KPFA_DEBUG("KpfaTransformerData Line #2", "%s\n", rInputString.c_str());
+	KPFA_DEBUG("KpfaTransformerData Line #2", "%.*s\n", (int)rInput.nSize, rInput.pData);
 #endif
 
 	// 2 Winding
@@ -179,9 +174,9 @@ KpfaTransformerData::ParseRawDataLineType2(string &rInputString) {
 
 		KPFA_CHECK(m_nK == 0, KPFA_ERROR_TRANSFORMER_PARSE);
 
-		m_nR[KPFA_WINDING_1_TO_2] = atof(tokens[0].c_str());
-		m_nX[KPFA_WINDING_1_TO_2] = atof(tokens[1].c_str());
-		m_nSbase[KPFA_WINDING_1_TO_2] = atof(tokens[2].c_str());
+		m_nR[KPFA_WINDING_1_TO_2] = KpfaParseDouble(tokens[0]);
+		m_nX[KPFA_WINDING_1_TO_2] = KpfaParseDouble(tokens[1]);
+		m_nSbase[KPFA_WINDING_1_TO_2] = KpfaParseDouble(tokens[2]);
 
 		return KPFA_SUCCESS;
 	}
@@ -193,13 +188,13 @@ KpfaTransformerData::ParseRawDataLineType2(string &rInputString) {
 		int j = 0;
 
 		for(int i = 0; i < KPFA_MAX_NUM_WINDINGS; i++) {
-			m_nR[i] = atof(tokens[j++].c_str());
-			m_nX[i] = atof(tokens[j++].c_str());
-			m_nSbase[i] = atof(tokens[j++].c_str());
+			m_nR[i] = KpfaParseDouble(tokens[j++]);
+			m_nX[i] = KpfaParseDouble(tokens[j++]);
+			m_nSbase[i] = KpfaParseDouble(tokens[j++]);
 		}
 
-		m_nVmstar = atof(tokens[j++].c_str());
-		m_nAnstar = atof(tokens[j++].c_str());
+		m_nVmstar = KpfaParseDouble(tokens[j++]);
+		m_nAnstar = KpfaParseDouble(tokens[j++]);
 
 		return KPFA_SUCCESS;
 	}
@@ -210,19 +205,19 @@ KpfaTransformerData::ParseRawDataLineType2(string &rInputString) {
 /**
  * This function must be implemented to parse the input string into the transformer data.
  *
- * @param rInputString a string at line #3 with the transformer data to be parsed
+ * @param rInput a view of line #3 with the transformer data to be parsed
  * @param nIdx index
  * @return error information
  */
 KpfaError_t
-KpfaTransformerData::ParseRawDataLineType3(string &rInputString, uint32_t nIdx) {
+KpfaTransformerData::ParseRawDataLineType3(const KpfaStringView_t &rInput, uint32_t nIdx) {
 
-	KpfaStringList_t tokens;
+	KpfaStringView_t tokens[KPFA_NUM_TRANSFORMER_DATA_ITEMS_3_1];
 
-	uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+	uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_TRANSFORMER_DATA_ITEMS_3_1, ",");
 
 #if 0
-	KPFA_DEBUG("KpfaTransformerData Line #3", "%s\n", rInputString.c_str());
+	KPFA_DEBUG("KpfaTransformerData Line #3", "%.*s\n", (int)rInput.nSize, rInput.pData);
 #endif
 
 	if(nTokens != KPFA_NUM_TRANSFORMER_DATA_ITEMS_3_1 &&
@@ -230,28 +225,28 @@ KpfaTransformerData::ParseRawDataLineType3(string &rInputString, uint32_t nIdx)
 		return KPFA_ERROR_TRANSFORMER_PARSE;
 	}
 
-	m_nWindv[nIdx] = atof(tokens[0].c_str());
-	m_nNomv[nIdx] = atof(tokens[1].c_str());
-	m_nAng[nIdx] = atof(tokens[2].c_str());
+	m_nWindv[nIdx] = KpfaParseDouble(tokens[0]);
+	m_nNomv[nIdx] = KpfaParseDouble(tokens[1]);
+	m_nAng[nIdx] = KpfaParseDouble(tokens[2]);
 
-	m_nRata[nIdx] = atof(tokens[3].c_str());
-	m_nRatb[nIdx] = atof(tokens[4].c_str());
-	m_nRatc[nIdx] = atof(tokens[5].c_str());
+	m_nRata[nIdx] = KpfaParseDouble(tokens[3]);
+	m_nRatb[nIdx] = KpfaParseDouble(tokens[4]);
+	m_nRatc[nIdx] = KpfaParseDouble(tokens[5]);
 
 	if(nTokens == KPFA_NUM_TRANSFORMER_DATA_ITEMS_3_1) {
-		m_nCod[nIdx] = (uint8_t)atoi(tokens[6].c_str());
-		m_nCont[nIdx] = (uint32_t)atoi(tokens[7].c_str());
+		m_nCod[nIdx] = (uint8_t)KpfaParseInt(tokens[6]);
+		m_nCont[nIdx] = (uint32_t)KpfaParseInt(tokens[7]);
 
-		m_nRma[nIdx] = atof(tokens[8].c_str());
-		m_nRmi[nIdx] = atof(tokens[9].c_str());
-		m_nVma[nIdx] = atof(tokens[10].c_str());
-		m_nVmi[nIdx] = atof(tokens[11].c_str());
+		m_nRma[nIdx] = KpfaParseDouble(tokens[8]);
+		m_nRmi[nIdx] = KpfaParseDouble(tokens[9]);
+		m_nVma[nIdx] = KpfaParseDouble(tokens[10]);
+		m_nVmi[nIdx] = KpfaParseDouble(tokens[11]);
 
-		m_nNtp[nIdx] = (uint32_t)atoi(tokens[12].c_str());
-		m_nTap[nIdx] = (uint32_t)atoi(tokens[13].c_str());
+		m_nNtp[nIdx] = (uint32_t)KpfaParseInt(tokens[12]);
+		m_nTap[nIdx] = (uint32_t)KpfaParseInt(tokens[13]);
 
-		m_nCr[nIdx] = atof(tokens[14].c_str());
-		m_nCx[nIdx] = atof(tokens[15].c_str());
+		m_nCr[nIdx] = KpfaParseDouble(tokens[14]);
+		m_nCx[nIdx] = KpfaParseDouble(tokens[15]);
 	}
 
 	return KPFA_SUCCESS;
@@ -260,26 +255,26 @@ KpfaTransformerData::ParseRawDataLineType3(string &rInputString, uint32_t nIdx)
 /**
  * This function must be implemented to parse the input string into the transformer data.
  *
- * @param rInputString a string at line #4 with the transformer data to be parsed
+ * @param rInput a view of line #4 with the transformer data to be parsed
  * @return error information
  */
 KpfaError_t
-KpfaTransformerData::ParseRawDataLineType4(string &rInputString) {
+KpfaTransformerData::ParseRawDataLineType4(const KpfaStringView_t &rInput) {
 
-	KpfaStringList_t tokens;
+	KpfaStringView_t tokens[KPFA_NUM_TRANSFORMER_DATA_ITEMS_4];
 
-	uint32_t nTokens = KpfaTokenize(rInputString, tokens, ",");
+	uint32_t nTokens = KpfaTokenizeView(rInput, tokens, KPFA_NUM_TRANSFORMER_DATA_ITEMS_4, ",");
 
 #if 0
-	KPFA_DEBUG("KpfaTransformerData Line #4", "%s\n", rInputString.c_str());
+	KPFA_DEBUG("KpfaTransformerData Line #4", "%.*s\n", (int)rInput.nSize, rInput.pData);
 #endif
 
 	if(nTokens != KPFA_NUM_TRANSFORMER_DATA_ITEMS_4) {
 		return KPFA_ERROR_TRANSFORMER_PARSE;
 	}
 
-	m_nWindv[1] = atof(tokens[0].c_str());
-	m_nNomv[1] = atof(tokens[1].c_str());
+	m_nWindv[1] = KpfaParseDouble(tokens[0]);
+	m_nNomv[1] = KpfaParseDouble(tokens[1]);
 
 	return KPFA_SUCCESS;
 }
@@ -294,20 +289,36 @@ KpfaTransformerData::ParseRawDataLineType4(string &rInputString) {
 KpfaError_t
 KpfaTransformerData::ParseInput(string &rInputString, uint32_t nId) {
 
+	KpfaStringView_t input = { rInputString.data(), rInputString.size() };
+
+	return ParseInput(input, nId);
+}
+
+/**
+ * This function will parse the transformer data directly from a view of the input line
+ * (e.g. a line of the memory-mapped raw file) without any intermediate string.
+ *
+ * @param rInput a view with the transformer data to be parsed
+ * @param nId the type of the routine of parsing the input
+ * @return error information
+ */
+KpfaError_t
+KpfaTransformerData::ParseInput(const KpfaStringView_t &rInput, uint32_t nId) {
+
 	switch(nId) {
 		case 0:
-			return ParseRawDataLineType1(rInputString);
+			return ParseRawDataLineType1(rInput);
 		case 1:
-			return ParseRawDataLineType2(rInputString);
+			return ParseRawDataLineType2(rInput);
 		case 2:
-			return ParseRawDataLineType3(rInputString, 0);
+			return ParseRawDataLineType3(rInput, 0);
 		case 3:
 			if(m_nK != 0) {
-				return ParseRawDataLineType3(rInputString, 1);
+				return ParseRawDataLineType3(rInput, 1);
 			}
-			return ParseRawDataLineType4(rInputString);
+			return ParseRawDataLineType4(rInput);
 		case 4:
-			return ParseRawDataLineType3(rInputString, 2);
+			return ParseRawDataLineType3(rInput, 2);
 		default:
 			return KPFA_ERROR_TRANSFORMER_PARSE;
 	}
@@ -331,6 +342,53 @@ KpfaTransformerData::TransformUnit(double nSbase) {
 	return KPFA_SUCCESS;
 }
 
+/**
+ * This function will store the values of the raw data into the archive or load them from it.
+ *
+ * @param rArchive archive of the raw data
+ */
+void
+KpfaTransformerData::Serialize(KpfaRawDataArchive &rArchive) {
+
+	rArchive.Field(m_nI);
+	rArchive.Field(m_nJ);
+	rArchive.Field(m_nK);
+	rArchive.Field(m_nCkt);
+	rArchive.Field(m_nCw);
+	rArchive.Field(m_nCz);
+	rArchive.Field(m_nCm);
+	rArchive.Field(m_nMag1);
+	rArchive.Field(m_nMag2);
+	rArchive.Field(m_nNmetr);
+	rArchive.Field(m_rName);
+	rArchive.Field(m_nStat);
+	rArchive.Field(m_nWindingCount);
+	rArchive.Field(m_nOwnerCount);
+	rArchive.Field(m_nO);
+	rArchive.Field(m_nF);
+	rArchive.Field(m_nR);
+	rArchive.Field(m_nX);
+	rArchive.Field(m_nSbase);
+	rArchive.Field(m_nVmstar);
+	rArchive.Field(m_nAnstar);
+	rArchive.Field(m_nWindv);
+	rArchive.Field(m_nNomv);
+	rArchive.Field(m_nAng);
+	rArchive.Field(m_nRata);
+	rArchive.Field(m_nRatb);
+	rArchive.Field(m_nRatc);
+	rArchive.Field(m_nCod);
+	rArchive.Field(m_nCont);
+	rArchive.Field(m_nRma);
+	rArchive.Field(m_nRmi);
+	rArchive.Field(m_nVma);
+	rArchive.Field(m_nVmi);
+	rArchive.Field(m_nNtp);
+	rArchive.Field(m_nTap);
+	rArchive.Field(m_nCr);
+	rArchive.Field(m_nCx);
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
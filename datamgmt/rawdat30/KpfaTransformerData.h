@@ -137,8 +137,12 @@ public:
 
 	KpfaError_t ParseInput(string &rInputString, uint32_t nId = 0);
 
+	KpfaError_t ParseInput(const KpfaStringView_t &rInput, uint32_t nId = 0);
+
 	KpfaError_t TransformUnit(double nSbase);
 
+	void Serialize(KpfaRawDataArchive &rArchive);
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Functions
 	///////////////////////////////////////////////////////////////////
@@ -149,13 +153,13 @@ public:
 
 private:
 
-	KpfaError_t ParseRawDataLineType1(string &rInputString);
+	KpfaError_t ParseRawDataLineType1(const KpfaStringView_t &rInput);
 
-	KpfaError_t ParseRawDataLineType2(string &rInputString);
+	KpfaError_t ParseRawDataLineType2(const KpfaStringView_t &rInput);
 
-	KpfaError_t ParseRawDataLineType3(string &rInputString, uint32_t nIdx = 0);
+	KpfaError_t ParseRawDataLineType3(const KpfaStringView_t &rInput, uint32_t nIdx = 0);
 
-	KpfaError_t ParseRawDataLineType4(string &rInputString);
+	KpfaError_t ParseRawDataLineType4(const KpfaStringView_t &rInput);
 };
 
 #endif /* _KPFA_TRANSFORMER_DATA_H_ */
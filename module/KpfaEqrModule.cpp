@@ -7,6 +7,8 @@
 
 #include "KpfaUtility.h"
 #include "KpfaEqrModule.h"
+#include "KpfaSparseLU.h"
+#include "KpfaDenseKernel.h"
 #ifdef KPFA_RESULT_SUPPORT
 #include "KpfaInterface.h"
 #include "KpfaResultData.h"
@@ -75,37 +77,44 @@ KpfaEqrModule::Execute(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtrlDataMgmt *pCtrlDat
 }
 
 /**
- * This function will calculate EQR.
+ * This function will calculate EQR. If the given powerflow has been solved on
+ * the current raw data, its Y matrix and solved values are reused. Otherwise,
+ * the powerflow analysis is performed again (in the given powerflow if any).
  *
  * @param pRawDataMgmt raw data management
  * @param bFirst indicates whether the EQR calculation is exeucted at first
+ * @param pPowerflow powerflow solved by the caller (NULL if not available)
  * @return error information
  */
 KpfaError_t
-KpfaEqrModule::Calculate(KpfaRawDataMgmt *pDataMgmt, bool_t bFirst) {
+KpfaEqrModule::Calculate(KpfaRawDataMgmt *pDataMgmt, bool_t bFirst, KpfaPowerflow *pPowerflow) {
 
 	KpfaError_t error;
 	KPFA_CHECK(pDataMgmt != NULL, KPFA_ERROR_INVALID_ARGUMENT);
 
-	// performs powerflow analysis
-	KpfaPowerflow pfa(m_pCtrlDataMgmt);
-	error = pfa.DoAnalysis(pDataMgmt);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
+	KpfaPowerflow localPfa(m_pCtrlDataMgmt);
+	KpfaPowerflow *pfa = (pPowerflow != NULL) ? pPowerflow : &localPfa;
+
+	// performs powerflow analysis only if the network was modified since the last one
+	if(pfa->IsSolved(pDataMgmt) == FALSE) {
+		error = pfa->DoAnalysis(pDataMgmt);
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+	}
 
 	// get Y matrix
-	KpfaYMatrix *ymat = pfa.GetYMatrix();
+	KpfaYMatrix *ymat = pfa->GetYMatrix();
 
 	// build B matrix
 	error = BuildBMatrix(pDataMgmt, ymat);
 	KPFA_CHECK(error == KPFA_SUCCESS, KPFA_ERROR_BMATRIX_BUILD);
 
 	// calculate WeightFactor(WF) matrix
-	KpfaDoubleMatrix_t wmat;
+	KpfaDenseMatrix_t wmat;
 	error = CalculateWeightFactor(wmat);
 	KPFA_CHECK(error == KPFA_SUCCESS, KPFA_ERROR_WFACTOR_CALCULATE);
 
 	// calculate CQR matrix
-	KpfaDoubleMatrix_t cmat;
+	KpfaDenseMatrix_t cmat;
 	error = CalculateCQR(pDataMgmt, cmat, bFirst);
 	KPFA_CHECK(error == KPFA_SUCCESS, KPFA_ERROR_CQR_CALCULATE);
 
@@ -116,6 +125,135 @@ KpfaEqrModule::Calculate(KpfaRawDataMgmt *pDataMgmt, bool_t bFirst) {
 	return KPFA_SUCCESS;
 }
 
+/**
+ * This function will calculate the L-index of each load bus from the last
+ * converged solution of the given powerflow. The Y matrix is partitioned into
+ * the generator and load buses as the B matrix is, and
+ *
+ *   L_j = |1 - V0_j / V_j|,  V0_L = -Inv[Yll] x [Ylg] x V_G
+ *
+ * where V0_L is the voltages of the load buses without the load currents. So
+ * only a single solve of Yll is required, which is factorized with the sparse
+ * LU as the real matrix of twice the size. The bus types are those of the
+ * network model at the solution, so that a generator at its Q limit is taken
+ * as a load bus.
+ *
+ * @param pDataMgmt raw data management solved by the powerflow
+ * @param pPowerflow powerflow with the converged solution
+ * @return error information
+ */
+KpfaError_t
+KpfaEqrModule::CalculateLIndex(KpfaRawDataMgmt *pDataMgmt, KpfaPowerflow *pPowerflow) {
+
+	KPFA_CHECK(pDataMgmt != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+	KPFA_CHECK(pPowerflow != NULL && pPowerflow->GetYMatrix() != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	KpfaError_t error;
+
+	KpfaComplexMatrix_t::iterator1 riter;
+	KpfaComplexMatrix_t::iterator2 citer;
+
+	// Y matrix, V matrix (magnitude, angle) and bus types of the solution
+	KpfaComplexMatrix_t &ymat = pPowerflow->GetYMatrix()->GetMatrix();
+	KpfaComplexVector_t &vmat = pPowerflow->GetVMatrix();
+	KpfaNetworkBus_t &bus = pDataMgmt->GetNetworkModel()->GetBus();
+
+	uint32_t k, nbus = ymat.size1();
+
+	KPFA_CHECK(vmat.size() == nbus && bus.rIde.size() == nbus, KPFA_ERROR_INVALID_BUS_INDEX);
+
+	m_rLIndexList.assign(nbus, 0.0);
+	m_nMaxLIndex = 0;
+	m_nMaxLIndexBusId = 0;
+
+	// index of each load bus in Yll (KPFA_NETWORK_NO_INDEX if not a load bus)
+	std::vector<uint32_t> lindex(nbus, KPFA_NETWORK_NO_INDEX);
+	uint32_t nload = 0;
+
+	for(k = 0; k < nbus; k++) {
+		if(bus.rIde[k] == KPFA_LOAD_BUS) {
+			lindex[k] = nload++;
+		}
+	}
+
+	if(nload == 0) {
+		return KPFA_SUCCESS;
+	}
+
+	// Yll = G + jB as the real matrix of [G -B; B G] interleaved by bus, and
+	// the right-hand side of -[Ylg] x V_G
+	KpfaDoubleMatrix_t yll(2 * nload, 2 * nload, 4 * ymat.nnz());
+	std::vector<double> v0(2 * nload, 0.0);
+
+	for(riter = ymat.begin1(); riter != ymat.end1(); riter++) {
+
+		uint32_t r = lindex[riter.index1()];
+
+		if(r == KPFA_NETWORK_NO_INDEX) continue;
+
+		KpfaComplex_t ylg_v(0, 0);
+
+		// real row
+		for(citer = riter.begin(); citer != riter.end(); citer++) {
+
+			uint32_t j = citer.index2();
+			uint32_t c = lindex[j];
+			KpfaComplex_t y_kj = *citer;
+
+			if(c != KPFA_NETWORK_NO_INDEX) {
+				yll(2 * r, 2 * c) = y_kj.real();
+				yll(2 * r, 2 * c + 1) = -y_kj.imag();
+			}
+			else if(bus.rIde[j] == KPFA_GEN_BUS || bus.rIde[j] == KPFA_SWING_BUS) {
+				ylg_v += y_kj * std::polar(vmat(j).real(), vmat(j).imag());
+			}
+		}
+
+		// imaginary row
+		for(citer = riter.begin(); citer != riter.end(); citer++) {
+
+			uint32_t c = lindex[citer.index2()];
+			KpfaComplex_t y_kj = *citer;
+
+			if(c != KPFA_NETWORK_NO_INDEX) {
+				yll(2 * r + 1, 2 * c) = y_kj.imag();
+				yll(2 * r + 1, 2 * c + 1) = y_kj.real();
+			}
+		}
+
+		v0[2 * r] = -ylg_v.real();
+		v0[2 * r + 1] = -ylg_v.imag();
+	}
+
+	KpfaSparseLU lu;
+
+	error = lu.Factorize(yll);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	lu.Solve(&v0[0]);
+
+	for(k = 0; k < nbus; k++) {
+
+		uint32_t r = lindex[k];
+
+		if(r == KPFA_NETWORK_NO_INDEX) continue;
+
+		KpfaComplex_t v_k = std::polar(vmat(k).real(), vmat(k).imag());
+		KpfaComplex_t v0_k(v0[2 * r], v0[2 * r + 1]);
+
+		double l_k = std::abs(1.0 - v0_k / v_k);
+
+		m_rLIndexList[k] = l_k;
+
+		if(l_k > m_nMaxLIndex) {
+			m_nMaxLIndex = l_k;
+			m_nMaxLIndexBusId = bus.rId[k];
+		}
+	}
+
+	return KPFA_SUCCESS;
+}
+
 /**
  * This function will calculate CQR using generator buses.
  *
@@ -125,7 +263,7 @@ KpfaEqrModule::Calculate(KpfaRawDataMgmt *pDataMgmt, bool_t bFirst) {
  * @return error information
  */
 KpfaError_t
-KpfaEqrModule::CalculateCQR(KpfaRawDataMgmt *pDataMgmt, KpfaDoubleMatrix_t &rCmat, bool_t bFirst) {
+KpfaEqrModule::CalculateCQR(KpfaRawDataMgmt *pDataMgmt, KpfaDenseMatrix_t &rCmat, bool_t bFirst) {
 
 	KPFA_CHECK(pDataMgmt != NULL, KPFA_ERROR_INVALID_ARGUMENT);
 
@@ -167,7 +305,7 @@ KpfaEqrModule::CalculateCQR(KpfaRawDataMgmt *pDataMgmt, KpfaDoubleMatrix_t &rCma
 #ifdef KPFA_RESULT_SUPPORT
 	KpfaEqrList_t *eqrList = &g_pResultData->hEqrList;
 	KpfaEqrCtg_t *eqrCtgList = (bFirst == TRUE) ?
-		&eqrList->pPrevList[k] : &eqrList->pNextList[k];
+		&eqrList->pPrevList[KpfaGetResultSlot(k)] : &eqrList->pNextList[KpfaGetResultSlot(k)];
 	eqrCtgList->nEqrMarginC = m_nEqrMarginC;
 	eqrCtgList->nEqrMarginL = m_nEqrMarginL;
 	eqrCtgList->nCqrValueC = m_nCqrC;
@@ -189,8 +327,8 @@ KpfaEqrModule::CalculateCQR(KpfaRawDataMgmt *pDataMgmt, KpfaDoubleMatrix_t &rCma
  */
 KpfaError_t
 KpfaEqrModule::CalculateEQR(KpfaRawDataMgmt *pDataMgmt,
-						 	KpfaDoubleMatrix_t &rWmat,
-							KpfaDoubleMatrix_t &rCmat,
+						 	KpfaDenseMatrix_t &rWmat,
+							KpfaDenseMatrix_t &rCmat,
 							KpfaDoubleMatrix_t &rEmat,
 							bool_t bFirst) {
 
@@ -207,8 +345,24 @@ KpfaEqrModule::CalculateEQR(KpfaRawDataMgmt *pDataMgmt,
 	KpfaRawDataList_t &genList = pDataMgmt->GetGenDataList();
 	KpfaRawDataList_t &loadList = pDataMgmt->GetLoadDataList();
 
+	uint32_t ngen = genList.size();
 	uint32_t nload = loadList.size();
 
+	// EQR of all loads at once by the weighted sums of CQR (C, L):
+	///////////////////////////////////////////////////////////
+	// EQR = Transpose{w-factor} x CQR
+	///////////////////////////////////////////////////////////
+	std::vector<double> cqrC(ngen + 1), cqrL(ngen + 1);
+	std::vector<double> eqrListC(nload + 1), eqrListL(nload + 1);
+
+	for(j = 0; j < ngen; j++) {
+		cqrC[j] = rCmat(j, 0);
+		cqrL[j] = rCmat(j, 1);
+	}
+
+	KpfaGemv(&eqrListC[0], rWmat, &cqrC[0], true);
+	KpfaGemv(&eqrListL[0], rWmat, &cqrL[0], true);
+
 	// reset EQR matrix
 	rEmat.resize(nload, 2, false);
 	rEmat.clear();
@@ -216,9 +370,11 @@ KpfaEqrModule::CalculateEQR(KpfaRawDataMgmt *pDataMgmt,
 #ifdef KPFA_RESULT_SUPPORT
 	KpfaEqrList_t *eqrList = &g_pResultData->hEqrList;
 	KpfaEqrCtg_t *eqrCtgList = (bFirst == TRUE) ?
-		&eqrList->pPrevList[k] : &eqrList->pNextList[k];
-	eqrCtgList->pList = (KpfaEqr_t *)malloc(sizeof(KpfaEqr_t) * nload);
+		&eqrList->pPrevList[KpfaGetResultSlot(k)] : &eqrList->pNextList[KpfaGetResultSlot(k)];
+	eqrCtgList->pList = KPFA_RESULT_ALLOC(KpfaEqr_t, nload);
 	eqrCtgList->nSize = nload;
+
+	KPFA_CHECK(eqrCtgList->pList != NULL, KPFA_ERROR_MEMORY_ALLOC);
 #endif
 
 	uint32_t minIdxC = 0;
@@ -227,18 +383,8 @@ KpfaEqrModule::CalculateEQR(KpfaRawDataMgmt *pDataMgmt,
 	// for each load
 	for(i = 0, riter = loadList.begin(); riter != loadList.end(); riter++, i++) {
 
-		double eqrC = 0;	// t
-		double eqrL = 0;	// b
-
-	 	// for all generators
-		for(j = 0, citer = genList.begin(); citer != genList.end(); citer++, j++) {
-
-			eqrC += (rWmat(j, i) * rCmat(j, 0));
-			eqrL += (rWmat(j, i) * rCmat(j, 1));
-		}
-
-		eqrC *= pDataMgmt->m_nSysBase;
-		eqrL *= pDataMgmt->m_nSysBase;
+		double eqrC = eqrListC[i] * pDataMgmt->m_nSysBase;	// t
+		double eqrL = eqrListL[i] * pDataMgmt->m_nSysBase;	// b
 
 #ifdef KPFA_RESULT_SUPPORT
 		KpfaLoadData *loadData = (KpfaLoadData *)*riter;
@@ -291,27 +437,36 @@ KpfaEqrModule::CalculateEQR(KpfaRawDataMgmt *pDataMgmt,
 }
 
 /**
- * This function will build the Z matrix with the given Y matrix.
+ * This function will build the Z matrix (inverse of the imaginary part of the
+ * Y matrix) among the given buses only. The imaginary part is factorized once
+ * with the sparse LU, and the column of each bus is solved to pick the rows of
+ * the buses, so that neither the inverse nor a dense copy of the matrix is made.
  *
  * @param pYmat Y matrix
- * @param rZmat return Z matrix (inverse Y matrix)
+ * @param rBusList bus indices of the rows and columns
+ * @param rZmat return Z matrix among the buses (rZmat(r, c) = Z(rBusList[r], rBusList[c]))
  * @return error information
  */
 KpfaError_t 
-KpfaEqrModule::BuildZMatrix(KpfaYMatrix *pYmat, KpfaDoubleMatrix_t &rZmat) {
+KpfaEqrModule::BuildZMatrix(KpfaYMatrix *pYmat,
+							std::vector<uint32_t> &rBusList,
+							KpfaDenseMatrix_t &rZmat) {
 
 	KPFA_CHECK(pYmat != NULL, KPFA_ERROR_INVALID_ARGUMENT);
 
+	KpfaError_t error;
+
 	KpfaComplexMatrix_t::iterator1 riter;
 	KpfaComplexMatrix_t::iterator2 citer;
 
 	// Y matrix
 	KpfaComplexMatrix_t &ymat = pYmat->GetMatrix();
 
+	uint32_t nbus = ymat.size1();
+	uint32_t ncol = rBusList.size();
+
 	// build temporary matrix including only the imaginary values of the given Y matrix 
-	KpfaDoubleMatrix_t tmp;
-	tmp.resize(ymat.size1(), ymat.size2(), false);	
-	tmp.clear();
+	KpfaDoubleMatrix_t tmp(nbus, nbus, ymat.nnz());
 
 	// copy only imaginary value from the Y matrix
 	for(riter = ymat.begin1(); riter != ymat.end1(); riter++) {
@@ -322,8 +477,33 @@ KpfaEqrModule::BuildZMatrix(KpfaYMatrix *pYmat, KpfaDoubleMatrix_t &rZmat) {
 			tmp(i,j) = y_ij.imag();
 		}
 	}
-	
-	return InverseMatrix(tmp, rZmat);
+
+	// perform sparse LU-factorization
+	KpfaSparseLU lu;
+
+	error = lu.Factorize(tmp);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	// solve the unit column of each bus, and pick the rows of the buses
+	std::vector<double> zcol(nbus, 0.0);
+
+	rZmat.resize(ncol, ncol, false);
+
+	for(uint32_t c = 0; c < ncol; c++) {
+
+		KPFA_CHECK(rBusList[c] < nbus, KPFA_ERROR_INVALID_BUS_INDEX);
+
+		std::fill(zcol.begin(), zcol.end(), 0.0);
+		zcol[rBusList[c]] = 1.0;
+
+		lu.Solve(&zcol[0]);
+
+		for(uint32_t r = 0; r < ncol; r++) {
+			rZmat(r, c) = zcol[rBusList[r]];
+		}
+	}
+
+	return KPFA_SUCCESS;
 }
 
 /**
@@ -342,18 +522,31 @@ KpfaEqrModule::BuildBMatrix(KpfaRawDataMgmt *pDataMgmt, KpfaYMatrix *pYmat) {
 	KpfaRawDataList_t::iterator riter;
 	KpfaRawDataList_t::iterator citer;
 
-	// Z matrix
-	KpfaDoubleMatrix_t zmat;
-	BuildZMatrix(pYmat, zmat);
-
 	// generator, load list
 	KpfaRawDataList_t &genList = pDataMgmt->GetGenDataList();
 	KpfaRawDataList_t &loadList = pDataMgmt->GetLoadDataList();
 
+	// bus indices of the generators and loads
+	KpfaNetworkModel *model = pDataMgmt->GetNetworkModel();
+	std::vector<uint32_t> &genBus = model->GetGen().rBus;
+	std::vector<uint32_t> &loadBus = model->GetLoad().rBus;
+
 	// build Bgg, Bgl, Blg, Bll matrices
 	uint32_t ngen = genList.size();
 	uint32_t nload = loadList.size();
 
+	KPFA_CHECK(ngen == model->GetGenCount(), KPFA_ERROR_INVALID_BUS_INDEX);
+	KPFA_CHECK(nload == model->GetLoadCount(), KPFA_ERROR_INVALID_BUS_INDEX);
+
+	// Z matrix among the generator buses followed by the load buses
+	std::vector<uint32_t> busList(genBus);
+	busList.insert(busList.end(), loadBus.begin(), loadBus.end());
+
+	KpfaDenseMatrix_t zmat;
+
+	KpfaError_t error = BuildZMatrix(pYmat, busList, zmat);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
 	m_rBggMat.resize( ngen,  ngen, false);	m_rBggMat.clear();
 	m_rBglMat.resize( ngen, nload, false);	m_rBglMat.clear();
 	m_rBlgMat.resize(nload,  ngen, false);	m_rBlgMat.clear();
@@ -363,37 +556,21 @@ KpfaEqrModule::BuildBMatrix(KpfaRawDataMgmt *pDataMgmt, KpfaYMatrix *pYmat) {
 	uint32_t b_k = 0, b_j = 0;
 
 	// Bgg
-	for(riter = genList.begin(), b_k = 0; riter != genList.end(); riter++, b_k++) {
-
-		KpfaGenData *gen_k = (KpfaGenData *)*riter;
-
-		for(citer = genList.begin(), b_j = 0; citer != genList.end(); citer++, b_j++) {
-
-			KpfaGenData *gen_j = (KpfaGenData *)*citer;
+	for(b_k = 0; b_k < ngen; b_k++) {
 
-			// get the generator k, j indices of Y matrix
-			uint32_t y_k = pDataMgmt->GetBusIndex(gen_k->m_nI);
-			uint32_t y_j = pDataMgmt->GetBusIndex(gen_j->m_nI);
+		for(b_j = 0; b_j < ngen; b_j++) {
 
-			m_rBggMat(b_k, b_j) = zmat(y_k, y_j);
+			m_rBggMat(b_k, b_j) = zmat(b_k, b_j);
 		}
 	}
 
 	// Bgl, Blg
-	for(riter = genList.begin(), b_k = 0; riter != genList.end(); riter++, b_k++) {
-
-		KpfaGenData *gen_k = (KpfaGenData *)*riter;
-
-		for(b_j = 0, citer = loadList.begin(); citer != loadList.end(); citer++, b_j++) {
+	for(b_k = 0; b_k < ngen; b_k++) {
 
-			KpfaLoadData *load_j = (KpfaLoadData *)*citer;
+		for(b_j = 0; b_j < nload; b_j++) {
 
-			// get the generator k, load j indices of Y matrix
-			uint32_t y_k = pDataMgmt->GetBusIndex( gen_k->m_nI);
-			uint32_t y_j = pDataMgmt->GetBusIndex(load_j->m_nI);
-
-			m_rBglMat(b_k, b_j) = zmat(y_k, y_j);
-			m_rBlgMat(b_j, b_k) = zmat(y_j, y_k);
+			m_rBglMat(b_k, b_j) = zmat(b_k, ngen + b_j);
+			m_rBlgMat(b_j, b_k) = zmat(ngen + b_j, b_k);
 		}
 	}
 
@@ -418,136 +595,89 @@ KpfaEqrModule::BuildBMatrix(KpfaRawDataMgmt *pDataMgmt, KpfaYMatrix *pYmat) {
 #endif
 
 	// Bll
-	for(riter = loadList.begin(), b_k = 0; riter != loadList.end(); riter++, b_k++) {
+	for(b_k = 0; b_k < nload; b_k++) {
 
-		KpfaLoadData *load_k = (KpfaLoadData *)*riter;
-
-		for(citer = loadList.begin(), b_j = 0; citer != loadList.end(); citer++, b_j++) {
+		for(b_j = 0; b_j < nload; b_j++) {
 
-			KpfaLoadData *load_j = (KpfaLoadData *)*citer;
-
-			// get the load k, j indices of Y matrix
-			uint32_t y_k = pDataMgmt->GetBusIndex(load_k->m_nI);
-			uint32_t y_j = pDataMgmt->GetBusIndex(load_j->m_nI);
-
-			m_rBllMat(b_k, b_j) = zmat(y_k, y_j);
+			m_rBllMat(b_k, b_j) = zmat(ngen + b_k, ngen + b_j);
 		}
 	}
 
 	return KPFA_SUCCESS;
 }
 
-/**
- * This function will calculate the inverse matrix of the given matrix.
- *
- * @param rMat original input matrix
- * @param rInvMat output inverse matrix
- * @return error information
- */
-KpfaError_t
-KpfaEqrModule::InverseMatrix(KpfaDoubleMatrix_t &rMat, KpfaDoubleMatrix_t &rInvMat) {
-
-	uint32_t msize = rMat.size1();
-
-	// create identity matrix of "inverse"
-	rInvMat.resize(msize, msize, false);
-	rInvMat.clear();
-
-	rInvMat.assign(identity_matrix<double>(msize));
-
-	// create a permutation matrix for the LU-factorization
-	permutation_matrix<std::size_t> pmat(msize);
-
-	// perform LU-factorization
-	if(lu_factorize(rMat, pmat) != 0) {
-		return KPFA_ERROR_LU_FACTORIZE;
-	}
-
-	// back-substitute to get the inverse
-	lu_substitute(rMat, pmat, rInvMat);
-
-	return KPFA_SUCCESS;
-}
-
 /**
  * This function will calculate the weight factor using the B matrix.
+ * Bll and the Schur complement of Bll are factorized and solved against
+ * the other blocks, so that no inverse matrix is formed explicitly.
  *
  * @param rWmat weight factor matrix
  * @return error information
  */
 KpfaError_t
-KpfaEqrModule::CalculateWeightFactor(KpfaDoubleMatrix_t &rWmat) {
+KpfaEqrModule::CalculateWeightFactor(KpfaDenseMatrix_t &rWmat) {
 
-	KpfaError_t error;
-
-	// temporary matrix
-	KpfaDoubleMatrix_t tmp;
+	uint32_t ngen = m_rBggMat.size1();
+	uint32_t nload = m_rBllMat.size1();
 
-	// S matrix
-	KpfaDoubleMatrix_t sgg;
-	KpfaDoubleMatrix_t sgl;
+	// 1. solve Bll with Blg:
+	///////////////////////////////////////////////////////////
+	// Xlg = Inv[Bll] x [Blg]
+	///////////////////////////////////////////////////////////
+	permutation_matrix<std::size_t> pll(nload);
 
-	// inverse Sgg, Bll matrices
-	KpfaDoubleMatrix_t invSgg;
-	KpfaDoubleMatrix_t invBll;
+	if(lu_factorize(m_rBllMat, pll) != 0) {
+		return KPFA_ERROR_LU_FACTORIZE;
+	}
 
-	error = InverseMatrix(m_rBllMat, invBll);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
+	KpfaDenseMatrix_t xlg(m_rBlgMat);
+	lu_substitute(m_rBllMat, pll, xlg);
 
-	// 1. build Sgg matrix:
+	// 2. build the Schur complement of Bll (inverse of Sgg matrix):
 	///////////////////////////////////////////////////////////
-	// Sgg = Inv{[Bgg] - [Bgl] x Inv[Bll] x [Blg]}
+	// Inv[Sgg] = [Bgg] - [Bgl] x Xlg
 	///////////////////////////////////////////////////////////
+	KpfaDenseMatrix_t invSgg(m_rBggMat);
+	KpfaGemm(invSgg, m_rBglMat, xlg, -1.0, 1.0);
 
-	tmp = block_prod<KpfaDoubleMatrix_t, 64>(m_rBglMat, invBll);
-	tmp = block_prod<KpfaDoubleMatrix_t, 64>(tmp, m_rBlgMat);
-	invSgg = m_rBggMat - tmp;
-
-	error = InverseMatrix(invSgg, sgg);
-	KPFA_CHECK(error == KPFA_SUCCESS, error);
-
-	// 2. build Sgl matrix (transpose of Slg matrix):
+	// 3. build Sgl matrix (transpose of Slg matrix):
 	///////////////////////////////////////////////////////////
-	// Sgl = Transpose{Inv[Bll] x [Blg] x [Sgg]}
+	// Sgl = Transpose{Xlg x [Sgg]}
+	//     = solution of Transpose{Inv[Sgg]} x Sgl = Transpose{Xlg}
 	///////////////////////////////////////////////////////////
-	tmp = block_prod<KpfaDoubleMatrix_t, 64>(invBll, m_rBlgMat);
-	tmp = block_prod<KpfaDoubleMatrix_t, 64>(tmp, sgg);
+	KpfaDenseMatrix_t tsgg(trans(invSgg));
+	permutation_matrix<std::size_t> pgg(ngen);
 
-	sgl = trans(tmp);
+	if(lu_factorize(tsgg, pgg) != 0) {
+		return KPFA_ERROR_LU_FACTORIZE;
+	}
 
-	// 3. calculate w-factor matrix:
+	KpfaDenseMatrix_t sgl(trans(xlg));
+	lu_substitute(tsgg, pgg, sgl);
+
+	// 4. calculate w-factor matrix:
 	///////////////////////////////////////////////////////////
 	// w-factor = Inv[Sgg] x Sgl
 	///////////////////////////////////////////////////////////
-	rWmat = block_prod<KpfaDoubleMatrix_t, 64>(invSgg, sgl);
-
+	KpfaGemm(rWmat, invSgg, sgl);
 
-	// 4. normalize w-factor matrix:
+	// 5. normalize w-factor matrix:
 	///////////////////////////////////////////////////////////
 	// w-factor /= max value
 	///////////////////////////////////////////////////////////
-	int i;
+	for(uint32_t i = 0; i < ngen; i++) {
 
-	KpfaDoubleMatrix_t::iterator1 riter;
-	KpfaDoubleMatrix_t::iterator2 citer;
+		double norm = 0;
 
-	double *normArray = new double[rWmat.size1()];
-
-	for(i = 0, riter = rWmat.begin1(); riter != rWmat.end1(); riter++) {
-		double norm = 0;
-		for(citer = riter.begin(); citer != riter.end(); citer++) {
-			if(norm < *citer) {
-				norm = *citer;
+		for(uint32_t j = 0; j < nload; j++) {
+			if(norm < rWmat(i, j)) {
+				norm = rWmat(i, j);
 			}
 		}
-		normArray[i++] = norm;
-	}
 
-	for(i = 0, riter = rWmat.begin1(); riter != rWmat.end1(); riter++) {
-		for(citer = riter.begin(); citer != riter.end(); citer++) {
-			*citer /= normArray[i];
+		for(uint32_t j = 0; j < nload; j++) {
+			rWmat(i, j) /= norm;
 		}
-		i++;
 	}
 
 	return KPFA_SUCCESS;
@@ -11,6 +11,7 @@
 #include "KpfaDebug.h"
 #include "KpfaConfig.h"
 #include "KpfaYMatrix.h"
+#include "KpfaPowerflow.h"
 #include "KpfaRawDataMgmt.h"
 #include "KpfaCtrlDataMgmt.h"
 
@@ -40,11 +41,16 @@ private:
 	// EQR matrix
 	KpfaDoubleMatrix_t m_rEqrMat;
 
-	// B matrix
-	KpfaDoubleMatrix_t m_rBggMat;
-	KpfaDoubleMatrix_t m_rBglMat;
-	KpfaDoubleMatrix_t m_rBlgMat;
-	KpfaDoubleMatrix_t m_rBllMat;
+	// B matrix (dense blocks of the Z matrix)
+	KpfaDenseMatrix_t m_rBggMat;
+	KpfaDenseMatrix_t m_rBglMat;
+	KpfaDenseMatrix_t m_rBlgMat;
+	KpfaDenseMatrix_t m_rBllMat;
+
+	// L-index of each bus (zero for the generator buses), and the maximum one
+	std::vector<double> m_rLIndexList;
+	double m_nMaxLIndex;
+	uint32_t m_nMaxLIndexBusId;
 
 	// Control data management
 	KpfaCtrlDataMgmt *m_pCtrlDataMgmt;
@@ -73,6 +79,10 @@ public:
 		m_rBglMat.clear();
 		m_rBlgMat.clear();
 		m_rBllMat.clear();
+
+		m_rLIndexList.clear();
+		m_nMaxLIndex = 0;
+		m_nMaxLIndexBusId = 0;
 	}
 
 	virtual ~KpfaEqrModule() {
@@ -87,7 +97,11 @@ public:
 
 	KpfaError_t Execute(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtrlDataMgmt *pCtrlDataMgmt);
 
-	KpfaError_t Calculate(KpfaRawDataMgmt *pRawDataMgmt, bool_t bFirst = TRUE);
+	KpfaError_t Calculate(KpfaRawDataMgmt *pRawDataMgmt,
+						  bool_t bFirst = TRUE,
+						  KpfaPowerflow *pPowerflow = NULL);
+
+	KpfaError_t CalculateLIndex(KpfaRawDataMgmt *pRawDataMgmt, KpfaPowerflow *pPowerflow);
 
 	/**
 	 * This function will return the reactive value of EQR.
@@ -126,24 +140,46 @@ public:
 		return m_rEqrMat;
 	}
 
-private:
+	/**
+	 * This function will return the maximum L-index among the load buses.
+	 *
+	 * @return maximum L-index
+	 */
+	inline double GetMaxLIndex() {	return m_nMaxLIndex;	}
 
-	KpfaError_t InverseMatrix(KpfaDoubleMatrix_t &rMat,
-							  KpfaDoubleMatrix_t &rInvMat);
+	/**
+	 * This function will return the ID of the bus with the maximum L-index.
+	 *
+	 * @return bus ID
+	 */
+	inline uint32_t GetMaxLIndexBusId() {	return m_nMaxLIndexBusId;	}
+
+	/**
+	 * This function will return the L-index of each bus by the bus index.
+	 *
+	 * @return L-index list
+	 */
+	inline std::vector<double> &GetLIndexList() {
+		return m_rLIndexList;
+	}
+
+private:
 
-	KpfaError_t CalculateWeightFactor(KpfaDoubleMatrix_t &rWmat);
+	KpfaError_t CalculateWeightFactor(KpfaDenseMatrix_t &rWmat);
 
 	KpfaError_t CalculateCQR(KpfaRawDataMgmt *pDataMgmt, 
-							 KpfaDoubleMatrix_t &rCmat, 
+							 KpfaDenseMatrix_t &rCmat, 
 							 bool_t bFirst);
 
 	KpfaError_t CalculateEQR(KpfaRawDataMgmt *pDataMgmt,
-							 KpfaDoubleMatrix_t &rWmat,
-							 KpfaDoubleMatrix_t &rCmat,
+							 KpfaDenseMatrix_t &rWmat,
+							 KpfaDenseMatrix_t &rCmat,
 							 KpfaDoubleMatrix_t &rEmat,
 							 bool_t bFirst);
 
-	KpfaError_t BuildZMatrix(KpfaYMatrix *pYmat, KpfaDoubleMatrix_t &rZmat);
+	KpfaError_t BuildZMatrix(KpfaYMatrix *pYmat,
+							 std::vector<uint32_t> &rBusList,
+							 KpfaDenseMatrix_t &rZmat);
 
 	KpfaError_t BuildBMatrix(KpfaRawDataMgmt *pDataMgmt, KpfaYMatrix *pYmat);
 
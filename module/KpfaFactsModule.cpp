@@ -24,7 +24,10 @@ KpfaFactsModule::Execute(KpfaRawDataMgmt *pRawDataMgmt) {
 		KpfaFactsData *factsData = (KpfaFactsData *)*fiter;
 
 		// insert the new shunt data at the end of the shunt list
-		KpfaSwitchedShuntData *shuntData = new KpfaSwitchedShuntData();
+		KpfaSwitchedShuntData *shuntData =
+				(KpfaSwitchedShuntData *)pRawDataMgmt->NewRawData(KPFA_RAW_SWITCHED_SHUNT);
+		KPFA_CHECK(shuntData != NULL, KPFA_ERROR_MEMORY_ALLOC);
+
 		shuntData->m_nBinit = -factsData->m_nRequiredQ;
 		pRawDataMgmt->GetSwitchedShuntDataList().push_back(shuntData);
 
@@ -35,6 +38,10 @@ KpfaFactsModule::Execute(KpfaRawDataMgmt *pRawDataMgmt) {
 		shuntBus->m_nBl += shuntData->m_nBinit;
 	}
 
+	if(factsList.empty() == false) {
+		pRawDataMgmt->SetModified();
+	}
+
 	return KPFA_SUCCESS;
 }
 
@@ -78,6 +85,8 @@ KpfaFactsModule::Execute(KpfaRawDataMgmt *pRawDataMgmt, bool_t bIncrement) {
 				bus->m_nVm += m_nVsStep;
 				gen->m_nVs += m_nVsStep;
 
+				pRawDataMgmt->SetModified();
+
 				if(((qt - qg) / qt) < KPFA_FACTS_VS_MARGIN) {
 					gen->m_nQg = qt;
 				}
@@ -91,6 +100,8 @@ KpfaFactsModule::Execute(KpfaRawDataMgmt *pRawDataMgmt, bool_t bIncrement) {
 				bus->m_nVm -= m_nVsStep;
 				gen->m_nVs -= m_nVsStep;
 
+				pRawDataMgmt->SetModified();
+
 				if(((qg - qb) / qb) < KPFA_FACTS_VS_MARGIN) {
 					gen->m_nQg = qb;
 				}
@@ -107,6 +118,158 @@ KpfaFactsModule::Execute(KpfaRawDataMgmt *pRawDataMgmt, bool_t bIncrement) {
 	return FALSE;
 }
 
+/**
+ * This function will apply a stabilization algorithm to the given raw data for FACTS
+ * with the fixed Vs step, or with the adaptive one if it is enabled.
+ *
+ * @param pRawDataMgmt raw data management to be stabilized
+ * @param bIncrement if the FACTS will be incrementally updated
+ * @param nMargin GV margin with the current setpoints
+ * @param pBusList bus data of the last converged GV point (NULL if not available)
+ * @return if the FACTS was updated
+ */
+bool_t
+KpfaFactsModule::Execute(KpfaRawDataMgmt *pRawDataMgmt, bool_t bIncrement, double nMargin,
+						 std::vector<KpfaBusData> *pBusList) {
+
+	if(m_pCtrlDataMgmt != NULL && m_pCtrlDataMgmt->m_bAdaptiveFacts == TRUE) {
+		return ExecuteAdaptive(pRawDataMgmt, bIncrement, nMargin, pBusList);
+	}
+
+	return Execute(pRawDataMgmt, bIncrement);
+}
+
+/**
+ * This function will move the setpoints of the FACTS generators by the step
+ * estimated to reach the full GV margin, instead of the fixed Vs step. The
+ * step is the secant of the margin on the last step, bounded by the fixed Vs
+ * step and KPFA_FACTS_VS_MAX_STEP. The step is doubled if the last step did
+ * not increase the margin. The step of each generator is also bounded
+ * by the secant of its reactive power, so that it stops at its Q limit instead
+ * of stepping over it. The reactive power is taken from the last converged GV
+ * point if given, since the failed analysis leaves it at the limits, and from
+ * the raw data otherwise. The setpoints are updated at most KPFA_FACTS_MAX_UPDATE
+ * times.
+ *
+ * @param pRawDataMgmt raw data management to be stabilized
+ * @param bIncrement if the FACTS will be incrementally updated
+ * @param nMargin GV margin with the current setpoints
+ * @param pBusList bus data of the last converged GV point (NULL if not available)
+ * @return if the FACTS was updated
+ */
+bool_t
+KpfaFactsModule::ExecuteAdaptive(KpfaRawDataMgmt *pRawDataMgmt, bool_t bIncrement, double nMargin,
+								 std::vector<KpfaBusData> *pBusList) {
+
+	bool_t updated = FALSE;
+
+	// generator list
+	KpfaRawDataList_t &genList = pRawDataMgmt->GetGenDataList();
+
+	// bus list
+	KpfaRawDataList_t &busList = pRawDataMgmt->GetBusDataList();
+
+	if(pBusList != NULL && pBusList->size() != busList.size()) {
+		pBusList = NULL;
+	}
+
+	if(m_nUpdateCount >= KPFA_FACTS_MAX_UPDATE) {
+		return FALSE;
+	}
+
+	if(m_rPrevList.size() != genList.size()) {
+
+		KpfaFactsPoint_t point = { FALSE, 0.0, 0.0 };
+
+		m_rPrevList.assign(genList.size(), point);
+		m_nPrevStep = 0.0;
+	}
+
+	// step to reach the full margin (secant of the margin on the last step)
+	double step = m_nVsStep;
+
+	if(m_nPrevStep > 0) {
+
+		double slope = (nMargin - m_nPrevMargin) / m_nPrevStep;
+
+		// expand the step on the flat margin (the margin moves by the G-steps)
+		step = (slope > 0) ? (1.0 - nMargin) / slope : 2.0 * m_nPrevStep;
+	}
+
+	step = std::min(std::max(step, m_nVsStep), KPFA_FACTS_VS_MAX_STEP);
+
+	double sign = (bIncrement == TRUE) ? 1.0 : -1.0;
+	double moved = 0;
+
+	for(uint32_t g = 0; g < genList.size(); g++) {
+
+		KpfaGenData *gen = (KpfaGenData *)genList[g];
+
+		// skip non-FACTS generators
+		if(gen->m_bFacts != TRUE) {
+			continue;
+		}
+
+		// get the bus of the generator
+		KpfaBusData *bus = pRawDataMgmt->GetBusData(gen->m_nI);
+		KPFA_CHECK(bus != NULL, FALSE);
+
+		KpfaFactsPoint_t &prev = m_rPrevList[g];
+
+		double qg = bus->m_nQg;
+
+		if(pBusList != NULL) {
+			qg = (*pBusList)[pRawDataMgmt->GetBusIndex(gen->m_nI)].m_nQg;
+		}
+
+		double limit = (bIncrement == TRUE) ? gen->m_nQt : gen->m_nQb;
+
+		// room of the reactive power to the limit
+		double room = sign * (limit - qg);
+
+		if(room <= 0 || room < KPFA_FACTS_VS_MARGIN * fabs(limit)) {
+			gen->m_nQg = limit;
+			prev.bValid = FALSE;
+			continue;
+		}
+
+		double dvs = step;
+
+		// stop at the Q limit (secant of the reactive power on the last step)
+		if(prev.bValid == TRUE && gen->m_nVs != prev.nVs) {
+
+			double sensitivity = (qg - prev.nQg) / (gen->m_nVs - prev.nVs);
+
+			if(sensitivity > 0) {
+				dvs = std::min(dvs, room / sensitivity);
+			}
+		}
+
+		prev.bValid = TRUE;
+		prev.nVs = gen->m_nVs;
+		prev.nQg = qg;
+
+		bus->m_nVm += sign * dvs;
+		gen->m_nVs += sign * dvs;
+
+		moved = std::max(moved, dvs);
+		updated = TRUE;
+	}
+
+	if(updated == FALSE) {
+		m_nPrevStep = 0.0;
+		return FALSE;
+	}
+
+	pRawDataMgmt->SetModified();
+
+	m_nPrevMargin = nMargin;
+	m_nPrevStep = moved;
+	m_nUpdateCount++;
+
+	return TRUE;
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
@@ -16,6 +16,19 @@
 #define KPFA_FACTS_VS_STEP		(double)0.005
 #define KPFA_FACTS_VS_MARGIN	(double)0.02
 
+// Largest Vs step and the number of the adaptive updates
+#define KPFA_FACTS_VS_MAX_STEP	(double)0.05
+#define KPFA_FACTS_MAX_UPDATE	16
+
+/**
+ * Setpoint and reactive power of a FACTS generator before the last adaptive update
+ */
+typedef struct {
+	bool_t bValid;
+	double nVs;
+	double nQg;
+} KpfaFactsPoint_t;
+
 /**
  * The declaration of the class for FACTS algorithm module
  */
@@ -32,12 +45,26 @@ private:
 	// Control data management
 	KpfaCtrlDataMgmt *m_pCtrlDataMgmt;
 
+	// GV margin and Vs step of the last adaptive update (no step if zero)
+	double m_nPrevMargin;
+	double m_nPrevStep;
+
+	// Number of the adaptive updates
+	uint32_t m_nUpdateCount;
+
+	// FACTS generators before the last adaptive update (in the order of the generators)
+	std::vector<KpfaFactsPoint_t> m_rPrevList;
+
 public:
 
 	KpfaFactsModule(KpfaCtrlDataMgmt *pCtrlDataMgmt = NULL) {
 		m_pCtrlDataMgmt = pCtrlDataMgmt;
 
 		m_nVsStep = KPFA_FACTS_VS_STEP;
+
+		m_nPrevMargin = 0.0;
+		m_nPrevStep = 0.0;
+		m_nUpdateCount = 0;
 	}
 
 	virtual ~KpfaFactsModule() {
@@ -66,6 +93,12 @@ public:
 
 	bool_t Execute(KpfaRawDataMgmt *pRawDataMgmt, bool_t bIncrement);
 
+	bool_t Execute(KpfaRawDataMgmt *pRawDataMgmt, bool_t bIncrement, double nMargin,
+				   std::vector<KpfaBusData> *pBusList = NULL);
+
+	bool_t ExecuteAdaptive(KpfaRawDataMgmt *pRawDataMgmt, bool_t bIncrement, double nMargin,
+						   std::vector<KpfaBusData> *pBusList = NULL);
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Functions
 	///////////////////////////////////////////////////////////////////
@@ -5,6 +5,9 @@
  *      Author: youngsun
  */
 
+#include <thread>
+#include <algorithm>
+
 #include "KpfaGvModule.h"
 #include "KpfaPowerflow.h"
 #ifdef KPFA_RESULT_SUPPORT
@@ -34,6 +37,8 @@ KpfaGvModule::Execute(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtgData *pCtgData) {
 
 	m_rGvDataList.clear();
 
+	m_rResume.pCtgData = NULL;
+
 	double gstep = m_pCtrlDataMgmt->m_nGstep / pRawDataMgmt->m_nSysBase;
 
 	uint32_t inc0 = m_pCtrlDataMgmt->m_nIncrement0;
@@ -96,7 +101,7 @@ KpfaGvModule::Execute(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtgData *pCtgData) {
 	}
 #ifdef KPFA_RESULT_SUPPORT
 	else {
-		g_pResultData->hGvList.pList[pCtgData->GetIndex()].nSize = 0;
+		g_pResultData->hGvList.pList[KpfaGetResultSlot(pCtgData->GetIndex())].nSize = 0;
 
 		return KPFA_SUCCESS;
 	}
@@ -144,18 +149,53 @@ KpfaGvModule::Execute(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtgData *pCtgData) {
 
 #ifdef KPFA_RESULT_SUPPORT
 	KpfaGvList_t *gvCtgList = &g_pResultData->hGvList;
-	KpfaGvCtg_t *gvCtgItem = &gvCtgList->pList[pCtgData->GetIndex()];
+	KpfaGvCtg_t *gvCtgItem = &gvCtgList->pList[KpfaGetResultSlot(pCtgData->GetIndex())];
 
 	// Calculate the number of GV steps
 	int numGvStep = ((int)(totalPg0 / gstep) + 1);
 
 	gvCtgItem->nMargin = 1.0;
 	gvCtgItem->nSize = numGvStep;
-	gvCtgItem->pList = (KpfaGv_t *)malloc(sizeof(KpfaGv_t) * numGvStep);
+	gvCtgItem->pList = KPFA_RESULT_ALLOC(KpfaGv_t, numGvStep);
+
+	KPFA_CHECK(gvCtgItem->pList != NULL, KPFA_ERROR_MEMORY_ALLOC);
 
 	uint32_t k = 0;
 #endif
 
+	// Search the collapse point on the transfer of the outages, so that it can be
+	// bisected or resumed
+	if(m_pCtrlDataMgmt->m_bSearchGv == TRUE || m_pCtrlDataMgmt->m_bIncrementalGv == TRUE) {
+
+		delete [] prevVmList;
+
+		return ExecuteSearch(pRawDataMgmt, pCtgData, hvdcid, hvdcP, hvdcQ,
+							 ratioPQ, gstep, totalPg0);
+	}
+
+	// Sweep the outages on several threads
+	if(m_pCtrlDataMgmt->m_bParallelGv == TRUE) {
+
+		uint32_t nsweep = 0;
+
+		for(otgIter = otgList.begin(); otgIter != otgList.end(); otgIter++) {
+
+			KpfaOutageData *otg = (KpfaOutageData *)*otgIter;
+
+			if(otg->GetDataType() == KPFA_OUTAGE_GEN || otg->GetDataType() == KPFA_OUTAGE_HVDC) {
+				nsweep++;
+			}
+		}
+
+		if(nsweep > 1) {
+
+			delete [] prevVmList;
+
+			return ExecuteParallel(pRawDataMgmt, pCtgData, hvdcid, hvdcP, hvdcQ,
+								   ratioPQ, gstep, totalPg0);
+		}
+	}
+
 	KpfaPowerflow pfa(m_pCtrlDataMgmt);
 
 	// HVDC load
@@ -239,6 +279,8 @@ KpfaGvModule::Execute(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtgData *pCtgData) {
 			hvdcBus->m_nPl = -hvdcP;
 			hvdcBus->m_nQl =  hvdcQ;
 
+			pRawDataMgmt->SetModified();
+
 			error = pfa.DoAnalysis(pRawDataMgmt);
 
 			if(error == KPFA_ERROR_NOT_CONVERGED) {
@@ -250,17 +292,7 @@ KpfaGvModule::Execute(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtgData *pCtgData) {
 				m_nSysReqQ = (1.0 - m_nMaxMargin) * totalPg0 * ratioPQ;
 
 				// calculate the required Q for each FACTS using the sensitivity
-				double totalSensitivity = 0;
-
-				for(fiter = factsList.begin(); fiter != factsList.end(); fiter++) {
-					KpfaFactsData *factsData = (KpfaFactsData *)*fiter;
-					totalSensitivity += factsData->m_nSensitivity;
-				}
-
-				for(fiter = factsList.begin(); fiter != factsList.end(); fiter++) {
-					KpfaFactsData *factsData = (KpfaFactsData *)*fiter;
-					factsData->m_nRequiredQ = (factsData->m_nSensitivity / totalSensitivity);
-				}
+				UpdateFactsRequiredQ(pRawDataMgmt);
 
 				return error;
 			}
@@ -315,12 +347,914 @@ KpfaGvModule::Execute(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtgData *pCtgData) {
 			hvdcBus->m_nPl = phvdc0;
 			hvdcBus->m_nQl = qhvdc0;
 		}
+
+		pRawDataMgmt->SetModified();
 		///////////////////////////////////////////////////////////
 	}
 
 	return KPFA_SUCCESS;
 }
 
+/**
+ * This function will sweep the outages of the given contingency on several
+ * threads, each on its own copy of the raw data. The values at the start of
+ * each sweep (HVDC P, Q, total Pg and G-step) are planned in the order of the
+ * outages as the sequential sweeps leave them, and the steps are combined in
+ * the same order, so that the results do not depend on the thread scheduling.
+ * The sweeps after the first failed one are not combined, and the raw data is
+ * left as the last combined sweep left its copy. Since each sweep starts from
+ * the given raw data instead of the last solution of the sweep before it, the
+ * solutions can differ from the sequential ones within the tolerance. The
+ * sensitivities of the FACTS are calculated on the combined steps, starting
+ * from the voltages of the given raw data.
+ *
+ * @param pRawDataMgmt raw data management
+ * @param pCtgData contingency data
+ * @param nHvdcId bus ID of the HVDC load taking up the outages
+ * @param nHvdcP initial HVDC P
+ * @param nHvdcQ initial HVDC Q
+ * @param nRatioPQ PQ ratio of the HVDC
+ * @param nGstep initial G-step
+ * @param nTotalPg0 total Pg of the outages
+ * @return error information
+ */
+KpfaError_t
+KpfaGvModule::ExecuteParallel(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtgData *pCtgData,
+							  uint32_t nHvdcId, double nHvdcP, double nHvdcQ,
+							  double nRatioPQ, double nGstep, double nTotalPg0) {
+
+	KpfaError_t error = KPFA_SUCCESS;
+
+	uint32_t i, j;
+
+	KpfaBusData *hvdcBus = pRawDataMgmt->GetBusData(nHvdcId);
+	KPFA_CHECK(hvdcBus != NULL, KPFA_ERROR_INVALID_HVDC_ID);
+
+	// 1. plan the sweeps in the order of the outages
+	KpfaGvSweepList_t sweepList;
+
+	double gstep = nGstep;
+	double totalPg = nTotalPg0;
+	double hvdcP = nHvdcP;
+	double hvdcQ = nHvdcQ;
+	double hvdcPl = hvdcBus->m_nPl;
+	double hvdcQl = hvdcBus->m_nQl;
+
+	KpfaOutageDataList_t::iterator otgIter;
+	KpfaOutageDataList_t &otgList = pCtgData->GetOutageDataList();
+
+	for(otgIter = otgList.begin(); otgIter != otgList.end(); otgIter++) {
+
+		KpfaOutageData *otg = (KpfaOutageData *)*otgIter;
+
+		if(otg->GetDataType() != KPFA_OUTAGE_GEN && otg->GetDataType() != KPFA_OUTAGE_HVDC) {
+			continue;
+		}
+
+		KpfaBusData *bus = pRawDataMgmt->GetBusData(otg->m_nI);
+		KPFA_CHECK(bus != NULL, KPFA_ERROR_INVALID_BUS_ID);
+
+		KpfaGvSweep_t sweep;
+
+		sweep.pOutage = otg;
+		sweep.nHvdcP = hvdcP;
+		sweep.nHvdcQ = hvdcQ;
+		sweep.nHvdcPl = hvdcPl;
+		sweep.nHvdcQl = hvdcQl;
+		sweep.nTotalPg = totalPg;
+		sweep.nGstep = gstep;
+		sweep.nError = KPFA_SUCCESS;
+		sweep.pDataPool = NULL;
+		sweep.pDataMgmt = NULL;
+
+		sweepList.push_back(sweep);
+
+		// steps of the sweep
+		double pvalue = (otg->GetDataType() == KPFA_OUTAGE_GEN) ? bus->m_nPg : -bus->m_nPl;
+
+		while(pvalue != 0) {
+
+			if(pvalue < gstep) {
+				gstep = pvalue;
+			}
+
+			pvalue -= gstep;
+			totalPg -= gstep;
+
+			hvdcP += gstep;
+			hvdcQ += gstep * nRatioPQ;
+
+			// the HVDC load is restored only after an HVDC outage
+			if(otg->GetDataType() == KPFA_OUTAGE_GEN) {
+				hvdcPl = -hvdcP;
+				hvdcQl =  hvdcQ;
+			}
+		}
+	}
+
+	// Voltages of the FACTS buses before the sweeps
+	std::vector<double> prevVmList;
+
+	error = GetFactsVmList(pRawDataMgmt, prevVmList);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	// 2. sweep the outages on the threads
+	uint32_t nsweep = sweepList.size();
+	uint32_t threadCount = std::thread::hardware_concurrency();
+
+	if(threadCount == 0) {
+		threadCount = 1;
+	}
+
+	if(threadCount > nsweep) {
+		threadCount = nsweep;
+	}
+
+	std::atomic<uint32_t> next(0);
+	std::atomic<uint32_t> stop(nsweep);
+	std::vector<std::thread> threadList;
+
+	for(i = 1; i < threadCount; i++) {
+		threadList.push_back(std::thread(&KpfaGvModule::SweepWorker, this, pRawDataMgmt,
+										 &sweepList, &next, &stop, nHvdcId, nRatioPQ));
+	}
+
+	// The calling thread also sweeps the outages
+	SweepWorker(pRawDataMgmt, &sweepList, &next, &stop, nHvdcId, nRatioPQ);
+
+	for(i = 0; i < threadList.size(); i++) {
+		threadList[i].join();
+	}
+
+	// 3. combine the steps in the order of the outages
+#ifdef KPFA_RESULT_SUPPORT
+	KpfaGvCtg_t *gvCtgItem = &g_pResultData->hGvList.pList[KpfaGetResultSlot(pCtgData->GetIndex())];
+	uint32_t k = 0;
+#endif
+
+	double prevPg = nTotalPg0;
+
+	KpfaGvSweep_t *last = NULL;
+
+	for(i = 0; i < nsweep && error == KPFA_SUCCESS; i++) {
+
+		KpfaGvSweep_t *sweep = &sweepList[i];
+
+		last = sweep;
+		error = sweep->nError;
+
+		for(j = 0; j < sweep->rStepList.size() && error == KPFA_SUCCESS; j++) {
+
+			KpfaGvStep_t &step = sweep->rStepList[j];
+
+			error = step.nError;
+
+			if(error == KPFA_ERROR_NOT_CONVERGED) {
+
+				// maximum margin
+				m_nMaxMargin = (nTotalPg0 - step.nTotalPg) / nTotalPg0;
+
+				// system required Q
+				m_nSysReqQ = (1.0 - m_nMaxMargin) * nTotalPg0 * nRatioPQ;
+
+				// required Q for each FACTS using the sensitivity
+				UpdateFactsRequiredQ(pRawDataMgmt);
+			}
+			else if(error == KPFA_SUCCESS) {
+
+				// sensitivity of each FACTS on the step, as the sequential sweeps chain it
+				UpdateFactsSensitivity(pRawDataMgmt, prevVmList, step.rFactsVmList,
+									   prevPg - step.nTotalPg);
+
+				prevPg = step.nTotalPg;
+
+#ifdef KPFA_RESULT_SUPPORT
+				// G margin
+				gvCtgItem->pList[k].nGenParam = (float)((nTotalPg0 - step.nTotalPg) / nTotalPg0);
+
+				// Voltage
+				gvCtgItem->pList[k].nVoltage = step.nVoltage;
+
+				k++;
+#endif
+			}
+		}
+	}
+
+	// 4. leave the raw data as the last combined sweep
+	if(last != NULL && last->nError == KPFA_SUCCESS) {
+
+		KpfaRawDataList_t &busList = pRawDataMgmt->GetBusDataList();
+		KpfaRawDataList_t &copyList = last->pDataMgmt->GetBusDataList();
+
+		for(j = 0; j < busList.size(); j++) {
+			*(KpfaBusData *)busList[j] = *(KpfaBusData *)copyList[j];
+		}
+
+		pRawDataMgmt->SetModified();
+	}
+
+	for(i = 0; i < nsweep; i++) {
+
+		if(sweepList[i].pDataMgmt != NULL) {
+			delete sweepList[i].pDataMgmt;
+		}
+
+		if(sweepList[i].pDataPool != NULL) {
+			delete sweepList[i].pDataPool;
+		}
+	}
+
+	return error;
+}
+
+/**
+ * This function will take the sweeps from the shared counter and run them until
+ * all the sweeps are taken. The sweeps after a failed one are skipped since they
+ * are not combined.
+ *
+ * @param pRawDataMgmt raw data management to be copied
+ * @param pSweepList planned sweeps
+ * @param pNext index of the next sweep to be taken
+ * @param pStop index of the first failed sweep
+ * @param nHvdcId bus ID of the HVDC load
+ * @param nRatioPQ PQ ratio of the HVDC
+ */
+void
+KpfaGvModule::SweepWorker(KpfaRawDataMgmt *pRawDataMgmt, KpfaGvSweepList_t *pSweepList,
+						  std::atomic<uint32_t> *pNext, std::atomic<uint32_t> *pStop,
+						  uint32_t nHvdcId, double nRatioPQ) {
+
+	uint32_t nsweep = pSweepList->size();
+
+	for(uint32_t i = (*pNext)++; i < nsweep && i <= *pStop; i = (*pNext)++) {
+
+		KpfaGvSweep_t *sweep = &(*pSweepList)[i];
+
+		sweep->nError = SweepOutage(pRawDataMgmt, sweep, nHvdcId, nRatioPQ);
+
+		if(sweep->nError == KPFA_SUCCESS &&
+		   (sweep->rStepList.empty() || sweep->rStepList.back().nError == KPFA_SUCCESS)) {
+			continue;
+		}
+
+		// lower the index of the first failed sweep
+		uint32_t stop = *pStop;
+
+		while(i < stop && pStop->compare_exchange_weak(stop, i) == false);
+	}
+}
+
+/**
+ * This function will sweep an outage on a copy of the raw data. The P of the
+ * outage is moved to the HVDC load step by step with the powerflow analysis
+ * until the analysis fails.
+ *
+ * @param pRawDataMgmt raw data management to be copied
+ * @param pSweep planned sweep to be run
+ * @param nHvdcId bus ID of the HVDC load
+ * @param nRatioPQ PQ ratio of the HVDC
+ * @return error information
+ */
+KpfaError_t
+KpfaGvModule::SweepOutage(KpfaRawDataMgmt *pRawDataMgmt, KpfaGvSweep_t *pSweep,
+						  uint32_t nHvdcId, double nRatioPQ) {
+
+	KpfaError_t error;
+
+	// Copy of the raw data for this sweep
+	pSweep->pDataPool = new KpfaRawDataPool();
+	pSweep->pDataMgmt = new KpfaRawDataMgmt();
+
+	error = pRawDataMgmt->CopyTo(pSweep->pDataMgmt, pSweep->pDataPool);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	KpfaRawDataMgmt *dataMgmt = pSweep->pDataMgmt;
+	KpfaOutageData *otg = pSweep->pOutage;
+
+	// HVDC load as left by the sweeps before
+	KpfaBusData *hvdcBus = dataMgmt->GetBusData(nHvdcId);
+	KPFA_CHECK(hvdcBus != NULL, KPFA_ERROR_INVALID_HVDC_ID);
+
+	hvdcBus->m_nPl = pSweep->nHvdcPl;
+	hvdcBus->m_nQl = pSweep->nHvdcQl;
+
+	KpfaBusData *genBus = NULL;
+	KpfaBusData *loadBus = NULL;
+
+	double pvalue = 0;
+
+	if(otg->GetDataType() == KPFA_OUTAGE_GEN) {
+		genBus = dataMgmt->GetBusData(otg->m_nI);
+		KPFA_CHECK(genBus != NULL, KPFA_ERROR_INVALID_BUS_ID);
+		pvalue = genBus->m_nPg;
+	}
+	else {
+		loadBus = dataMgmt->GetBusData(otg->m_nI);
+		KPFA_CHECK(loadBus != NULL, KPFA_ERROR_INVALID_BUS_ID);
+		pvalue = -loadBus->m_nPl;
+	}
+
+	// Keep P, Q values
+	///////////////////////////////////////////////////////////
+	double pgen0 = (genBus != NULL) ? genBus->m_nPg : 0;
+	double qmin0 = (genBus != NULL) ? genBus->m_nQb : 0;
+	double qmax0 = (genBus != NULL) ? genBus->m_nQt : 0;
+
+	double pload0 = (loadBus != NULL) ? loadBus->m_nPl : 0;
+	double phvdc0 = hvdcBus->m_nPl;
+	double qhvdc0 = hvdcBus->m_nQl;
+	///////////////////////////////////////////////////////////
+
+	double gstep = pSweep->nGstep;
+	double totalPg = pSweep->nTotalPg;
+	double hvdcP = pSweep->nHvdcP;
+	double hvdcQ = pSweep->nHvdcQ;
+
+	// Sparse LU of this thread, so that the sweeps do not wait for the lock of
+	// the MA28 library; its column order is kept over the steps
+	KpfaSparseLU lu;
+
+	KpfaPowerflow pfa(m_pCtrlDataMgmt);
+	pfa.SetSparseLU(&lu);
+
+	while(pvalue != 0) {
+
+		//Modify the information of the generator
+		if(pvalue < gstep) {
+			gstep = pvalue;
+		}
+
+		pvalue -= gstep;
+
+		// Decrement the value of the total Pg
+		totalPg -= gstep;
+
+		if(genBus != NULL) {
+
+			genBus->m_nPg -= gstep;
+
+			// Qmax, Qmin
+			genBus->m_nQb = qmin0 * (pvalue / pgen0);
+			genBus->m_nQt = qmax0 * (pvalue / pgen0);
+		}
+		else {
+			// HVDC P&Q
+			loadBus->m_nPl += gstep;
+			loadBus->m_nQl -= gstep * nRatioPQ;
+		}
+
+		// HVDC P, Q
+		hvdcP += gstep;
+		hvdcQ += gstep * nRatioPQ;
+
+		hvdcBus->m_nPl = -hvdcP;
+		hvdcBus->m_nQl =  hvdcQ;
+
+		dataMgmt->SetModified();
+
+		KpfaGvStep_t step;
+
+		step.nTotalPg = totalPg;
+		step.nVoltage = 0;
+		step.nError = pfa.DoAnalysis(dataMgmt);
+
+		if(step.nError == KPFA_SUCCESS) {
+
+			// voltages of the FACTS buses for their sensitivities
+			error = GetFactsVmList(dataMgmt, step.rFactsVmList);
+			KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+#ifdef KPFA_RESULT_SUPPORT
+			// monitor bus ID
+			uint32_t mid = m_pCtrlDataMgmt->m_nHvdcFreqControl;
+
+			KpfaComplexVector_t &vmat = pfa.GetVMatrix();
+			step.nVoltage = vmat(dataMgmt->GetBusIndex(mid)).real();
+#endif
+		}
+
+		pSweep->rStepList.push_back(step);
+
+		// The raw data is left as it failed
+		if(step.nError != KPFA_SUCCESS) {
+			return KPFA_SUCCESS;
+		}
+	}
+
+	// Restore P, Q
+	///////////////////////////////////////////////////////////
+	if(genBus != NULL) {
+		genBus->m_nPg = pgen0;
+		genBus->m_nQb = qmin0;
+		genBus->m_nQt = qmax0;
+	}
+	else {
+		loadBus->m_nPl = pload0;
+		hvdcBus->m_nPl = phvdc0;
+		hvdcBus->m_nQl = qhvdc0;
+	}
+	///////////////////////////////////////////////////////////
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will search the collapse point of GV on the transfer of the
+ * outages to the HVDC load, instead of moving the outages by the G-steps in
+ * place. The outages are planned and the search is started from the given raw
+ * data, and the state of the search is kept so that it can be resumed.
+ *
+ * @param pRawDataMgmt raw data management
+ * @param pCtgData contingency data
+ * @param nHvdcId bus ID of the HVDC load taking up the outages
+ * @param nHvdcP initial HVDC P
+ * @param nHvdcQ initial HVDC Q
+ * @param nRatioPQ PQ ratio of the HVDC
+ * @param nGstep G-step
+ * @param nTotalPg0 total Pg of the outages
+ * @return error information
+ */
+KpfaError_t
+KpfaGvModule::ExecuteSearch(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtgData *pCtgData,
+							uint32_t nHvdcId, double nHvdcP, double nHvdcQ,
+							double nRatioPQ, double nGstep, double nTotalPg0) {
+
+	uint32_t i;
+
+	KpfaGvResume_t &resume = m_rResume;
+
+	resume.pCtgData = NULL;
+
+	KpfaBusData *hvdcBus = pRawDataMgmt->GetBusData(nHvdcId);
+	KPFA_CHECK(hvdcBus != NULL, KPFA_ERROR_INVALID_HVDC_ID);
+
+	resume.pHvdcBus = hvdcBus;
+	resume.nHvdcP = nHvdcP;
+	resume.nHvdcQ = nHvdcQ;
+	resume.nRatioPQ = nRatioPQ;
+	resume.nGstep = nGstep;
+	resume.nTotalPg0 = nTotalPg0;
+
+	// 1. outages in the order of the transfer
+	KpfaGvTransferList_t &transferList = resume.rTransferList;
+
+	double total = 0;
+	double hvdcPl = hvdcBus->m_nPl;
+	double hvdcQl = hvdcBus->m_nQl;
+
+	transferList.clear();
+
+	KpfaOutageDataList_t::iterator otgIter;
+	KpfaOutageDataList_t &otgList = pCtgData->GetOutageDataList();
+
+	for(otgIter = otgList.begin(); otgIter != otgList.end(); otgIter++) {
+
+		KpfaOutageData *otg = (KpfaOutageData *)*otgIter;
+
+		if(otg->GetDataType() != KPFA_OUTAGE_GEN && otg->GetDataType() != KPFA_OUTAGE_HVDC) {
+			continue;
+		}
+
+		KpfaBusData *bus = pRawDataMgmt->GetBusData(otg->m_nI);
+		KPFA_CHECK(bus != NULL, KPFA_ERROR_INVALID_BUS_ID);
+
+		KpfaGvTransfer_t transfer;
+
+		transfer.pBus = bus;
+		transfer.bGen = (otg->GetDataType() == KPFA_OUTAGE_GEN) ? TRUE : FALSE;
+		transfer.nStart = total;
+		transfer.nCapacity = (transfer.bGen == TRUE) ? bus->m_nPg : -bus->m_nPl;
+		transfer.nPg0 = bus->m_nPg;
+		transfer.nQb0 = bus->m_nQb;
+		transfer.nQt0 = bus->m_nQt;
+		transfer.nPl0 = bus->m_nPl;
+		transfer.nQl0 = bus->m_nQl;
+		transfer.nHvdcPl0 = hvdcPl;
+		transfer.nHvdcQl0 = hvdcQl;
+
+		transferList.push_back(transfer);
+
+		total += transfer.nCapacity;
+
+		// the HVDC load is restored only after an HVDC outage
+		if(transfer.bGen == TRUE && transfer.nCapacity > 0) {
+			hvdcPl = -(nHvdcP + total);
+			hvdcQl =  nHvdcQ + total * nRatioPQ;
+		}
+	}
+
+	resume.nTotal = total;
+
+	// 2. start from the given raw data
+	KpfaRawDataList_t &busList = pRawDataMgmt->GetBusDataList();
+	KpfaRawDataList_t &genList = pRawDataMgmt->GetGenDataList();
+
+	resume.nConverged = 0;
+	resume.rBusList.clear();
+	resume.rVsList.clear();
+	resume.rPointList.clear();
+
+	for(i = 0; i < busList.size(); i++) {
+		resume.rBusList.push_back(*(KpfaBusData *)busList[i]);
+	}
+
+	for(i = 0; i < genList.size(); i++) {
+		resume.rVsList.push_back(((KpfaGenData *)genList[i])->m_nVs);
+	}
+
+#ifdef KPFA_RESULT_SUPPORT
+	resume.nPointCapacity = g_pResultData->hGvList.pList[KpfaGetResultSlot(pCtgData->GetIndex())].nSize;
+#endif
+
+	resume.pCtgData = pCtgData;
+
+	return SearchTransfer(pRawDataMgmt);
+}
+
+/**
+ * This function will resume the GV of the given contingency from the last
+ * converged transfer of the previous search, after the FACTS voltages are
+ * updated. The analysis starts from the bus data of the converged transfer
+ * with the updated voltages, so that only the transfers beyond it are
+ * analyzed again. The sensitivities of the FACTS on the next move are taken
+ * from the updated voltages too, so that they do not count the setpoint
+ * change. The GV is executed from the start if it cannot be resumed.
+ *
+ * @param pRawDataMgmt raw data management
+ * @param pCtgData contingency data
+ * @return error information
+ */
+KpfaError_t
+KpfaGvModule::Resume(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtgData *pCtgData) {
+
+	KpfaGvResume_t &resume = m_rResume;
+
+	if(m_pCtrlDataMgmt->m_bIncrementalGv == FALSE || resume.pCtgData != pCtgData) {
+		return Execute(pRawDataMgmt, pCtgData);
+	}
+
+	KpfaRawDataList_t &busList = pRawDataMgmt->GetBusDataList();
+	KpfaRawDataList_t &genList = pRawDataMgmt->GetGenDataList();
+
+	KPFA_CHECK(busList.size() == resume.rBusList.size(), KPFA_ERROR_INVALID_ARGUMENT);
+	KPFA_CHECK(genList.size() == resume.rVsList.size(), KPFA_ERROR_INVALID_ARGUMENT);
+
+	// Move the voltages of the converged transfer by the updated Vs
+	for(uint32_t g = 0; g < genList.size(); g++) {
+
+		KpfaGenData *gen = (KpfaGenData *)genList[g];
+
+		double dvs = gen->m_nVs - resume.rVsList[g];
+
+		if(dvs == 0) continue;
+
+		KPFA_CHECK(pRawDataMgmt->GetBusData(gen->m_nI) != NULL, KPFA_ERROR_INVALID_BUS_ID);
+
+		resume.rBusList[pRawDataMgmt->GetBusIndex(gen->m_nI)].m_nVm += dvs;
+
+		resume.rVsList[g] = gen->m_nVs;
+	}
+
+	return SearchTransfer(pRawDataMgmt);
+}
+
+/**
+ * This function will search the collapse point from the last converged
+ * transfer. The transfer is moved by the G-step until the powerflow analysis
+ * fails. In the search mode, the move is doubled after each converged transfer,
+ * and the bracket of the last converged and the failed transfers is bisected
+ * down to the margin resolution. Each analysis starts from the bus data of the
+ * last converged transfer. The converged transfers are reported as the GV
+ * points, and the sensitivities of the FACTS are updated on each move from the
+ * last converged transfer. The raw data is left as the analysis of the failed
+ * transfer left it, or as the G-steps leave it if all the outages are moved.
+ *
+ * @param pRawDataMgmt raw data management
+ * @return error information
+ */
+KpfaError_t
+KpfaGvModule::SearchTransfer(KpfaRawDataMgmt *pRawDataMgmt) {
+
+	KpfaError_t error;
+
+	uint32_t i;
+
+	KpfaGvResume_t &resume = m_rResume;
+
+	bool_t bisect = m_pCtrlDataMgmt->m_bSearchGv;
+
+	double resolution = m_pCtrlDataMgmt->m_nGvResolution * resume.nTotalPg0;
+
+	if(bisect == FALSE || resolution <= 0) {
+		resolution = resume.nGstep;
+	}
+
+	KpfaRawDataList_t &busList = pRawDataMgmt->GetBusDataList();
+
+	// Bus data of the failed transfer
+	std::vector<KpfaBusData> failedList;
+
+	// Voltages of the FACTS buses of the last converged and the current transfers
+	std::vector<double> prevVmList;
+	std::vector<double> vmList;
+
+	double lo = resume.nConverged;
+	double hi = -1;
+	double move = resume.nGstep;
+	double transfer = std::min(lo + move, resume.nTotal);
+
+	KpfaPowerflow pfa(m_pCtrlDataMgmt);
+
+	while(transfer > lo) {
+
+		// start from the last converged transfer
+		for(i = 0; i < busList.size(); i++) {
+			*(KpfaBusData *)busList[i] = resume.rBusList[i];
+		}
+
+		ApplyTransfer(resume.pHvdcBus, resume.rTransferList, transfer,
+					  resume.nHvdcP, resume.nHvdcQ, resume.nRatioPQ, FALSE);
+
+		pRawDataMgmt->SetModified();
+
+		error = pfa.DoAnalysis(pRawDataMgmt);
+
+		if(error == KPFA_SUCCESS) {
+
+			// sensitivity of each FACTS on the move from the last converged transfer
+			error = GetFactsVmList(pRawDataMgmt, prevVmList, &resume.rBusList);
+			KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+			error = GetFactsVmList(pRawDataMgmt, vmList);
+			KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+			UpdateFactsSensitivity(pRawDataMgmt, prevVmList, vmList, transfer - lo);
+
+			lo = transfer;
+
+			for(i = 0; i < busList.size(); i++) {
+				resume.rBusList[i] = *(KpfaBusData *)busList[i];
+			}
+
+#ifdef KPFA_RESULT_SUPPORT
+			// monitor bus ID
+			uint32_t mid = m_pCtrlDataMgmt->m_nHvdcFreqControl;
+
+			KpfaComplexVector_t &vmat = pfa.GetVMatrix();
+			resume.rPointList.push_back(std::make_pair(lo, vmat(pRawDataMgmt->GetBusIndex(mid)).real()));
+#endif
+		}
+		else if(error == KPFA_ERROR_NOT_CONVERGED) {
+
+			hi = transfer;
+
+			failedList.clear();
+
+			for(i = 0; i < busList.size(); i++) {
+				failedList.push_back(*(KpfaBusData *)busList[i]);
+			}
+		}
+		else KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+		// next transfer
+		if(hi < 0) {
+
+			if(bisect == TRUE) {
+				move *= 2;
+			}
+
+			transfer = std::min(lo + move, resume.nTotal);
+		}
+		else if(bisect == TRUE && hi - lo > resolution) {
+			transfer = 0.5 * (lo + hi);
+		}
+		else break;
+	}
+
+	resume.nConverged = lo;
+
+#ifdef KPFA_RESULT_SUPPORT
+	KpfaGvCtg_t *gvCtgItem = &g_pResultData->hGvList.pList[KpfaGetResultSlot(resume.pCtgData->GetIndex())];
+
+	std::vector<std::pair<double, double> > &pointList = resume.rPointList;
+
+	std::sort(pointList.begin(), pointList.end());
+
+	uint32_t npoint = std::min<uint32_t>(pointList.size(), resume.nPointCapacity);
+
+	for(i = 0; i < npoint; i++) {
+
+		// G margin
+		gvCtgItem->pList[i].nGenParam = (float)(pointList[i].first / resume.nTotalPg0);
+
+		// Voltage
+		gvCtgItem->pList[i].nVoltage = pointList[i].second;
+	}
+
+	gvCtgItem->nSize = npoint;
+#endif
+
+	// leave the raw data as the G-steps leave it
+	if(hi < 0) {
+
+		ApplyTransfer(resume.pHvdcBus, resume.rTransferList, resume.nTotal,
+					  resume.nHvdcP, resume.nHvdcQ, resume.nRatioPQ, TRUE);
+
+		pRawDataMgmt->SetModified();
+
+		// nothing to be resumed
+		resume.pCtgData = NULL;
+
+		return KPFA_SUCCESS;
+	}
+
+	for(i = 0; i < busList.size(); i++) {
+		*(KpfaBusData *)busList[i] = failedList[i];
+	}
+
+	pRawDataMgmt->SetModified();
+
+	// maximum margin
+	m_nMaxMargin = hi / resume.nTotalPg0;
+
+	// system required Q
+	m_nSysReqQ = (1.0 - m_nMaxMargin) * resume.nTotalPg0 * resume.nRatioPQ;
+
+	// required Q for each FACTS using the sensitivity
+	UpdateFactsRequiredQ(pRawDataMgmt);
+
+	return KPFA_ERROR_NOT_CONVERGED;
+}
+
+/**
+ * This function will set the raw data to the given transfer of the outages to
+ * the HVDC load, as the G-steps set it when they reach the transfer. The
+ * outages before the one being moved are restored, and the ones after it are
+ * not moved yet.
+ *
+ * @param pHvdcBus bus of the HVDC load
+ * @param rTransferList outages in the order of the transfer
+ * @param nTransfer total P moved to the HVDC load
+ * @param nHvdcP initial HVDC P
+ * @param nHvdcQ initial HVDC Q
+ * @param nRatioPQ PQ ratio of the HVDC
+ * @param bEnd whether the outage ending at the transfer is restored too
+ */
+void
+KpfaGvModule::ApplyTransfer(KpfaBusData *pHvdcBus, KpfaGvTransferList_t &rTransferList,
+							double nTransfer, double nHvdcP, double nHvdcQ,
+							double nRatioPQ, bool_t bEnd) {
+
+	KpfaGvTransfer_t *last = NULL;
+
+	for(uint32_t i = 0; i < rTransferList.size(); i++) {
+
+		KpfaGvTransfer_t &transfer = rTransferList[i];
+		KpfaBusData *bus = transfer.pBus;
+
+		double moved = std::max(0.0, std::min(nTransfer - transfer.nStart, transfer.nCapacity));
+
+		bool_t restored = (nTransfer > transfer.nStart + transfer.nCapacity ||
+						   (bEnd == TRUE && moved == transfer.nCapacity)) ? TRUE : FALSE;
+
+		if(transfer.bGen == TRUE) {
+
+			bus->m_nPg = transfer.nPg0;
+			bus->m_nQb = transfer.nQb0;
+			bus->m_nQt = transfer.nQt0;
+
+			if(restored == FALSE && moved > 0) {
+
+				bus->m_nPg -= moved;
+
+				// Qmax, Qmin
+				bus->m_nQb = transfer.nQb0 * ((transfer.nCapacity - moved) / transfer.nPg0);
+				bus->m_nQt = transfer.nQt0 * ((transfer.nCapacity - moved) / transfer.nPg0);
+			}
+		}
+		else {
+			// HVDC P&Q (Q is not restored)
+			bus->m_nPl = (restored == FALSE) ? transfer.nPl0 + moved : transfer.nPl0;
+			bus->m_nQl = transfer.nQl0 - moved * nRatioPQ;
+		}
+
+		if(transfer.nCapacity > 0 && moved > 0) {
+			last = &transfer;
+		}
+	}
+
+	// HVDC P, Q
+	pHvdcBus->m_nPl = -(nHvdcP + nTransfer);
+	pHvdcBus->m_nQl =  nHvdcQ + nTransfer * nRatioPQ;
+
+	// the HVDC load is restored after an HVDC outage
+	if(bEnd == TRUE && last != NULL && last->bGen == FALSE) {
+		pHvdcBus->m_nPl = last->nHvdcPl0;
+		pHvdcBus->m_nQl = last->nHvdcQl0;
+	}
+}
+
+/**
+ * This function will return the voltages of the FACTS buses in the order of
+ * the FACTS data, from the given bus data (in the order of the buses) or from
+ * the raw data.
+ *
+ * @param pRawDataMgmt raw data management
+ * @param rVmList voltages of the FACTS buses
+ * @param pBusList bus data to take the voltages from (NULL for the raw data)
+ * @return error information
+ */
+KpfaError_t
+KpfaGvModule::GetFactsVmList(KpfaRawDataMgmt *pRawDataMgmt, std::vector<double> &rVmList,
+							 std::vector<KpfaBusData> *pBusList) {
+
+	KpfaRawDataList_t &factsList = pRawDataMgmt->GetFactsDataList();
+
+	KPFA_CHECK(pBusList == NULL || pBusList->size() == pRawDataMgmt->GetBusCount(),
+			   KPFA_ERROR_INVALID_ARGUMENT);
+
+	rVmList.clear();
+
+	for(uint32_t i = 0; i < factsList.size(); i++) {
+
+		KpfaFactsData *factsData = (KpfaFactsData *)factsList[i];
+
+		// get facts bus
+		KpfaBusData *factsBusData = pRawDataMgmt->GetBusData(factsData->m_nI);
+		KPFA_CHECK(factsBusData != NULL, KPFA_ERROR_INVALID_FACTS_DATA);
+
+		if(pBusList != NULL) {
+			factsBusData = &(*pBusList)[pRawDataMgmt->GetBusIndex(factsData->m_nI)];
+		}
+
+		rVmList.push_back(factsBusData->m_nVm);
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will update the sensitivity of each FACTS with the change of
+ * its bus voltage on a step of the transfer, and keep the voltages for the
+ * next step.
+ *
+ * @param pRawDataMgmt raw data management
+ * @param rPrevVmList voltages of the FACTS buses before the step
+ * @param rVmList voltages of the FACTS buses after the step
+ * @param nStep P moved by the step
+ */
+void
+KpfaGvModule::UpdateFactsSensitivity(KpfaRawDataMgmt *pRawDataMgmt, std::vector<double> &rPrevVmList,
+									 std::vector<double> &rVmList, double nStep) {
+
+	KpfaRawDataList_t &factsList = pRawDataMgmt->GetFactsDataList();
+
+	if(nStep <= 0 || rPrevVmList.size() != factsList.size() || rVmList.size() != factsList.size()) {
+		return;
+	}
+
+	for(uint32_t i = 0; i < factsList.size(); i++) {
+
+		KpfaFactsData *factsData = (KpfaFactsData *)factsList[i];
+
+		factsData->m_nSensitivity = (rVmList[i] - rPrevVmList[i]) / nStep;
+	}
+
+	rPrevVmList = rVmList;
+}
+
+/**
+ * This function will calculate the required Q for each FACTS using the
+ * sensitivity of the last converged step. The required Q is left as it is
+ * if none of the sensitivities is available.
+ *
+ * @param pRawDataMgmt raw data management
+ */
+void
+KpfaGvModule::UpdateFactsRequiredQ(KpfaRawDataMgmt *pRawDataMgmt) {
+
+	KpfaRawDataList_t::iterator fiter;
+	KpfaRawDataList_t &factsList = pRawDataMgmt->GetFactsDataList();
+
+	double totalSensitivity = 0;
+
+	for(fiter = factsList.begin(); fiter != factsList.end(); fiter++) {
+		KpfaFactsData *factsData = (KpfaFactsData *)*fiter;
+		totalSensitivity += factsData->m_nSensitivity;
+	}
+
+	// no FACTS voltage moved on the step (e.g. all of them at their setpoints)
+	if(totalSensitivity == 0) {
+		return;
+	}
+
+	for(fiter = factsList.begin(); fiter != factsList.end(); fiter++) {
+		KpfaFactsData *factsData = (KpfaFactsData *)*fiter;
+		factsData->m_nRequiredQ = (factsData->m_nSensitivity / totalSensitivity);
+	}
+}
+
 ///////////////////////////////////////////////////////////////////
 // Debugging Functions
 ///////////////////////////////////////////////////////////////////
@@ -8,6 +8,8 @@
 #ifndef _KPFA_GV_MODULE_H_
 #define _KPFA_GV_MODULE_H_
 
+#include <atomic>
+
 #include "KpfaDebug.h"
 #include "KpfaConfig.h"
 #include "KpfaRawDataMgmt.h"
@@ -25,6 +27,98 @@ typedef struct {
 
 typedef std::vector<KpfaGvData_t *> KpfaGvDataList_t;
 
+/**
+ * GV point of a step of an outage sweep
+ */
+typedef struct {
+	// total Pg after the step
+	double nTotalPg;
+	// voltage of the monitored bus
+	double nVoltage;
+	// error of the powerflow analysis of the step
+	KpfaError_t nError;
+	// voltages of the FACTS buses after the step
+	std::vector<double> rFactsVmList;
+} KpfaGvStep_t;
+
+/**
+ * GV sweep of an outage run on a copy of the raw data. The values at the start
+ * are the ones left by the sweeps of the outages before it.
+ */
+typedef struct {
+	// outage to be swept
+	KpfaOutageData *pOutage;
+	// HVDC P, Q and the HVDC load at the start
+	double nHvdcP;
+	double nHvdcQ;
+	double nHvdcPl;
+	double nHvdcQl;
+	// total Pg and G-step at the start
+	double nTotalPg;
+	double nGstep;
+	// steps up to the first failed one
+	std::vector<KpfaGvStep_t> rStepList;
+	// error of the sweep itself
+	KpfaError_t nError;
+	// copy of the raw data and the pool of its raw data
+	KpfaRawDataPool *pDataPool;
+	KpfaRawDataMgmt *pDataMgmt;
+} KpfaGvSweep_t;
+
+typedef std::vector<KpfaGvSweep_t> KpfaGvSweepList_t;
+
+/**
+ * Outage moved to the HVDC load by the GV search. The outages are moved one
+ * after another in the order of the contingency, as the G-steps move them.
+ */
+typedef struct {
+	// bus of the outage
+	KpfaBusData *pBus;
+	// generator (TRUE) or HVDC (FALSE) outage
+	bool_t bGen;
+	// transfer at the start of the outage and P of the outage
+	double nStart;
+	double nCapacity;
+	// values before the transfer
+	double nPg0;
+	double nQb0;
+	double nQt0;
+	double nPl0;
+	double nQl0;
+	// HVDC load at the start of the outage
+	double nHvdcPl0;
+	double nHvdcQl0;
+} KpfaGvTransfer_t;
+
+typedef std::vector<KpfaGvTransfer_t> KpfaGvTransferList_t;
+
+/**
+ * State of the GV search kept to resume it after the FACTS are updated
+ */
+typedef struct {
+	// contingency of the search (NULL if it cannot be resumed)
+	KpfaCtgData *pCtgData;
+	// bus of the HVDC load, its initial P, Q and PQ ratio
+	KpfaBusData *pHvdcBus;
+	double nHvdcP;
+	double nHvdcQ;
+	double nRatioPQ;
+	// G-step, total Pg of the outages and the total transfer
+	double nGstep;
+	double nTotalPg0;
+	double nTotal;
+	// outages in the order of the transfer
+	KpfaGvTransferList_t rTransferList;
+	// last converged transfer and its bus data
+	double nConverged;
+	std::vector<KpfaBusData> rBusList;
+	// Vs of the generators of the bus data
+	std::vector<double> rVsList;
+	// GV points (transfer, voltage of the monitored bus) and the size of the result
+	std::vector<std::pair<double, double> > rPointList;
+	uint32_t nPointCapacity;
+} KpfaGvResume_t;
+
 /**
  * The declaration of the class for GV algorithm module
  */
@@ -41,6 +135,9 @@ private:
 
 	KpfaCtrlDataMgmt *m_pCtrlDataMgmt;
 
+	// state of the last GV search
+	KpfaGvResume_t m_rResume;
+
 public:
 
 	KpfaGvModule(KpfaCtrlDataMgmt *pDataMgmt = NULL) {
@@ -57,6 +154,8 @@ public:
 		m_nMaxMargin = 1.0;
 
 		m_nSysReqQ = 0.0;
+
+		m_rResume.pCtgData = NULL;
 	}
 
 	virtual ~KpfaGvModule() {
@@ -89,8 +188,20 @@ public:
 		return m_nSysReqQ;
 	}
 
+	/**
+	 * This function will return the bus data of the last converged transfer of
+	 * the GV search, in the order of the buses.
+	 *
+	 * @return bus data (NULL if the GV cannot be resumed)
+	 */
+	inline std::vector<KpfaBusData> *GetConvergedBusList() {
+		return (m_rResume.pCtgData != NULL) ? &m_rResume.rBusList : NULL;
+	}
+
 	KpfaError_t Execute(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtgData *pCtgData);
 
+	KpfaError_t Resume(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtgData *pCtgData);
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Functions
 	///////////////////////////////////////////////////////////////////
@@ -98,6 +209,37 @@ public:
 	virtual void Write(ostream &rOut);
 
 	friend ostream &operator << (ostream &rOut, KpfaGvModule *pModule);
+
+private:
+
+	KpfaError_t ExecuteParallel(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtgData *pCtgData,
+								uint32_t nHvdcId, double nHvdcP, double nHvdcQ,
+								double nRatioPQ, double nGstep, double nTotalPg0);
+
+	void SweepWorker(KpfaRawDataMgmt *pRawDataMgmt, KpfaGvSweepList_t *pSweepList,
+					 std::atomic<uint32_t> *pNext, std::atomic<uint32_t> *pStop,
+					 uint32_t nHvdcId, double nRatioPQ);
+
+	KpfaError_t SweepOutage(KpfaRawDataMgmt *pRawDataMgmt, KpfaGvSweep_t *pSweep,
+							uint32_t nHvdcId, double nRatioPQ);
+
+	KpfaError_t ExecuteSearch(KpfaRawDataMgmt *pRawDataMgmt, KpfaCtgData *pCtgData,
+							  uint32_t nHvdcId, double nHvdcP, double nHvdcQ,
+							  double nRatioPQ, double nGstep, double nTotalPg0);
+
+	KpfaError_t SearchTransfer(KpfaRawDataMgmt *pRawDataMgmt);
+
+	void ApplyTransfer(KpfaBusData *pHvdcBus, KpfaGvTransferList_t &rTransferList,
+					   double nTransfer, double nHvdcP, double nHvdcQ,
+					   double nRatioPQ, bool_t bEnd);
+
+	KpfaError_t GetFactsVmList(KpfaRawDataMgmt *pRawDataMgmt, std::vector<double> &rVmList,
+							   std::vector<KpfaBusData> *pBusList = NULL);
+
+	void UpdateFactsSensitivity(KpfaRawDataMgmt *pRawDataMgmt, std::vector<double> &rPrevVmList,
+								std::vector<double> &rVmList, double nStep);
+
+	void UpdateFactsRequiredQ(KpfaRawDataMgmt *pRawDataMgmt);
 };
 
 #endif /* _KPFA_GV_MODULE_H_ */
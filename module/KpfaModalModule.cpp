@@ -0,0 +1,620 @@
+/*
+ * KpfaModalModule.cpp
+ */
+
+#include <algorithm>
+
+#include "KpfaModalModule.h"
+
+// A Ritz value is real if its imaginary part is not larger than this ratio of its real part
+#define KPFA_MODAL_REAL_TOLERANCE	1e-8
+
+// The Arnoldi method stops if the new vector is not larger than this ratio of its column
+#define KPFA_MODAL_BREAKDOWN		1e-12
+
+// Relative shift of a Ritz value to keep the inverse iteration away from a singular matrix
+#define KPFA_MODAL_EIGEN_PERTURB	1e-10
+
+/**
+ * Returns the address of the given row of a dense (row-major) matrix.
+ */
+static inline double *
+GetDenseRow(KpfaDenseMatrix_t &rMat, uint32_t nRow) {
+	return &rMat.data()[0] + (size_t)nRow * rMat.size2();
+}
+
+/**
+ * Returns the dot product of the given vectors.
+ */
+static inline double
+Dot(const double *pX, const double *pY, uint32_t nSize) {
+
+	double sum = 0;
+
+	for(uint32_t i = 0; i < nSize; i++) {
+		sum += pX[i] * pY[i];
+	}
+
+	return sum;
+}
+
+/**
+ * Orders the modes by the eigenvalues.
+ */
+static bool
+CompareMode(const KpfaModalMode_t &rLeft, const KpfaModalMode_t &rRight) {
+	return rLeft.nEigenvalue < rRight.nEigenvalue;
+}
+
+/**
+ * This function will calculate all the eigenvalues of the leading n x n block
+ * of the given upper Hessenberg matrix with the shifted QR algorithm (hqr of
+ * EISPACK). The block is copied and indexed from one as in the original.
+ *
+ * @param rHmat upper Hessenberg matrix
+ * @param nSize size of the block
+ * @param rWr output real parts of the eigenvalues
+ * @param rWi output imaginary parts of the eigenvalues
+ * @return error information
+ */
+static KpfaError_t
+HessenbergEigenvalues(KpfaDenseMatrix_t &rHmat, uint32_t nSize,
+					  std::vector<double> &rWr, std::vector<double> &rWi) {
+
+	int n = (int)nSize;
+	int nn, m, l, k, j, its, i, mmin;
+
+	double z = 0, y, x, w, v, u, t, s, r = 0, q = 0, p = 0, anorm = 0;
+
+	KpfaDenseMatrix_t a(n + 1, n + 1);
+
+	for(i = 1; i <= n; i++) {
+		for(j = 1; j <= n; j++) {
+			a(i, j) = (j >= i - 1) ? rHmat(i - 1, j - 1) : 0;
+		}
+	}
+
+	rWr.assign(n + 1, 0.0);
+	rWi.assign(n + 1, 0.0);
+
+	for(i = 1; i <= n; i++) {
+		for(j = std::max(i - 1, 1); j <= n; j++) {
+			anorm += fabs(a(i, j));
+		}
+	}
+
+	nn = n;
+	t = 0.0;
+
+	while(nn >= 1) {
+
+		its = 0;
+
+		do {
+			// find a small subdiagonal element
+			for(l = nn; l >= 2; l--) {
+				s = fabs(a(l - 1, l - 1)) + fabs(a(l, l));
+				if(s == 0.0) s = anorm;
+				if(fabs(a(l, l - 1)) + s == s) {
+					a(l, l - 1) = 0.0;
+					break;
+				}
+			}
+
+			x = a(nn, nn);
+
+			// one root found
+			if(l == nn) {
+				rWr[nn] = x + t;
+				rWi[nn--] = 0.0;
+			}
+			else {
+				y = a(nn - 1, nn - 1);
+				w = a(nn, nn - 1) * a(nn - 1, nn);
+
+				// two roots found
+				if(l == nn - 1) {
+					p = 0.5 * (y - x);
+					q = p * p + w;
+					z = sqrt(fabs(q));
+					x += t;
+
+					if(q >= 0.0) {
+						z = p + ((p >= 0) ? fabs(z) : -fabs(z));
+						rWr[nn - 1] = rWr[nn] = x + z;
+						if(z != 0) rWr[nn] = x - w / z;
+						rWi[nn - 1] = rWi[nn] = 0.0;
+					}
+					else {
+						rWr[nn - 1] = rWr[nn] = x + p;
+						rWi[nn - 1] = -(rWi[nn] = z);
+					}
+
+					nn -= 2;
+				}
+				// no roots found yet
+				else {
+					if(its == KPFA_MODAL_MAX_QR_ITERATION) {
+						return KPFA_ERROR_NOT_CONVERGED;
+					}
+
+					// exceptional shift
+					if(its == 10 || its == 20) {
+						t += x;
+						for(i = 1; i <= nn; i++) a(i, i) -= x;
+						s = fabs(a(nn, nn - 1)) + fabs(a(nn - 1, nn - 2));
+						y = x = 0.75 * s;
+						w = -0.4375 * s * s;
+					}
+
+					++its;
+
+					// find two consecutive small subdiagonal elements
+					for(m = nn - 2; m >= l; m--) {
+						z = a(m, m);
+						r = x - z;
+						s = y - z;
+						p = (r * s - w) / a(m + 1, m) + a(m, m + 1);
+						q = a(m + 1, m + 1) - z - r - s;
+						r = a(m + 2, m + 1);
+						s = fabs(p) + fabs(q) + fabs(r);
+						p /= s;
+						q /= s;
+						r /= s;
+						if(m == l) break;
+						u = fabs(a(m, m - 1)) * (fabs(q) + fabs(r));
+						v = fabs(p) * (fabs(a(m - 1, m - 1)) + fabs(z) + fabs(a(m + 1, m + 1)));
+						if(u + v == v) break;
+					}
+
+					for(i = m + 2; i <= nn; i++) {
+						a(i, i - 2) = 0.0;
+						if(i != m + 2) a(i, i - 3) = 0.0;
+					}
+
+					// double QR step on the rows l to nn and the columns m to nn
+					for(k = m; k <= nn - 1; k++) {
+
+						if(k != m) {
+							p = a(k, k - 1);
+							q = a(k + 1, k - 1);
+							r = 0.0;
+							if(k != nn - 1) r = a(k + 2, k - 1);
+							if((x = fabs(p) + fabs(q) + fabs(r)) != 0.0) {
+								p /= x;
+								q /= x;
+								r /= x;
+							}
+						}
+
+						s = sqrt(p * p + q * q + r * r);
+						if(p < 0) s = -s;
+
+						if(s != 0.0) {
+
+							if(k == m) {
+								if(l != m) a(k, k - 1) = -a(k, k - 1);
+							}
+							else {
+								a(k, k - 1) = -s * x;
+							}
+
+							p += s;
+							x = p / s;
+							y = q / s;
+							z = r / s;
+							q /= p;
+							r /= p;
+
+							for(j = k; j <= nn; j++) {
+								p = a(k, j) + q * a(k + 1, j);
+								if(k != nn - 1) {
+									p += r * a(k + 2, j);
+									a(k + 2, j) -= p * z;
+								}
+								a(k + 1, j) -= p * y;
+								a(k, j) -= p * x;
+							}
+
+							mmin = (nn < k + 3) ? nn : k + 3;
+
+							for(i = l; i <= mmin; i++) {
+								p = x * a(i, k) + y * a(i, k + 1);
+								if(k != nn - 1) {
+									p += z * a(i, k + 2);
+									a(i, k + 2) -= p * r;
+								}
+								a(i, k + 1) -= p * q;
+								a(i, k) -= p;
+							}
+						}
+					}
+				}
+			}
+		} while(l < nn - 1);
+	}
+
+	// back to the indices from zero
+	rWr.erase(rWr.begin());
+	rWi.erase(rWi.begin());
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will calculate the eigenvector of the leading n x n block of the
+ * given Hessenberg matrix for the given real eigenvalue by the inverse iteration.
+ *
+ * @param rHmat upper Hessenberg matrix
+ * @param nSize size of the block
+ * @param nTheta eigenvalue
+ * @param rY output eigenvector (unit length)
+ * @return error information
+ */
+static KpfaError_t
+HessenbergEigenvector(KpfaDenseMatrix_t &rHmat, uint32_t nSize, double nTheta, std::vector<double> &rY) {
+
+	uint32_t i, j, k;
+
+	double shift = nTheta + KPFA_MODAL_EIGEN_PERTURB * std::max(fabs(nTheta), 1.0);
+
+	KpfaDenseMatrix_t lu(nSize, nSize);
+
+	for(i = 0; i < nSize; i++) {
+		for(j = 0; j < nSize; j++) {
+			lu(i, j) = rHmat(i, j) - ((i == j) ? shift : 0);
+		}
+	}
+
+	// LU factorization with the partial pivoting, which is done here as the matrix
+	// is nearly singular on purpose (lu_substitute checks the residual in debug)
+	std::vector<uint32_t> pivot(nSize);
+
+	for(k = 0; k < nSize; k++) {
+
+		uint32_t piv = k;
+
+		for(i = k + 1; i < nSize; i++) {
+			if(fabs(lu(i, k)) > fabs(lu(piv, k))) piv = i;
+		}
+
+		if(lu(piv, k) == 0) {
+			return KPFA_ERROR_LU_FACTORIZE;
+		}
+
+		pivot[k] = piv;
+
+		if(piv != k) {
+			for(j = 0; j < nSize; j++) std::swap(lu(k, j), lu(piv, j));
+		}
+
+		for(i = k + 1; i < nSize; i++) {
+
+			double f = (lu(i, k) /= lu(k, k));
+
+			if(f == 0) continue;
+
+			for(j = k + 1; j < nSize; j++) {
+				lu(i, j) -= f * lu(k, j);
+			}
+		}
+	}
+
+	rY.assign(nSize, 1.0);
+
+	for(uint32_t it = 0; it < KPFA_MODAL_INVERSE_ITERATION; it++) {
+
+		// L U y' = P y
+		for(k = 0; k < nSize; k++) {
+			std::swap(rY[k], rY[pivot[k]]);
+		}
+
+		for(k = 0; k < nSize; k++) {
+			for(i = k + 1; i < nSize; i++) rY[i] -= lu(i, k) * rY[k];
+		}
+
+		for(k = nSize; k-- > 0; ) {
+			for(j = k + 1; j < nSize; j++) rY[k] -= lu(k, j) * rY[j];
+			rY[k] /= lu(k, k);
+		}
+
+		double norm = sqrt(Dot(&rY[0], &rY[0], nSize));
+		KPFA_CHECK(norm > 0, KPFA_ERROR_LU_FACTORIZE);
+
+		for(i = 0; i < nSize; i++) rY[i] /= norm;
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will calculate the critical modes of the reduced Q-V Jacobian
+ * matrix at the last converged solution of the given powerflow. The eigenvalues
+ * of JR closest to the given shift are the largest ones of Inv[JR - shift], which
+ * the Arnoldi method finds first. The participation factor of the bus k in the
+ * mode i is (right eigenvector)_k x (left eigenvector)_k, normalized so that the
+ * factors of a mode sum to one. Only the real modes are kept.
+ *
+ * @param pDataMgmt raw data management solved by the powerflow
+ * @param pPowerflow powerflow with the converged solution
+ * @param nShift shift of the eigenvalues
+ * @return error information
+ */
+KpfaError_t
+KpfaModalModule::Calculate(KpfaRawDataMgmt *pDataMgmt, KpfaPowerflow *pPowerflow, double nShift) {
+
+	KPFA_CHECK(pDataMgmt != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+	KPFA_CHECK(pPowerflow != NULL && pPowerflow->GetYMatrix() != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+	KPFA_CHECK(pPowerflow->GetNewtonRaphson() != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+	KPFA_CHECK(m_pCtrlDataMgmt != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	KpfaError_t error;
+
+	uint32_t i, k;
+
+	m_rModeList.clear();
+
+	KpfaNewtonRaphson *ntrap = pPowerflow->GetNewtonRaphson();
+	KpfaNetworkModel *model = pDataMgmt->GetNetworkModel();
+
+	// 1. build the Jacobian matrix at the solution, and factorize it with the
+	//    shift on the diagonal of J4
+	KpfaDoubleMatrix_t jmat;
+
+	error = ntrap->BuildJacobiMatrix(pPowerflow->GetYMatrix(), jmat);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	KpfaBusIndexMap_t::iterator iter;
+	KpfaBusIndexMap_t &qbmap = ntrap->GetQbusMap();
+
+	m_nPsize = ntrap->GetPbusMap().size();
+	m_rBusList.clear();
+
+	for(iter = qbmap.begin(); iter != qbmap.end(); iter++) {
+		m_rBusList.push_back(iter->first);
+	}
+
+	uint32_t nq = m_rBusList.size();
+	uint32_t count = std::min(m_pCtrlDataMgmt->m_nModalCount, nq);
+
+	if(count == 0) {
+		return KPFA_SUCCESS;
+	}
+
+	if(nShift != 0) {
+		for(i = 0; i < nq; i++) {
+			jmat(m_nPsize + i, m_nPsize + i) -= nShift;
+		}
+	}
+
+	error = m_rLU.Factorize(jmat);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	m_rWork.assign(m_nPsize + nq, 0.0);
+
+	// 2. Arnoldi method on Inv[JR] and its transpose
+	uint32_t ndim = std::min(nq, std::max(2 * count, (uint32_t)KPFA_MODAL_MIN_KRYLOV));
+
+	KpfaDenseMatrix_t vr, hr, vl, hl;
+
+	uint32_t mr = Arnoldi(FALSE, ndim, vr, hr);
+	uint32_t ml = Arnoldi(TRUE, ndim, vl, hl);
+
+	// 3. Ritz values, the eigenvalues of the Hessenberg matrices
+	std::vector<double> wrr, wir, wrl, wil;
+
+	error = HessenbergEigenvalues(hr, mr, wrr, wir);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	error = HessenbergEigenvalues(hl, ml, wrl, wil);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	// real Ritz values in the descending order of the magnitude
+	std::vector<std::pair<double, uint32_t> > order;
+
+	for(i = 0; i < mr; i++) {
+		if(wrr[i] != 0 && fabs(wir[i]) <= KPFA_MODAL_REAL_TOLERANCE * fabs(wrr[i])) {
+			order.push_back(std::make_pair(-fabs(wrr[i]), i));
+		}
+	}
+
+	std::sort(order.begin(), order.end());
+
+	// 4. right and left eigenvectors (Ritz vectors), and the participation factors
+	KpfaNetworkBus_t &bus = model->GetBus();
+	uint32_t nbus = model->GetBusCount();
+
+	std::vector<double> y, x(nq), eta(nq);
+
+	for(k = 0; k < order.size() && m_rModeList.size() < count; k++) {
+
+		double theta = wrr[order[k].second];
+
+		// left Ritz value nearest to the right one
+		uint32_t l = ml;
+
+		for(i = 0; i < ml; i++) {
+			if(fabs(wil[i]) <= KPFA_MODAL_REAL_TOLERANCE * fabs(wrl[i]) &&
+			   (l == ml || fabs(wrl[i] - theta) < fabs(wrl[l] - theta))) {
+				l = i;
+			}
+		}
+
+		if(l == ml) continue;
+
+		// right eigenvector x = Transpose[Vr] x y
+		if(HessenbergEigenvector(hr, mr, theta, y) != KPFA_SUCCESS) continue;
+
+		double residual = fabs(hr(mr, mr - 1) * y[mr - 1]) / fabs(theta);
+
+		std::fill(x.begin(), x.end(), 0.0);
+
+		for(uint32_t j = 0; j < mr; j++) {
+			const double *v = GetDenseRow(vr, j);
+			for(i = 0; i < nq; i++) x[i] += y[j] * v[i];
+		}
+
+		// left eigenvector eta = Transpose[Vl] x y
+		if(HessenbergEigenvector(hl, ml, wrl[l], y) != KPFA_SUCCESS) continue;
+
+		std::fill(eta.begin(), eta.end(), 0.0);
+
+		for(uint32_t j = 0; j < ml; j++) {
+			const double *v = GetDenseRow(vl, j);
+			for(i = 0; i < nq; i++) eta[i] += y[j] * v[i];
+		}
+
+		double dot = Dot(&x[0], &eta[0], nq);
+
+		if(dot == 0) continue;
+
+		KpfaModalMode_t mode;
+
+		mode.nEigenvalue = nShift + 1.0 / theta;
+		mode.nResidual = residual;
+		mode.rParticipation.assign(nbus, 0.0);
+		mode.nWeakestBusId = 0;
+
+		double maxp = 0;
+
+		for(i = 0; i < nq; i++) {
+
+			double p = x[i] * eta[i] / dot;
+
+			mode.rParticipation[m_rBusList[i]] = p;
+
+			if(p > maxp) {
+				maxp = p;
+				mode.nWeakestBusId = bus.rId[m_rBusList[i]];
+			}
+		}
+
+		m_rModeList.push_back(mode);
+	}
+
+	std::sort(m_rModeList.begin(), m_rModeList.end(), CompareMode);
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will multiply the given vector by Inv[JR] (or its transpose)
+ * with the factorized Jacobian matrix: the dV part of Inv[J] x [0; x].
+ *
+ * @param pX input vector (the size of the Q rows)
+ * @param pY output vector (the size of the Q rows)
+ * @param bTrans whether the matrix is transposed
+ */
+void
+KpfaModalModule::ApplyInverse(const double *pX, double *pY, bool_t bTrans) {
+
+	uint32_t i, nq = m_rBusList.size();
+
+	double *w = &m_rWork[0];
+
+	std::fill(w, w + m_nPsize, 0.0);
+
+	for(i = 0; i < nq; i++) {
+		w[m_nPsize + i] = pX[i];
+	}
+
+	if(bTrans == TRUE)	m_rLU.SolveTranspose(w);
+	else				m_rLU.Solve(w);
+
+	for(i = 0; i < nq; i++) {
+		pY[i] = w[m_nPsize + i];
+	}
+}
+
+/**
+ * This function will build the orthonormal basis of the Krylov subspace of
+ * Inv[JR] (or its transpose) by the Arnoldi method, so that
+ * Inv[JR] x Transpose[V] = Transpose[V] x H approximately. The basis vectors are
+ * orthogonalized twice by the Gram-Schmidt process to keep them orthogonal.
+ *
+ * @param bTrans whether the matrix is transposed
+ * @param nDim dimension of the subspace
+ * @param rVmat output basis vectors by the rows ((nDim + 1) x size of the Q rows)
+ * @param rHmat output upper Hessenberg matrix ((nDim + 1) x nDim)
+ * @return dimension of the subspace built (smaller than nDim if an invariant subspace is found)
+ */
+uint32_t
+KpfaModalModule::Arnoldi(bool_t bTrans, uint32_t nDim, KpfaDenseMatrix_t &rVmat, KpfaDenseMatrix_t &rHmat) {
+
+	uint32_t i, j, n = m_rBusList.size();
+
+	rVmat.resize(nDim + 1, n, false);
+	rHmat.resize(nDim + 1, nDim, false);
+	rHmat.clear();
+
+	double *v0 = GetDenseRow(rVmat, 0);
+
+	for(i = 0; i < n; i++) {
+		v0[i] = 1.0 / sqrt((double)n);
+	}
+
+	for(j = 0; j < nDim; j++) {
+
+		double *w = GetDenseRow(rVmat, j + 1);
+
+		ApplyInverse(GetDenseRow(rVmat, j), w, bTrans);
+
+		double cnorm = 0;
+
+		for(uint32_t pass = 0; pass < 2; pass++) {
+			for(i = 0; i <= j; i++) {
+
+				const double *v = GetDenseRow(rVmat, i);
+				double h = Dot(v, w, n);
+
+				rHmat(i, j) += h;
+
+				for(uint32_t r = 0; r < n; r++) {
+					w[r] -= h * v[r];
+				}
+			}
+		}
+
+		for(i = 0; i <= j; i++) {
+			cnorm += rHmat(i, j) * rHmat(i, j);
+		}
+
+		double norm = sqrt(Dot(w, w, n));
+
+		rHmat(j + 1, j) = norm;
+
+		if(norm <= KPFA_MODAL_BREAKDOWN * sqrt(cnorm)) {
+			return j + 1;
+		}
+
+		for(i = 0; i < n; i++) {
+			w[i] /= norm;
+		}
+	}
+
+	return nDim;
+}
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaModalModule::Write(ostream &rOut) {
+
+	rOut << "KPFA MODAL MODULE: " << endl;
+
+	for(uint32_t i = 0; i < m_rModeList.size(); i++) {
+
+		KpfaModalMode_t &mode = m_rModeList[i];
+
+		rOut << "\tMODE " << i << ": EIGENVALUE " << mode.nEigenvalue
+			 << ", RESIDUAL " << mode.nResidual
+			 << ", WEAKEST BUS " << mode.nWeakestBusId << endl;
+	}
+}
+
+ostream &operator << (ostream &rOut, KpfaModalModule *pModule) {
+	pModule->Write(rOut);
+	return rOut;
+}
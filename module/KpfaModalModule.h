@@ -0,0 +1,127 @@
+/*
+ * KpfaModalModule.h
+ */
+
+#ifndef _KPFA_MODAL_MODULE_H_
+#define _KPFA_MODAL_MODULE_H_
+
+#include "KpfaDebug.h"
+#include "KpfaConfig.h"
+#include "KpfaSparseLU.h"
+#include "KpfaPowerflow.h"
+#include "KpfaRawDataMgmt.h"
+#include "KpfaCtrlDataMgmt.h"
+
+// Minimum dimension of the Krylov subspace of the Arnoldi method
+#define KPFA_MODAL_MIN_KRYLOV		20
+
+// Maximum number of the QR iterations for an eigenvalue of the Hessenberg matrix
+#define KPFA_MODAL_MAX_QR_ITERATION	30
+
+// Number of the inverse iterations for an eigenvector of the Hessenberg matrix
+#define KPFA_MODAL_INVERSE_ITERATION	3
+
+/**
+ * Mode of the reduced Q-V Jacobian matrix
+ */
+typedef struct {
+	// eigenvalue (dQ/dV of the mode)
+	double nEigenvalue;
+	// residual of the eigenvalue relative to the eigenvalue of the inverse
+	double nResidual;
+	// participation factor of each bus by the bus index (zero if not a load bus)
+	std::vector<double> rParticipation;
+	// bus with the largest participation factor
+	uint32_t nWeakestBusId;
+} KpfaModalMode_t;
+
+typedef std::vector<KpfaModalMode_t> KpfaModalModeList_t;
+
+/**
+ * The declaration of the class for the modal analysis of the voltage stability.
+ * The smallest eigenvalues of the reduced Q-V Jacobian matrix at a converged
+ * solution and their participation factors are calculated. A small positive
+ * eigenvalue means the solution is close to the voltage collapse, and the buses
+ * with the large participation factors of the mode are the weak ones.
+ *
+ * The reduced matrix JR = J4 - J3 x Inv[J1] x J2 is not formed. Inv[JR] x dQ is
+ * the dV part of Inv[J] x [0; dQ], so that the Jacobian matrix is factorized
+ * once with the sparse LU, and each step of the shift-invert Arnoldi method on
+ * JR and on Transpose[JR] (for the left eigenvectors) is a pair of triangular
+ * solves.
+ */
+class KpfaModalModule {
+
+private:
+
+	// Critical modes in the ascending order of the eigenvalues
+	KpfaModalModeList_t m_rModeList;
+
+	// Factorized Jacobian matrix
+	KpfaSparseLU m_rLU;
+
+	// Number of the P rows of the Jacobian matrix
+	uint32_t m_nPsize;
+
+	// Bus index of each Q row of the Jacobian matrix
+	std::vector<uint32_t> m_rBusList;
+
+	// Work vector of the solves
+	std::vector<double> m_rWork;
+
+	// Control data management
+	KpfaCtrlDataMgmt *m_pCtrlDataMgmt;
+
+public:
+
+	KpfaModalModule(KpfaCtrlDataMgmt *pCtrlDataMgmt = NULL) {
+
+		m_pCtrlDataMgmt = pCtrlDataMgmt;
+
+		m_nPsize = 0;
+	}
+
+	virtual ~KpfaModalModule() {
+		// Do nothing
+	}
+
+	KpfaError_t Calculate(KpfaRawDataMgmt *pRawDataMgmt,
+						  KpfaPowerflow *pPowerflow,
+						  double nShift = 0);
+
+	/**
+	 * This function will return the critical modes in the ascending order of the eigenvalues.
+	 *
+	 * @return mode list
+	 */
+	inline KpfaModalModeList_t &GetModeList() {
+		return m_rModeList;
+	}
+
+	/**
+	 * This function will return the smallest eigenvalue of the reduced Q-V Jacobian matrix.
+	 *
+	 * @return smallest eigenvalue (zero if no mode)
+	 */
+	inline double GetMinEigenvalue() {
+		return (m_rModeList.empty() == false) ? m_rModeList[0].nEigenvalue : 0;
+	}
+
+private:
+
+	void ApplyInverse(const double *pX, double *pY, bool_t bTrans);
+
+	uint32_t Arnoldi(bool_t bTrans, uint32_t nDim, KpfaDenseMatrix_t &rVmat, KpfaDenseMatrix_t &rHmat);
+
+public:
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+
+	friend ostream &operator << (ostream &rOut, KpfaModalModule *pModule);
+};
+
+#endif /* _KPFA_MODAL_MODULE_H_ */
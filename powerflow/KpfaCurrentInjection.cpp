@@ -0,0 +1,531 @@
+/*
+ * KpfaCurrentInjection.cpp
+ */
+
+#include "KpfaCurrentInjection.h"
+
+KpfaCurrentInjection::KpfaCurrentInjection(KpfaRawDataMgmt *pDataMgmt, KpfaNtrapParam_t *pParam)
+	: KpfaNewtonRaphson(pDataMgmt, pParam) {
+	// Do nothing
+}
+
+KpfaCurrentInjection::~KpfaCurrentInjection() {
+	// Do nothing
+}
+
+/**
+ * This function will return the number of the variables of the given bus.
+ * A generator bus, and a load bus with a generator which is able to be changed
+ * to a generator bus, have the reactive power as the third variable.
+ *
+ * @param k bus index
+ * @return variable number (zero for a swing or an isolated bus)
+ */
+uint32_t
+KpfaCurrentInjection::GetVariableCount(uint32_t k) {
+
+	KpfaNetworkBus_t &bus = m_pModel->GetBus();
+
+	switch(bus.rIde[k]) {
+		case KPFA_GEN_BUS:
+			return 3;
+		case KPFA_LOAD_BUS:
+			return (bus.rGen[k] != KPFA_NETWORK_NO_INDEX) ? 3 : 2;
+		default:
+			return 0;
+	}
+}
+
+/**
+ * This function will build the initial V matrix in the rectangular form using
+ * the bus data, and the first Jacobian row of each bus.
+ *
+ * @return error information
+ */
+KpfaError_t
+KpfaCurrentInjection::BuildRectVMatrix() {
+
+	KpfaNetworkBus_t &bus = m_pModel->GetBus();
+	uint32_t k, nbus = m_pModel->GetBusCount();
+
+	KPFA_CHECK(nbus == m_rVmat.size(), KPFA_ERROR_INVALID_BUS_INDEX);
+
+	m_rVre.resize(nbus);
+	m_rVim.resize(nbus);
+	m_rIre.assign(nbus, 0.0);
+	m_rIim.assign(nbus, 0.0);
+	m_rQnet.assign(nbus, 0.0);
+	m_rVsq.assign(nbus, 0.0);
+	m_rColIndex.assign(nbus, KPFA_NETWORK_NO_INDEX);
+
+	uint32_t ncol = 0;
+
+	for(k = 0; k < nbus; k++) {
+
+		m_rVre[k] = bus.rVm[k] * cos(bus.rVa[k]);
+		m_rVim[k] = bus.rVm[k] * sin(bus.rVa[k]);
+
+		uint32_t nvar = GetVariableCount(k);
+
+		if(nvar > 0) {
+			m_rColIndex[k] = ncol;
+			ncol += nvar;
+		}
+	}
+
+	m_rDeltaXmat.assign(ncol, 0.0);
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will build the Jacobian matrix with the off-diagonal blocks
+ * [G -B; B G] of the Y matrix, which are not changed over the iterations, and
+ * keep the elements of the diagonal blocks to be updated at each iteration.
+ *
+ * @param pYmat Y matrix
+ * @return error information
+ */
+KpfaError_t
+KpfaCurrentInjection::BuildCurrentJacobiMatrix(KpfaYMatrix *pYmat) {
+
+	KpfaComplexMatrix_t &ymat = pYmat->GetMatrix();
+	KpfaDoubleMatrix_t &jmat = m_rJmat;
+
+	uint32_t k, j, r, c, nbus = m_pModel->GetBusCount();
+	uint32_t ncol = m_rDeltaXmat.size();
+
+	jmat.resize(ncol, ncol, false);
+	jmat.clear();
+
+	m_rYdiag.assign(nbus, KpfaComplex_t(0, 0));
+
+	KpfaComplexMatrix_t::iterator1 riter;
+	KpfaComplexMatrix_t::iterator2 citer;
+
+	// The elements are inserted in the row order, and the rows of a bus are
+	// the real and the imaginary parts of the current (and the Q row)
+	for(riter = ymat.begin1(); riter != ymat.end1(); riter++) {
+
+		uint32_t col_k = m_rColIndex[k = riter.index1()];
+
+		if(col_k == KPFA_NETWORK_NO_INDEX) continue;
+
+		uint32_t nvar_k = GetVariableCount(k);
+
+		for(r = 0; r < 2; r++) {
+			for(citer = riter.begin(); citer != riter.end(); citer++) {
+
+				uint32_t col_j = m_rColIndex[j = citer.index2()];
+
+				if(col_j == KPFA_NETWORK_NO_INDEX) continue;
+
+				KpfaComplex_t y_kj = *citer;
+
+				// diagonal block (updated at each iteration)
+				if(k == j) {
+					m_rYdiag[k] = y_kj;
+					for(c = 0; c < nvar_k; c++) {
+						jmat.push_back(col_k + r, col_k + c, 0.0);
+					}
+					continue;
+				}
+
+				// off-diagonal block: [G -B] for the real part, [B G] for the imaginary part
+				double de = (r == 0) ?  y_kj.real() : y_kj.imag();
+				double df = (r == 0) ? -y_kj.imag() : y_kj.real();
+
+				if(de != 0) jmat.push_back(col_k + r, col_j, de);
+				if(df != 0) jmat.push_back(col_k + r, col_j + 1, df);
+			}
+		}
+
+		// Q row of the voltage magnitude (or the fixed reactive power)
+		if(nvar_k == 3) {
+			for(c = 0; c < nvar_k; c++) {
+				jmat.push_back(col_k + 2, col_k + c, 0.0);
+			}
+		}
+	}
+
+	// Keep the diagonal block elements after all the insertions
+	m_rBlockList.assign(nbus * KPFA_CURRENT_BLOCK_SIZE, NULL);
+
+	for(k = 0; k < nbus; k++) {
+
+		uint32_t col_k = m_rColIndex[k];
+		uint32_t nvar_k = GetVariableCount(k);
+
+		if(col_k == KPFA_NETWORK_NO_INDEX) continue;
+
+		for(r = 0; r < nvar_k; r++) {
+			for(c = 0; c < nvar_k; c++) {
+
+				double *elem = jmat.find_element(col_k + r, col_k + c);
+
+				// A bus without its diagonal Y element makes the Jacobian matrix singular
+				KPFA_CHECK(elem != NULL, KPFA_ERROR_INVALID_BUS_INDEX);
+
+				m_rBlockList[k * KPFA_CURRENT_BLOCK_SIZE + r * 3 + c] = elem;
+			}
+		}
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will calculate the bus currents (Y x V) with the current V matrix,
+ * and change the bus types by the reactive power limits of the generators as the
+ * polar formulation does. The reactive power and the voltage magnitude of a bus
+ * are kept as the variable and the target when it becomes a generator bus.
+ *
+ * @param pYmat Y matrix
+ * @param bFirst whether it is the first iteration
+ * @return error information
+ */
+KpfaError_t
+KpfaCurrentInjection::BuildIMatrix(KpfaYMatrix *pYmat, bool_t bFirst) {
+
+	uint32_t k, j;
+
+	KpfaComplexMatrix_t &ymat = pYmat->GetMatrix();
+
+	KpfaNetworkBus_t &bus = m_pModel->GetBus();
+	uint32_t nbus = m_pModel->GetBusCount();
+
+#ifdef KPFA_APPLY_CONVERGE_HEURISTIC
+	KpfaNetworkGen_t &gen = m_pModel->GetGen();
+#endif
+
+	std::fill(m_rIre.begin(), m_rIre.end(), 0.0);
+	std::fill(m_rIim.begin(), m_rIim.end(), 0.0);
+
+	KpfaComplexMatrix_t::iterator1 riter;
+	KpfaComplexMatrix_t::iterator2 citer;
+
+	for(riter = ymat.begin1(); riter != ymat.end1(); riter++) {
+
+		double ire = 0, iim = 0;
+
+		for(citer = riter.begin(); citer != riter.end(); citer++) {
+
+			KpfaComplex_t y_kj = *citer;
+
+			j = citer.index2();
+
+			ire += y_kj.real() * m_rVre[j] - y_kj.imag() * m_rVim[j];
+			iim += y_kj.real() * m_rVim[j] + y_kj.imag() * m_rVre[j];
+		}
+
+		m_rIre[riter.index1()] = ire;
+		m_rIim[riter.index1()] = iim;
+	}
+
+	for(k = 0; k < nbus; k++) {
+
+		if(m_rColIndex[k] == KPFA_NETWORK_NO_INDEX) continue;
+
+		uint8_t ide = bus.rIde[k];
+
+		// Q_k = Im(V_k x conj(I_k))
+		double q_k = m_rVim[k] * m_rIre[k] - m_rVre[k] * m_rIim[k];
+
+#ifdef KPFA_APPLY_CONVERGE_HEURISTIC
+		KpfaBusData *busData = m_pDataMgmt->GetBusDataAt(k);
+		uint32_t g = bus.rGen[k];
+
+		double tmpQ = q_k + bus.rQl[k];
+
+		if(g != KPFA_NETWORK_NO_INDEX) {
+			switch(ide) {
+				case KPFA_GEN_BUS: {
+					if(tmpQ < gen.rQb[g]) {
+						busData->m_nIde = KPFA_LOAD_BUS;
+						busData->m_nQg = gen.rQb[g];
+					}
+					else if(tmpQ > gen.rQt[g]) {
+						busData->m_nIde = KPFA_LOAD_BUS;
+						busData->m_nQg = gen.rQt[g];
+					}
+					break;
+				}
+				case KPFA_LOAD_BUS: {
+					if(tmpQ > gen.rQb[g] && tmpQ < gen.rQt[g]) {
+						busData->m_nIde = KPFA_GEN_BUS;
+					}
+					break;
+				}
+				default: break;
+			}
+
+			bus.rIde[k] = (uint8_t)busData->m_nIde;
+			bus.rQg[k] = busData->m_nQg;
+		}
+#endif
+
+		if(bus.rIde[k] == KPFA_GEN_BUS && (bFirst == TRUE || ide != KPFA_GEN_BUS)) {
+			m_rQnet[k] = q_k;
+			m_rVsq[k] = m_rVre[k] * m_rVre[k] + m_rVim[k] * m_rVim[k];
+		}
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will calculate the mismatches of the current injections (and
+ * the squared voltage magnitudes of the generator buses) into the delta X matrix,
+ * and the maximum power mismatch for the convergence check of the polar formulation.
+ *
+ * @return error information
+ */
+KpfaError_t
+KpfaCurrentInjection::CalculateMismatch() {
+
+	KpfaNetworkBus_t &bus = m_pModel->GetBus();
+	uint32_t k, nbus = m_pModel->GetBusCount();
+
+	double *dx = m_rDeltaXmat.data();
+
+	// Reset the maximum Tolerance
+	double maxptol = 0, maxqtol = 0;
+	uint32_t maxpid = 0;
+	uint32_t maxqid = 0;
+
+	for(k = 0; k < nbus; k++) {
+
+		uint32_t col_k = m_rColIndex[k];
+
+		if(col_k == KPFA_NETWORK_NO_INDEX) continue;
+
+		double e = m_rVre[k], f = m_rVim[k];
+		double d = e * e + f * f;
+
+		double p_k = bus.rPg[k] - bus.rPl[k];
+		double q_k = (bus.rIde[k] == KPFA_GEN_BUS) ? m_rQnet[k] : bus.rQg[k] - bus.rQl[k];
+
+		// Ispec - Y x V, where Ispec = conj(S / V)
+		dx[col_k]     = (p_k * e + q_k * f) / d - m_rIre[k];
+		dx[col_k + 1] = (p_k * f - q_k * e) / d - m_rIim[k];
+
+		if(GetVariableCount(k) == 3) {
+			dx[col_k + 2] = (bus.rIde[k] == KPFA_GEN_BUS) ? m_rVsq[k] - d : 0;
+		}
+
+		// Update the maximum tolerance info.
+		////////////////////////////////////////////////////////////
+		double pval = p_k - (e * m_rIre[k] + f * m_rIim[k]);
+
+		if(fabs(pval) > maxptol) {
+			maxptol = fabs(pval);
+			maxpid = bus.rId[k];
+		}
+
+		if(bus.rIde[k] == KPFA_GEN_BUS) continue;
+
+		double qval = q_k - (f * m_rIre[k] - e * m_rIim[k]);
+
+		if(fabs(qval) > maxqtol) {
+			maxqtol = fabs(qval);
+			maxqid = bus.rId[k];
+		}
+	}
+
+	if(maxqtol > maxptol) {
+		m_nMaxTolerance = maxqtol;
+		m_nMaxPbusId = 0;
+		m_nMaxQbusId = maxqid;
+	}
+	else {
+		m_nMaxTolerance = maxptol;
+		m_nMaxPbusId = maxpid;
+		m_nMaxQbusId = 0;
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will update the diagonal blocks of the Jacobian matrix of
+ * Y x V - Ispec with the current V matrix. With a = Re(Ispec), b = Im(Ispec),
+ * the block of a bus is
+ *
+ *   [G - da/de   -B - da/df   -da/dQ]
+ *   [B - db/de    G - db/df   -db/dQ]
+ *   [2e           2f           0    ]
+ *
+ * where the third row and column are kept only for a generator bus. The third
+ * row of a load bus with a generator keeps its reactive power fixed.
+ *
+ * @return error information
+ */
+KpfaError_t
+KpfaCurrentInjection::UpdateCurrentJacobiMatrix() {
+
+	KpfaNetworkBus_t &bus = m_pModel->GetBus();
+	uint32_t k, nbus = m_pModel->GetBusCount();
+
+	for(k = 0; k < nbus; k++) {
+
+		if(m_rColIndex[k] == KPFA_NETWORK_NO_INDEX) continue;
+
+		double **block = &m_rBlockList[k * KPFA_CURRENT_BLOCK_SIZE];
+
+		double e = m_rVre[k], f = m_rVim[k];
+		double d = e * e + f * f;
+
+		double g_kk = m_rYdiag[k].real();
+		double b_kk = m_rYdiag[k].imag();
+
+		double p_k = bus.rPg[k] - bus.rPl[k];
+		double q_k = (bus.rIde[k] == KPFA_GEN_BUS) ? m_rQnet[k] : bus.rQg[k] - bus.rQl[k];
+
+		double a = (p_k * e + q_k * f) / d;
+		double b = (p_k * f - q_k * e) / d;
+
+		*block[0] = g_kk - (p_k - 2 * e * a) / d;
+		*block[1] = -b_kk - (q_k - 2 * f * a) / d;
+		*block[3] = b_kk - (-q_k - 2 * e * b) / d;
+		*block[4] = g_kk - (p_k - 2 * f * b) / d;
+
+		if(GetVariableCount(k) != 3) continue;
+
+		if(bus.rIde[k] == KPFA_GEN_BUS) {
+			*block[2] = -f / d;
+			*block[5] = e / d;
+			*block[6] = 2 * e;
+			*block[7] = 2 * f;
+			*block[8] = 0;
+		}
+		else {
+			*block[2] = 0;
+			*block[5] = 0;
+			*block[6] = 0;
+			*block[7] = 0;
+			*block[8] = 1;
+		}
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will update the rectangular V matrix and the reactive powers of
+ * the generator buses using the delta X matrix.
+ *
+ * @return error information
+ */
+KpfaError_t
+KpfaCurrentInjection::UpdateRectVMatrix() {
+
+	uint32_t k, nbus = m_pModel->GetBusCount();
+
+	double *dx = m_rDeltaXmat.data();
+
+	for(k = 0; k < nbus; k++) {
+
+		uint32_t col_k = m_rColIndex[k];
+
+		if(col_k == KPFA_NETWORK_NO_INDEX) continue;
+
+		m_rVre[k] += dx[col_k];
+		m_rVim[k] += dx[col_k + 1];
+
+		if(GetVariableCount(k) == 3) {
+			m_rQnet[k] += dx[col_k + 2];
+		}
+	}
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will be used to calculate the result of the powerflow analysis
+ * by applying the Newton-Raphson method with the current injection formulation
+ * to the given Y matrix. The V matrix is converted to the polar form at the end.
+ *
+ * @param pYmat input Y matrix, already reduced
+ * @return error information
+ */
+KpfaError_t
+KpfaCurrentInjection::Calculate(KpfaYMatrix *pYmat) {
+
+	uint32_t i, k;
+	KpfaError_t error;
+
+	double tolerance = m_pParam->nTolerance;
+	uint32_t maxiter = m_pParam->nMaxIteration;
+
+	// Build an initial V matrix
+	error = BuildRectVMatrix();
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	// Build the Jacobian matrix with the constant off-diagonal blocks
+	error = BuildCurrentJacobiMatrix(pYmat);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	for(i = 1; i < maxiter; i++) {
+
+		// Calculate the bus currents
+		error = BuildIMatrix(pYmat, (i == 1) ? TRUE : FALSE);
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+		// Calculate the mismatches
+		error = CalculateMismatch();
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+		// Update the diagonal blocks of the Jacobian matrix
+		error = UpdateCurrentJacobiMatrix();
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+		// Calculate the delta X matrix with the column order of the first iteration
+		error = m_rLU.Factorize(m_rJmat, (i == 1) ? FALSE : TRUE);
+
+		if(error != KPFA_SUCCESS) {
+			KPFA_ERROR("The linear system for delta V matrix is not solved.");
+			return error;
+		}
+
+		m_rLU.Solve(m_rDeltaXmat.data());
+
+		// Update the V matrix using the delta X matrix
+		error = UpdateRectVMatrix();
+		KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+		// For debugging
+		/////////////////////////////////////////////////////////////
+#if 1
+		KPFA_DEBUG("CurrentInjection", "Iteration number: %d", i);
+		KPFA_DEBUG("CurrentInjection", "Maximum mismatch: %f, P: %d, Q: %d",
+					m_nMaxTolerance, m_nMaxPbusId, m_nMaxQbusId);
+#endif
+		/////////////////////////////////////////////////////////////
+
+		// Check if the solution is converged
+		if(m_nMaxTolerance < tolerance) {
+			break;
+		}
+	}
+
+	// Convert the V matrix to the polar form, keeping the angle around the initial one
+	KpfaNetworkBus_t &bus = m_pModel->GetBus();
+	uint32_t nbus = m_pModel->GetBusCount();
+
+	for(k = 0; k < nbus; k++) {
+
+		double vm = sqrt(m_rVre[k] * m_rVre[k] + m_rVim[k] * m_rVim[k]);
+		double va = atan2(m_rVim[k], m_rVre[k]) - bus.rVa[k];
+
+		va -= 2 * M_PI * floor((va + M_PI) / (2 * M_PI));
+
+		m_rVmat(k) = KpfaComplex_t(vm, bus.rVa[k] + va);
+	}
+
+	if(i == maxiter) {
+		KPFA_ERROR("Powerflow solution is not converged");
+		return KPFA_ERROR_NOT_CONVERGED;
+	}
+
+	return KPFA_SUCCESS;
+}
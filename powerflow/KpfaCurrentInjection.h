@@ -0,0 +1,84 @@
+/*
+ * KpfaCurrentInjection.h
+ */
+
+#ifndef _KPFA_CURRENT_INJECTION_H_
+#define _KPFA_CURRENT_INJECTION_H_
+
+#include "KpfaSparseLU.h"
+#include "KpfaNewtonRaphson.h"
+
+// Number of the Jacobian elements kept for the diagonal block of a bus (3 x 3)
+#define KPFA_CURRENT_BLOCK_SIZE		9
+
+/**
+ * The declaration of the class for the Newton-Raphson method with the rectangular
+ * current injection formulation. The variables of a bus are the real and the
+ * imaginary parts of its voltage (e, f), and the mismatches are those of the
+ * current injection, Ispec - Y x V. A generator bus has the reactive power as
+ * the third variable with the mismatch of the squared voltage magnitude.
+ *
+ * The off-diagonal blocks of the Jacobian matrix are [G -B; B G] of the Y matrix,
+ * which do not change over the iterations. The matrix is built once, and only
+ * the diagonal blocks are updated at each iteration without any trigonometric
+ * function. The column order of the sparse LU is also kept after the first
+ * factorization. The converged V matrix is returned in the polar form as the
+ * polar formulation does.
+ */
+class KpfaCurrentInjection : public KpfaNewtonRaphson {
+
+private:
+
+	// Real and imaginary parts of the bus voltage
+	std::vector<double> m_rVre;
+	std::vector<double> m_rVim;
+
+	// Real and imaginary parts of the bus current (Y x V)
+	std::vector<double> m_rIre;
+	std::vector<double> m_rIim;
+
+	// Net reactive power of a generator bus (variable) and its squared voltage magnitude
+	std::vector<double> m_rQnet;
+	std::vector<double> m_rVsq;
+
+	// First Jacobian row (and column) of each bus (KPFA_NETWORK_NO_INDEX if no variable)
+	KpfaBusIndexList_t m_rColIndex;
+
+	// Diagonal element of the Y matrix
+	std::vector<KpfaComplex_t> m_rYdiag;
+
+	// Diagonal block elements of the Jacobian matrix of each bus (NULL if not kept)
+	std::vector<double *> m_rBlockList;
+
+	// Mismatch on input, and the update of the variables on output
+	std::vector<double> m_rDeltaXmat;
+
+	// Factorized Jacobian matrix
+	KpfaSparseLU m_rLU;
+
+public:
+
+	KpfaCurrentInjection(KpfaRawDataMgmt *pDataMgmt, KpfaNtrapParam_t *pParam = NULL);
+
+	virtual ~KpfaCurrentInjection();
+
+	virtual KpfaError_t Calculate(KpfaYMatrix *pYmat);
+
+private:
+
+	uint32_t GetVariableCount(uint32_t k);
+
+	KpfaError_t BuildRectVMatrix();
+
+	KpfaError_t BuildCurrentJacobiMatrix(KpfaYMatrix *pYmat);
+
+	KpfaError_t BuildIMatrix(KpfaYMatrix *pYmat, bool_t bFirst);
+
+	KpfaError_t CalculateMismatch();
+
+	KpfaError_t UpdateCurrentJacobiMatrix();
+
+	KpfaError_t UpdateRectVMatrix();
+};
+
+#endif /* _KPFA_CURRENT_INJECTION_H_ */
@@ -0,0 +1,308 @@
+/*
+ * KpfaDenseKernel.cpp
+ */
+
+#include <thread>
+#include <atomic>
+
+#include "KpfaDenseKernel.h"
+
+/**
+ * The operands of a GEMM shared by the threads computing its tiles.
+ * All the matrices are dense and row-major.
+ */
+typedef struct {
+	// C = alpha x A x B + beta x C (C: m x n, A: m x k, B: k x n)
+	const double *pA;
+	const double *pB;
+	double *pC;
+	uint32_t nM;
+	uint32_t nN;
+	uint32_t nK;
+	double nAlpha;
+	double nBeta;
+	// Number of the tiles of C (row blocks x column blocks)
+	uint32_t nRowTiles;
+	uint32_t nColTiles;
+} KpfaGemmTask_t;
+
+/**
+ * Returns the start address of the elements of a dense matrix.
+ */
+static inline const double *
+GetDenseData(const KpfaDenseMatrix_t &rMat) {
+	return (rMat.data().size() > 0) ? &rMat.data()[0] : NULL;
+}
+
+/**
+ * Packs a block of A (nRows x nDepth from pA) into slivers of KPFA_GEMM_MR rows,
+ * stored column by column. The last sliver is padded with zeros.
+ */
+static void
+PackBlockA(const double *pA, uint32_t nLda, uint32_t nRows, uint32_t nDepth, double *pPack) {
+
+	for(uint32_t i = 0; i < nRows; i += KPFA_GEMM_MR) {
+
+		uint32_t mr = std::min<uint32_t>(KPFA_GEMM_MR, nRows - i);
+
+		for(uint32_t p = 0; p < nDepth; p++) {
+
+			uint32_t r = 0;
+
+			for(; r < mr; r++) {
+				*pPack++ = pA[(size_t)(i + r) * nLda + p];
+			}
+			for(; r < KPFA_GEMM_MR; r++) {
+				*pPack++ = 0;
+			}
+		}
+	}
+}
+
+/**
+ * Packs a panel of B (nDepth x nCols from pB) into slivers of KPFA_GEMM_NR columns,
+ * stored row by row. The last sliver is padded with zeros.
+ */
+static void
+PackPanelB(const double *pB, uint32_t nLdb, uint32_t nDepth, uint32_t nCols, double *pPack) {
+
+	for(uint32_t j = 0; j < nCols; j += KPFA_GEMM_NR) {
+
+		uint32_t nr = std::min<uint32_t>(KPFA_GEMM_NR, nCols - j);
+
+		for(uint32_t p = 0; p < nDepth; p++) {
+
+			const double *b = pB + (size_t)p * nLdb + j;
+			uint32_t c = 0;
+
+			for(; c < nr; c++) {
+				*pPack++ = b[c];
+			}
+			for(; c < KPFA_GEMM_NR; c++) {
+				*pPack++ = 0;
+			}
+		}
+	}
+}
+
+/**
+ * Multiplies a packed sliver of A by a packed sliver of B, keeping the
+ * KPFA_GEMM_MR x KPFA_GEMM_NR block of the product in local accumulators
+ * which the compiler can keep in the vector registers.
+ */
+static inline void
+MultiplySliver(uint32_t nDepth, const double *pA, const double *pB,
+			   double *pC, uint32_t nLdc, uint32_t nRows, uint32_t nCols, double nAlpha) {
+
+	double acc[KPFA_GEMM_MR][KPFA_GEMM_NR];
+
+	for(uint32_t r = 0; r < KPFA_GEMM_MR; r++) {
+		for(uint32_t c = 0; c < KPFA_GEMM_NR; c++) {
+			acc[r][c] = 0;
+		}
+	}
+
+	for(uint32_t p = 0; p < nDepth; p++) {
+
+		const double *a = pA + p * KPFA_GEMM_MR;
+		const double *b = pB + p * KPFA_GEMM_NR;
+
+		for(uint32_t r = 0; r < KPFA_GEMM_MR; r++) {
+			for(uint32_t c = 0; c < KPFA_GEMM_NR; c++) {
+				acc[r][c] += a[r] * b[c];
+			}
+		}
+	}
+
+	for(uint32_t r = 0; r < nRows; r++) {
+		for(uint32_t c = 0; c < nCols; c++) {
+			pC[(size_t)r * nLdc + c] += nAlpha * acc[r][c];
+		}
+	}
+}
+
+/**
+ * Computes a tile of C: the block of KPFA_GEMM_MC rows and KPFA_GEMM_NC columns.
+ */
+static void
+ComputeGemmTile(KpfaGemmTask_t *pTask, uint32_t nTile, double *pPackA, double *pPackB) {
+
+	uint32_t m = pTask->nM, n = pTask->nN, k = pTask->nK;
+
+	uint32_t i0 = (nTile / pTask->nColTiles) * KPFA_GEMM_MC;
+	uint32_t j0 = (nTile % pTask->nColTiles) * KPFA_GEMM_NC;
+
+	uint32_t mc = std::min<uint32_t>(KPFA_GEMM_MC, m - i0);
+	uint32_t nc = std::min<uint32_t>(KPFA_GEMM_NC, n - j0);
+
+	double *c = pTask->pC + (size_t)i0 * n + j0;
+
+	// C = beta x C first, and then the products are accumulated
+	for(uint32_t r = 0; r < mc; r++) {
+		for(uint32_t s = 0; s < nc; s++) {
+			double &cij = c[(size_t)r * n + s];
+			cij = (pTask->nBeta == 0) ? 0 : pTask->nBeta * cij;
+		}
+	}
+
+	for(uint32_t p0 = 0; p0 < k; p0 += KPFA_GEMM_KC) {
+
+		uint32_t kc = std::min<uint32_t>(KPFA_GEMM_KC, k - p0);
+
+		PackBlockA(pTask->pA + (size_t)i0 * k + p0, k, mc, kc, pPackA);
+		PackPanelB(pTask->pB + (size_t)p0 * n + j0, n, kc, nc, pPackB);
+
+		for(uint32_t j = 0; j < nc; j += KPFA_GEMM_NR) {
+			for(uint32_t i = 0; i < mc; i += KPFA_GEMM_MR) {
+				MultiplySliver(kc, pPackA + (size_t)i * kc, pPackB + (size_t)j * kc,
+							   c + (size_t)i * n + j, n,
+							   std::min<uint32_t>(KPFA_GEMM_MR, mc - i),
+							   std::min<uint32_t>(KPFA_GEMM_NR, nc - j),
+							   pTask->nAlpha);
+			}
+		}
+	}
+}
+
+/**
+ * This function will compute the tiles of the GEMM taken from the shared
+ * counter until all the tiles are taken.
+ *
+ * @param pTask GEMM operands
+ * @param pNext index of the next tile to be taken
+ */
+static void
+GemmWorker(KpfaGemmTask_t *pTask, std::atomic<uint32_t> *pNext) {
+
+	// Packed block of A and panel of B of this thread
+	std::vector<double> packA(KPFA_GEMM_MC * KPFA_GEMM_KC + KPFA_GEMM_MR * KPFA_GEMM_KC);
+	std::vector<double> packB(KPFA_GEMM_KC * KPFA_GEMM_NC + KPFA_GEMM_KC * KPFA_GEMM_NR);
+
+	uint32_t ntile = pTask->nRowTiles * pTask->nColTiles;
+
+	for(uint32_t t = (*pNext)++; t < ntile; t = (*pNext)++) {
+		ComputeGemmTile(pTask, t, &packA[0], &packB[0]);
+	}
+}
+
+/**
+ * This function will compute C = alpha x A x B + beta x C with dense matrices.
+ * The blocks of A and the panels of B are packed so that the inner kernel reads
+ * them contiguously, and the tiles of C are computed on several threads if the
+ * product is large enough. C is resized if beta is zero.
+ *
+ * @param rC output matrix (m x n)
+ * @param rA left matrix (m x k)
+ * @param rB right matrix (k x n)
+ * @param nAlpha scale of the product
+ * @param nBeta scale of C
+ */
+void
+KpfaGemm(KpfaDenseMatrix_t &rC,
+		 const KpfaDenseMatrix_t &rA,
+		 const KpfaDenseMatrix_t &rB,
+		 double nAlpha,
+		 double nBeta) {
+
+	uint32_t m = rA.size1(), k = rA.size2(), n = rB.size2();
+
+	KPFA_ASSERT(rB.size1() == k, "Invalid matrix size for GEMM");
+
+	if(nBeta == 0) {
+		rC.resize(m, n, false);
+	}
+
+	KPFA_ASSERT(rC.size1() == m && rC.size2() == n, "Invalid matrix size for GEMM");
+
+	if(m == 0 || n == 0) {
+		return;
+	}
+
+	KpfaGemmTask_t task;
+
+	task.pA = GetDenseData(rA);
+	task.pB = GetDenseData(rB);
+	task.pC = &rC.data()[0];
+	task.nM = m;
+	task.nN = n;
+	task.nK = k;
+	task.nAlpha = nAlpha;
+	task.nBeta = nBeta;
+	task.nRowTiles = (m + KPFA_GEMM_MC - 1) / KPFA_GEMM_MC;
+	task.nColTiles = (n + KPFA_GEMM_NC - 1) / KPFA_GEMM_NC;
+
+	uint32_t ntile = task.nRowTiles * task.nColTiles;
+	uint32_t threadCount = 1;
+
+	if((double)m * n * k >= KPFA_GEMM_PARALLEL_WORK) {
+		threadCount = std::thread::hardware_concurrency();
+	}
+
+	if(threadCount == 0) {
+		threadCount = 1;
+	}
+
+	if(threadCount > ntile) {
+		threadCount = ntile;
+	}
+
+	std::atomic<uint32_t> next(0);
+	std::vector<std::thread> threadList;
+
+	for(uint32_t i = 1; i < threadCount; i++) {
+		threadList.push_back(std::thread(GemmWorker, &task, &next));
+	}
+
+	// The calling thread also computes the tiles
+	GemmWorker(&task, &next);
+
+	for(uint32_t i = 0; i < threadList.size(); i++) {
+		threadList[i].join();
+	}
+}
+
+/**
+ * This function will compute y = A x x (or y = A^T x x) with a dense matrix.
+ * Both are computed by the rows of A, so that A is read contiguously.
+ *
+ * @param pY output vector (rows of A, or columns of A if transposed)
+ * @param rA dense matrix
+ * @param pX input vector (columns of A, or rows of A if transposed)
+ * @param bTrans whether A is transposed
+ */
+void
+KpfaGemv(double *pY, const KpfaDenseMatrix_t &rA, const double *pX, bool bTrans) {
+
+	uint32_t m = rA.size1(), n = rA.size2();
+
+	const double *a = GetDenseData(rA);
+
+	if(bTrans == false) {
+
+		for(uint32_t i = 0; i < m; i++, a += n) {
+
+			double sum = 0;
+
+			for(uint32_t j = 0; j < n; j++) {
+				sum += a[j] * pX[j];
+			}
+
+			pY[i] = sum;
+		}
+
+		return;
+	}
+
+	for(uint32_t j = 0; j < n; j++) {
+		pY[j] = 0;
+	}
+
+	for(uint32_t i = 0; i < m; i++, a += n) {
+
+		double xi = pX[i];
+
+		for(uint32_t j = 0; j < n; j++) {
+			pY[j] += a[j] * xi;
+		}
+	}
+}
@@ -0,0 +1,38 @@
+/*
+ * KpfaDenseKernel.h
+ */
+
+#ifndef _KPFA_DENSE_KERNEL_H_
+#define _KPFA_DENSE_KERNEL_H_
+
+#include "KpfaDebug.h"
+#include "KpfaConfig.h"
+
+// Register block of the GEMM (rows x columns of C kept in the registers)
+#define KPFA_GEMM_MR				4
+#define KPFA_GEMM_NR				8
+
+// Cache block of the GEMM (rows, depth and columns of the packed panels)
+#define KPFA_GEMM_MC				64
+#define KPFA_GEMM_KC				256
+#define KPFA_GEMM_NC				512
+
+// Minimum number of multiply-adds to run the GEMM on several threads
+#define KPFA_GEMM_PARALLEL_WORK		(1 << 21)
+
+////////////////////////////////////////////////////////
+// Function declaration
+////////////////////////////////////////////////////////
+
+void KpfaGemm(KpfaDenseMatrix_t &rC,
+			  const KpfaDenseMatrix_t &rA,
+			  const KpfaDenseMatrix_t &rB,
+			  double nAlpha = 1.0,
+			  double nBeta = 0.0);
+
+void KpfaGemv(double *pY,
+			  const KpfaDenseMatrix_t &rA,
+			  const double *pX,
+			  bool bTrans = false);
+
+#endif /* _KPFA_DENSE_KERNEL_H_ */
@@ -5,6 +5,8 @@
  *      Author: youngsun
  */
 
+#include <mutex>
+
 #include "KpfaLinearSystem.h"
 #if KPFA_LINEAR_SYSTEM_SOLVER == KPFA_PCG_SOLVER
 #include "pcg.hpp"
@@ -122,6 +124,9 @@ KpfaLinearSystem::Solve_PCG(M &rAmat, V &rBmat, V &rXmat) {
 // C++ to Fortran interface for MA28 library 
 ///////////////////////////////////////////////////////////////////
 
+// MA28 keeps its state in the COMMON blocks, so that it is called by a thread at a time
+static std::mutex g_rMa28Lock;
+
 typedef int* F_INT;
 typedef float* F_REAL;
 typedef double* F_DOUBLE;
@@ -216,7 +221,10 @@ KpfaLinearSystem::Solve_MA28(M &rAmat, V &rBmat, V &rXmat) {
 #endif
 
     // Solve the linear system using MA28 library
-    ma28_solve_linear_system_(&n, &nz, amat, &licn, icn, &lirn, irn, xmat, &error);
+    {
+        std::lock_guard<std::mutex> guard(g_rMa28Lock);
+        ma28_solve_linear_system_(&n, &nz, amat, &licn, icn, &lirn, irn, xmat, &error);
+    }
 
     // YOUNGSUN - CHKME
 #if 1
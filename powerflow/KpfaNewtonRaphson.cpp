@@ -12,6 +12,7 @@ KpfaNewtonRaphson::KpfaNewtonRaphson(KpfaRawDataMgmt *pDataMgmt, KpfaNtrapParam_
 	KPFA_ASSERT(pDataMgmt != NULL, "KpfaJacobi: pDataMgmt must not be NULL.");
 
 	m_pDataMgmt = pDataMgmt;
+	m_pModel = pDataMgmt->GetNetworkModel();
 
 	if(pParam == NULL) {
 		m_pParam = new KpfaNtrapParam_t();
@@ -27,6 +28,8 @@ KpfaNewtonRaphson::KpfaNewtonRaphson(KpfaRawDataMgmt *pDataMgmt, KpfaNtrapParam_
 	m_nMaxPbusId = 0;
 	m_nMaxQbusId = 0;
 
+	m_pLU = NULL;
+
 	// Initialize S, V matrices
 	uint32_t nbus = pDataMgmt->GetBusCount();
 
@@ -52,17 +55,16 @@ KpfaNewtonRaphson::BuildVMatrix() {
 	vmat.clear();
 
 	// Set voltage, angle
-	uint32_t i = 0;
-	KpfaRawDataList_t::iterator iter;
-	KpfaRawDataList_t &dataList = m_pDataMgmt->GetBusDataList();
+	KpfaNetworkBus_t &bus = m_pModel->GetBus();
+	uint32_t nbus = m_pModel->GetBusCount();
+
+	KPFA_CHECK(nbus == vmat.size(), KPFA_ERROR_INVALID_BUS_INDEX);
 
-	for(iter = dataList.begin(); iter != dataList.end(); iter++) {
-		KpfaBusData *bus = (KpfaBusData *)*iter;
-		KPFA_CHECK(bus->m_nIdx == i, KPFA_ERROR_INVALID_BUS_INDEX);
+	for(uint32_t i = 0; i < nbus; i++) {
 #if 1
-		vmat(i++) = KpfaComplex_t(bus->m_nVm, bus->m_nVa);
+		vmat(i) = KpfaComplex_t(bus.rVm[i], bus.rVa[i]);
 #else
-		vmat(i++) = KpfaComplex_t(1.0, 0.0);
+		vmat(i) = KpfaComplex_t(1.0, 0.0);
 #endif
 	}
 
@@ -126,6 +128,11 @@ KpfaNewtonRaphson::BuildSMatrix(KpfaYMatrix *pYmat) {
 	KpfaComplexVector_t &vmat = m_rVmat;
 	KpfaComplexVector_t &smat = m_rSmat;
 
+#ifdef KPFA_APPLY_CONVERGE_HEURISTIC
+	KpfaNetworkBus_t &bus = m_pModel->GetBus();
+	KpfaNetworkGen_t &gen = m_pModel->GetGen();
+#endif
+
 	// Initialize S matrix
 	smat.clear();
 
@@ -156,20 +163,21 @@ KpfaNewtonRaphson::BuildSMatrix(KpfaYMatrix *pYmat) {
         // PVTEST in KU Fortran
 #ifdef KPFA_APPLY_CONVERGE_HEURISTIC		
         // YOUNGSUN - CHKME 
-		KpfaBusData *bus = m_pDataMgmt->GetBusDataAt(k);
-		KpfaGenData *gen = m_pDataMgmt->GetGenData(bus->m_nI);
+		// The raw bus data is also updated to keep the changed bus types.
+		KpfaBusData *busData = m_pDataMgmt->GetBusDataAt(k);
+		uint32_t g = bus.rGen[k];
 		
-		double tmpQ = smat(k).imag() + bus->m_nQl;
+		double tmpQ = smat(k).imag() + bus.rQl[k];
 				
-		switch(bus->m_nIde) {
+		switch(bus.rIde[k]) {
 			case KPFA_GEN_BUS: {
-				if(tmpQ < gen->m_nQb) {
-					bus->m_nIde = KPFA_LOAD_BUS;
-					bus->m_nQg = gen->m_nQb;
+				if(tmpQ < gen.rQb[g]) {
+					busData->m_nIde = KPFA_LOAD_BUS;
+					busData->m_nQg = gen.rQb[g];
 				}
-				else if(tmpQ > gen->m_nQt) {
-					bus->m_nIde = KPFA_LOAD_BUS;
-					bus->m_nQg = gen->m_nQt;
+				else if(tmpQ > gen.rQt[g]) {
+					busData->m_nIde = KPFA_LOAD_BUS;
+					busData->m_nQg = gen.rQt[g];
 				}
 				break;
 			}
@@ -177,13 +185,16 @@ KpfaNewtonRaphson::BuildSMatrix(KpfaYMatrix *pYmat) {
 			// A load bus is able to be changed to a generator bus 
 			// if the bus was a generator bus before. 
 			case KPFA_LOAD_BUS: {
-				if(gen != NULL && tmpQ > gen->m_nQb && tmpQ < gen->m_nQt) {
-					bus->m_nIde = KPFA_GEN_BUS;
+				if(g != KPFA_NETWORK_NO_INDEX && tmpQ > gen.rQb[g] && tmpQ < gen.rQt[g]) {
+					busData->m_nIde = KPFA_GEN_BUS;
 				}
 				break;
 			}
 			default: break;
 		}
+
+		bus.rIde[k] = (uint8_t)busData->m_nIde;
+		bus.rQg[k] = busData->m_nQg;
 #endif
 	}
 
@@ -243,15 +254,14 @@ KpfaNewtonRaphson::BuildPqBusIndexMaps() {
 	pbmap.clear();
 	qbmap.clear();    
 
-	uint32_t k = 0, npb = 0, nqb = 0;
+	uint32_t k, npb = 0, nqb = 0;
 
-	KpfaRawDataList_t::iterator iter;
-	KpfaRawDataList_t &dataList = m_pDataMgmt->GetBusDataList();
+	KpfaNetworkBus_t &bus = m_pModel->GetBus();
+	uint32_t nbus = m_pModel->GetBusCount();
 
-	for(iter = dataList.begin(); iter != dataList.end(); iter++, k++) {
-		KpfaBusData *bus = (KpfaBusData *)*iter;
+	for(k = 0; k < nbus; k++) {
 
-		switch(bus->m_nIde) {
+		switch(bus.rIde[k]) {
 			case KPFA_GEN_BUS:
 				// Keep to only P matrix
                 pbmap[k] = npb++;
@@ -294,18 +304,17 @@ KpfaNewtonRaphson::CalculateDeltaSMatrix(KpfaDoubleVector_t &rDeltaSmat) {
 
 	uint32_t i = 0, k;
 	
-	KpfaRawDataList_t::iterator iter;
-	KpfaRawDataList_t &dataList = m_pDataMgmt->GetBusDataList();
+	KpfaNetworkBus_t &bus = m_pModel->GetBus();
+	uint32_t nbus = m_pModel->GetBusCount();
 
 	// P matrix (Both generator and load)
-	for(iter = dataList.begin(), k = 0; iter != dataList.end(); iter++, k++) {
+	for(k = 0; k < nbus; k++) {
 
-		KpfaBusData *bus = (KpfaBusData *)*iter;
-		if(bus->m_nIde == KPFA_SWING_BUS) continue;
+		if(bus.rIde[k] != KPFA_GEN_BUS && bus.rIde[k] != KPFA_LOAD_BUS) continue;
 
 		KpfaComplex_t s_k = smat(k);
 
-		double pval = bus->m_nPg - bus->m_nPl - s_k.real();
+		double pval = bus.rPg[k] - bus.rPl[k] - s_k.real();
 
 		if(pval != 0) {
 			rDeltaSmat(i) = pval;
@@ -316,20 +325,19 @@ KpfaNewtonRaphson::CalculateDeltaSMatrix(KpfaDoubleVector_t &rDeltaSmat) {
 		////////////////////////////////////////////////////////////
 		if(fabs(pval) > maxtol) {
 			maxtol = fabs(pval);
-			maxpid = bus->m_nI;
+			maxpid = bus.rId[k];
 			maxqid = 0;
 		}
 	}
 
 	// Q matrix (Only load)
-	for(iter = dataList.begin(), k = 0; iter != dataList.end(); iter++, k++) {
+	for(k = 0; k < nbus; k++) {
 
-		KpfaBusData *bus = (KpfaBusData *)*iter;
-		if(bus->m_nIde == KPFA_SWING_BUS || bus->m_nIde == KPFA_GEN_BUS) continue;
+		if(bus.rIde[k] != KPFA_LOAD_BUS) continue;
 
 		KpfaComplex_t s_k = smat(k);
 
-		double qval = bus->m_nQg - bus->m_nQl - s_k.imag();
+		double qval = bus.rQg[k] - bus.rQl[k] - s_k.imag();
 
 		if(qval != 0) {
 			rDeltaSmat(i) = qval;
@@ -341,7 +349,7 @@ KpfaNewtonRaphson::CalculateDeltaSMatrix(KpfaDoubleVector_t &rDeltaSmat) {
 		if(fabs(qval) > maxtol) {
 			maxtol = fabs(qval);
 			maxpid = 0;
-			maxqid = bus->m_nI;
+			maxqid = bus.rId[k];
 		}
 	}
 
@@ -365,13 +373,25 @@ KpfaError_t
 KpfaNewtonRaphson::CalculateDeltaVMatrix(KpfaDoubleMatrix_t &rJmat, 
                                          KpfaDoubleVector_t &rDeltaSmat,
                                          KpfaDoubleVector_t &rDeltaVmat) {
-	KpfaLinearSystem jls;
-
 	rDeltaVmat.resize(rDeltaSmat.size(), false);
 	rDeltaVmat.clear();
 
+	KpfaError_t error;
+
 	// Calculate the delta V matrix
-	KpfaError_t error = jls.Solve(rJmat, rDeltaSmat, rDeltaVmat);
+	if(m_pLU != NULL) {
+
+		error = m_pLU->Factorize(rJmat, TRUE);
+
+		if(error == KPFA_SUCCESS) {
+			rDeltaVmat = rDeltaSmat;
+			m_pLU->Solve(rDeltaVmat.data().begin());
+		}
+	}
+	else {
+		KpfaLinearSystem jls;
+		error = jls.Solve(rJmat, rDeltaSmat, rDeltaVmat);
+	}
 
 	if(error != KPFA_SUCCESS) {
 		KPFA_ERROR("The linear system for delta V matrix is not solved.");
@@ -419,14 +439,18 @@ KpfaNewtonRaphson::CalculateJacobiMatrix(KpfaYMatrix *pYmat, KpfaDoubleMatrix_t
     // Jacobian matrix flag
 	uint32_t jm_flag;
 
+    // Bus types
+    std::vector<uint8_t> &ide = m_pModel->GetBus().rIde;
+
     // Bus iterators
     KpfaComplexMatrix_t::iterator1 iter_k;
     KpfaComplexMatrix_t::iterator2 iter_j;
     KpfaComplexMatrix_t::iterator2 iter_i;
 
     for(iter_k = ymat.begin1(); iter_k != ymat.end1(); iter_k++) {
-        KpfaBusData *bus_k = m_pDataMgmt->GetBusDataAt(k = iter_k.index1());
-        if(bus_k->m_nIde == KPFA_SWING_BUS) continue;
+        // Only generator and load buses have rows (not swing or isolated buses)
+        uint8_t ide_k = ide[k = iter_k.index1()];
+        if(ide_k != KPFA_GEN_BUS && ide_k != KPFA_LOAD_BUS) continue;
 
     	// Jacobian matrix k index
         jm1_k = jm2_k = pbmap[k];
@@ -440,13 +464,13 @@ KpfaNewtonRaphson::CalculateJacobiMatrix(KpfaYMatrix *pYmat, KpfaDoubleMatrix_t
         double tmp4_kk = -v_k.real() * y_kk.real() * sin(y_kk.imag());
 
         for(iter_j = iter_k.begin(); iter_j != iter_k.end(); iter_j++) {
-            KpfaBusData *bus_j = m_pDataMgmt->GetBusDataAt(j = iter_j.index2());
+            uint8_t ide_j = ide[j = iter_j.index2()];
 
             // set jm_flag to indicate which sub-matrices will be updated
-            if(bus_k->m_nIde == KPFA_GEN_BUS && bus_j->m_nIde == KPFA_GEN_BUS)        jm_flag = 0x01; // J1
-            else if(bus_k->m_nIde == KPFA_GEN_BUS && bus_j->m_nIde == KPFA_LOAD_BUS)  jm_flag = 0x03; // J1,2
-            else if(bus_k->m_nIde == KPFA_LOAD_BUS && bus_j->m_nIde == KPFA_GEN_BUS)  jm_flag = 0x05; // J1,3
-            else if(bus_k->m_nIde == KPFA_LOAD_BUS && bus_j->m_nIde == KPFA_LOAD_BUS) jm_flag = 0x0F; // J1,2,3,4
+            if(ide_k == KPFA_GEN_BUS && ide_j == KPFA_GEN_BUS)        jm_flag = 0x01; // J1
+            else if(ide_k == KPFA_GEN_BUS && ide_j == KPFA_LOAD_BUS)  jm_flag = 0x03; // J1,2
+            else if(ide_k == KPFA_LOAD_BUS && ide_j == KPFA_GEN_BUS)  jm_flag = 0x05; // J1,3
+            else if(ide_k == KPFA_LOAD_BUS && ide_j == KPFA_LOAD_BUS) jm_flag = 0x0F; // J1,2,3,4
             else continue;
 
         	// Jacobian matrix j index
@@ -520,33 +544,34 @@ KpfaNewtonRaphson::CheckValidity(KpfaComplexMatrix_t &rYmat, KpfaComplexVector_t
 
 	int k, j;
 	bool_t flag;
-	KpfaRawDataList_t::iterator riter;
-	KpfaRawDataList_t::iterator citer;
-	KpfaRawDataList_t &busList = m_pDataMgmt->GetBusDataList();
 
-	// k
-	for(k = 0, riter = busList.begin(); riter != busList.end(); riter++, k++) {
+	KpfaNetworkBus_t &bus = m_pModel->GetBus();
+	KpfaNetworkGen_t &gen = m_pModel->GetGen();
+	int nbus = (int)m_pModel->GetBusCount();
 
-		KpfaBusData *bus_k = (KpfaBusData *)*riter;
+	// k
+	for(k = 0; k < nbus; k++) {
 
-		if(bus_k->m_nIde != KPFA_GEN_BUS) {
+		if(bus.rIde[k] != KPFA_GEN_BUS) {
 			continue;
 		}
 
 		flag = FALSE;
 
-		KpfaGenData *gen_k = m_pDataMgmt->GetGenData(bus_k->m_nI);
-		KPFA_CHECK(gen_k != NULL, KPFA_ERROR_INVALID_BUS_ID);
+		uint32_t g = bus.rGen[k];
+		KPFA_CHECK(g != KPFA_NETWORK_NO_INDEX, KPFA_ERROR_INVALID_BUS_ID);
+
+		KpfaBusData *bus_k = m_pDataMgmt->GetBusDataAt(k);
 
 		KpfaComplex_t v_k = rVmat(k);
 		
-		double vm_k = bus_k->m_nVm;
+		double vm_k = bus.rVm[k];
 		double va_k = v_k.imag();
 
 		double q_k = 0;
 		double p_k = 0;
 
-		for(j = 0, citer = busList.begin(); citer != busList.end(); citer++, j++) {
+		for(j = 0; j < nbus; j++) {
 
 			KpfaComplex_t y_kj = rYmat(k, j);
 			KpfaComplex_t v_j  = rVmat(j);
@@ -556,22 +581,22 @@ KpfaNewtonRaphson::CheckValidity(KpfaComplexMatrix_t &rYmat, KpfaComplexVector_t
 
 		q_k *= vm_k;
 
-		if(q_k < gen_k->m_nQb) {
-			q_k = gen_k->m_nQb;
+		if(q_k < gen.rQb[g]) {
+			q_k = gen.rQb[g];
 			flag = TRUE;
 		}
-		else if(q_k > gen_k->m_nQt) {
-			q_k = gen_k->m_nQt;
+		else if(q_k > gen.rQt[g]) {
+			q_k = gen.rQt[g];
 			flag = TRUE;
 		}
 
-		bus_k->m_nQg = q_k;
+		bus_k->m_nQg = bus.rQg[k] = q_k;
 
 		// update Vm
 		/////////////////////////////////////////////////////////////////////////
 		if(flag == FALSE) continue;
 
-		p_k = gen_k->m_nPg;
+		p_k = gen.rPg[g];
 
 		// S_k
 		KpfaComplex_t tmp(p_k, -q_k);
@@ -580,7 +605,7 @@ KpfaNewtonRaphson::CheckValidity(KpfaComplexMatrix_t &rYmat, KpfaComplexVector_t
 		tmp /= KpfaComplex_t(vm_k * cos(-va_k), vm_k * sin(-va_k));
 
 		// {S_k / V_k} - Sum of Y_kj * Vj
-		for(j = 0, citer = busList.begin(); citer != busList.end(); citer++, j++) {
+		for(j = 0; j < nbus; j++) {
 
 			if(k == j) continue;
 
@@ -599,7 +624,7 @@ KpfaNewtonRaphson::CheckValidity(KpfaComplexMatrix_t &rYmat, KpfaComplexVector_t
 #endif
 
 		// new Vm 
-		bus_k->m_nVm = abs(tmp);
+		bus_k->m_nVm = bus.rVm[k] = abs(tmp);
 	}
 
 	return KPFA_SUCCESS;
@@ -700,6 +725,26 @@ KpfaNewtonRaphson::Calculate(KpfaYMatrix *pYmat) {
 	return KPFA_SUCCESS;
 }
 
+/**
+ * This function will build the Jacobian matrix at the current V matrix, and the
+ * P, Q bus index maps of its rows with the current bus types. It is used to
+ * analyze the converged solution after the Newton-Raphson method.
+ *
+ * @param pYmat Y matrix
+ * @param rJmat output Jacobian matrix
+ * @return error information
+ */
+KpfaError_t
+KpfaNewtonRaphson::BuildJacobiMatrix(KpfaYMatrix *pYmat, KpfaDoubleMatrix_t &rJmat) {
+
+	KPFA_CHECK(pYmat != NULL, KPFA_ERROR_INVALID_ARGUMENT);
+
+	KpfaError_t error = BuildPqBusIndexMaps();
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	return CalculateJacobiMatrix(pYmat, rJmat);
+}
+
 void
 KpfaNewtonRaphson::Write(ostream &rOut) {
     // do nothing
@@ -9,6 +9,7 @@
 #define _KPFA_NEWTON_RAPHSON_H_
 
 #include "KpfaLinearSystem.h"
+#include "KpfaSparseLU.h"
 #include "KpfaYMatrix.h"
 #include "KpfaConfig.h"
 #include "KpfaUtility.h"
@@ -35,11 +36,14 @@ typedef std::map<uint32_t, uint32_t> KpfaBusIndexMap_t;
 
 class KpfaNewtonRaphson {
 
-private:
+protected:
 
 	// Raw data management
 	KpfaRawDataMgmt *m_pDataMgmt;
 
+	// Network model of the raw data management
+	KpfaNetworkModel *m_pModel;
+
 	// Parameters for powerflow analysis
 	KpfaNtrapParam_t *m_pParam;
 
@@ -65,6 +69,9 @@ private:
 	uint32_t m_nMaxPbusId;
 	uint32_t m_nMaxQbusId;
 
+	// Sparse LU solving the delta V matrix (NULL to use the linear system)
+	KpfaSparseLU *m_pLU;
+
 public:
 
 	KpfaNewtonRaphson(KpfaRawDataMgmt *pDataMgmt, KpfaNtrapParam_t *pParam = NULL);
@@ -80,7 +87,39 @@ public:
 		return m_rVmat;
 	}
 
-	KpfaError_t Calculate(KpfaYMatrix *pYmat);
+	/**
+	 * This function will return the P bus index map (bus index to the P row of the Jacobian matrix).
+	 *
+	 * @return P bus index map
+	 */
+	inline KpfaBusIndexMap_t &GetPbusMap() {
+		return m_rPbusMap;
+	}
+
+	/**
+	 * This function will return the Q bus index map (bus index to the Q row of the Jacobian matrix).
+	 *
+	 * @return Q bus index map
+	 */
+	inline KpfaBusIndexMap_t &GetQbusMap() {
+		return m_rQbusMap;
+	}
+
+	/**
+	 * This function will make the delta V matrix solved with the given sparse LU
+	 * instead of the linear system. The column order of the LU is kept while the
+	 * size of the Jacobian matrix does not change. Unlike the linear system, the
+	 * sparse LU does not share any state with the other threads.
+	 *
+	 * @param pLU sparse LU (NULL to use the linear system)
+	 */
+	inline void SetSparseLU(KpfaSparseLU *pLU) {
+		m_pLU = pLU;
+	}
+
+	virtual KpfaError_t Calculate(KpfaYMatrix *pYmat);
+
+	KpfaError_t BuildJacobiMatrix(KpfaYMatrix *pYmat, KpfaDoubleMatrix_t &rJmat);
 
 	///////////////////////////////////////////////////////////////////
 	// Debugging Functions
@@ -12,6 +12,12 @@ KpfaPowerflow::KpfaPowerflow(KpfaCtrlDataMgmt *pCtrlDataMgmt) {
 	m_pCtrlDataMgmt = pCtrlDataMgmt;
 
 	m_pNtrap = NULL;
+	m_pYmat = NULL;
+
+	m_pSolvedDataMgmt = NULL;
+	m_nSolvedModifyCount = 0;
+
+	m_pLU = NULL;
 }
 
 KpfaPowerflow::~KpfaPowerflow() {
@@ -40,6 +46,27 @@ KpfaPowerflow::DoAnalysis(KpfaRawDataMgmt *pRawDataMgmt) {
 
 	KPFA_CHECK(pRawDataMgmt != NULL, KPFA_ERROR_INVALID_ARGUMENT);
 
+	// Release the previous analysis
+	m_pSolvedDataMgmt = NULL;
+
+	if(m_pNtrap != NULL) {
+		delete m_pNtrap;
+		m_pNtrap = NULL;
+	}
+
+	if(m_pYmat != NULL) {
+		delete m_pYmat;
+		m_pYmat = NULL;
+	}
+
+	// Copy the current raw data into the network model read by the solvers
+	error = pRawDataMgmt->UpdateNetworkModel();
+
+	if(error != KPFA_SUCCESS) {
+		KPFA_ERROR("KpfaRawDataMgmt->UpdateNetworkModel: error - %d", error);
+		return error;
+	}
+
 	m_pYmat = new KpfaYMatrix();
 	error = m_pYmat->BuildMatrix(pRawDataMgmt);
 
@@ -55,8 +82,15 @@ KpfaPowerflow::DoAnalysis(KpfaRawDataMgmt *pRawDataMgmt) {
 		KpfaComplex_t(1.0, 0)
 	};
 
-	// Perform the Newton-Raphson method
-	m_pNtrap = new KpfaNewtonRaphson(pRawDataMgmt, &param);
+	// Perform the Newton-Raphson method with the selected formulation
+	if(m_pCtrlDataMgmt->m_bCurrentInjection == TRUE) {
+		m_pNtrap = new KpfaCurrentInjection(pRawDataMgmt, &param);
+	}
+	else {
+		m_pNtrap = new KpfaNewtonRaphson(pRawDataMgmt, &param);
+		m_pNtrap->SetSparseLU(m_pLU);
+	}
+
 	error = m_pNtrap->Calculate(m_pYmat);
 
 	if(error != KPFA_SUCCESS) {
@@ -65,7 +99,17 @@ KpfaPowerflow::DoAnalysis(KpfaRawDataMgmt *pRawDataMgmt) {
 	}
 
 	// Update P, Q flow
-	return UpdateBranchFlow(pRawDataMgmt);
+	error = UpdateBranchFlow(pRawDataMgmt);
+	KPFA_CHECK(error == KPFA_SUCCESS, error);
+
+	// The solved values were written to the raw data, which makes the solutions
+	// of the other analyses out of date
+	pRawDataMgmt->SetModified();
+
+	m_pSolvedDataMgmt = pRawDataMgmt;
+	m_nSolvedModifyCount = pRawDataMgmt->GetModifyCount();
+
+	return KPFA_SUCCESS;
 }
 
 /**
@@ -92,6 +136,8 @@ KpfaPowerflow::DoAnalysis(KpfaRawDataMgmt *pRawDataMgmt,
 
 	if(error != KPFA_SUCCESS) {
 		KPFA_ERROR("KpfaPerformPowerflowAnalysis: error - %d", error);
+		// Do not leave the outages applied to the raw data
+		pRawDataMgmt->RetrieveFromContingency();
 		return error;
 	}
 
@@ -119,15 +165,15 @@ KpfaPowerflow::UpdateBranchFlow(KpfaRawDataMgmt *pRawDataMgmt) {
 	KpfaComplexVector_t &vmat = m_pNtrap->GetVMatrix();
 	KpfaComplexMatrix_t &ymat = m_pYmat->GetPolarMatrix();
 	
-	KpfaRawDataList_t::iterator iter;
 	KpfaRawDataList_t &branchList = pRawDataMgmt->GetBranchDataList();
+	KpfaNetworkBranch_t &branch = pRawDataMgmt->GetNetworkModel()->GetBranch();
 
-	for(iter = branchList.begin(); iter != branchList.end(); iter++) {
+	for(uint32_t b = 0; b < branchList.size(); b++) {
 
-		KpfaBranchData *branchData = (KpfaBranchData *)*iter;
+		KpfaBranchData *branchData = (KpfaBranchData *)branchList[b];
 
-		uint32_t i = pRawDataMgmt->GetBusIndex(branchData->m_nI);
-		uint32_t j = pRawDataMgmt->GetBusIndex(branchData->m_nJ);
+		uint32_t i = branch.rFrom[b];
+		uint32_t j = branch.rTo[b];
 
 		KpfaComplex_t v_i = vmat(i);
 		KpfaComplex_t v_j = vmat(j);
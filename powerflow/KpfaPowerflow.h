@@ -13,6 +13,7 @@
 #include "KpfaRawDataMgmt.h"
 #include "KpfaCtrlDataMgmt.h"
 #include "KpfaNewtonRaphson.h"
+#include "KpfaCurrentInjection.h"
 
 class KpfaPowerflow {
 
@@ -27,6 +28,13 @@ private:
 	// Y matrix
 	KpfaYMatrix *m_pYmat;
 
+	// Raw data management solved last, and its modification number at that time
+	KpfaRawDataMgmt *m_pSolvedDataMgmt;
+	uint32_t m_nSolvedModifyCount;
+
+	// Sparse LU of the Newton-Raphson method (NULL to use the linear system)
+	KpfaSparseLU *m_pLU;
+
 public:
 
 	KpfaPowerflow(KpfaCtrlDataMgmt *pCtrlDataMgmt = NULL);
@@ -42,6 +50,18 @@ public:
 		m_pCtrlDataMgmt = pDataMgmt;
 	}
 
+	/**
+	 * This function will make the polar Newton-Raphson method solve its linear
+	 * systems with the given sparse LU instead of the MA28 library, which is
+	 * serialized by a global lock. A powerflow analysis running on several
+	 * threads should have a sparse LU of its own.
+	 *
+	 * @param pLU sparse LU (NULL to use the linear system)
+	 */
+	inline void SetSparseLU(KpfaSparseLU *pLU) {
+		m_pLU = pLU;
+	}
+
 	/**
 	 * This function will return the Y matrix.
 	 *
@@ -60,6 +80,29 @@ public:
 		return m_pYmat;
 	}
 
+	/**
+	 * This function will return the Newton-Raphson method of the last analysis.
+	 *
+	 * @return Newton-Raphson method (NULL if not performed)
+	 */
+	inline KpfaNewtonRaphson *GetNewtonRaphson() {
+		return m_pNtrap;
+	}
+
+	/**
+	 * This function will check whether the last analysis converged on the given
+	 * raw data, and the raw data has not been modified since then. If so, the
+	 * Y matrix, the V matrix and the solved values of the raw data can be reused
+	 * without performing the analysis again.
+	 *
+	 * @param pRawDataMgmt raw data management
+	 * @return if the solution is up to date
+	 */
+	inline bool_t IsSolved(KpfaRawDataMgmt *pRawDataMgmt) {
+		return (pRawDataMgmt != NULL && m_pSolvedDataMgmt == pRawDataMgmt &&
+				m_nSolvedModifyCount == pRawDataMgmt->GetModifyCount()) ? TRUE : FALSE;
+	}
+
 	KpfaError_t UpdateBranchFlow(KpfaRawDataMgmt *pRawDataMgmt);
 
 	KpfaError_t DoAnalysis(KpfaRawDataMgmt *pRawDataMgmt);
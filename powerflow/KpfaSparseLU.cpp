@@ -0,0 +1,403 @@
+/*
+ * KpfaSparseLU.cpp
+ */
+
+#include "KpfaSparseLU.h"
+
+// Row which is not pivoted yet
+#define KPFA_SPARSE_LU_NO_PIVOT		0xFFFFFFFF
+
+KpfaSparseLU::KpfaSparseLU() {
+	m_nSize = 0;
+}
+
+KpfaSparseLU::~KpfaSparseLU() {
+	// Do nothing
+}
+
+/**
+ * This function will factorize the given square matrix into P x A x Q = L x U.
+ * The column order of the previous factorization can be kept for a matrix with
+ * the same non-zero pattern, which skips the minimum degree ordering.
+ *
+ * @param rMat matrix to be factorized
+ * @param bKeepOrder whether the previous column order is kept
+ * @return error information
+ */
+KpfaError_t
+KpfaSparseLU::Factorize(KpfaDoubleMatrix_t &rMat, bool_t bKeepOrder) {
+
+	KPFA_CHECK(rMat.size1() == rMat.size2(), KPFA_ERROR_INVALID_ARGUMENT);
+
+	uint32_t i, k, p, n = rMat.size1();
+
+	m_nSize = n;
+
+	// Compressed columns of the matrix
+	std::vector<uint32_t> ap(n + 1, 0), ai(rMat.nnz());
+	std::vector<double> ax(rMat.nnz());
+
+	KpfaDoubleMatrix_t::iterator1 riter;
+	KpfaDoubleMatrix_t::iterator2 citer;
+
+	for(riter = rMat.begin1(); riter != rMat.end1(); riter++) {
+		for(citer = riter.begin(); citer != riter.end(); citer++) {
+			ap[citer.index2() + 1]++;
+		}
+	}
+
+	for(k = 0; k < n; k++) {
+		ap[k + 1] += ap[k];
+	}
+
+	std::vector<uint32_t> next(ap.begin(), ap.end() - 1);
+
+	for(riter = rMat.begin1(); riter != rMat.end1(); riter++) {
+		for(citer = riter.begin(); citer != riter.end(); citer++) {
+			p = next[citer.index2()]++;
+			ai[p] = citer.index1();
+			ax[p] = *citer;
+		}
+	}
+
+	if(bKeepOrder == FALSE || m_rColPerm.size() != n) {
+		OrderColumns(ap, ai);
+	}
+
+	m_rLp.assign(1, 0);		m_rLi.clear();	m_rLx.clear();
+	m_rUp.assign(1, 0);		m_rUi.clear();	m_rUx.clear();
+
+	// Pivot position of each row
+	std::vector<uint32_t> pinv(n, KPFA_SPARSE_LU_NO_PIVOT);
+
+	// Dense column being factorized, and the rows reached from its non-zeros
+	std::vector<double> x(n, 0.0);
+	std::vector<uint32_t> reach(n), stack(n), resume(n), mark(n, 0);
+
+	for(k = 0; k < n; k++) {
+
+		uint32_t col = m_rColPerm[k];
+		uint32_t top = n;
+
+		// 1. find the rows reached from the non-zeros of the column through the
+		//    columns of L, in the topological order (depth first search)
+		for(p = ap[col]; p < ap[col + 1]; p++) {
+
+			if(mark[ai[p]] == k + 1) continue;
+
+			int32_t head = 0;
+			stack[0] = ai[p];
+
+			while(head >= 0) {
+
+				uint32_t j = stack[head];
+				uint32_t jpiv = pinv[j];
+
+				if(mark[j] != k + 1) {
+					mark[j] = k + 1;
+					resume[head] = (jpiv == KPFA_SPARSE_LU_NO_PIVOT) ? 0 : m_rLp[jpiv];
+				}
+
+				uint32_t end = (jpiv == KPFA_SPARSE_LU_NO_PIVOT) ? 0 : m_rLp[jpiv + 1];
+				bool done = true;
+
+				for(uint32_t q = resume[head]; q < end; q++) {
+
+					if(mark[m_rLi[q]] == k + 1) continue;
+
+					resume[head] = q + 1;
+					stack[++head] = m_rLi[q];
+					done = false;
+					break;
+				}
+
+				if(done == true) {
+					head--;
+					reach[--top] = j;
+				}
+			}
+		}
+
+		// 2. solve L x = A(:, col) over the reached rows
+		for(p = ap[col]; p < ap[col + 1]; p++) {
+			x[ai[p]] += ax[p];
+		}
+
+		for(p = top; p < n; p++) {
+
+			uint32_t j = reach[p];
+			uint32_t jpiv = pinv[j];
+
+			if(jpiv == KPFA_SPARSE_LU_NO_PIVOT) continue;
+
+			double xj = x[j];
+
+			for(uint32_t q = m_rLp[jpiv]; q < m_rLp[jpiv + 1]; q++) {
+				x[m_rLi[q]] -= m_rLx[q] * xj;
+			}
+		}
+
+		// 3. keep the pivoted rows in U, and choose the pivot among the others
+		uint32_t ipiv = KPFA_SPARSE_LU_NO_PIVOT;
+		double amax = 0;
+
+		for(p = top; p < n; p++) {
+
+			i = reach[p];
+
+			if(pinv[i] != KPFA_SPARSE_LU_NO_PIVOT) {
+				m_rUi.push_back(pinv[i]);
+				m_rUx.push_back(x[i]);
+			}
+			else if(fabs(x[i]) > amax) {
+				amax = fabs(x[i]);
+				ipiv = i;
+			}
+		}
+
+		if(ipiv == KPFA_SPARSE_LU_NO_PIVOT || amax == 0) {
+			return KPFA_ERROR_LU_FACTORIZE;
+		}
+
+		// prefer the diagonal to keep the column order
+		if(pinv[col] == KPFA_SPARSE_LU_NO_PIVOT && mark[col] == k + 1 &&
+		   fabs(x[col]) >= KPFA_SPARSE_LU_PIVOT_THRESHOLD * amax) {
+			ipiv = col;
+		}
+
+		double pivot = x[ipiv];
+
+		m_rUi.push_back(k);
+		m_rUx.push_back(pivot);
+		m_rUp.push_back(m_rUi.size());
+
+		pinv[ipiv] = k;
+
+		// 4. divide the rest by the pivot for L
+		for(p = top; p < n; p++) {
+
+			i = reach[p];
+
+			if(pinv[i] == KPFA_SPARSE_LU_NO_PIVOT) {
+				m_rLi.push_back(i);
+				m_rLx.push_back(x[i] / pivot);
+			}
+
+			x[i] = 0;
+		}
+
+		m_rLp.push_back(m_rLi.size());
+	}
+
+	// Renumber the rows of L in the pivot order
+	m_rRowPerm.resize(n);
+
+	for(i = 0; i < n; i++) {
+		m_rRowPerm[pinv[i]] = i;
+	}
+
+	for(p = 0; p < m_rLi.size(); p++) {
+		m_rLi[p] = pinv[m_rLi[p]];
+	}
+
+	m_rWork.assign(n, 0.0);
+
+	return KPFA_SUCCESS;
+}
+
+/**
+ * This function will solve A x = b with the factors.
+ *
+ * @param pX b on input, x on output (the size of the matrix)
+ */
+void
+KpfaSparseLU::Solve(double *pX) {
+
+	uint32_t k, p, n = m_nSize;
+
+	double *w = &m_rWork[0];
+
+	for(k = 0; k < n; k++) {
+		w[k] = pX[m_rRowPerm[k]];
+	}
+
+	// L y = P b
+	for(k = 0; k < n; k++) {
+
+		double wk = w[k];
+
+		if(wk == 0) continue;
+
+		for(p = m_rLp[k]; p < m_rLp[k + 1]; p++) {
+			w[m_rLi[p]] -= m_rLx[p] * wk;
+		}
+	}
+
+	// U z = y
+	for(k = n; k-- > 0; ) {
+
+		uint32_t last = m_rUp[k + 1] - 1;
+
+		double wk = (w[k] /= m_rUx[last]);
+
+		if(wk == 0) continue;
+
+		for(p = m_rUp[k]; p < last; p++) {
+			w[m_rUi[p]] -= m_rUx[p] * wk;
+		}
+	}
+
+	// x = Q z
+	for(k = 0; k < n; k++) {
+		pX[m_rColPerm[k]] = w[k];
+	}
+}
+
+/**
+ * This function will solve Transpose[A] x = b with the factors, which is
+ * Transpose[U] x Transpose[L] x P x = Transpose[Q] x b.
+ *
+ * @param pX b on input, x on output (the size of the matrix)
+ */
+void
+KpfaSparseLU::SolveTranspose(double *pX) {
+
+	uint32_t k, p, n = m_nSize;
+
+	double *w = &m_rWork[0];
+
+	for(k = 0; k < n; k++) {
+		w[k] = pX[m_rColPerm[k]];
+	}
+
+	// Transpose[U] y = Transpose[Q] b (the column k of U is the row k of Transpose[U])
+	for(k = 0; k < n; k++) {
+
+		uint32_t last = m_rUp[k + 1] - 1;
+
+		double wk = w[k];
+
+		for(p = m_rUp[k]; p < last; p++) {
+			wk -= m_rUx[p] * w[m_rUi[p]];
+		}
+
+		w[k] = wk / m_rUx[last];
+	}
+
+	// Transpose[L] z = y
+	for(k = n; k-- > 0; ) {
+
+		double wk = w[k];
+
+		for(p = m_rLp[k]; p < m_rLp[k + 1]; p++) {
+			wk -= m_rLx[p] * w[m_rLi[p]];
+		}
+
+		w[k] = wk;
+	}
+
+	// x = Transpose[P] z
+	for(k = 0; k < n; k++) {
+		pX[m_rRowPerm[k]] = w[k];
+	}
+}
+
+/**
+ * This function will order the columns by the minimum degree of the symmetric
+ * pattern of the matrix (Tinney scheme 2). The vertex with the fewest neighbors
+ * is eliminated first, and its neighbors are joined with each other as the
+ * fill-ins of the elimination.
+ *
+ * @param rAp column pointers of the matrix
+ * @param rAi row indices of the matrix
+ */
+void
+KpfaSparseLU::OrderColumns(std::vector<uint32_t> &rAp, std::vector<uint32_t> &rAi) {
+
+	uint32_t i, j, n = m_nSize;
+
+	// Sorted neighbors of each vertex
+	std::vector<std::vector<uint32_t> > adjacency(n);
+
+	for(j = 0; j < n; j++) {
+		for(uint32_t p = rAp[j]; p < rAp[j + 1]; p++) {
+
+			i = rAi[p];
+
+			if(i == j) continue;
+
+			adjacency[i].push_back(j);
+			adjacency[j].push_back(i);
+		}
+	}
+
+	for(i = 0; i < n; i++) {
+		std::vector<uint32_t> &adj = adjacency[i];
+		std::sort(adj.begin(), adj.end());
+		adj.erase(std::unique(adj.begin(), adj.end()), adj.end());
+	}
+
+	// Vertices ordered by the degree and then the index
+	std::set<std::pair<uint32_t, uint32_t> > queue;
+
+	for(i = 0; i < n; i++) {
+		queue.insert(std::make_pair((uint32_t)adjacency[i].size(), i));
+	}
+
+	m_rColPerm.clear();
+	m_rColPerm.reserve(n);
+
+	std::vector<uint32_t> merged;
+
+	while(queue.empty() == false) {
+
+		uint32_t v = queue.begin()->second;
+		queue.erase(queue.begin());
+
+		m_rColPerm.push_back(v);
+
+		std::vector<uint32_t> &neighbors = adjacency[v];
+
+		// Join the neighbors with each other, and remove the eliminated vertex
+		for(j = 0; j < neighbors.size(); j++) {
+
+			uint32_t u = neighbors[j];
+			std::vector<uint32_t> &adj = adjacency[u];
+
+			queue.erase(std::make_pair((uint32_t)adj.size(), u));
+
+			merged.clear();
+			std::set_union(adj.begin(), adj.end(), neighbors.begin(), neighbors.end(),
+						   std::back_inserter(merged));
+
+			adj.clear();
+
+			for(i = 0; i < merged.size(); i++) {
+				if(merged[i] != u && merged[i] != v) adj.push_back(merged[i]);
+			}
+
+			queue.insert(std::make_pair((uint32_t)adj.size(), u));
+		}
+
+		std::vector<uint32_t>().swap(neighbors);
+	}
+}
+
+///////////////////////////////////////////////////////////////////
+// Debugging Functions
+///////////////////////////////////////////////////////////////////
+
+void
+KpfaSparseLU::Write(ostream &rOut) {
+
+	rOut << "KPFA SPARSE LU: " << endl;
+	rOut << "\tSIZE: " << m_nSize << endl;
+	rOut << "\tL NNZ: " << m_rLx.size() << endl;
+	rOut << "\tU NNZ: " << m_rUx.size() << endl;
+}
+
+ostream &operator << (ostream &rOut, KpfaSparseLU *pLU) {
+
+	pLU->Write(rOut);
+	return rOut;
+}
@@ -0,0 +1,97 @@
+/*
+ * KpfaSparseLU.h
+ */
+
+#ifndef _KPFA_SPARSE_LU_H_
+#define _KPFA_SPARSE_LU_H_
+
+#include "KpfaDebug.h"
+#include "KpfaConfig.h"
+
+// A diagonal pivot is kept if it is not smaller than this ratio of the largest
+// candidate in its column, so that the fill-reducing order is followed
+#define KPFA_SPARSE_LU_PIVOT_THRESHOLD	0.1
+
+/**
+ * The declaration of the class for the sparse LU factorization of a square matrix.
+ * The columns are ordered by the minimum degree of the symmetric pattern (Tinney
+ * scheme 2) to reduce the fill-ins, and each column is factorized with a sparse
+ * triangular solve against the columns before it (Gilbert-Peierls), with a
+ * threshold partial pivoting which prefers the diagonal. The factors are kept in
+ * the compressed column form, so that any number of right-hand sides can be
+ * solved with a single factorization.
+ */
+class KpfaSparseLU {
+
+private:
+
+	// Matrix size
+	uint32_t m_nSize;
+
+	// Column order (the column k of the factors is the column m_rColPerm[k])
+	std::vector<uint32_t> m_rColPerm;
+
+	// Row order (the row k of the factors is the row m_rRowPerm[k])
+	std::vector<uint32_t> m_rRowPerm;
+
+	// Unit lower factor without the diagonal (compressed columns)
+	std::vector<uint32_t> m_rLp;
+	std::vector<uint32_t> m_rLi;
+	std::vector<double> m_rLx;
+
+	// Upper factor with the diagonal at the end of each column (compressed columns)
+	std::vector<uint32_t> m_rUp;
+	std::vector<uint32_t> m_rUi;
+	std::vector<double> m_rUx;
+
+	// Work vector of the solve
+	std::vector<double> m_rWork;
+
+public:
+
+	KpfaSparseLU();
+
+	virtual ~KpfaSparseLU();
+
+	/**
+	 * This function will return the size of the factorized matrix.
+	 *
+	 * @return matrix size
+	 */
+	inline uint32_t GetSize() {
+		return m_nSize;
+	}
+
+	/**
+	 * This function will return the number of non-zero elements of both factors.
+	 *
+	 * @return non-zero number
+	 */
+	inline size_t GetFactorNnz() {
+		return m_rLx.size() + m_rUx.size();
+	}
+
+	KpfaError_t Factorize(KpfaDoubleMatrix_t &rMat, bool_t bKeepOrder = FALSE);
+
+	void Solve(double *pX);
+
+	void SolveTranspose(double *pX);
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Functions
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(ostream &rOut);
+
+	friend ostream &operator << (ostream &rOut, KpfaSparseLU *pLU);
+
+private:
+
+	void OrderColumns(std::vector<uint32_t> &rAp, std::vector<uint32_t> &rAi);
+
+	KpfaSparseLU(const KpfaSparseLU &);
+
+	KpfaSparseLU &operator = (const KpfaSparseLU &);
+};
+
+#endif /* _KPFA_SPARSE_LU_H_ */
@@ -33,19 +33,16 @@ KpfaYMatrix::~KpfaYMatrix() {
 KpfaError_t
 KpfaYMatrix::ApplyBusData(KpfaRawDataMgmt *pDataMgmt) {
 
-	uint32_t k;
 	KpfaComplexMatrix_t &mat = GetMatrix();
-	KpfaRawDataList_t &dataList = pDataMgmt->GetBusDataList();
+	KpfaNetworkModel *model = pDataMgmt->GetNetworkModel();
+	KpfaNetworkBus_t &bus = model->GetBus();
+	uint32_t nbus = model->GetBusCount();
 
 	// Update the admittance of the Y matrix with fixed shunt data.
-	KpfaRawDataList_t::iterator iter;
-
-	for(iter = dataList.begin(), k = 0; iter != dataList.end(); iter++, k++) {
-
-		KpfaBusData* bus = (KpfaBusData *)*iter;
+	for(uint32_t k = 0; k < nbus; k++) {
 
         // Skip the isolated bus
-        if(bus->m_nIde == KPFA_ISOLATED_BUS) {
+        if(bus.rIde[k] == KPFA_ISOLATED_BUS) {
             continue;
         }
 
@@ -53,7 +50,7 @@ KpfaYMatrix::ApplyBusData(KpfaRawDataMgmt *pDataMgmt) {
 		//---------------------------------------------------------------------------
 		// Y_kk = (Sum of y_kj + Sum of Image (B_kj/2)) + Shunt(GL, BL)
 		//---------------------------------------------------------------------------
-		mat(k, k) += KpfaComplex_t(bus->m_nGl, bus->m_nBl);
+		mat(k, k) += KpfaComplex_t(bus.rGl[k], bus.rBl[k]);
 	}
 
 	return KPFA_SUCCESS;
@@ -123,30 +120,28 @@ KpfaYMatrix::ApplyBranchData(KpfaRawDataMgmt *pDataMgmt) {
 
 	uint32_t msize = GetSize();
 	KpfaComplexMatrix_t &mat = m_rMatrix;
-	KpfaRawDataList_t &dataList = pDataMgmt->GetBranchDataList();
+	KpfaNetworkModel *model = pDataMgmt->GetNetworkModel();
+	KpfaNetworkBranch_t &branch = model->GetBranch();
+	uint32_t nbranch = model->GetBranchCount();
 
 	// Calculate the admittance of each branch.
-	KpfaRawDataList_t::iterator iter;
-
-	for(iter = dataList.begin(); iter != dataList.end(); iter++) {
-
-		KpfaBranchData *branch = (KpfaBranchData *)*iter;
+	for(uint32_t b = 0; b < nbranch; b++) {
 
         // Skip the branch out of service
-        if(branch->m_bSt == FALSE) {
+        if(branch.rSt[b] == FALSE) {
             continue;
         }
 
-		double r = branch->m_nR;
-		double x = branch->m_nX;
-		double hb = branch->m_nB / 2.0;
+		double r = branch.rR[b];
+		double x = branch.rX[b];
+		double hb = branch.rB[b] / 2.0;
 
 		double tapInv = 0;
-		double tap = branch->m_nTap;
+		double tap = branch.rTap[b];
 
 		// Each index of the array must start from 0.
-		uint32_t k = pDataMgmt->GetBusIndex(branch->m_nI);
-		uint32_t j = pDataMgmt->GetBusIndex(branch->m_nJ);
+		uint32_t k = branch.rFrom[b];
+		uint32_t j = branch.rTo[b];
 
 		KPFA_CHECK(k >= 0 && k < msize, KPFA_ERROR_YMATRIX_BUILD);
 		KPFA_CHECK(j >= 0 && j < msize, KPFA_ERROR_YMATRIX_BUILD);
@@ -200,23 +195,19 @@ KpfaYMatrix::ApplySwitchedShuntData(KpfaRawDataMgmt *pDataMgmt) {
 
 	uint32_t msize = GetSize();
 	KpfaComplexMatrix_t &mat = GetMatrix();
-	KpfaRawDataList_t &dataList = pDataMgmt->GetSwitchedShuntDataList();
+	KpfaNetworkModel *model = pDataMgmt->GetNetworkModel();
+	KpfaNetworkShunt_t &shunt = model->GetShunt();
+	uint32_t nshunt = model->GetShuntCount();
 
 	// Update the admittance of the Y matrix with fixed shunt data.
-	KpfaRawDataList_t::iterator iter;
+	for(uint32_t s = 0; s < nshunt; s++) {
 
-	for(iter = dataList.begin(); iter != dataList.end(); iter++) {
-
-		KpfaSwitchedShuntData *shunt = (KpfaSwitchedShuntData *)*iter;
-
-		KpfaBusData *shuntBusData = pDataMgmt->GetBusData(shunt->m_nI);
-		KPFA_CHECK(shuntBusData != NULL, KPFA_ERROR_INVALID_SSHUNT_DATA);
+		// Each index of the array must start from 0.
+		uint32_t k = shunt.rBus[s];
+		KPFA_CHECK(k != KPFA_NETWORK_NO_INDEX, KPFA_ERROR_INVALID_SSHUNT_DATA);
 
 		double gl = 0;
-		double bl = shuntBusData->m_nBl;
-
-		// Each index of the array must start from 0.
-		uint32_t k = pDataMgmt->GetBusIndex(shunt->m_nI);
+		double bl = model->GetBus().rBl[k];
 
 		KPFA_CHECK(k >= 0 && k < msize, KPFA_ERROR_YMATRIX_BUILD);
 